@@ -414,7 +414,7 @@ namespace std {
 size_t hash<sd::ShapeDescriptor>::operator()(const sd::ShapeDescriptor &k) const {
   auto res = std::hash<char>()(k.order());
   res ^= std::hash<int>()((int)k.dataType()) + 0x9e3779b9 + (res << 6) + (res >> 2);
-  auto shape_strides = const_cast<sd::ShapeDescriptor &>(k).shape_strides();
+  auto &shape_strides = const_cast<sd::ShapeDescriptor &>(k).shape_strides();
   auto ptr = shape_strides.data();
   //dont include strides if its' ews==1
   int stop = k.ews()==1? shape_strides.size()/2 : shape_strides.size() ;
@@ -81,7 +81,7 @@ size_t hash<sd::TadDescriptor>::operator()(const sd::TadDescriptor &k) const {
   // and bit shifting:
   auto res = std::hash<int>()((int)k.areUnitiesinShape());
   res ^= std::hash<sd::ShapeDescriptor>()(k.originalShapeConst()) + 0x9e3779b9 + (res << 6) + (res >> 2);
-  auto axes = const_cast<sd::TadDescriptor &>(k).axis();
+  auto &axes = const_cast<sd::TadDescriptor &>(k).axis();
   for (auto a : axes) {
     res ^= std::hash<int>()(a) + 0x9e3779b9 + (res << 6) + (res >> 2);
   }
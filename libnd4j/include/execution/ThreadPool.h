@@ -26,9 +26,12 @@
 #include <execution/CallableInterface.h>
 #include <execution/CallableWithArguments.h>
 #include <execution/Ticket.h>
+#include <execution/WorkStealingDeque.h>
 #include <system/common.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
 #include <queue>
@@ -36,30 +39,49 @@
 #include <vector>
 
 namespace samediff {
+/**
+ * Work-stealing pool: every worker owns lock-free deque of invitations into parallel regions (Tickets).
+ * Regions opened by workers (nested parallelism) go into own deque, regions opened by outside threads go
+ * into shared injection queue, and idle workers steal from each other.
+ */
 class SD_LIB_EXPORT ThreadPool {
  private:
   std::vector<std::thread> _threads;
-  std::vector<BlockingQueue<CallableWithArguments*>*> _queues;
-  std::vector<CallableInterface*> _interfaces;
+  std::vector<WorkStealingDeque<Ticket *> *> _deques;
 
   std::mutex _lock;
   std::atomic<int> _available;
-  std::queue<Ticket*> _tickets;
+  std::queue<Ticket *> _tickets;
+
+  // invitations submitted by threads that aren't part of this pool
+  std::mutex _injectionLock;
+  std::deque<Ticket *> _injection;
+  std::atomic<int> _injected;
+
+  // number of invitations sitting in queues, workers go to sleep only when it's 0
+  std::atomic<int> _queued;
+  std::atomic<int> _sleeping;
+  std::atomic<bool> _stopped;
+  std::mutex _sleepLock;
+  std::condition_variable _sleepCondition;
+
+  Ticket *take(int workerId);
+  void executionLoop(int workerId);
 
  protected:
   ThreadPool();
   ~ThreadPool();
 
  public:
-  static ThreadPool& getInstance();
+  static ThreadPool &getInstance();
 
   /**
-   * This method returns list of pointers to threads ONLY if num_threads of threads were available upon request,
-   * returning empty list otherwise
+   * This method returns Ticket with up to num_threads pool threads granted to it, or nullptr if no threads are
+   * available at all. Calling thread always takes part in execution, so partial grant still makes progress.
    * @param num_threads
    * @return
    */
-  Ticket* tryAcquire(int num_threads);
+  Ticket *tryAcquire(int num_threads);
 
   /**
    * This method marks specified number of threads as released, and available for use
@@ -67,7 +89,24 @@ class SD_LIB_EXPORT ThreadPool {
    */
   void release(int num_threads = 1);
 
-  void release(Ticket* ticket);
+  /**
+   * This method returns ticket back to the pool
+   * @param ticket
+   */
+  void release(Ticket *ticket);
+
+  /**
+   * This method puts invitation into given ticket into the queue of the current worker,
+   * or into the injection queue for external threads
+   * @param ticket
+   */
+  void submit(Ticket *ticket);
+
+  /**
+   * This method executes tasks of a single pending invitation, if any
+   * @return true if something was executed
+   */
+  bool executeOne();
 };
 }  // namespace samediff
 
@@ -106,8 +106,13 @@ class SD_LIB_EXPORT Threads {
 #ifdef _OPENMP
  public:
   static std::mutex gThreadmutex;
-  static uint64_t _nFreeThreads;
-  static bool tryAcquire(int numThreads);
+  static int64_t _nFreeThreads;
+
+  /**
+   * This method returns number of threads granted for the parallel region, which can be smaller than requested.
+   * 0 means region should be executed by calling thread alone.
+   */
+  static int tryAcquire(int numThreads);
   static bool freeThreads(int numThreads);
 #endif
  public:
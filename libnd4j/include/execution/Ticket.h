@@ -23,7 +23,6 @@
 #ifndef SAMEDIFF_TICKET_H
 #define SAMEDIFF_TICKET_H
 #include <execution/BlockingQueue.h>
-#include <execution/CallableInterface.h>
 #include <execution/CallableWithArguments.h>
 #include <system/common.h>
 
@@ -32,14 +31,49 @@
 #include <vector>
 
 namespace samediff {
+/**
+ * This class represents single parallel region: calling thread enqueues tasks into it, and pool threads invited
+ * via ThreadPool grab tasks one by one until nothing left. Calling thread takes part in execution as well, so
+ * region always makes progress even if every pool thread is busy.
+ */
 class SD_LIB_EXPORT Ticket {
  private:
+  struct Task {
+    int branch = 0;
+    uint32_t threadId = 0;
+    uint32_t numThreads = 0;
+
+    FUNC_DO function_do;
+    FUNC_1D function_1d;
+    FUNC_2D function_2d;
+    FUNC_3D function_3d;
+    FUNC_RL function_rl;
+    FUNC_RD function_rd;
+
+    int64_t arguments[9];
+    int64_t *lptr = nullptr;
+    double *dptr = nullptr;
+  };
+
   bool _acquired = false;
   std::vector<BlockingQueue<CallableWithArguments *> *> _queues;
   std::vector<CallableWithArguments *> _callables;
-  std::vector<samediff::CallableInterface *> _interfaces;
+
+  // task storage is never resized while ticket is in flight, since other threads read it
+  std::vector<Task> _tasks;
+  std::atomic<uint32_t> _enqueued;
+  std::atomic<uint32_t> _claimed;
+  std::atomic<uint32_t> _finished;
+
+  // calling thread holds one reference, plus one per invitation sent to the pool
+  std::atomic<int> _references;
 
   uint32_t _acquiredThreads = 0;
+  uint32_t _invitedThreads = 0;
+
+  Task *next();
+  void execute(Task &task);
+  void publish(uint32_t slot);
 
  public:
   explicit Ticket(const std::vector<BlockingQueue<CallableWithArguments *> *> &queues);
@@ -48,10 +82,14 @@ class SD_LIB_EXPORT Ticket {
 
   bool acquired();
 
+  /**
+   * This method resets ticket before new parallel region
+   * @param threads - number of pool threads granted to this region
+   * @param tasks - max number of tasks that will be enqueued
+   */
+  void acquiredThreads(uint32_t threads, uint32_t tasks);
   void acquiredThreads(uint32_t threads);
 
-  void attach(uint32_t thread_id, samediff::CallableInterface *call_interface);
-
   // deprecated one
   void enqueue(int thread_id, CallableWithArguments *callable);
 
@@ -67,6 +105,20 @@ class SD_LIB_EXPORT Ticket {
   void enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_3D func, int64_t start_x, int64_t stop_x, int64_t inc_x,
                int64_t start_y, int64_t stop_y, int64_t inc_y, int64_t start_, int64_t stop_z, int64_t inc_z);
 
+  /**
+   * This method executes tasks that weren't claimed by anyone yet, and returns once there's nothing left to claim
+   */
+  void execute();
+
+  /**
+   * This method drops one reference, ticket goes back to the pool once last reference is dropped
+   */
+  void detach();
+
+  /**
+   * This method executes remaining tasks within calling thread, blocks until all tasks are finished,
+   * and returns ticket back to the pool
+   */
   void waitAndRelease();
 };
 }  // namespace samediff
@@ -0,0 +1,112 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Bounded Chase-Lev deque: owner thread pushes and pops at the bottom, any other thread steals from the top
+//
+
+#ifndef SAMEDIFF_WORKSTEALINGDEQUE_H
+#define SAMEDIFF_WORKSTEALINGDEQUE_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace samediff {
+template <typename T>
+class WorkStealingDeque {
+ private:
+  std::unique_ptr<std::atomic<T>[]> _buffer;
+  const int64_t _mask;
+
+  // top and bottom are written by different threads, so they're kept a cache line apart. Padding is used instead of
+  // alignas(64), since deques are created with plain new, which doesn't honour over-alignment before C++17
+  char _paddingHead[64];
+  std::atomic<int64_t> _top;
+  char _paddingMiddle[64];
+  std::atomic<int64_t> _bottom;
+  char _paddingTail[64];
+
+ public:
+  /**
+   * @param capacity - must be power of 2
+   */
+  explicit WorkStealingDeque(int64_t capacity = 256)
+      : _buffer(new std::atomic<T>[capacity]), _mask(capacity - 1), _top(0), _bottom(0) {}
+  ~WorkStealingDeque() = default;
+
+  /**
+   * This method adds item to the bottom of the deque. Owner thread only.
+   * @return false if deque is full
+   */
+  bool push(T item) {
+    auto b = _bottom.load(std::memory_order_relaxed);
+    auto t = _top.load(std::memory_order_acquire);
+    if (b - t > _mask) return false;
+
+    _buffer[b & _mask].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * This method takes most recently pushed item. Owner thread only.
+   * @return nullptr if deque is empty
+   */
+  T pop() {
+    auto b = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = _top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      _bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    auto item = _buffer[b & _mask].load(std::memory_order_relaxed);
+    if (t == b) {
+      // last item, we're racing with thieves for it
+      if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        item = nullptr;
+
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return item;
+  }
+
+  /**
+   * This method takes oldest item. Safe to call from any thread.
+   * @return nullptr if deque is empty, or if another thread took the item first
+   */
+  T steal() {
+    auto t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = _bottom.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+
+    auto item = _buffer[t & _mask].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+
+    return item;
+  }
+};
+}  // namespace samediff
+
+#endif  // SAMEDIFF_WORKSTEALINGDEQUE_H
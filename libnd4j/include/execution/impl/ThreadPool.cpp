@@ -21,6 +21,7 @@
 //
 #include <execution/ThreadPool.h>
 #include <helpers/logger.h>
+#include <math/templatemath.h>
 
 #include <stdexcept>
 
@@ -29,69 +30,34 @@
 #endif
 
 namespace samediff {
+// index of the pool worker running on this thread, -1 for all other threads
+static thread_local int _workerId = -1;
 
-// this function executed once per thread, it polls functions from queue, and executes them via wrapper
-static void executionLoop_(int thread_id, BlockingQueue<CallableWithArguments *> *queue) {
-  while (true) {
-    // this method blocks until there's something within queue
-    auto c = queue->poll();
-    // sd_printf("ThreadPool: starting thread %i\n", c->threadId());
-    switch (c->dimensions()) {
-      case 0: {
-        c->function_do()(c->threadId(), c->numThreads());
-        c->finish();
-      } break;
-      case 1: {
-        auto args = c->arguments();
-        c->function_1d()(c->threadId(), args[0], args[1], args[2]);
-        c->finish();
-      } break;
-      case 2: {
-        auto args = c->arguments();
-        c->function_2d()(c->threadId(), args[0], args[1], args[2], args[3], args[4], args[5]);
-        c->finish();
-        // sd_printf("ThreadPool: finished thread %i\n", c->threadId());
-      } break;
-      case 3: {
-        auto args = c->arguments();
-        c->function_3d()(c->threadId(), args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7],
-                         args[8]);
-        c->finish();
-      } break;
-      default:
-        throw std::runtime_error("Don't know what to do with provided Callable");
-    }
-  }
-}
-
-static void executionLoopWithInterface_(int thread_id, CallableInterface *c) {
-  while (true) {
-    // blocking here until there's something to do
-    c->waitForTask();
-
-    // execute whatever we have
-    c->execute();
-  }
-}
+// number of empty polls before idle worker goes to sleep
+static const int _spinsBeforeSleep = 64;
 
 ThreadPool::ThreadPool() {
   // TODO: number of threads must reflect number of cores for UMA system. In case of NUMA it should be per-device pool
   // FIXME: on mobile phones this feature must NOT be used
-  _available = sd::Environment::getInstance().maxThreads();
+  _available = 0;
+  _injected = 0;
+  _queued = 0;
+  _sleeping = 0;
+  _stopped = false;
 
-  _queues.resize(_available.load());
-  _threads.resize(_available.load());
-  _interfaces.resize(_available.load());
+  auto numThreads = sd::Environment::getInstance().maxThreads();
+  _deques.resize(numThreads);
+  _threads.resize(numThreads);
 
 #ifndef __NEC__
   // we're not creating threadpool on aurora
+  // deques must exist before any worker starts stealing from them
+  for (int e = 0; e < numThreads; e++) _deques[e] = new WorkStealingDeque<Ticket *>();
+
   // creating threads here
-  for (int e = 0; e < _available.load(); e++) {
-    _queues[e] = new BlockingQueue<CallableWithArguments *>(2);
-    _interfaces[e] = new CallableInterface();
-    _threads[e] = std::thread(executionLoopWithInterface_, e, _interfaces[e]);
+  for (int e = 0; e < numThreads; e++) {
+    _threads[e] = std::thread(&ThreadPool::executionLoop, this, e);
     _tickets.push(new Ticket());
-    // _threads[e] = new std::thread(executionLoop_, e, _queues[e]);
 
     // TODO: add other platforms here as well
     // now we must set affinity, and it's going to be platform-specific thing
@@ -99,40 +65,27 @@ ThreadPool::ThreadPool() {
     cpu_set_t cpuset;
     CPU_ZERO(&cpuset);
     CPU_SET(e, &cpuset);
-    int rc = pthread_setaffinity_np(_threads[e]->native_handle(), sizeof(cpu_set_t), &cpuset);
+    int rc = pthread_setaffinity_np(_threads[e].native_handle(), sizeof(cpu_set_t), &cpuset);
     if (rc != 0) throw std::runtime_error("Failed to set pthread affinity");
 #endif
-    /*
-#if defined(_WIN32) || defined(_WIN64)
-    // we can't set affinity to more than 64 cores
-    if (e <= 64) {
-        auto mask = (static_cast<DWORD_PTR>(1) << e);
-        auto result = SetThreadAffinityMask(_threads[e]->native_handle(), mask);
-        if (!result)
-            throw std::runtime_error("Failed to set pthread affinity");
-    }
-
-    // that's fine. no need for time_critical here
-    SetThreadPriority(_threads[e]->native_handle(), THREAD_PRIORITY_HIGHEST);
-#endif
-     */
   }
-  //add an extra ticket to minimize the risk of running out of tickets due to race conditions
-  _tickets.push(new Ticket());
+
+  _available = numThreads;
 #endif
 }
 
 ThreadPool::~ThreadPool() {
   // TODO: implement this one properly
-  for (int e = 0; e < _queues.size(); e++) {
-    // stop each and every thread
-
-    // release queue and thread
-    delete _queues[e];
-    _threads[e].detach();
-    // delete _interfaces[e];
+  _stopped = true;
+  {
+    std::unique_lock<std::mutex> lock(_sleepLock);
+    _sleepCondition.notify_all();
   }
 
+  // threads might still be inside of the loop, so deques are left alone
+  for (auto &thread : _threads)
+    if (thread.joinable()) thread.detach();
+
   while (!_tickets.empty()) {
     auto t = _tickets.front();
     _tickets.pop();
@@ -148,44 +101,32 @@ ThreadPool &ThreadPool::getInstance() {
 void ThreadPool::release(int numThreads) { _available += numThreads; }
 
 Ticket *ThreadPool::tryAcquire(int numThreads) {
-  // std::vector<BlockingQueue<CallableWithArguments*>*> queues;
   if (numThreads <= 0) return nullptr;
+
+  // we grant as many threads as we have available right now, even if it's less than requested
+  auto available = _available.load();
+  int granted = 0;
+  do {
+    granted = sd::math::sd_min<int>(available, numThreads);
+    if (granted <= 0) return nullptr;
+  } while (!_available.compare_exchange_weak(available, available - granted));
+
   Ticket *t = nullptr;
-  // we check for threads availability first
-  bool threaded = false;
   {
-    // we lock before checking availability
     std::unique_lock<std::mutex> lock(_lock);
-    //test for both _available and _tickets in order to deal with race conditions caused by the
-    //fact that marking threads as available AND releasing tickets does not happen atomically
-    if (_available >= numThreads && !_tickets.empty()) {
-      threaded = true;
-      _available -= numThreads;
-
-      // getting a ticket from the queue
+    if (!_tickets.empty()) {
       t = _tickets.front();
       _tickets.pop();
-
-      // ticket must contain information about number of threads for the current session
-      t->acquiredThreads(numThreads);
-
-      // filling ticket with executable interfaces
-      for (int e = 0, i = 0; e < _queues.size() && i < numThreads; e++) {
-        if (_interfaces[e]->available()) {
-          t->attach(i++, _interfaces[e]);
-          _interfaces[e]->markUnavailable();
-        }
-      }
     }
   }
 
-  // we either dispatch tasks to threads, or run single-threaded
-  if (threaded) {
-    return t;
-  } else {
-    // if there's no threads available - return nullptr
-    return nullptr;
-  }
+  // tickets are only limited by memory now
+  if (t == nullptr) t = new Ticket();
+
+  // ticket must contain information about number of threads for the current session.
+  // callers enqueue either numThreads or numThreads + 1 tasks
+  t->acquiredThreads(granted, numThreads + 1);
+  return t;
 }
 
 void ThreadPool::release(samediff::Ticket *ticket) {
@@ -193,4 +134,85 @@ void ThreadPool::release(samediff::Ticket *ticket) {
   std::unique_lock<std::mutex> lock(_lock);
   _tickets.push(ticket);
 }
+
+void ThreadPool::submit(Ticket *ticket) {
+  _queued++;
+
+  if (_workerId < 0 || !_deques[_workerId]->push(ticket)) {
+    std::unique_lock<std::mutex> lock(_injectionLock);
+    _injection.push_back(ticket);
+    _injected++;
+  }
+
+  if (_sleeping.load() > 0) {
+    std::unique_lock<std::mutex> lock(_sleepLock);
+    _sleepCondition.notify_one();
+  }
+}
+
+Ticket *ThreadPool::take(int workerId) {
+  Ticket *t = nullptr;
+
+  // own deque first, most recent region is the one with hottest caches
+  if (workerId >= 0) t = _deques[workerId]->pop();
+
+  if (t == nullptr && _injected.load() > 0) {
+    std::unique_lock<std::mutex> lock(_injectionLock);
+    if (!_injection.empty()) {
+      t = _injection.front();
+      _injection.pop_front();
+      _injected--;
+    }
+  }
+
+  // and then we try to steal from other workers
+  auto numDeques = static_cast<int>(_deques.size());
+  for (int e = 1; t == nullptr && e <= numDeques; e++) {
+    auto victim = (workerId + e) % numDeques;
+    if (victim == workerId || _deques[victim] == nullptr) continue;
+
+    t = _deques[victim]->steal();
+  }
+
+  if (t != nullptr) _queued--;
+
+  return t;
+}
+
+bool ThreadPool::executeOne() {
+  auto t = take(_workerId);
+  if (t == nullptr) return false;
+
+  t->execute();
+
+  // this thread was granted to the ticket, now it's free again
+  release(1);
+  t->detach();
+  return true;
+}
+
+// this function executed once per thread, it takes invitations from queues and executes tasks of invited regions
+void ThreadPool::executionLoop(int workerId) {
+  _workerId = workerId;
+
+  int spins = 0;
+  while (!_stopped.load()) {
+    if (executeOne()) {
+      spins = 0;
+      continue;
+    }
+
+    if (++spins < _spinsBeforeSleep) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // blocking here until there's something to do
+    std::unique_lock<std::mutex> lock(_sleepLock);
+    _sleeping++;
+    _sleepCondition.wait(lock, [&] { return _queued.load() > 0 || _stopped.load(); });
+    _sleeping--;
+    spins = 0;
+  }
+}
 }  // namespace samediff
@@ -350,17 +350,22 @@ namespace samediff {
 #ifdef _OPENMP
 
 	std::mutex Threads::gThreadmutex;
-	uint64_t Threads::_nFreeThreads = sd::Environment::getInstance().maxThreads();
+	int64_t Threads::_nFreeThreads = sd::Environment::getInstance().maxThreads();
+
+	int Threads::tryAcquire(int numThreads) {
+		// nested region would get single thread from OpenMP anyway, so we don't hold threads other callers could use
+		if (omp_get_active_level() >= omp_get_max_active_levels())
+			return 0;
 
-	bool   Threads::tryAcquire(int numThreads) {
 		std::lock_guard<std::mutex> lock(gThreadmutex);
-		auto nThreads = _nFreeThreads - numThreads;
-		if (nThreads >= 0) {
-			_nFreeThreads = nThreads;
 
-			return true;
-		}
-		return false;
+		// we grant as many threads as available right now, even if it's less than requested
+		auto granted = sd::math::sd_min<int64_t>(_nFreeThreads, numThreads);
+		if (granted < 2)
+			return 0;
+
+		_nFreeThreads -= granted;
+		return static_cast<int>(granted);
 	}
 
 	bool  Threads::freeThreads(int numThreads) {
@@ -390,10 +395,11 @@ namespace samediff {
 		}
 
 #ifdef _OPENMP
-                if (tryAcquire(numThreads)) {
+                auto granted = tryAcquire(numThreads);
+                if (granted > 0) {
 
 			auto span = delta / numThreads;
-#pragma omp parallel for  schedule(guided) proc_bind(close) default(shared)
+#pragma omp parallel for schedule(guided) proc_bind(close) default(shared) num_threads(granted)
 			for (int e = 0; e < numThreads; e++) {
 				auto start_ = span * e + start;
 				auto stop_ = start_ + span;
@@ -401,7 +407,7 @@ namespace samediff {
 					stop_ = stop;
 				function(e, start_, stop_, increment);
 			}
-			freeThreads(numThreads);
+			freeThreads(granted);
 			return numThreads;
 		}
 		else {
@@ -513,13 +519,14 @@ namespace samediff {
 		else {
 #ifdef _OPENMP
 
-			if (tryAcquire(numThreads)) {
-#pragma omp parallel for
+			auto granted = tryAcquire(numThreads);
+			if (granted > 0) {
+#pragma omp parallel for num_threads(granted)
 				for (int e = 0; e < numThreads; e++) {
 					auto span = Span2::build(splitLoop, e, numThreads, startX, stopX, incX, startY, stopY, incY);
 					function(e, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY());
 				}
-				freeThreads(numThreads);
+				freeThreads(granted);
 				return numThreads;
 			}
 			else {
@@ -586,17 +593,18 @@ namespace samediff {
 
 #ifdef _OPENMP
 
-		if (tryAcquire(numThreads)) {
+		auto granted = tryAcquire(numThreads);
+		if (granted > 0) {
 
 			auto splitLoop = ThreadsHelper::pickLoop3d(numThreads, itersX, itersY, itersZ);
-#pragma omp parallel for
+#pragma omp parallel for num_threads(granted)
 			for (int e = 0; e < numThreads; e++) {
 				auto thread_id = numThreads - e - 1;
 				auto span = Span3::build(splitLoop, thread_id, numThreads, startX, stopX, incX, startY, stopY, incY, startZ, stopZ, incZ);
 				function(e, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY(), span.startZ(), span.stopZ(), span.incZ());
 			}
 
-			freeThreads(numThreads);
+			freeThreads(granted);
 			return numThreads;
 		}
 		else {
@@ -644,13 +652,14 @@ namespace samediff {
 
 #ifdef _OPENMP
 
-		if (tryAcquire(numThreads)) {
-#pragma omp parallel for
+		auto granted = tryAcquire(numThreads);
+		if (granted > 0) {
+#pragma omp parallel for num_threads(granted)
 			for (int e = 0; e < numThreads; e++) {
 				function(e, numThreads);
 			}
 
-			freeThreads(numThreads);
+			freeThreads(granted);
 			return numThreads;
 		}
 		else {
@@ -706,15 +715,16 @@ namespace samediff {
 		auto span = delta / numThreads;
 
 #ifdef _OPENMP
-		if (tryAcquire(numThreads)) {
-#pragma omp parallel for
+		auto granted = tryAcquire(numThreads);
+		if (granted > 0) {
+#pragma omp parallel for num_threads(granted)
 			for (int e = 0; e < numThreads; e++) {
 				auto start_ = span * e + start;
 				auto stop_ = span * (e + 1) + start;
 
 				intermediatery[e] = function(e, start_, e == numThreads - 1 ? stop : stop_, increment);
 			}
-			freeThreads(numThreads);
+			freeThreads(granted);
 		}
 		else {
 			// if there were no threads available - we'll execute function right within current thread
@@ -769,15 +779,16 @@ namespace samediff {
 
 #ifdef _OPENMP
 
-		if (tryAcquire(numThreads)) {
-#pragma omp parallel for
+		auto granted = tryAcquire(numThreads);
+		if (granted > 0) {
+#pragma omp parallel for num_threads(granted)
 			for (int e = 0; e < numThreads; e++) {
 				auto start_ = span * e + start;
 				auto stop_ = span * (e + 1) + start;
 
 				intermediatery[e] = function(e, start_, e == numThreads - 1 ? stop : stop_, increment);
 			}
-			freeThreads(numThreads);
+			freeThreads(granted);
 		}
 		else {
 			// if there were no thre ads available - we'll execute function right within current thread
@@ -908,12 +919,13 @@ namespace samediff {
 		thread_spans[numThreads - 1].end = stop;
 
 #ifdef _OPENMP
-		if (tryAcquire(numThreads)) {
-#pragma omp parallel for
+		auto granted = tryAcquire(numThreads);
+		if (granted > 0) {
+#pragma omp parallel for num_threads(granted)
 			for (size_t j = 0; j < numThreads; j++) {
 				function(j, thread_spans[j].start, thread_spans[j].end, increment);
 			}
-			freeThreads(numThreads);
+			freeThreads(granted);
 			return numThreads;
 		}
 		else {
@@ -28,68 +28,234 @@ namespace samediff {
 Ticket::Ticket(const std::vector<BlockingQueue<CallableWithArguments *> *> &queues) {
   _acquired = true;
   _queues = queues;
+  _enqueued = 0;
+  _claimed = 0;
+  _finished = 0;
+  _references = 0;
 }
 
 Ticket::Ticket() {
   _acquired = true;
-  _interfaces.resize(sd::Environment::getInstance().maxThreads());
+  _tasks.resize(sd::Environment::getInstance().maxThreads() + 1);
+  _enqueued = 0;
+  _claimed = 0;
+  _finished = 0;
+  _references = 0;
 }
 
 bool Ticket::acquired() { return _acquired; }
 
+void Ticket::acquiredThreads(uint32_t threads) { acquiredThreads(threads, threads + 1); }
+
+void Ticket::acquiredThreads(uint32_t threads, uint32_t tasks) {
+  // nobody else references this ticket at this point, so it's safe to resize storage
+  if (_tasks.size() < tasks) _tasks.resize(tasks);
+
+  _acquiredThreads = threads;
+  _invitedThreads = 0;
+  _enqueued.store(0, std::memory_order_relaxed);
+  _claimed.store(0, std::memory_order_relaxed);
+  _finished.store(0, std::memory_order_relaxed);
+  _references.store(1, std::memory_order_release);
+}
+
 void Ticket::enqueue(int thread_id, samediff::CallableWithArguments *callable) {
   _queues[thread_id]->put(callable);
   _callables.emplace_back(callable);
 }
 
+void Ticket::publish(uint32_t slot) {
+  _enqueued.store(slot + 1, std::memory_order_release);
+
+  // every task gets a chance to be picked up by another thread, as long as we have granted threads left
+  if (_invitedThreads < _acquiredThreads) {
+    _invitedThreads++;
+    _references++;
+    ThreadPool::getInstance().submit(this);
+  }
+}
+
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_DO func) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, func);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    func(thread_id, num_threads);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 0;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_do = std::move(func);
+  publish(slot);
 }
 
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_1D func, int64_t start_x, int64_t stop_x,
                      int64_t inc_x) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, func, start_x, stop_x, inc_x);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    func(thread_id, start_x, stop_x, inc_x);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 1;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_1d = std::move(func);
+  task.arguments[0] = start_x;
+  task.arguments[1] = stop_x;
+  task.arguments[2] = inc_x;
+  publish(slot);
 }
 
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, int64_t *lpt, FUNC_RL func, int64_t start_x,
                      int64_t stop_x, int64_t inc_x) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, lpt, func, start_x, stop_x, inc_x);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    *lpt = func(thread_id, start_x, stop_x, inc_x);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 4;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_rl = std::move(func);
+  task.lptr = lpt;
+  task.arguments[0] = start_x;
+  task.arguments[1] = stop_x;
+  task.arguments[2] = inc_x;
+  publish(slot);
 }
 
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, double *dpt, FUNC_RD func, int64_t start_x,
                      int64_t stop_x, int64_t inc_x) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, dpt, func, start_x, stop_x, inc_x);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    *dpt = func(thread_id, start_x, stop_x, inc_x);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 5;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_rd = std::move(func);
+  task.dptr = dpt;
+  task.arguments[0] = start_x;
+  task.arguments[1] = stop_x;
+  task.arguments[2] = inc_x;
+  publish(slot);
 }
 
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_2D func, int64_t start_x, int64_t stop_x,
                      int64_t inc_x, int64_t start_y, int64_t stop_y, int64_t inc_y) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, std::move(func), start_x, stop_x, inc_x, start_y, stop_y, inc_y);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    func(thread_id, start_x, stop_x, inc_x, start_y, stop_y, inc_y);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 2;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_2d = std::move(func);
+  task.arguments[0] = start_x;
+  task.arguments[1] = stop_x;
+  task.arguments[2] = inc_x;
+  task.arguments[3] = start_y;
+  task.arguments[4] = stop_y;
+  task.arguments[5] = inc_y;
+  publish(slot);
 }
 
 void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_3D func, int64_t start_x, int64_t stop_x,
                      int64_t inc_x, int64_t start_y, int64_t stop_y, int64_t inc_y, int64_t start_z, int64_t stop_z,
                      int64_t inc_z) {
-  _interfaces[thread_id]->fill(thread_id, num_threads, func, start_x, stop_x, inc_x, start_y, stop_y, inc_y, start_z,
-                               stop_z, inc_z);
+  auto slot = _enqueued.load(std::memory_order_relaxed);
+  if (slot >= _tasks.size()) {
+    func(thread_id, start_x, stop_x, inc_x, start_y, stop_y, inc_y, start_z, stop_z, inc_z);
+    return;
+  }
+
+  auto &task = _tasks[slot];
+  task.branch = 3;
+  task.threadId = thread_id;
+  task.numThreads = num_threads;
+  task.function_3d = std::move(func);
+  task.arguments[0] = start_x;
+  task.arguments[1] = stop_x;
+  task.arguments[2] = inc_x;
+  task.arguments[3] = start_y;
+  task.arguments[4] = stop_y;
+  task.arguments[5] = inc_y;
+  task.arguments[6] = start_z;
+  task.arguments[7] = stop_z;
+  task.arguments[8] = inc_z;
+  publish(slot);
+}
+
+Ticket::Task *Ticket::next() {
+  auto claimed = _claimed.load(std::memory_order_relaxed);
+  while (claimed < _enqueued.load(std::memory_order_acquire)) {
+    if (_claimed.compare_exchange_weak(claimed, claimed + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+      return &_tasks[claimed];
+  }
+
+  return nullptr;
 }
 
-void Ticket::acquiredThreads(uint32_t threads) { _acquiredThreads = threads; }
+void Ticket::execute(Task &task) {
+  auto args = task.arguments;
+  switch (task.branch) {
+    case 0:
+      task.function_do(task.threadId, task.numThreads);
+      break;
+    case 1:
+      task.function_1d(task.threadId, args[0], args[1], args[2]);
+      break;
+    case 2:
+      task.function_2d(task.threadId, args[0], args[1], args[2], args[3], args[4], args[5]);
+      break;
+    case 3:
+      task.function_3d(task.threadId, args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]);
+      break;
+    case 4:
+      *task.lptr = task.function_rl(task.threadId, args[0], args[1], args[2]);
+      break;
+    case 5:
+      *task.dptr = task.function_rd(task.threadId, args[0], args[1], args[2]);
+      break;
+    default:
+      throw std::runtime_error("Don't know what to do with provided Callable");
+  }
+
+  _finished.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void Ticket::execute() {
+  for (auto task = next(); task != nullptr; task = next()) execute(*task);
+}
+
+void Ticket::detach() {
+  if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) ThreadPool::getInstance().release(this);
+}
 
 void Ticket::waitAndRelease() {
-  for (uint32_t e = 0; e < this->_acquiredThreads; e++) {
-    // block until finished
-    _interfaces[e]->waitForCompletion();
+  // calling thread picks up everything pool threads didn't get to yet
+  execute();
 
-    // mark available
-    _interfaces[e]->markAvailable();
+  // granted threads that were never invited go back to the pool right away
+  if (_invitedThreads < _acquiredThreads) ThreadPool::getInstance().release(_acquiredThreads - _invitedThreads);
 
-    // increment availability counter
-    ThreadPool::getInstance().release();
+  // now we wait for tasks claimed by other threads, helping out with other regions meanwhile
+  auto enqueued = _enqueued.load(std::memory_order_relaxed);
+  while (_finished.load(std::memory_order_acquire) < enqueued) {
+    if (!ThreadPool::getInstance().executeOne()) std::this_thread::yield();
   }
 
-  // return this ticket back to the pool
-  ThreadPool::getInstance().release(this);
+  detach();
 }
-
-void Ticket::attach(uint32_t thread_id, samediff::CallableInterface *call_interface) { _interfaces[thread_id] = call_interface; }
 }  // namespace samediff
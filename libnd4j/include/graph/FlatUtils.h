@@ -36,7 +36,12 @@ class SD_LIB_EXPORT FlatUtils {
 
   static std::pair<sd::LongType, sd::LongType> fromLongPair(LongPair* pair);
 
-  static NDArray* fromFlatArray(const sd::graph::FlatArray* flatArray);
+  /**
+   * This method restores NDArray from FlatArray. If zeroCopy is true, and payload is aligned and stored in native
+   * byte order, returned array points straight into the FlatBuffer memory instead of owning a copy, so that memory
+   * must outlive the array. Everything else is copied
+   */
+  static NDArray* fromFlatArray(const sd::graph::FlatArray* flatArray, bool zeroCopy = false);
 
   static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder& builder, NDArray& array);
 };
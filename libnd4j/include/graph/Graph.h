@@ -25,9 +25,12 @@
 #include <algorithm>
 #include <list>
 #include <map>
+#include <memory>
 #include <unordered_map>
 //#include <NDArray.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MappedFile.h>
+#include <graph/MemoryPlan.h>
 #include <graph/Node.h>
 #include <graph/Scope.h>
 #include <graph/Stash.h>
@@ -67,6 +70,11 @@ class SD_LIB_EXPORT Graph {
   SD_MAP_IMPL<int, Scope *> _mappedScopes;
   std::vector<Scope *> _scopes;
 
+  MemoryPlan *_memoryPlan = nullptr;
+
+  // ops created by fusion pass, they are owned by this graph
+  std::vector<sd::ops::DeclarableOp *> _fusedOps;
+
   ////////////////////////////////////////
   sd::Status validateNode(sd::graph::Node *node);
 
@@ -80,8 +88,20 @@ class SD_LIB_EXPORT Graph {
 
   void prepareOutputs();
 
+  /**
+   * This method replaces chains of elementwise nodes with single FusedElementwiseOp node.
+   * Only nodes consumed by exactly one other node, and not requested as graph outputs, are absorbed into chains
+   */
+  void fuseElementwise();
+
+  void cloneFusedOp(Node *node);
+
  public:
-  Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+  /**
+   * If mappedFile is given, flatGraph must live in it: weights are then used in place instead of being copied
+   */
+  Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr,
+        const std::shared_ptr<MappedFile> &mappedFile = nullptr);
 
   ~Graph();
 
@@ -97,6 +117,23 @@ class SD_LIB_EXPORT Graph {
   // this method will return estimated memory size (in bytes) required for 1 full graph execution round
   sd::LongType estimateRequiredMemory();
 
+  /**
+   * This method builds static MemoryPlan out of arrays stored in given VariableSpace after graph execution, and binds
+   * planned arrays to the arena
+   * @return nullptr if this graph can't be planned
+   */
+  MemoryPlan *planMemory(VariableSpace *variableSpace);
+
+  /**
+   * This method returns MemoryPlan built for this graph, or nullptr if there's none
+   */
+  MemoryPlan *memoryPlan();
+
+  /**
+   * This method releases MemoryPlan and its arena, arrays bound to the plan have to be released before
+   */
+  void dropMemoryPlan();
+
   // this method returns number of root nodes in this graph
   int rootNodes();
 
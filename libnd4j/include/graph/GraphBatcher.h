@@ -0,0 +1,174 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Dynamic request batching for graphs stored in GraphHolder
+//
+
+#ifndef LIBND4J_GRAPHBATCHER_H
+#define LIBND4J_GRAPHBATCHER_H
+
+#include <array/NDArray.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sd {
+namespace graph {
+
+enum class BatchPadding {
+  // only requests with identical non-batch dimensions share a batch
+  NONE = 0,
+  // ragged requests are padded with padValue up to the largest extent within a batch
+  PAD = 1,
+};
+
+struct SD_LIB_EXPORT BatcherOptions {
+  // upper bound of rows (sum of leading dimensions) per execution, single larger request still runs on its own
+  int maxBatchSize = 32;
+
+  // time the oldest queued request may wait for batch to fill up
+  sd::LongType maxLatencyMicros = 2000;
+
+  // number of batches executed concurrently, each one uses its own graph session
+  int numWorkers = 1;
+
+  BatchPadding padding = BatchPadding::NONE;
+  double padValue = 0.0;
+};
+
+struct SD_LIB_EXPORT BatcherStats {
+  sd::LongType requests = 0;
+  sd::LongType batches = 0;
+  sd::LongType failed = 0;
+
+  // rows executed, and elements added by padding
+  sd::LongType rows = 0;
+  sd::LongType paddedElements = 0;
+
+  // total time requests spent queued, before their batch started
+  sd::LongType queueMicros = 0;
+
+  sd::LongType queueDepth = 0;
+  sd::LongType maxQueueDepth = 0;
+
+  double meanBatchSize() const { return batches > 0 ? static_cast<double>(rows) / batches : 0.0; }
+  double meanQueueMicros() const { return requests > 0 ? static_cast<double>(queueMicros) / requests : 0.0; }
+};
+
+struct SD_LIB_EXPORT BatchResult {
+  sd::Status status = sd::Status::OK;
+  std::string error;
+
+  // graph outputs: rows belonging to the request for batched outputs, or full copy for everything else
+  std::vector<NDArray> outputs;
+
+  // variable id and index of every output
+  std::vector<std::pair<int, int>> outputIds;
+};
+
+/**
+ * Coalesces single requests to one stored graph along batch (first) dimension. Requests are queued until either
+ * maxBatchSize rows are available or the oldest request reaches maxLatencyMicros, then batch is executed once
+ * via GraphHolder session and outputs are split back to callers.
+ *
+ * Input arrays aren't copied on submit, so they have to stay alive until result is delivered.
+ */
+class SD_LIB_EXPORT GraphBatcher {
+ public:
+  typedef std::function<void(BatchResult&)> Callback;
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Request {
+    std::vector<const NDArray*> inputs;
+    sd::LongType rows;
+    Clock::time_point enqueued;
+
+    std::promise<BatchResult> promise;
+    Callback callback;
+  };
+
+  sd::LongType _graphId;
+  std::vector<int> _inputIds;
+  BatcherOptions _options;
+
+  std::mutex _lock;
+  std::condition_variable _condition;
+  std::deque<Request*> _queue;
+  sd::LongType _queuedRows = 0;
+  bool _stopped = false;
+
+  BatcherStats _stats;
+
+  std::vector<std::thread> _workers;
+
+  Request* buildRequest(const std::vector<const NDArray*>& inputs);
+  void enqueue(Request* request);
+
+  bool compatible(const Request* head, const Request* request) const;
+  std::vector<Request*> takeBatch();
+
+  void run();
+  void execute(std::vector<Request*>& batch);
+
+ public:
+  /**
+   * @param graphId - graph registered in GraphHolder
+   * @param inputIds - variable ids of graph inputs, requests provide arrays in the same order
+   */
+  GraphBatcher(sd::LongType graphId, const std::vector<int>& inputIds, const BatcherOptions& options);
+
+  /**
+   * Stops accepting requests, queued ones are still executed
+   */
+  ~GraphBatcher();
+
+  /**
+   * Same as destructor, but object stays valid: later submits fail instead of touching freed memory
+   */
+  void stop();
+
+  std::future<BatchResult> submit(const std::vector<const NDArray*>& inputs);
+
+  /**
+   * Callback is invoked from batcher's worker thread
+   */
+  void submit(const std::vector<const NDArray*>& inputs, const Callback& callback);
+
+  BatcherStats stats();
+
+  sd::LongType graphId() const { return _graphId; }
+
+  const std::vector<int>& inputIds() const { return _inputIds; }
+
+  const BatcherOptions& options() const { return _options; }
+};
+
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_GRAPHBATCHER_H
@@ -69,6 +69,12 @@ class SD_LIB_EXPORT GraphExecutioner {
   static Graph *importFromFlatBuffers(const char *filename);
 
   static Graph *importFromFlatPointer(sd::Pointer ptr);
+
+  /**
+   * This method memory-maps given FlatBuffers file instead of reading it. Aligned weights stored in native byte
+   * order are used straight from the mapping, so only pages actually touched are ever loaded
+   */
+  static Graph *importFromMappedFile(const char *filename);
 };
 
 long getFileSize(const char *filename);
@@ -21,10 +21,14 @@
 //
 #include <exceptions/unknown_graph_exception.h>
 #include <graph/Graph.h>
+#include <graph/GraphBatcher.h>
+#include <graph/GraphSession.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <helpers/logger.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace sd {
@@ -35,6 +39,14 @@ class SD_LIB_EXPORT GraphHolder {
 
   SD_MAP_IMPL<sd::LongType, SimpleReadWriteLock> _locks;
 
+  SD_MAP_IMPL<sd::LongType, GraphSessionPool*> _pools;
+
+  // batchers are shared with callers still submitting to them, so unregistering one can't free it underneath
+  SD_MAP_IMPL<sd::LongType, std::shared_ptr<GraphBatcher>> _batchers;
+  std::mutex _batchersLock;
+
+  void dropPool(sd::LongType graphId);
+
   GraphHolder() = default;
   ~GraphHolder() = default;
 
@@ -47,6 +59,31 @@ class SD_LIB_EXPORT GraphHolder {
 
   Graph* pullGraph(sd::LongType graphId);
 
+  /**
+   * Takes execution session of stored graph from its pool, it has to be given back via releaseSession()
+   */
+  GraphSession* checkoutSession(sd::LongType graphId);
+
+  void releaseSession(sd::LongType graphId, GraphSession* session);
+
+  /**
+   * Gives back session that failed during execution, it's destroyed instead of being reused
+   */
+  void discardSession(sd::LongType graphId, GraphSession* session);
+
+  /**
+   * Starts batching front-end for stored graph, requests submitted to it are executed together
+   */
+  std::shared_ptr<GraphBatcher> enableBatching(sd::LongType graphId, const std::vector<int>& inputIds,
+                                              const BatcherOptions& options);
+
+  std::shared_ptr<GraphBatcher> batcher(sd::LongType graphId);
+
+  /**
+   * Stops batching front-end, queued requests are executed before this method returns
+   */
+  void disableBatching(sd::LongType graphId);
+
   void forgetGraph(sd::LongType graphId);
 
   void dropGraph(sd::LongType graphId);
@@ -0,0 +1,133 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Reusable execution state for graphs stored in GraphHolder
+//
+
+#ifndef LIBND4J_GRAPHSESSION_H
+#define LIBND4J_GRAPHSESSION_H
+
+#include <graph/Graph.h>
+#include <graph/VariableProxy.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace sd {
+namespace graph {
+
+/**
+ * Copy of a stored graph prepared for repeated execution. Nodes belong to the session, variables of the original
+ * graph (i.e. weights) are shared read-only through VariableProxy. Inputs and intermediate results live in session's
+ * own VariableSpace and are overwritten by the next request, so arrays (and memory plan) from previous run get reused.
+ *
+ * Session is used by one request at a time.
+ */
+class SD_LIB_EXPORT GraphSession {
+ private:
+  Graph* _graph = nullptr;
+
+  // ids of inputs bound to external buffers during current request
+  std::vector<int> _bound;
+
+  // shapes and data types of inputs of the previous run and of the current request: intermediate arrays left by
+  // previous run only fit inputs of the same shape
+  std::vector<std::vector<sd::LongType>> _signature;
+  std::vector<std::vector<sd::LongType>> _pending;
+  bool _executed = false;
+
+  // drops intermediate arrays and memory plan, bound inputs are kept
+  void reset();
+
+  // position within owning pool, -1 for sessions built beyond pool capacity
+  int _slot = -1;
+
+  friend class GraphSessionPool;
+
+ public:
+  explicit GraphSession(Graph* origin);
+  ~GraphSession();
+
+  Graph* graph() { return _graph; }
+
+  VariableSpace* variableSpace() { return _graph->getVariableSpace(); }
+
+  /**
+   * Binds external buffer as input variable without copying, buffer has to stay alive until unbindInputs() call
+   */
+  void bindInput(int id, void* buffer, const sd::LongType* shapeInfo);
+
+  /**
+   * Detaches external buffers bound by bindInput(), so next request can't touch them
+   */
+  void unbindInputs();
+
+  /**
+   * Executes graph with bound inputs, state of previous run is dropped if input shapes changed since then
+   */
+  sd::Status execute();
+};
+
+/**
+ * Sessions of a single stored graph. Checkout and release only touch atomic flags: busy session is never handed out
+ * twice and idle sessions are never freed while the pool exists. New sessions are built under a lock, since cloning
+ * a graph registers cloned nodes in the original graph.
+ */
+class SD_LIB_EXPORT GraphSessionPool {
+ public:
+  static const int CAPACITY = 64;
+
+ private:
+  Graph* _origin;
+
+  GraphSession* _sessions[CAPACITY];
+  std::atomic<bool> _busy[CAPACITY];
+
+  // number of published sessions, slots below it are immutable
+  std::atomic<int> _size;
+
+  std::mutex _lock;
+
+ public:
+  explicit GraphSessionPool(Graph* origin);
+  ~GraphSessionPool();
+
+  /**
+   * Returns idle session, or builds a new one if all sessions are busy
+   */
+  GraphSession* checkout();
+
+  /**
+   * Returns session to the pool, external inputs are unbound
+   */
+  void release(GraphSession* session);
+
+  /**
+   * Destroys session that failed during execution, its slot gets a freshly built session
+   */
+  void discard(GraphSession* session);
+
+  int size() { return _size.load(); }
+};
+
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_GRAPHSESSION_H
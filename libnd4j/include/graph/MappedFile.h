@@ -0,0 +1,61 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Read-only memory mapping of the whole file, used for zero-copy graph loading
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+#include <system/common.h>
+
+#include <cstdint>
+
+namespace sd {
+namespace graph {
+/**
+ * This class maps given file into memory, and unmaps it on destruction. On POSIX systems mapping is private, so
+ * writes into mapped arrays are copy-on-write and never reach the file. On Windows mapping is read-only.
+ *
+ * Arrays pointing into the mapping hold it via shared_ptr, so it stays alive as long as any of them does.
+ */
+class SD_LIB_EXPORT MappedFile {
+ private:
+  uint8_t *_data = nullptr;
+  sd::LongType _size = 0L;
+  int _fd = -1;
+
+ public:
+  explicit MappedFile(const char *fileName);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &other) = delete;
+  MappedFile &operator=(const MappedFile &other) = delete;
+
+  const uint8_t *data() const { return _data; }
+  sd::LongType size() const { return _size; }
+
+  /**
+   * This method checks if given memory range lies within the mapping
+   */
+  bool contains(const void *ptr, sd::LongType numBytes) const;
+};
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_MAPPEDFILE_H
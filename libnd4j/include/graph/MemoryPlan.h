@@ -0,0 +1,98 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Static memory plan: intermediate arrays of the graph packed into single arena
+//
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+#include <memory/Workspace.h>
+#include <system/common.h>
+
+#include <utility>
+#include <vector>
+
+namespace sd {
+namespace graph {
+class Graph;
+class VariableSpace;
+
+class SD_LIB_EXPORT MemoryPlan {
+ public:
+  struct Allocation {
+    // variable this allocation was made for
+    std::pair<int, int> id;
+    // first and last onion layers where this array is used, both inclusive
+    int firstLayer;
+    int lastLayer;
+    sd::LongType offset;
+    sd::LongType bytes;
+  };
+
+ protected:
+  std::vector<Allocation> _allocations;
+
+  // outputs of inplace nodes: they share memory with allocation at given index
+  std::vector<std::pair<std::pair<int, int>, int>> _aliases;
+
+  sd::LongType _plannedBytes = 0L;
+  sd::LongType _naiveBytes = 0L;
+
+  sd::memory::Workspace *_arena = nullptr;
+  int8_t *_base = nullptr;
+
+  MemoryPlan() = default;
+
+  void assignOffsets();
+
+ public:
+  // offsets within arena are aligned to this number of bytes
+  static const sd::LongType ALIGNMENT = 64;
+
+  ~MemoryPlan();
+
+  /**
+   * This method builds plan using arrays produced by previous execution of the graph.
+   * Layers of the onion are used as time steps: arrays used within intersecting layer ranges never share memory, so
+   * plan stays valid if nodes of the same layer are executed concurrently.
+   *
+   * @return nullptr if graph can't be planned statically, i.e. it has logic ops
+   */
+  static MemoryPlan *build(Graph *graph, VariableSpace *variableSpace);
+
+  /**
+   * This method allocates arena, and replaces planned arrays in VariableSpace with arena-backed views.
+   * DeclarableOp::prepareOutputs() reuses existing arrays, so all following executions write into the arena
+   */
+  void bind(VariableSpace *variableSpace);
+
+  const std::vector<Allocation> &allocations() const { return _allocations; }
+
+  // size of the arena
+  sd::LongType plannedBytes() const { return _plannedBytes; }
+
+  // memory required if every intermediate array is allocated separately
+  sd::LongType naiveBytes() const { return _naiveBytes; }
+
+  void printOut();
+};
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_MEMORYPLAN_H
@@ -72,7 +72,22 @@ class SD_LIB_EXPORT RandomGenerator {
    */
   static SD_INLINE sd::LongType currentMilliseconds();
 
+  /**
+   * Stateless core of xoroshiro32, so bulk methods can keep states in registers
+   */
+  static SD_INLINE SD_HOST_DEVICE uint32_t xoroshiro32(uint64_t rootState, uint64_t nodeState, uint64_t index);
+
+  /**
+   * Maps 32 random bits to float within [0, 1)
+   */
+  static SD_INLINE SD_HOST_DEVICE float toUnitFloat(uint32_t bits);
+
  public:
+  /**
+   * Number of elements bulk methods below are meant to be called for at once, temporary buffers are sized with it
+   */
+  static const int BLOCK_LENGTH = 1024;
+
   SD_INLINE SD_HOST_DEVICE uint32_t xoroshiro32(uint64_t index);
   SD_INLINE SD_HOST_DEVICE uint64_t xoroshiro64(uint64_t index);
 
@@ -110,6 +125,23 @@ class SD_LIB_EXPORT RandomGenerator {
   SD_INLINE SD_HOST_DEVICE int relativeInt(sd::LongType index);
   SD_INLINE SD_HOST_DEVICE sd::LongType relativeLong(sd::LongType index);
 
+  /**
+   * Bulk versions of relativeT for floating point types: z[e] gets exactly the value relativeT<T>(index + e)
+   * would return, so output doesn't depend on the way array is split between threads
+   */
+  template <typename T>
+  SD_INLINE SD_HOST void relativeBlock(sd::LongType index, sd::LongType length, T *z);
+
+  template <typename T>
+  SD_INLINE SD_HOST void relativeBlock(sd::LongType index, sd::LongType length, T *z, T from, T to);
+
+  /**
+   * Box-Muller transform of two blocks of uniform values within (0, 1], done in place:
+   * u0 gets cosine branch and u1 gets sine branch of standard normal pairs
+   */
+  template <typename T>
+  static SD_INLINE SD_HOST void boxMuller(sd::LongType length, T *u0, T *u1);
+
   SD_INLINE SD_HOST_DEVICE void rewindH(uint64_t steps);
 
   /**
@@ -154,9 +186,7 @@ SD_INLINE sd::LongType RandomGenerator::currentMilliseconds() {
 
 template <>
 SD_INLINE SD_HOST_DEVICE float RandomGenerator::relativeT<float>(sd::LongType index) {
-  u32 u;
-  u._u32 = (0x3f800000 | (this->xoroshiro32(index) >> 9));
-  return u._f32 - 1.0f;
+  return toUnitFloat(this->xoroshiro32(index));
 }
 
 template <>
@@ -241,18 +271,81 @@ static SD_INLINE SD_HOST_DEVICE uint32_t next(uint32_t s0, uint32_t s1, uint32_t
 }
 
 SD_INLINE SD_HOST_DEVICE uint32_t RandomGenerator::xoroshiro32(uint64_t index) {
-  auto s0 = _rootState._ulong;
-  auto s1 = _nodeState._ulong;
+  return xoroshiro32(_rootState._ulong, _nodeState._ulong, index);
+}
+
+SD_INLINE SD_HOST_DEVICE uint32_t RandomGenerator::xoroshiro32(uint64_t rootState, uint64_t nodeState,
+                                                               uint64_t index) {
+  auto s0 = rootState;
+  auto s1 = nodeState;
 
   // xor by idx
   s0 |= ((index + 2) * (s1 + 24243287));
   s1 ^= ((index + 2) * (s0 + 723829));
 
-  unsigned long val = 0;
-  val = s1 ^ s0;
-  int *pHalf = reinterpret_cast<int *>(&val);
+  // we need the half of 64-bit value that lives at its lowest address
+  unsigned long val = s1 ^ s0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  uint32_t half = static_cast<uint32_t>(val >> (8 * (sizeof(unsigned long) - sizeof(uint32_t))));
+#else
+  uint32_t half = static_cast<uint32_t>(val);
+#endif
 
-  return rotl(*pHalf * 0x9E3779BB, 5) * 5;
+  return rotl(half * 0x9E3779BB, 5) * 5;
+}
+
+SD_INLINE SD_HOST_DEVICE float RandomGenerator::toUnitFloat(uint32_t bits) {
+  // 23 random mantissa bits scaled by 2^-23, bit-exact equivalent of (1.mantissa - 1.0f) without type punning
+  return static_cast<float>(bits >> 9) * 1.1920928955078125e-7f;
+}
+
+template <typename T>
+SD_INLINE SD_HOST void RandomGenerator::relativeBlock(sd::LongType index, sd::LongType length, T *z) {
+  const uint64_t root = _rootState._ulong;
+  const uint64_t node = _nodeState._ulong;
+
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < length; e++) z[e] = static_cast<T>(toUnitFloat(xoroshiro32(root, node, index + e)));
+}
+
+template <typename T>
+SD_INLINE SD_HOST void RandomGenerator::relativeBlock(sd::LongType index, sd::LongType length, T *z, T from, T to) {
+  const uint64_t root = _rootState._ulong;
+  const uint64_t node = _nodeState._ulong;
+  const T range = to - from;
+
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < length; e++) {
+    auto t = static_cast<T>(toUnitFloat(xoroshiro32(root, node, index + e)));
+    z[e] = from + T(t * range);
+  }
+}
+
+#ifdef __DOUBLE_RNG__
+template <>
+SD_INLINE SD_HOST void RandomGenerator::relativeBlock(sd::LongType index, sd::LongType length, double *z) {
+  for (sd::LongType e = 0; e < length; e++) z[e] = relativeT<double>(index + e);
+}
+
+template <>
+SD_INLINE SD_HOST void RandomGenerator::relativeBlock(sd::LongType index, sd::LongType length, double *z, double from,
+                                                      double to) {
+  for (sd::LongType e = 0; e < length; e++) z[e] = relativeT<double>(index + e, from, to);
+}
+#endif
+
+template <typename T>
+SD_INLINE SD_HOST void RandomGenerator::boxMuller(sd::LongType length, T *u0, T *u1) {
+  const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
+
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < length; e++) {
+    auto radius = sd::math::sd_sqrt<T, T>(static_cast<T>(-2.0f) * sd::math::sd_log<T, T>(u0[e]));
+    auto angle = two_pi * u1[e];
+
+    u0[e] = radius * sd::math::sd_cos<T, T>(angle);
+    u1[e] = radius * sd::math::sd_sin<T, T>(angle);
+  }
 }
 
 SD_INLINE SD_HOST_DEVICE uint64_t RandomGenerator::xoroshiro64(uint64_t index) {
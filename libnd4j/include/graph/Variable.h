@@ -24,11 +24,13 @@
 #define LIBND4J_VARIABLE_H
 #include <array/NDArray.h>
 #include <array/NDArrayList.h>
+#include <graph/MappedFile.h>
 #include <graph/VariableType.h>
 #include <graph/scheme/array_generated.h>
 #include <graph/scheme/graph_generated.h>
 #include <graph/scheme/node_generated.h>
 
+#include <memory>
 #include <string>
 
 #ifndef __JAVACPP_HACK__
@@ -81,13 +83,20 @@ class SD_LIB_EXPORT Variable {
 
   VariableType _variableType = VariableType::NDARRAY;
 
+  // mapped file the array points into, if it was loaded without copying
+  std::shared_ptr<MappedFile> _mappedFile;
+
  public:
   Variable(bool placeHolder);
   Variable(sd::NDArray *arrayw, const char *name, int id, int idx = 0);
   Variable(sd::NDArray *array = nullptr, const char *name = nullptr);
 
 #ifndef __JAVACPP_HACK__
-  Variable(const sd::graph::FlatVariable *flatVariable);
+  /**
+   * If mappedFile is given, flatVariable is expected to live in it: arrays of variables and constants are then
+   * wrapped in place whenever possible, and keep the mapping alive
+   */
+  Variable(const sd::graph::FlatVariable *flatVariable, const std::shared_ptr<MappedFile> &mappedFile = nullptr);
 #endif
 
   ~Variable();
@@ -34,6 +34,12 @@ class SD_LIB_EXPORT VariableProxy : public VariableSpace {
 
   virtual VariableSpace &operator=(const VariableSpace &other);
 
+  // space holding variables created through this proxy, backing space is never modified
+  VariableSpace *local() { return _current; }
+
+  // drops all variables created through this proxy
+  void resetLocal();
+
   virtual int numberOfPlaceholders();
   virtual std::vector<Variable *> *getPlaceholders();
 
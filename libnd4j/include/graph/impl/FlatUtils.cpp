@@ -34,7 +34,7 @@ std::pair<sd::LongType, sd::LongType> FlatUtils::fromLongPair(LongPair *pair) {
   return std::pair<sd::LongType, sd::LongType>(pair->first(), pair->second());
 }
 
-NDArray *FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray) {
+NDArray *FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray, bool zeroCopy) {
   auto rank = static_cast<int>(flatArray->shape()->Get(0));
   auto newShape = new sd::LongType[shape::shapeInfoLength(rank)];
   memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -92,7 +92,20 @@ NDArray *FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray) {
     return NDArrayFactory::string_(shapeVector, substrings);
   }
 
-  auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
+  const auto numBytes = length * DataTypeUtils::sizeOf(dtype);
+  const auto payload = flatArray->buffer()->data();
+
+  // payload is used in place only if it doesn't need any conversion
+  if (zeroCopy && ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()) == BitwiseUtils::asByteOrder() &&
+      flatArray->buffer()->size() >= numBytes &&
+      reinterpret_cast<uintptr_t>(payload) % DataTypeUtils::sizeOf(dtype) == 0) {
+    auto array = new NDArray(const_cast<int8_t *>(payload), newShape, sd::LaunchContext::defaultContext(), false);
+
+    delete[] newShape;
+    return array;
+  }
+
+  auto newBuffer = new int8_t[numBytes];
 
   BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions,
                         ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype,
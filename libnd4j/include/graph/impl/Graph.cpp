@@ -29,8 +29,11 @@
 #include <helpers/EnumUtils.h>
 #include <helpers/ShapeUtils.h>
 #include <legacy/NativeOps.h>
+#include <ops/declarable/FusedElementwiseOp.h>
 #include <ops/declarable/OpRegistrator.h>
 
+#include <map>
+#include <set>
 #include <vector>
 
 namespace sd {
@@ -201,6 +204,26 @@ void Graph::addOutput(int id) {
 
 ExecutorConfiguration *Graph::getExecutorConfiguration() { return _configuration; }
 
+MemoryPlan *Graph::planMemory(VariableSpace *variableSpace) {
+  if (_memoryPlan != nullptr) return _memoryPlan;
+
+  _memoryPlan = MemoryPlan::build(this, variableSpace);
+  if (_memoryPlan != nullptr) {
+    _memoryPlan->bind(variableSpace);
+
+    if (Environment::getInstance().isDebugAndVerbose()) _memoryPlan->printOut();
+  }
+
+  return _memoryPlan;
+}
+
+MemoryPlan *Graph::memoryPlan() { return _memoryPlan; }
+
+void Graph::dropMemoryPlan() {
+  delete _memoryPlan;
+  _memoryPlan = nullptr;
+}
+
 std::vector<Variable *> *Graph::fetchOutputs() {
   auto res = new std::vector<Variable *>();
 
@@ -259,6 +282,9 @@ Graph::~Graph() {
 
   for (auto v : _scopes) delete v;
 
+  for (auto v : _fusedOps) delete v;
+
+  delete _memoryPlan;
   delete _mapped;
   delete _nodes;
   delete _variableSpace;
@@ -637,7 +663,10 @@ sd::Status Graph::buildGraph() {
     }
   }
 
-  if (_unmapped.size() == 0) _built.store(true);
+  if (_unmapped.size() == 0) {
+    fuseElementwise();
+    _built.store(true);
+  }
 
   prepareOutputs();
 
@@ -791,7 +820,210 @@ void Graph::prepareOutputs() {
   }
 }
 
-Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+// fills FusedStep for given node, returns false if node can't be part of fused chain
+static bool describeFusedStep(Node *node, sd::ops::FusedStep &step) {
+  // step is reused for every candidate, nothing from previous one may leak into it
+  step = sd::ops::FusedStep();
+
+  if (!node->hasCustomOp() || !node->hasBlockAttached() || node->hasGraphEmbedded()) return false;
+
+  auto proto = node->getContextPrototype();
+  if (!proto->getDArguments()->empty()) return false;
+
+  const int numInputs = node->input()->size();
+  switch (node->opType()) {
+    case OpType_TRANSFORM_STRICT:
+    case OpType_TRANSFORM_SAME: {
+      if (numInputs != 1) return false;
+
+      step.opType = node->opType();
+      step.opNum = node->opNum();
+      step.extras = *proto->getTArguments();
+    } break;
+    case OpType_PAIRWISE: {
+      if (numInputs != 2) return false;
+
+      step.opType = OpType_PAIRWISE;
+      step.opNum = node->opNum();
+    } break;
+    case OpType_CUSTOM: {
+      // experimental builds pick result type of broadcastable ops differently
+      if (Environment::getInstance().isExperimentalBuild()) return false;
+
+      auto name = *node->getCustomOp()->getOpName();
+      auto bArgs = proto->getBArguments();
+      if (numInputs == 2) {
+        step.opType = OpType_PAIRWISE;
+        if (name == "add" || (name == "biasadd" && (bArgs->empty() || !bArgs->at(0))))
+          step.opNum = sd::pairwise::Add;
+        else if (name == "subtract")
+          step.opNum = sd::pairwise::Subtract;
+        else if (name == "multiply")
+          step.opNum = sd::pairwise::Multiply;
+        else if (name == "divide")
+          step.opNum = sd::pairwise::Divide;
+        else
+          return false;
+      } else if (numInputs == 1) {
+        if (name == "tanh") {
+          step.opType = OpType_TRANSFORM_STRICT;
+          step.opNum = sd::transform::Tanh;
+        } else if (name == "sigmoid") {
+          step.opType = OpType_TRANSFORM_STRICT;
+          step.opNum = sd::transform::Sigmoid;
+        } else if (name == "relu") {
+          step.opType = OpType_SCALAR;
+          step.opNum = sd::scalar::RELU;
+          step.scalar = proto->getTArguments()->empty() ? 0.0 : proto->getTArguments()->at(0);
+        } else {
+          return false;
+        }
+      } else {
+        return false;
+      }
+    } break;
+    default:
+      return false;
+  }
+
+  return sd::ops::FusedElementwiseOp::isFusable(step.opType, step.opNum);
+}
+
+void Graph::fuseElementwise() {
+  if (!Environment::getInstance().isGraphFusion() || !Environment::getInstance().isCPU()) return;
+
+  // every intermediate variable is expected to be available in this mode
+  if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE) return;
+
+  for (auto &v : *_mapped)
+    if (v.second->opType() == OpType_LOGIC || v.second->hasGraphEmbedded() || v.second->isDivergencePoint()) return;
+
+  std::map<int, int> references;
+  for (auto &v : *_mapped)
+    for (auto &in : *v.second->input()) references[in.first]++;
+
+  std::set<int> outputs(_output.begin(), _output.end());
+  std::set<int> absorbed;
+
+  // node can be absorbed into chain only if its result isn't needed anywhere else
+  auto absorbable = [&](const std::pair<int, int> &in) -> Node * {
+    if (in.first <= 0 || in.second != 0 || _mapped->count(in.first) == 0) return nullptr;
+    if (references[in.first] != 1 || outputs.count(in.first) > 0 || absorbed.count(in.first) > 0) return nullptr;
+
+    return _mapped->at(in.first);
+  };
+
+  struct Link {
+    Node *node;
+    sd::ops::FusedStep step;
+    // input of the node which carries running value of the chain
+    int chained;
+  };
+
+  // chains are collected starting from their tails, so later layers go first
+  for (int l = (int)_onion->size() - 1; l >= 0; l--) {
+    if (_onion->count(l) == 0) continue;
+
+    for (auto tail : *_onion->at(l)) {
+      sd::ops::FusedStep step;
+      if (absorbed.count(tail->id()) > 0 || !describeFusedStep(tail, step)) continue;
+
+      std::vector<Link> links;
+      auto current = tail;
+      while (current != nullptr) {
+        Link link = {current, step, 0};
+        current = nullptr;
+
+        const int numCandidates = link.step.opType == OpType_PAIRWISE ? 2 : 1;
+        for (int e = 0; e < numCandidates; e++) {
+          auto candidate = absorbable(link.node->input()->at(e));
+          if (candidate != nullptr && describeFusedStep(candidate, step)) {
+            link.chained = e;
+            current = candidate;
+            break;
+          }
+        }
+
+        links.emplace_back(link);
+      }
+
+      if (links.size() < 2) continue;
+
+      // inputs of fused op: running value first, then operands of pairwise steps
+      std::vector<std::pair<int, int>> inputs;
+      inputs.emplace_back(links.back().node->input()->at(links.back().chained));
+
+      std::vector<sd::ops::FusedStep> steps;
+      for (auto it = links.rbegin(); it != links.rend(); ++it) {
+        auto s = it->step;
+        if (s.opType == OpType_PAIRWISE) {
+          auto operand = it->node->input()->at(1 - it->chained);
+          auto position = std::find(inputs.begin(), inputs.end(), operand);
+          if (position == inputs.end()) position = inputs.insert(inputs.end(), operand);
+
+          s.operand = (int)(position - inputs.begin());
+          s.reversed = it->chained == 1;
+        }
+
+        steps.emplace_back(s);
+
+        if (it->node != tail) {
+          absorbed.insert(it->node->id());
+          it->node->pickOutputOnce(tail->id());
+        }
+      }
+
+      auto op = new sd::ops::FusedElementwiseOp((int)inputs.size(), steps);
+      _fusedOps.emplace_back(op);
+
+      if (tail->isDeductable()) {
+        Node::deleteOpByType(tail->opType(), tail->getCustomOp());
+        tail->setDeductable(false);
+      }
+
+      tail->setOpType(OpType_CUSTOM);
+      tail->setCustomOp(op);
+      tail->markInplace(false);
+
+      auto proto = tail->getContextPrototype();
+      proto->setOpDescriptor(op->getOpDescriptor());
+      proto->markInplace(false);
+      proto->inputs()->clear();
+      tail->input()->clear();
+      for (auto &in : inputs) {
+        proto->pickInput(in);
+        tail->input()->emplace_back(in);
+      }
+
+      // legacy inplace nodes don't own their variables, fused op always allocates own output
+      if (_variableSpace->hasVariable(tail->id())) _variableSpace->getVariable(tail->id())->markRemovable(true);
+
+      sd_debug("Node_%i fused with %i preceding node(s)\n", tail->id(), (int)links.size() - 1);
+    }
+  }
+
+  if (absorbed.empty()) return;
+
+  for (auto &v : *_onion) {
+    auto layer = v.second;
+    layer->erase(std::remove_if(layer->begin(), layer->end(),
+                                [&](Node *node) -> bool { return absorbed.count(node->id()) > 0; }),
+                 layer->end());
+  }
+}
+
+void Graph::cloneFusedOp(Node *node) {
+  // fused ops are owned by the graph, so each clone gets its own copy
+  auto fused = dynamic_cast<sd::ops::FusedElementwiseOp *>(node->getCustomOp());
+  if (fused == nullptr) return;
+
+  auto op = new sd::ops::FusedElementwiseOp(fused->getOpDescriptor()->getNumberOfInputs(), fused->steps());
+  _fusedOps.emplace_back(op);
+  node->setCustomOp(op);
+  node->getContextPrototype()->setOpDescriptor(op->getOpDescriptor());
+}
+
+Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, const std::shared_ptr<MappedFile> &mappedFile) {
   this->_onion = new SD_MAP_IMPL<int, std::vector<Node *> *>();
   this->_mapped = new SD_MAP_IMPL<int, Node *>();
   this->_nodes = new std::vector<int>();
@@ -818,7 +1050,7 @@ Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
     for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
       auto flatVar = flatGraph->variables()->Get(e);
 
-      auto var = new Variable(flatVar);
+      auto var = new Variable(flatVar, mappedFile);
       std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
       _variableSpace->putVariable(pair, var);
 
@@ -1219,6 +1451,7 @@ Graph *Graph::cloneWithProxy() {
     auto ovec = (*_onion)[v.first];
     for (auto x : *(ovec)) {
       auto n = x->clone();
+      clone->cloneFusedOp(n);
       vec->emplace_back(n);
       _handles.emplace_back(n);
       (*clone->_mapped)[n->id()] = n;
@@ -1264,6 +1497,7 @@ Graph *Graph::clone() {
     auto ovec = (*_onion)[v.first];
     for (auto x : *(ovec)) {
       auto n = x->clone();
+      clone->cloneFusedOp(n);
       vec->emplace_back(n);
       _handles.emplace_back(n);
       (*clone->_mapped)[n->id()] = n;
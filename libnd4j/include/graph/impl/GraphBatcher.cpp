@@ -0,0 +1,338 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Dynamic request batching for graphs stored in GraphHolder
+//
+#include <graph/GraphBatcher.h>
+#include <graph/GraphHolder.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sd {
+namespace graph {
+
+GraphBatcher::GraphBatcher(sd::LongType graphId, const std::vector<int>& inputIds, const BatcherOptions& options)
+    : _graphId(graphId), _inputIds(inputIds), _options(options) {
+  if (_inputIds.empty()) throw std::invalid_argument("GraphBatcher: at least one input id is required");
+
+  if (_options.maxBatchSize < 1) _options.maxBatchSize = 1;
+  if (_options.numWorkers < 1) _options.numWorkers = 1;
+  if (_options.maxLatencyMicros < 0) _options.maxLatencyMicros = 0;
+
+  for (int e = 0; e < _options.numWorkers; e++) _workers.emplace_back(&GraphBatcher::run, this);
+}
+
+GraphBatcher::~GraphBatcher() { stop(); }
+
+void GraphBatcher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _stopped = true;
+  }
+  _condition.notify_all();
+
+  for (auto& worker : _workers)
+    if (worker.joinable()) worker.join();
+}
+
+GraphBatcher::Request* GraphBatcher::buildRequest(const std::vector<const NDArray*>& inputs) {
+  if (inputs.size() != _inputIds.size())
+    throw std::invalid_argument("GraphBatcher: number of request inputs doesn't match number of graph inputs");
+
+  sd::LongType rows = -1;
+  for (auto input : inputs) {
+    if (input == nullptr || input->rankOf() < 1)
+      throw std::invalid_argument("GraphBatcher: request inputs must have batch dimension");
+
+    if (rows < 0) rows = input->sizeAt(0);
+
+    if (input->sizeAt(0) != rows || rows < 1)
+      throw std::invalid_argument("GraphBatcher: request inputs must have the same non-empty batch dimension");
+  }
+
+  auto request = new Request();
+  request->inputs = inputs;
+  request->rows = rows;
+  request->enqueued = Clock::now();
+
+  return request;
+}
+
+void GraphBatcher::enqueue(Request* request) {
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_stopped) {
+      delete request;
+      throw std::runtime_error("GraphBatcher: batcher was stopped");
+    }
+
+    _queue.emplace_back(request);
+    _queuedRows += request->rows;
+
+    _stats.requests++;
+    _stats.queueDepth = static_cast<sd::LongType>(_queue.size());
+    _stats.maxQueueDepth = std::max(_stats.maxQueueDepth, _stats.queueDepth);
+  }
+
+  _condition.notify_one();
+}
+
+std::future<BatchResult> GraphBatcher::submit(const std::vector<const NDArray*>& inputs) {
+  auto request = buildRequest(inputs);
+  auto future = request->promise.get_future();
+
+  enqueue(request);
+
+  return future;
+}
+
+void GraphBatcher::submit(const std::vector<const NDArray*>& inputs, const Callback& callback) {
+  auto request = buildRequest(inputs);
+  request->callback = callback;
+
+  enqueue(request);
+}
+
+BatcherStats GraphBatcher::stats() {
+  std::lock_guard<std::mutex> lock(_lock);
+  return _stats;
+}
+
+bool GraphBatcher::compatible(const Request* head, const Request* request) const {
+  for (size_t e = 0; e < _inputIds.size(); e++) {
+    auto a = head->inputs[e];
+    auto b = request->inputs[e];
+
+    if (a->dataType() != b->dataType() || a->rankOf() != b->rankOf()) return false;
+
+    if (_options.padding == BatchPadding::NONE)
+      for (int d = 1; d < a->rankOf(); d++)
+        if (a->sizeAt(d) != b->sizeAt(d)) return false;
+  }
+
+  return true;
+}
+
+std::vector<GraphBatcher::Request*> GraphBatcher::takeBatch() {
+  std::vector<Request*> batch;
+  std::deque<Request*> rest;
+  sd::LongType rows = 0;
+
+  // requests that can't join this batch keep their order for the next one
+  for (auto request : _queue) {
+    bool fits = batch.empty() || (rows + request->rows <= _options.maxBatchSize && compatible(batch[0], request));
+    if (fits && rows < _options.maxBatchSize) {
+      batch.emplace_back(request);
+      rows += request->rows;
+    } else {
+      rest.emplace_back(request);
+    }
+  }
+
+  _queue.swap(rest);
+  _queuedRows -= rows;
+  _stats.queueDepth = static_cast<sd::LongType>(_queue.size());
+
+  return batch;
+}
+
+void GraphBatcher::run() {
+  std::unique_lock<std::mutex> lock(_lock);
+
+  while (true) {
+    _condition.wait(lock, [this] { return _stopped || !_queue.empty(); });
+
+    // queue is drained before stopping
+    if (_queue.empty()) break;
+
+    // wait for the batch to fill up, until the oldest request runs out of time
+    while (!_stopped && !_queue.empty() && _queuedRows < _options.maxBatchSize) {
+      auto deadline = _queue.front()->enqueued + std::chrono::microseconds(_options.maxLatencyMicros);
+      if (Clock::now() >= deadline) break;
+
+      _condition.wait_until(lock, deadline);
+    }
+
+    // other worker could take everything meanwhile
+    if (_queue.empty()) continue;
+
+    auto batch = takeBatch();
+
+    // there might be enough requests left for another worker
+    if (!_queue.empty()) _condition.notify_one();
+
+    lock.unlock();
+    execute(batch);
+    lock.lock();
+  }
+}
+
+void GraphBatcher::execute(std::vector<Request*>& batch) {
+  auto started = Clock::now();
+
+  sd::LongType rows = 0;
+  for (auto request : batch) rows += request->rows;
+
+  std::vector<BatchResult> results(batch.size());
+  sd::LongType padded = 0;
+
+  try {
+    // requests are concatenated along the first dimension, ragged ones are padded up to the largest extent
+    std::vector<NDArray> inputs;
+    for (size_t e = 0; e < _inputIds.size(); e++) {
+      auto first = batch[0]->inputs[e];
+      auto rank = first->rankOf();
+
+      auto shape = first->getShapeAsVector();
+      shape[0] = rows;
+      for (auto request : batch)
+        for (int d = 1; d < rank; d++) shape[d] = std::max(shape[d], request->inputs[e]->sizeAt(d));
+
+      sd::LongType rowLength = 1;
+      for (int d = 1; d < rank; d++) rowLength *= shape[d];
+
+      sd::LongType missing = 0;
+      for (auto request : batch) missing += rowLength * request->rows - request->inputs[e]->lengthOf();
+
+      NDArray array('c', shape, first->dataType(), first->getContext());
+      if (missing > 0) array.assign(_options.padValue);
+
+      sd::LongType offset = 0;
+      for (auto request : batch) {
+        auto input = request->inputs[e];
+
+        std::vector<sd::LongType> idx(2 * rank);
+        idx[0] = offset;
+        idx[1] = offset + request->rows;
+        for (int d = 1; d < rank; d++) idx[2 * d + 1] = input->sizeAt(d);
+
+        auto view = array(idx, true);
+        view.assign(input);
+
+        offset += request->rows;
+      }
+
+      padded += missing;
+      inputs.emplace_back(array);
+    }
+
+    auto& holder = GraphHolder::getInstance();
+    holder.lockRead(_graphId);
+    GraphSession* session = nullptr;
+
+    try {
+      session = holder.checkoutSession(_graphId);
+
+      for (size_t e = 0; e < _inputIds.size(); e++)
+        session->bindInput(_inputIds[e], inputs[e].buffer(), inputs[e].shapeInfo());
+
+      auto status = session->execute();
+      if (status != sd::Status::OK) {
+        for (auto& result : results) {
+          result.status = status;
+          result.error = "GraphBatcher: graph execution failed";
+        }
+      } else {
+        auto varSpace = session->variableSpace();
+        auto outputs = session->graph()->fetchOutputs();
+
+        for (int o = 0; o < outputs->size(); o++) {
+          std::pair<int, int> varId(outputs->at(o)->id(), outputs->at(o)->index());
+          auto output = varSpace->getVariable(varId)->getNDArray();
+
+          // outputs without batch dimension are shared by all requests
+          bool batched = output->rankOf() > 0 && output->sizeAt(0) == rows;
+
+          sd::LongType offset = 0;
+          for (size_t r = 0; r < batch.size(); r++) {
+            results[r].outputIds.emplace_back(varId);
+
+            if (batched) {
+              std::vector<sd::LongType> idx(2 * output->rankOf(), 0);
+              idx[0] = offset;
+              idx[1] = offset + batch[r]->rows;
+              results[r].outputs.emplace_back((*output)(idx, true).dup());
+            } else {
+              results[r].outputs.emplace_back(output->dup());
+            }
+
+            offset += batch[r]->rows;
+          }
+        }
+
+        delete outputs;
+      }
+    } catch (...) {
+      // session might be left in inconsistent state, so it isn't reused
+      holder.discardSession(_graphId, session);
+      holder.unlockRead(_graphId);
+      throw;
+    }
+
+    holder.releaseSession(_graphId, session);
+    holder.unlockRead(_graphId);
+  } catch (std::exception& e) {
+    for (auto& result : results) {
+      result.status = sd::Status::BAD_GRAPH;
+      result.error = e.what();
+      result.outputs.clear();
+      result.outputIds.clear();
+    }
+  } catch (...) {
+    // anything escaping here would terminate worker thread and leave callers waiting forever
+    for (auto& result : results) {
+      result.status = sd::Status::BAD_GRAPH;
+      result.error = "GraphBatcher: unknown exception during graph execution";
+      result.outputs.clear();
+      result.outputIds.clear();
+    }
+  }
+
+  sd::LongType failed = 0;
+  for (size_t r = 0; r < batch.size(); r++) {
+    auto request = batch[r];
+    if (results[r].status != sd::Status::OK) failed++;
+
+    if (request->callback) {
+      // worker thread must survive misbehaving callbacks
+      try {
+        request->callback(results[r]);
+      } catch (...) {
+      }
+    } else {
+      request->promise.set_value(std::move(results[r]));
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _stats.batches++;
+    _stats.failed += failed;
+    _stats.rows += rows;
+    _stats.paddedElements += padded;
+    for (auto request : batch)
+      _stats.queueMicros += std::chrono::duration_cast<std::chrono::microseconds>(started - request->enqueued).count();
+  }
+
+  for (auto request : batch) delete request;
+}
+
+}  // namespace graph
+}  // namespace sd
@@ -53,6 +53,7 @@
 #include <chrono>
 #include <ctime>
 #include <deque>
+#include <execution/Threads.h>
 
 namespace sd {
 namespace graph {
@@ -193,6 +194,77 @@ sd::Status GraphExecutioner::executeFlatNode(Graph *graph, Node *node, VariableS
   return sd::Status::OK;
 }
 
+/**
+ * This method checks if given Node can be executed concurrently with other Nodes of the same onion layer.
+ * Only plain custom ops qualify: logic ops, divergent ops and embedded graphs touch FlowPath/frames,
+ * in-place ops might overwrite variables other nodes read, and ops with variable number of outputs
+ * would have to insert new entries into VariableSpace while other nodes are reading it.
+ */
+static bool canExecuteConcurrently(Node *node) {
+  if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || !node->hasCustomOp()) return false;
+
+  if (node->isDivergencePoint() || node->isInplace()) return false;
+
+  return node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs() > 0;
+}
+
+/**
+ * This method executes independent Nodes of a single onion layer using up to numThreads threads.
+ * Every worker picks next Node as soon as it's done with previous one, and limits its own ops to
+ * Environment::intraOpThreads() threads.
+ */
+static sd::Status executeConcurrently(Graph *graph, std::vector<Node *> &nodes, VariableSpace *variableSpace,
+                                      FlowPath *flowPath, int numThreads) {
+  // VariableSpace isn't safe for concurrent inserts, so we create all output variables upfront,
+  // and nodes only look them up during execution
+  for (auto node : nodes) {
+    auto numOutputs = node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs();
+    for (int e = 0; e < numOutputs; e++) {
+      std::pair<int, int> pair(node->id(), e);
+      if (!variableSpace->hasVariable(pair)) variableSpace->putVariable(pair, new Variable(nullptr, nullptr, node->id(), e));
+    }
+  }
+
+  std::vector<sd::Status> statuses(nodes.size(), sd::Status::OK);
+  std::vector<sd::LongType> times(nodes.size(), 0L);
+  std::atomic<int> nextNode(0);
+  const int numNodes = static_cast<int>(nodes.size());
+  const int intraOpThreads = Environment::getInstance().intraOpThreads();
+
+  auto func = PRAGMA_THREADS_DO {
+    Environment::getInstance().setThreadMaxMasterThreads(intraOpThreads);
+
+    for (int e = nextNode++; e < numNodes; e = nextNode++) {
+      auto timeStart = std::chrono::system_clock::now();
+
+      try {
+        statuses[e] = GraphExecutioner::executeFlatNode(graph, nodes[e], variableSpace);
+      } catch (std::exception &ex) {
+        sd_printf("Node_%i failed: %s\n", nodes[e]->id(), ex.what());
+        statuses[e] = sd::Status::KERNEL_FAILURE;
+      }
+
+      auto timeEnd = std::chrono::system_clock::now();
+      times[e] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+    }
+
+    Environment::getInstance().setThreadMaxMasterThreads(0);
+  };
+
+  samediff::Threads::parallel_do(func, sd::math::sd_min<int>(numThreads, numNodes));
+
+  // FlowPath isn't thread-safe either, so its bookkeeping happens here
+  for (int e = 0; e < numNodes; e++) {
+    flowPath->setOuterTime(nodes[e]->id(), times[e]);
+
+    if (statuses[e] != sd::Status::OK) return statuses[e];
+
+    flowPath->markExecuted(nodes[e]->id(), true);
+  }
+
+  return sd::Status::OK;
+}
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -228,6 +300,11 @@ sd::Status GraphExecutioner::execute(Graph *graph, VariableSpace *variableSpace)
 
   bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+  // independent nodes within the same layer can be executed concurrently, unless we're profiling or debugging
+  const int interOpThreads = Environment::getInstance().interOpThreads();
+  const bool concurrentExecution = pe && interOpThreads > 1 && !Environment::getInstance().isProfiling() &&
+                                   !Environment::getInstance().isDebugAndVerbose();
+
   // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be
   // disabled as well
 
@@ -242,8 +319,15 @@ sd::Status GraphExecutioner::execute(Graph *graph, VariableSpace *variableSpace)
   for (int l = 0; l < (int)graph->getOnion()->size(); l++) {
     int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+    // layers with logic ops can rewind execution or change frames, so they're always executed sequentially
+    bool concurrentLayer = concurrentExecution && layerSize > 1;
+    for (int n = 0; n < layerSize && concurrentLayer; n++)
+      if (graph->getOnion()->at(l)->at(n)->opType() == OpType_LOGIC) concurrentLayer = false;
+
+    // nodes that passed all activity checks, and will be executed together once the whole layer is scanned
+    std::vector<Node *> deferred;
+
     int n = 0;
-    // this omp block will probably never be the case
     for (; n < layerSize; n++) {
       if (++exec_counter > 10000) {
         l = graph->getOnion()->size();
@@ -410,6 +494,9 @@ sd::Status GraphExecutioner::execute(Graph *graph, VariableSpace *variableSpace)
         auto status = LogicExecutor::processNode(graph, node);
 
         if (status != sd::Status::OK) return status;
+      } else if (concurrentLayer && canExecuteConcurrently(node)) {
+        deferred.emplace_back(node);
+        continue;
       } else {
         auto timeStart = std::chrono::system_clock::now();
 
@@ -454,6 +541,23 @@ sd::Status GraphExecutioner::execute(Graph *graph, VariableSpace *variableSpace)
       // if node was executed - tag it as active
       flowPath->markExecuted(node->id(), true);
     }
+
+    if (deferred.size() == 1) {
+      auto timeStart = std::chrono::system_clock::now();
+
+      auto status = executeFlatNode(graph, deferred[0], __variableSpace);
+
+      auto timeEnd = std::chrono::system_clock::now();
+      auto outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+      flowPath->setOuterTime(deferred[0]->id(), outerTime);
+
+      if (status != sd::Status::OK) return status;
+
+      flowPath->markExecuted(deferred[0]->id(), true);
+    } else if (deferred.size() > 1) {
+      auto status = executeConcurrently(graph, deferred, __variableSpace, flowPath, interOpThreads);
+      if (status != sd::Status::OK) return status;
+    }
   }
 
   // optionally saving execution time
@@ -463,6 +567,11 @@ sd::Status GraphExecutioner::execute(Graph *graph, VariableSpace *variableSpace)
     // flowPath->profile().printOut();
   }
 
+  // arrays produced by the first run define the plan, following runs write intermediate results into the arena
+  if (Environment::getInstance().isMemoryPlanning() && graph->memoryPlan() == nullptr &&
+      __variableSpace == graph->getVariableSpace())
+    graph->planMemory(__variableSpace);
+
   // saving memory footprint for current run
   if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
     auto m = __variableSpace->launchContext()->getWorkspace()->getAllocatedSize();
@@ -867,5 +976,13 @@ Graph *GraphExecutioner::importFromFlatPointer(sd::Pointer ptr) {
 
   return restoredGraph;
 }
+
+Graph *GraphExecutioner::importFromMappedFile(const char *filename) {
+  auto mappedFile = std::make_shared<MappedFile>(filename);
+  auto fg = GetFlatGraph(mappedFile->data());
+
+  // mapping is kept alive by variables pointing into it, and released once the last of them is gone
+  return new Graph(fg, nullptr, mappedFile);
+}
 }  // namespace graph
 }  // namespace sd
@@ -21,6 +21,7 @@
 //
 #include <exceptions/graph_execution_exception.h>
 #include <exceptions/graph_exists_exception.h>
+#include <exceptions/unknown_graph_exception.h>
 #include <graph/GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 
@@ -35,6 +36,7 @@ void GraphHolder::registerGraph(sd::LongType graphId, Graph* graph) {
   if (hasGraphAny(graphId)) throw graph_exists_exception(graphId);
 
   _graphF[graphId] = graph;
+  _pools[graphId] = new GraphSessionPool(graph);
 
   sd::SimpleReadWriteLock lock;
   _locks[graphId] = lock;
@@ -62,7 +64,77 @@ Graph* GraphHolder::pullGraph(sd::LongType graphId) {
   return graph;
 }
 
+GraphSession* GraphHolder::checkoutSession(sd::LongType graphId) {
+  if (!this->hasGraph(graphId)) throw unknown_graph_exception(graphId);
+
+  return _pools[graphId]->checkout();
+}
+
+void GraphHolder::releaseSession(sd::LongType graphId, GraphSession* session) {
+  if (_pools.count(graphId) > 0)
+    _pools[graphId]->release(session);
+  else
+    delete session;
+}
+
+void GraphHolder::discardSession(sd::LongType graphId, GraphSession* session) {
+  if (session == nullptr) return;
+
+  if (_pools.count(graphId) > 0)
+    _pools[graphId]->discard(session);
+  else
+    delete session;
+}
+
+std::shared_ptr<GraphBatcher> GraphHolder::enableBatching(sd::LongType graphId, const std::vector<int>& inputIds,
+                                                          const BatcherOptions& options) {
+  if (!this->hasGraph(graphId)) throw unknown_graph_exception(graphId);
+
+  disableBatching(graphId);
+
+  auto batcher = std::make_shared<GraphBatcher>(graphId, inputIds, options);
+
+  std::lock_guard<std::mutex> lock(_batchersLock);
+  _batchers[graphId] = batcher;
+
+  return batcher;
+}
+
+std::shared_ptr<GraphBatcher> GraphHolder::batcher(sd::LongType graphId) {
+  std::lock_guard<std::mutex> lock(_batchersLock);
+  auto it = _batchers.find(graphId);
+
+  return it != _batchers.end() ? it->second : nullptr;
+}
+
+void GraphHolder::disableBatching(sd::LongType graphId) {
+  std::shared_ptr<GraphBatcher> batcher;
+  {
+    std::lock_guard<std::mutex> lock(_batchersLock);
+    auto it = _batchers.find(graphId);
+    if (it == _batchers.end()) return;
+
+    batcher = it->second;
+    _batchers.erase(it);
+  }
+
+  // batcher drains its queue using graph sessions, so it's stopped before them. Callers still holding it get an
+  // error on submit, and the object itself goes away with the last reference
+  batcher->stop();
+}
+
+void GraphHolder::dropPool(sd::LongType graphId) {
+  if (_pools.count(graphId) == 0) return;
+
+  // sessions hold clones of graph nodes, so they go away before the graph itself
+  delete _pools[graphId];
+  _pools.erase(graphId);
+}
+
 void GraphHolder::forgetGraph(sd::LongType graphId) {
+  disableBatching(graphId);
+  dropPool(graphId);
+
   if (this->hasGraph(graphId)) _graphF.erase(graphId);
 }
 
@@ -77,6 +149,9 @@ void GraphHolder::dropGraph(sd::LongType graphId) {
 void GraphHolder::dropGraphAny(sd::LongType graphId) {
   if (!hasGraphAny(graphId)) return;
 
+  // pending batches take read lock, so batcher has to be drained before write lock is taken
+  disableBatching(graphId);
+
   this->lockWrite(graphId);
 
   this->dropGraph(graphId);
@@ -96,7 +171,9 @@ void GraphHolder::replaceGraph(sd::LongType graphId, Graph* graph) {
 
   this->lockWrite(graphId);
 
+  dropPool(graphId);
   _graphF[graphId] = graph;
+  _pools[graphId] = new GraphSessionPool(graph);
 
   this->unlockWrite(graphId);
 }
@@ -0,0 +1,166 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Reusable execution state for graphs stored in GraphHolder
+//
+#include <graph/GraphExecutioner.h>
+#include <graph/GraphSession.h>
+
+namespace sd {
+namespace graph {
+
+GraphSession::GraphSession(Graph* origin) { _graph = origin->cloneWithProxy(); }
+
+GraphSession::~GraphSession() {
+  unbindInputs();
+  delete _graph;
+}
+
+void GraphSession::bindInput(int id, void* buffer, const sd::LongType* shapeInfo) {
+  // wrapper doesn't own the buffer, so deleting it later leaves caller's memory intact
+  auto array = new NDArray(buffer, shapeInfo);
+
+  // inputs always go to the local space, even if original graph has a placeholder with the same id
+  auto local = reinterpret_cast<VariableProxy*>(_graph->getVariableSpace())->local();
+  if (local->hasVariable(id)) {
+    auto var = local->getVariable(id);
+    if (var->hasNDArray() && var->isRemovable()) delete var->getNDArray();
+
+    var->setNDArray(array);
+    var->markRemovable(true);
+  } else {
+    local->putVariable(id, array);
+  }
+
+  _bound.emplace_back(id);
+
+  auto signature = array->getShapeAsVector();
+  signature.emplace_back(static_cast<sd::LongType>(array->dataType()));
+  _pending.emplace_back(signature);
+}
+
+void GraphSession::unbindInputs() {
+  auto local = reinterpret_cast<VariableProxy*>(_graph->getVariableSpace())->local();
+  for (auto id : _bound) {
+    auto var = local->getVariable(id);
+    if (var->hasNDArray() && var->isRemovable()) delete var->getNDArray();
+
+    var->setNDArray(nullptr);
+  }
+
+  _bound.clear();
+  _pending.clear();
+}
+
+void GraphSession::reset() {
+  auto proxy = reinterpret_cast<VariableProxy*>(_graph->getVariableSpace());
+
+  std::vector<NDArray*> inputs;
+  for (auto id : _bound) {
+    auto var = proxy->local()->getVariable(id);
+    inputs.emplace_back(var->getNDArray());
+    var->setNDArray(nullptr);
+  }
+
+  // views into the arena go away before the arena itself
+  proxy->resetLocal();
+  _graph->dropMemoryPlan();
+
+  for (size_t e = 0; e < _bound.size(); e++) proxy->local()->putVariable(_bound[e], inputs[e]);
+}
+
+sd::Status GraphSession::execute() {
+  if (_executed && _pending != _signature) reset();
+
+  _signature = _pending;
+  _executed = true;
+
+  return GraphExecutioner::execute(_graph, _graph->getVariableSpace());
+}
+
+GraphSessionPool::GraphSessionPool(Graph* origin) : _origin(origin), _size(0) {
+  for (int e = 0; e < CAPACITY; e++) {
+    _sessions[e] = nullptr;
+    _busy[e].store(false);
+  }
+}
+
+GraphSessionPool::~GraphSessionPool() {
+  auto size = _size.load();
+  for (int e = 0; e < size; e++) delete _sessions[e];
+}
+
+GraphSession* GraphSessionPool::checkout() {
+  auto size = _size.load(std::memory_order_acquire);
+  for (int e = 0; e < size; e++) {
+    bool expected = false;
+    if (!_busy[e].load(std::memory_order_relaxed) &&
+        _busy[e].compare_exchange_strong(expected, true, std::memory_order_acquire))
+      return _sessions[e];
+  }
+
+  std::lock_guard<std::mutex> lock(_lock);
+  auto session = new GraphSession(_origin);
+
+  auto slot = _size.load(std::memory_order_relaxed);
+  if (slot < CAPACITY) {
+    session->_slot = slot;
+    _sessions[slot] = session;
+    _busy[slot].store(true, std::memory_order_relaxed);
+    _size.store(slot + 1, std::memory_order_release);
+  }
+
+  return session;
+}
+
+void GraphSessionPool::release(GraphSession* session) {
+  session->unbindInputs();
+
+  if (session->_slot < 0) {
+    delete session;
+    return;
+  }
+
+  _busy[session->_slot].store(false, std::memory_order_release);
+}
+
+void GraphSessionPool::discard(GraphSession* session) {
+  auto slot = session->_slot;
+  delete session;
+
+  if (slot < 0) return;
+
+  // slot stays busy while it's being rebuilt, so nobody else can see it
+  GraphSession* replacement = nullptr;
+  try {
+    std::lock_guard<std::mutex> lock(_lock);
+    replacement = new GraphSession(_origin);
+    replacement->_slot = slot;
+  } catch (...) {
+    // slot is retired: it stays busy forever and is never handed out again
+    _sessions[slot] = nullptr;
+    return;
+  }
+
+  _sessions[slot] = replacement;
+  _busy[slot].store(false, std::memory_order_release);
+}
+
+}  // namespace graph
+}  // namespace sd
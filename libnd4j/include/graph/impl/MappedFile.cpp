@@ -0,0 +1,91 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Read-only memory mapping of the whole file, used for zero-copy graph loading
+//
+#include <fcntl.h>
+#include <graph/MappedFile.h>
+#include <sys/stat.h>
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <helpers/mman.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sd {
+namespace graph {
+MappedFile::MappedFile(const char *fileName) {
+#if defined(_WIN32) || defined(_WIN64)
+  _fd = _open(fileName, _O_RDONLY | _O_BINARY);
+#else
+  _fd = open(fileName, O_RDONLY);
+#endif
+  if (_fd < 0) throw std::runtime_error("MappedFile: unable to open file [" + std::string(fileName) + "]");
+
+  struct stat st;
+  if (fstat(_fd, &st) != 0 || st.st_size <= 0) {
+#if defined(_WIN32) || defined(_WIN64)
+    _close(_fd);
+#else
+    close(_fd);
+#endif
+    throw std::runtime_error("MappedFile: file [" + std::string(fileName) + "] is empty or can't be examined");
+  }
+
+  _size = static_cast<sd::LongType>(st.st_size);
+
+#if defined(_WIN32) || defined(_WIN64)
+  auto ptr = mmap(nullptr, static_cast<size_t>(_size), PROT_READ, MAP_SHARED, _fd, 0);
+#else
+  auto ptr = mmap(nullptr, static_cast<size_t>(_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, _fd, 0);
+#endif
+
+  if (ptr == MAP_FAILED) {
+#if defined(_WIN32) || defined(_WIN64)
+    _close(_fd);
+#else
+    close(_fd);
+#endif
+    throw std::runtime_error("MappedFile: mmap failed for file [" + std::string(fileName) + "]");
+  }
+
+  _data = reinterpret_cast<uint8_t *>(ptr);
+}
+
+MappedFile::~MappedFile() {
+  munmap(_data, static_cast<size_t>(_size));
+#if defined(_WIN32) || defined(_WIN64)
+  _close(_fd);
+#else
+  close(_fd);
+#endif
+}
+
+bool MappedFile::contains(const void *ptr, sd::LongType numBytes) const {
+  auto p = reinterpret_cast<const uint8_t *>(ptr);
+  return p >= _data && numBytes >= 0 && p + numBytes <= _data + _size;
+}
+}  // namespace graph
+}  // namespace sd
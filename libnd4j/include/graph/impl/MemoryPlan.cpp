@@ -0,0 +1,212 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Static memory plan: intermediate arrays of the graph packed into single arena
+//
+#include <array/NDArray.h>
+#include <graph/Graph.h>
+#include <graph/MemoryPlan.h>
+#include <graph/VariableSpace.h>
+#include <helpers/ShapeUtils.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace sd {
+namespace graph {
+
+static SD_INLINE sd::LongType alignBytes(sd::LongType bytes) {
+  return (bytes + MemoryPlan::ALIGNMENT - 1) / MemoryPlan::ALIGNMENT * MemoryPlan::ALIGNMENT;
+}
+
+MemoryPlan::~MemoryPlan() { delete _arena; }
+
+MemoryPlan *MemoryPlan::build(Graph *graph, VariableSpace *variableSpace) {
+  // arena lives in host memory only
+  if (!Environment::getInstance().isCPU()) return nullptr;
+
+  auto onion = graph->getOnion();
+  auto mapped = graph->getMapped();
+
+  // loops and conditionals make layer order differ from actual execution order
+  for (auto &v : *mapped)
+    if (v.second->opType() == OpType_LOGIC || v.second->hasGraphEmbedded() || v.second->isDivergencePoint())
+      return nullptr;
+
+  std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+
+  auto plan = new MemoryPlan();
+  std::map<std::pair<int, int>, int> planned;
+  std::set<int> pinned;
+
+  for (int l = 0; l < (int)onion->size(); l++) {
+    if (onion->count(l) == 0) continue;
+
+    for (auto node : *onion->at(l)) {
+      // legacy transform nodes are tagged as inplace, but they only reuse input if their context says so
+      const bool inplace = node->hasBlockAttached() && node->getContextPrototype()->isInplace();
+
+      // consumers extend lifetime of their inputs
+      for (auto &in : *node->input()) {
+        auto it = planned.find(in);
+        if (it != planned.end()) {
+          auto &a = plan->_allocations[it->second];
+          a.lastLayer = std::max(a.lastLayer, l);
+        }
+      }
+
+      for (int e = 0; variableSpace->hasVariable(node->id(), e); e++) {
+        std::pair<int, int> id(node->id(), e);
+
+        if (inplace) {
+          // inplace output shares memory with corresponding input
+          if (e < (int)node->input()->size()) {
+            auto it = planned.find(node->input()->at(e));
+            if (it != planned.end()) {
+              planned[id] = it->second;
+              plan->_aliases.emplace_back(id, it->second);
+
+              if (outputs.count(node->id()) > 0) pinned.insert(it->second);
+            }
+          }
+          continue;
+        }
+
+        if (!node->hasCustomOp() || outputs.count(node->id()) > 0) continue;
+
+        auto var = variableSpace->getVariable(id);
+        if (!var->hasNDArray()) continue;
+
+        // only plain arrays which own their whole buffer can be moved into the arena
+        auto array = var->getNDArray();
+        if (array->isEmpty() || array->isView() || array->bufferOffset() != 0 || array->ews() != 1 ||
+            array->lengthOf() < 1)
+          continue;
+
+        Allocation a;
+        a.id = id;
+        a.firstLayer = l;
+        a.lastLayer = l;
+        a.offset = 0;
+        a.bytes = array->lengthOf() * array->sizeOfT();
+
+        planned[id] = (int)plan->_allocations.size();
+        plan->_allocations.emplace_back(a);
+      }
+    }
+  }
+
+  // arrays that end up as graph outputs, via inplace nodes, must survive till the end of execution
+  for (auto p : pinned) plan->_allocations[p].lastLayer = (int)onion->size();
+
+  plan->assignOffsets();
+
+  return plan;
+}
+
+void MemoryPlan::assignOffsets() {
+  // greedy by size: the largest arrays get their offsets first, every array takes the tightest gap between
+  // arrays that are alive at the same time
+  std::vector<int> order(_allocations.size());
+  for (int e = 0; e < (int)order.size(); e++) order[e] = e;
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&](int a, int b) -> bool { return _allocations[a].bytes > _allocations[b].bytes; });
+
+  std::vector<int> placed;
+  std::vector<std::pair<sd::LongType, sd::LongType>> busy;
+
+  _plannedBytes = 0L;
+  _naiveBytes = 0L;
+
+  for (auto i : order) {
+    auto &a = _allocations[i];
+    auto bytes = alignBytes(a.bytes);
+    _naiveBytes += bytes;
+
+    busy.clear();
+    for (auto p : placed) {
+      auto &b = _allocations[p];
+      if (b.firstLayer <= a.lastLayer && a.firstLayer <= b.lastLayer)
+        busy.emplace_back(b.offset, b.offset + alignBytes(b.bytes));
+    }
+
+    std::sort(busy.begin(), busy.end());
+
+    sd::LongType bestOffset = -1;
+    sd::LongType bestGap = DataTypeUtils::max<sd::LongType>();
+    sd::LongType position = 0;
+    for (auto &r : busy) {
+      auto gap = r.first - position;
+      if (gap >= bytes && gap < bestGap) {
+        bestGap = gap;
+        bestOffset = position;
+      }
+
+      position = std::max(position, r.second);
+    }
+
+    a.offset = bestOffset >= 0 ? bestOffset : position;
+    _plannedBytes = std::max(_plannedBytes, a.offset + bytes);
+
+    placed.emplace_back(i);
+  }
+}
+
+void MemoryPlan::bind(VariableSpace *variableSpace) {
+  if (_allocations.empty() || _arena != nullptr) return;
+
+  _arena = new sd::memory::Workspace(_plannedBytes);
+  _base = reinterpret_cast<int8_t *>(_arena->allocateBytes(_plannedBytes));
+
+  std::vector<NDArray *> views(_allocations.size());
+  for (int e = 0; e < (int)_allocations.size(); e++) {
+    auto &a = _allocations[e];
+    auto var = variableSpace->getVariable(a.id);
+    auto array = var->getNDArray();
+
+    views[e] = new NDArray(_base + a.offset, array->shapeInfo(), array->getContext(), false);
+
+    if (var->isRemovable()) delete array;
+
+    var->setNDArray(views[e]);
+    var->markRemovable(true);
+  }
+
+  for (auto &v : _aliases) {
+    auto var = variableSpace->getVariable(v.first);
+    var->setNDArray(views[v.second]);
+    var->markRemovable(false);
+  }
+}
+
+void MemoryPlan::printOut() {
+  sd_printf("Memory plan: %i arrays; arena: %lld bytes; without planning: %lld bytes\n", (int)_allocations.size(),
+            _plannedBytes, _naiveBytes);
+
+  for (auto &a : _allocations) {
+    sd_printf("  [%i:%i]: layers [%i, %i]; offset: %lld; size: %lld\n", a.id.first, a.id.second, a.firstLayer,
+              a.lastLayer, a.offset, a.bytes);
+  }
+}
+
+}  // namespace graph
+}  // namespace sd
@@ -60,6 +60,7 @@ sd::graph::Variable *sd::graph::Variable::clone() {
   result->_name = this->_name;
   result->_index = this->_index;
 
+  // arrays living in mapped file are copied as well: clone is writable, and mapping is shared by the whole process
   if (this->_ndarray != nullptr) {
     result->_ndarray = new NDArray(this->_ndarray->dup(this->_ndarray->ordering()));
     result->_readOnly = false;
@@ -155,7 +156,8 @@ void sd::graph::Variable::setNDArray(sd::NDArray *array) {
 
 VariableType sd::graph::Variable::variableType() { return _variableType; }
 
-sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable) {
+sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable,
+                              const std::shared_ptr<MappedFile> &mappedFile) {
   auto vid = flatVariable->id();
   this->_id = vid->first();
   this->_index = vid->second();
@@ -167,12 +169,14 @@ sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable) {
 
   int8_t *buffer = nullptr;
 
+  const bool zeroCopy = mappedFile != nullptr;
+
   switch (flatVariable->variabletype()) {
     case VarType_VARIABLE: {
       // ?????
       if (flatVariable->ndarray() != nullptr) {
         auto ar = flatVariable->ndarray();
-        _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+        _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
       }
 
       _variableType = VariableType::NDARRAY;
@@ -184,7 +188,7 @@ sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable) {
       if (ar->dtype() == DType_UTF8) {
         _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
       } else {
-        _ndarray = sd::graph::FlatUtils::fromFlatArray(ar);
+        _ndarray = sd::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
       }
 
       _variableType = VariableType::NDARRAY;
@@ -221,6 +225,12 @@ sd::graph::Variable::Variable(const sd::graph::FlatVariable *flatVariable) {
     default:
       throw std::runtime_error("Unknown variable type used");
   }
+
+  if (zeroCopy && _ndarray != nullptr && !_ndarray->isEmpty() &&
+      mappedFile->contains(_ndarray->buffer(), _ndarray->lengthOf() * _ndarray->sizeOfT())) {
+    _mappedFile = mappedFile;
+    _readOnly = true;
+  }
 }
 
 std::vector<sd::LongType> &sd::graph::Variable::shape() { return _shape; }
@@ -34,6 +34,11 @@ VariableProxy::VariableProxy(VariableSpace *ref) {
 
 VariableProxy::~VariableProxy() { delete _current; }
 
+void VariableProxy::resetLocal() {
+  delete _current;
+  _current = new VariableSpace();
+}
+
 int VariableProxy::numberOfPlaceholders() { return _backed->numberOfPlaceholders(); }
 
 std::vector<Variable *> *VariableProxy::getPlaceholders() { return _backed->getPlaceholders(); }
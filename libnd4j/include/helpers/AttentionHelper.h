@@ -34,6 +34,30 @@ class SD_LIB_EXPORT AttentionHelper {
   static void multiHeadProjectBp(const sd::NDArray* input, const sd::NDArray* projectionMatrix, const sd::NDArray* eps,
                                  sd::NDArray* dLdInput, sd::NDArray* dLdProjectionMatrix,
                                  sd::LaunchContext* context = sd::LaunchContext ::defaultContext());
+
+  /**
+   * This method checks if dot product attention over given arrays can be computed by blocked CPU kernels below:
+   * all arrays must be either FLOAT32 or DOUBLE, with the same data type
+   */
+  static bool isBlockedAttentionApplicable(const std::vector<const sd::NDArray*>& arrays);
+
+  /**
+   * Dot product attention which never materializes [Tk, Tq] weights matrix: keys and values are streamed in
+   * blocks, while running max and running sum of softmax are kept for every query (online softmax).
+   * Arrays have the same layout dot_product_attention op uses:
+   * queries [bS, (nH,) d, Tq], keys [bS, (nH,) d, Tk], values [bS, (nH,) dv, Tk], mask [bS, Tk] or nullptr,
+   * output [bS, (nH,) dv, Tq]
+   */
+  static void dotProductAttention(const sd::NDArray* queries, const sd::NDArray* keys, const sd::NDArray* values,
+                                  const sd::NDArray* mask, bool normalization, sd::NDArray* output);
+
+  /**
+   * Backward pass of dotProductAttention(). Softmax weights are recomputed block by block from stored logsumexp
+   * of every query, so memory used stays linear in sequence length
+   */
+  static void dotProductAttentionBp(const sd::NDArray* queries, const sd::NDArray* keys, const sd::NDArray* values,
+                                    const sd::NDArray* eps, const sd::NDArray* mask, bool normalization,
+                                    sd::NDArray* dLdq, sd::NDArray* dLdk, sd::NDArray* dLdv);
 };
 }  // namespace sd
 
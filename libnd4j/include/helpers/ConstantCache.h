@@ -0,0 +1,217 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Concurrent insert-only cache used by ConstantShapeHelper and ConstantTadHelper
+//
+
+#ifndef LIBND4J_CONSTANTCACHE_H
+#define LIBND4J_CONSTANTCACHE_H
+
+#include <system/common.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace sd {
+
+enum ConstantCacheCounter {
+  CONSTANT_CACHE_LOCAL_HITS = 0,
+  CONSTANT_CACHE_HITS = 1,
+  CONSTANT_CACHE_MISSES = 2,
+  CONSTANT_CACHE_CONTENDED = 3,
+  CONSTANT_CACHE_ENTRIES = 4,
+};
+
+/**
+ * Counter split into cache-line sized slots, so threads updating it don't fight for the same line. Slots are padded
+ * rather than aligned: caches holding them are created with plain new, which ignores alignas(64) before C++17
+ */
+class StripedCounter {
+ private:
+  static const int NUM_SLOTS = 16;
+
+  struct Slot {
+    std::atomic<int64_t> value;
+    char padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+
+  Slot _slots[NUM_SLOTS];
+
+  static SD_INLINE int slot() {
+    static thread_local int slot = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_SLOTS);
+    return slot;
+  }
+
+ public:
+  StripedCounter() {
+    for (int e = 0; e < NUM_SLOTS; e++) _slots[e].value.store(0, std::memory_order_relaxed);
+  }
+
+  SD_INLINE void increment() { _slots[slot()].value.fetch_add(1, std::memory_order_relaxed); }
+
+  int64_t value() const {
+    int64_t result = 0;
+    for (int e = 0; e < NUM_SLOTS; e++) result += _slots[e].value.load(std::memory_order_relaxed);
+
+    return result;
+  }
+};
+
+/**
+ * Insert-only hash table: lookups walk immutable bucket chains without taking any locks, inserts take one of the
+ * shard locks. On top of that every thread keeps small direct-mapped front cache of recently used entries.
+ * Entries are never removed, so references to cached values stay valid for the lifetime of the cache.
+ *
+ * Number of buckets is fixed, since lock-free readers can't follow a rehash. Table is sized for the usual working
+ * set of shapes and TADs (thousands of entries); past NUM_BUCKETS entries chains grow linearly, so lookups that miss
+ * the front cache slow down proportionally. CONSTANT_CACHE_ENTRIES counter shows how close the cache is to that.
+ */
+template <typename K, typename V, typename H = std::hash<K>>
+class ConstantCache {
+ private:
+  struct Entry {
+    const size_t hash;
+    const K key;
+    V value;
+    Entry *const next;
+
+    Entry(size_t h, const K &k, const V &v, Entry *n) : hash(h), key(k), value(v), next(n) {}
+  };
+
+  struct FrontSlot {
+    const ConstantCache *owner = nullptr;
+    Entry *entry = nullptr;
+  };
+
+  // chains stay short up to about this many entries, see class description
+  static const int NUM_BUCKETS = 8192;
+  static const int NUM_SHARDS = 64;
+  static const int FRONT_SIZE = 64;
+
+  std::atomic<Entry *> _buckets[NUM_BUCKETS];
+  std::mutex _locks[NUM_SHARDS];
+  std::atomic<int64_t> _size;
+
+  StripedCounter _localHits;
+  StripedCounter _hits;
+  StripedCounter _misses;
+  StripedCounter _contended;
+
+  static SD_INLINE FrontSlot &frontSlot(size_t hash) {
+    static thread_local FrontSlot front[FRONT_SIZE];
+    return front[hash % FRONT_SIZE];
+  }
+
+  SD_INLINE Entry *find(size_t hash, const K &key) {
+    for (auto e = _buckets[hash % NUM_BUCKETS].load(std::memory_order_acquire); e != nullptr; e = e->next)
+      if (e->hash == hash && e->key == key) return e;
+
+    return nullptr;
+  }
+
+ public:
+  ConstantCache() : _size(0) {
+    for (int e = 0; e < NUM_BUCKETS; e++) _buckets[e].store(nullptr, std::memory_order_relaxed);
+  }
+
+  ~ConstantCache() {
+    for (int e = 0; e < NUM_BUCKETS; e++) {
+      auto entry = _buckets[e].load(std::memory_order_relaxed);
+      while (entry != nullptr) {
+        auto next = entry->next;
+        delete entry;
+        entry = next;
+      }
+    }
+  }
+
+  /**
+   * This method returns cached value for a given key, or creates it via factory if there's no such key yet.
+   * Factory is called at most once per key.
+   */
+  template <typename F>
+  V &getOrCreate(const K &key, F factory) {
+    const size_t hash = H()(key);
+
+    auto &slot = frontSlot(hash);
+    if (slot.owner == this && slot.entry->hash == hash && slot.entry->key == key) {
+      _localHits.increment();
+      return slot.entry->value;
+    }
+
+    auto entry = find(hash, key);
+    if (entry == nullptr) {
+      // buckets are mapped to shards, so all inserts into given bucket are serialized
+      std::unique_lock<std::mutex> lock(_locks[(hash % NUM_BUCKETS) % NUM_SHARDS], std::try_to_lock);
+      if (!lock.owns_lock()) {
+        _contended.increment();
+        lock.lock();
+      }
+
+      // other thread might have created this entry while we were waiting
+      entry = find(hash, key);
+      if (entry == nullptr) {
+        _misses.increment();
+
+        auto &bucket = _buckets[hash % NUM_BUCKETS];
+        entry = new Entry(hash, key, factory(), bucket.load(std::memory_order_relaxed));
+        bucket.store(entry, std::memory_order_release);
+        _size++;
+      } else {
+        _hits.increment();
+      }
+    } else {
+      _hits.increment();
+    }
+
+    slot.owner = this;
+    slot.entry = entry;
+    return entry->value;
+  }
+
+  bool contains(const K &key) { return find(H()(key), key) != nullptr; }
+
+  int64_t size() const { return _size.load(); }
+
+  /**
+   * This method returns value of the given ConstantCacheCounter
+   */
+  int64_t counter(int counter) const {
+    switch (counter) {
+      case CONSTANT_CACHE_LOCAL_HITS:
+        return _localHits.value();
+      case CONSTANT_CACHE_HITS:
+        return _hits.value();
+      case CONSTANT_CACHE_MISSES:
+        return _misses.value();
+      case CONSTANT_CACHE_CONTENDED:
+        return _contended.value();
+      case CONSTANT_CACHE_ENTRIES:
+        return size();
+      default:
+        return 0;
+    }
+  }
+};
+}  // namespace sd
+
+#endif  // LIBND4J_CONSTANTCACHE_H
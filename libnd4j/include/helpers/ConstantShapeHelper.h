@@ -26,6 +26,7 @@
 #include <array/ConstantShapeBuffer.h>
 #include <array/ShapeDescriptor.h>
 #include <memory/Workspace.h>
+#include <helpers/ConstantCache.h>
 #include <system/op_boilerplate.h>
 
 #include <map>
@@ -36,8 +37,7 @@ namespace sd {
 
 class SD_LIB_EXPORT ConstantShapeHelper {
  private:
-  std::mutex _mutex;
-  std::vector<SD_MAP_IMPL<ShapeDescriptor , ConstantShapeBuffer *>> _cache;
+  std::vector<ConstantCache<ShapeDescriptor, ConstantShapeBuffer *> *> _cache;
 #if defined(__NEC__)
   bool _cache_existing_pointers = true;
 #endif
@@ -93,7 +93,7 @@ class SD_LIB_EXPORT ConstantShapeHelper {
   SD_INLINE int cachedEntriesForDevice(int deviceId) {
     if (deviceId > _cache.size()) throw std::runtime_error("deviceId > number of actual devices");
 
-    return _cache[deviceId].size();
+    return _cache[deviceId]->size();
   }
 
   /**
@@ -103,7 +103,19 @@ class SD_LIB_EXPORT ConstantShapeHelper {
   SD_INLINE int totalCachedEntries() {
     int total = 0;
 
-    for (int e = 0; e < _cache.size(); e++) total += _cache[e].size();
+    for (int e = 0; e < _cache.size(); e++) total += _cache[e]->size();
+
+    return total;
+  }
+
+  /**
+   * This method returns value of the given ConstantCacheCounter, summed over all devices
+   * @return
+   */
+  SD_INLINE sd::LongType cacheCounter(int counter) {
+    sd::LongType total = 0;
+
+    for (int e = 0; e < _cache.size(); e++) total += _cache[e]->counter(counter);
 
     return total;
   }
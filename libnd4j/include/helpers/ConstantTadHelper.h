@@ -28,6 +28,7 @@
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/TadPack.h>
+#include <helpers/ConstantCache.h>
 #include <system/op_boilerplate.h>
 
 #include <map>
@@ -36,8 +37,7 @@
 namespace sd {
 class SD_LIB_EXPORT ConstantTadHelper {
  private:
-  std::mutex _mutex;
-  std::vector<SD_MAP_IMPL<TadDescriptor, TadPack>> _cache;
+  std::vector<ConstantCache<TadDescriptor, TadPack> *> _cache;
 
   ConstantTadHelper();
 
@@ -70,7 +70,7 @@ class SD_LIB_EXPORT ConstantTadHelper {
   SD_INLINE int cachedEntriesForDevice(int deviceId) {
     if (deviceId > _cache.size()) throw std::runtime_error("deviceId > number of actual devices");
 
-    return _cache[deviceId].size();
+    return _cache[deviceId]->size();
   }
 
   /**
@@ -80,7 +80,19 @@ class SD_LIB_EXPORT ConstantTadHelper {
   SD_INLINE int totalCachedEntries() {
     int total = 0;
 
-    for (int e = 0; e < _cache.size(); e++) total += _cache[e].size();
+    for (int e = 0; e < _cache.size(); e++) total += _cache[e]->size();
+
+    return total;
+  }
+
+  /**
+   * This method returns value of the given ConstantCacheCounter, summed over all devices
+   * @return
+   */
+  SD_INLINE sd::LongType cacheCounter(int counter) {
+    sd::LongType total = 0;
+
+    for (int e = 0; e < _cache.size(); e++) total += _cache[e]->counter(counter);
 
     return total;
   }
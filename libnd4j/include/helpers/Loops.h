@@ -30,6 +30,7 @@
 #include <helpers/shape.h>
 #include <loops/indexreduce.h>
 #include <ops/ops.h>
+#include <system/CpuDispatch.h>
 
 #include <functional>
 
@@ -699,6 +700,190 @@ SD_LIB_HIDDEN void reduceDefault(sd::memory::Workspace* workspace, const X* x, c
   if (!sameOffsets2) RELEASE(innerXTadOffsets, workspace);
 }
 
+////////////////////////////////////////////////////////////////////////
+// reduction problem with unit dimensions dropped, dimensions sorted by x stride and dimensions adjacent in memory
+// merged: tads are enumerated by outer dimensions, elements of every tad - by inner ones, innermost dimension last
+struct CollapsedReduceDims {
+  int outerRank = 0;
+  int innerRank = 0;
+
+  sd::LongType outerShape[SD_MAX_RANK];
+  sd::LongType outerXStrides[SD_MAX_RANK];
+  sd::LongType outerZStrides[SD_MAX_RANK];
+
+  sd::LongType innerShape[SD_MAX_RANK];
+  sd::LongType innerStrides[SD_MAX_RANK];
+};
+
+////////////////////////////////////////////////////////////////////////
+static SD_INLINE void collapseReduceDims(const sd::LongType* xShapeInfo, const sd::LongType* zShapeInfo,
+                                         const sd::LongType* dims, CollapsedReduceDims& c) {
+  const int zRank = shape::rank(zShapeInfo);
+  const int tadRank = shape::rank(xShapeInfo) - zRank;
+
+  // outer dimensions, z strides are moved along with x ones
+  c.outerRank = 0;
+  for (int i = 0; i < zRank; i++) {
+    const auto size = shape::sizeAt(xShapeInfo, dims[i]);
+    if (size == 1) continue;
+
+    const auto xStride = shape::strideAt(xShapeInfo, dims[i]);
+    const auto zStride = shape::strideAt(zShapeInfo, i);
+
+    // insertion sort by x stride, descending
+    int j = c.outerRank++;
+    for (; j > 0 && c.outerXStrides[j - 1] < xStride; j--) {
+      c.outerShape[j] = c.outerShape[j - 1];
+      c.outerXStrides[j] = c.outerXStrides[j - 1];
+      c.outerZStrides[j] = c.outerZStrides[j - 1];
+    }
+
+    c.outerShape[j] = size;
+    c.outerXStrides[j] = xStride;
+    c.outerZStrides[j] = zStride;
+  }
+
+  int merged = 0;
+  for (int i = 1; i < c.outerRank; i++) {
+    if (c.outerXStrides[merged] == c.outerXStrides[i] * c.outerShape[i] &&
+        c.outerZStrides[merged] == c.outerZStrides[i] * c.outerShape[i]) {
+      c.outerShape[merged] *= c.outerShape[i];
+      c.outerXStrides[merged] = c.outerXStrides[i];
+      c.outerZStrides[merged] = c.outerZStrides[i];
+    } else {
+      ++merged;
+      c.outerShape[merged] = c.outerShape[i];
+      c.outerXStrides[merged] = c.outerXStrides[i];
+      c.outerZStrides[merged] = c.outerZStrides[i];
+    }
+  }
+  if (c.outerRank > 0) c.outerRank = merged + 1;
+
+  // inner dimensions: order of accumulation doesn't matter for reduce ops
+  c.innerRank = 0;
+  for (int i = zRank; i < zRank + tadRank; i++) {
+    const auto size = shape::sizeAt(xShapeInfo, dims[i]);
+    if (size == 1) continue;
+
+    const auto stride = shape::strideAt(xShapeInfo, dims[i]);
+
+    int j = c.innerRank++;
+    for (; j > 0 && c.innerStrides[j - 1] < stride; j--) {
+      c.innerShape[j] = c.innerShape[j - 1];
+      c.innerStrides[j] = c.innerStrides[j - 1];
+    }
+
+    c.innerShape[j] = size;
+    c.innerStrides[j] = stride;
+  }
+
+  merged = 0;
+  for (int i = 1; i < c.innerRank; i++) {
+    if (c.innerStrides[merged] == c.innerStrides[i] * c.innerShape[i]) {
+      c.innerShape[merged] *= c.innerShape[i];
+      c.innerStrides[merged] = c.innerStrides[i];
+    } else {
+      ++merged;
+      c.innerShape[merged] = c.innerShape[i];
+      c.innerStrides[merged] = c.innerStrides[i];
+    }
+  }
+
+  if (c.innerRank > 0) {
+    c.innerRank = merged + 1;
+  } else {
+    // tad of single element
+    c.innerRank = 1;
+    c.innerShape[0] = 1;
+    c.innerStrides[0] = 1;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+template <typename X, typename S, typename E, typename OpType>
+static SD_INLINE S reduceRow(const X* x, const sd::LongType length, const sd::LongType stride, S s, E* extraParams) {
+  if (stride == 1)
+    for (sd::LongType i = 0; i < length; ++i) s = OpType::update(s, OpType::op(x[i], extraParams), extraParams);
+  else
+    for (sd::LongType i = 0; i < length; ++i)
+      s = OpType::update(s, OpType::op(x[i * stride], extraParams), extraParams);
+
+  return s;
+}
+
+////////////////////////////////////////////////////////////////////////
+// contiguous run folded into accumulator, built for every ISA level via IsaDispatch
+template <typename X, typename S, typename E, typename OpType>
+struct ReduceRowKernel {
+  static SD_INLINE void run(const X* x, const sd::LongType length, S* s, E* extraParams) {
+    *s = reduceRow<X, S, E, OpType>(x, length, 1, *s, extraParams);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////
+// reduces tads [start, stop) of collapsed array, built for every ISA level via IsaDispatch
+template <typename X, typename Z, typename E, typename OpType, int InnerRank>
+struct ReduceCollapsedKernel {
+  static SD_INLINE void run(const X* x, Z* z, const CollapsedReduceDims* c, E* extraParams, const sd::LongType tadLen,
+                            const int64_t start, const int64_t stop) {
+    const int outerRank = c->outerRank;
+
+    const sd::LongType axis0 = c->innerShape[0];
+    const sd::LongType strd0 = c->innerStrides[0];
+    const sd::LongType axis1 = InnerRank > 1 ? c->innerShape[1] : 1;
+    const sd::LongType strd1 = InnerRank > 1 ? c->innerStrides[1] : 0;
+    const sd::LongType axis2 = InnerRank > 2 ? c->innerShape[2] : 1;
+    const sd::LongType strd2 = InnerRank > 2 ? c->innerStrides[2] : 0;
+
+    for (auto i = start; i < stop; ++i) {
+      // offsets of the tad are evaluated once per tad, not per element
+      sd::LongType xOffset = 0, zOffset = 0, index = i;
+      for (int d = outerRank - 1; d >= 0; --d) {
+        const auto coord = index % c->outerShape[d];
+        index /= c->outerShape[d];
+
+        xOffset += coord * c->outerXStrides[d];
+        zOffset += coord * c->outerZStrides[d];
+      }
+
+      const auto tad = x + xOffset;
+      auto s = OpType::startingValue(tad);
+
+      if (InnerRank == 1) {
+        s = reduceRow<X, decltype(s), E, OpType>(tad, axis0, strd0, s, extraParams);
+      } else if (InnerRank == 2) {
+        for (sd::LongType i0 = 0; i0 < axis0; ++i0)
+          s = reduceRow<X, decltype(s), E, OpType>(tad + i0 * strd0, axis1, strd1, s, extraParams);
+      } else {
+        for (sd::LongType i0 = 0; i0 < axis0; ++i0)
+          for (sd::LongType i1 = 0; i1 < axis1; ++i1)
+            s = reduceRow<X, decltype(s), E, OpType>(tad + i0 * strd0 + i1 * strd1, axis2, strd2, s, extraParams);
+      }
+
+      z[zOffset] = OpType::postProcess(s, tadLen, extraParams);
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////
+// InnerRank is rank of the collapsed tad, loops over it are fully known at compile time
+template <typename X, typename Z, typename E, typename OpType, int InnerRank>
+static void reduceExecCollapsed(const X* x, Z* z, const CollapsedReduceDims& c, E* extraParams) {
+  const int outerRank = c.outerRank;
+
+  sd::LongType numTads = 1;
+  for (int i = 0; i < outerRank; i++) numTads *= c.outerShape[i];
+
+  sd::LongType tadLen = 1;
+  for (int i = 0; i < InnerRank; i++) tadLen *= c.innerShape[i];
+
+  auto func = PRAGMA_THREADS_FOR {
+    IsaDispatch<ReduceCollapsedKernel<X, Z, E, OpType, InnerRank>>::run(x, z, &c, extraParams, tadLen, start, stop);
+  };
+
+  samediff::Threads::parallel_for(func, 0, numTads);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z, typename E>
 template <typename OpType>
@@ -713,7 +898,17 @@ SD_LIB_HIDDEN void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace
   // shape::printShapeInfoLinear(zShapeInfo);
   // shape::printIntArray(dims, shape::rank(xShapeInfo));
 
-  if (xRank == 2 && zRank == 1)
+  // permuted views and contiguous runs of dimensions mostly collapse into tads of rank <= 3 with unit innermost stride
+  CollapsedReduceDims collapsed;
+  collapseReduceDims(xShapeInfo, zShapeInfo, dims, collapsed);
+
+  if (collapsed.innerRank == 1)
+    reduceExecCollapsed<X, Z, E, OpType, 1>(x, z, collapsed, extraParams);
+  else if (collapsed.innerRank == 2)
+    reduceExecCollapsed<X, Z, E, OpType, 2>(x, z, collapsed, extraParams);
+  else if (collapsed.innerRank == 3)
+    reduceExecCollapsed<X, Z, E, OpType, 3>(x, z, collapsed, extraParams);
+  else if (xRank == 2 && zRank == 1)
     reduceExec21<X, Z, E, OpType>(x, xShapeInfo, z, zShapeInfo, dims, extraParams);
   else if (xRank == 3 && zRank == 1)
     reduceExec31<X, Z, E, OpType>(x, xShapeInfo, z, zShapeInfo, dims, extraParams);
@@ -737,6 +932,15 @@ SD_LIB_HIDDEN void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace
     reduceDefault<X, Z, E, OpType>(workspace, x, xShapeInfo, z, zShapeInfo, dims, extraParams);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// contiguous elementwise transform, built for every ISA level via IsaDispatch
+template <typename X, typename Z, typename E, typename OpType>
+struct TransformKernel {
+  static SD_INLINE void run(const X* x, Z* z, E* extraParams, const int64_t start, const int64_t stop) {
+    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], extraParams);
+  }
+};
+
 //////////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z, typename E>
 template <typename OpType>
@@ -776,7 +980,7 @@ SD_LIB_HIDDEN void sd::TransformLoops<X, Z, E>::loopTransform(const X* x, const
       auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
       int64_t start = span.startX(), stop = span.stopX();
 
-      for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], extraParams);
+      IsaDispatch<TransformKernel<X, Z, E, OpType>>::run(x, z, extraParams, start, stop);
 
     } break;
 
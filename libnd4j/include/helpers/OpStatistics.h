@@ -0,0 +1,144 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Always-on per-op counters and latency histograms
+//
+
+#ifndef LIBND4J_OP_STATISTICS_H
+#define LIBND4J_OP_STATISTICS_H
+#include <system/common.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sd {
+class SD_LIB_EXPORT OpStatistics {
+ public:
+  // log-linear histogram: every power of two is split into SUB_BUCKETS linear buckets, so relative error of any
+  // reported latency is below 1 / SUB_BUCKETS
+  static const int SUB_BUCKETS = 8;
+  static const int MAGNITUDES = 40;
+  static const int NUM_BUCKETS = SUB_BUCKETS * MAGNITUDES;
+
+  struct SD_LIB_EXPORT Record {
+    std::string name;
+    int64_t calls = 0;
+    int64_t helperCalls = 0;
+    int64_t bytes = 0;
+    int64_t totalNanos = 0;
+    int64_t minNanos = INT64_MAX;
+    int64_t maxNanos = 0;
+    std::array<int64_t, NUM_BUCKETS> histogram{};
+
+    void add(int64_t nanos, int64_t bytes, bool helper);
+    void merge(const Record& other);
+
+    /**
+     * This method returns upper bound of latency bucket below which given fraction of calls falls
+     */
+    int64_t percentile(double fraction) const;
+  };
+
+  // records of single thread, owned by that thread and merged into global view on read
+  struct ThreadRecords {
+    std::mutex lock;
+    std::unordered_map<uint64_t, Record> records;
+
+    ThreadRecords();
+    ~ThreadRecords();
+  };
+
+ private:
+  std::mutex _lock;
+  std::vector<ThreadRecords*> _threads;
+
+  // records of threads which already finished
+  std::map<std::string, Record> _retired;
+
+  std::string _export;
+
+  OpStatistics() = default;
+  ~OpStatistics() = default;
+
+  static ThreadRecords& threadRecords();
+
+  void attach(ThreadRecords* records);
+  void detach(ThreadRecords* records);
+
+ public:
+  static OpStatistics& getInstance();
+
+  static int bucket(int64_t nanos);
+  static int64_t bucketUpperBound(int bucket);
+
+  /**
+   * This method returns number of bytes in array described by given shapeInfo, 0 for nullptr and empty arrays
+   */
+  static int64_t bytesOf(const sd::LongType* shapeInfo);
+
+  /**
+   * This method returns key of the legacy op, based on its category (i.e. "transform_strict") and op number
+   */
+  static uint64_t legacyKey(const char* category, int opNum);
+
+  /**
+   * This method stores single op call in records of the current thread.
+   * Name is resolved only once per thread: as is if opNum < 0, or "name:opNum" otherwise
+   */
+  void record(uint64_t key, const char* name, int opNum, int64_t nanos, int64_t bytes, bool helper);
+
+  /**
+   * This method merges records of all threads, keyed by op name
+   */
+  std::map<std::string, Record> snapshot();
+
+  /**
+   * This method returns merged records as JSON document. Returned pointer stays valid till next call
+   */
+  const char* exportJson();
+
+  void reset();
+};
+
+/**
+ * Measures lifetime of the scope, and stores it as a call of the legacy op when scope ends.
+ * Bytes touched are derived from given shapeInfos, any of them can be nullptr
+ */
+class SD_LIB_EXPORT OpStatisticsScope {
+ private:
+  const char* _category;
+  int _opNum;
+  int64_t _bytes;
+  bool _enabled;
+  std::chrono::steady_clock::time_point _start;
+
+ public:
+  OpStatisticsScope(const char* category, int opNum, const sd::LongType* xShapeInfo, const sd::LongType* yShapeInfo,
+                    const sd::LongType* zShapeInfo);
+  ~OpStatisticsScope();
+};
+}  // namespace sd
+
+#endif  // LIBND4J_OP_STATISTICS_H
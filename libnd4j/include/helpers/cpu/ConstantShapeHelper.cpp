@@ -30,10 +30,7 @@
 namespace sd {
 ConstantShapeHelper::ConstantShapeHelper() {
   _cache.resize(1);
-  for (int e = 0; e < 1; e++) {
-    SD_MAP_IMPL<ShapeDescriptor , ConstantShapeBuffer *> cache;
-    _cache[e] = cache;
-  }
+  for (int e = 0; e < 1; e++) _cache[e] = new ConstantCache<ShapeDescriptor, ConstantShapeBuffer *>();
 }
 
 ConstantShapeHelper& ConstantShapeHelper::getInstance() {
@@ -59,20 +56,15 @@ ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::DataType
 
 ConstantShapeBuffer * ConstantShapeHelper::bufferForShapeInfo(ShapeDescriptor *descriptor) {
   int deviceId = 0;
-  std::lock_guard<std::mutex> lock(_mutex);
   if(_cache.empty()) {
     throw std::runtime_error("Cache is empty!");
   }
 
-  if (_cache[deviceId].count(*descriptor) == 0) {
+  return _cache[deviceId]->getOrCreate(*descriptor, [&]() -> ConstantShapeBuffer * {
     auto hPtr =
         std::make_shared<PointerWrapper>(descriptor->toShapeInfo(), std::make_shared<PrimaryPointerDeallocator>());
-    ConstantShapeBuffer *constantShapeBuffer2 = new ConstantShapeBuffer(hPtr);
-    _cache[deviceId][*descriptor] = constantShapeBuffer2;
-    return constantShapeBuffer2;
-  } else {
-    return _cache[deviceId].at(*descriptor);
-  }
+    return new ConstantShapeBuffer(hPtr);
+  });
 }
 
 ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::LongType* shapeInfo) {
@@ -84,9 +76,8 @@ ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::LongType*
 
 bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor *descriptor) {
   int deviceId = 0;
-  std::lock_guard<std::mutex> lock(_mutex);
 
-  return _cache[deviceId].count(*descriptor) != 0;
+  return _cache[deviceId]->contains(*descriptor);
 }
 
 const sd::LongType* ConstantShapeHelper::createShapeInfo(const sd::DataType dataType, const char order, const int rank,
@@ -30,10 +30,7 @@
 
 namespace sd {
 
-ConstantTadHelper::ConstantTadHelper() {
-  SD_MAP_IMPL<TadDescriptor, TadPack> pack;
-  _cache.emplace_back(pack);
-}
+ConstantTadHelper::ConstantTadHelper() { _cache.emplace_back(new ConstantCache<TadDescriptor, TadPack>()); }
 
 ConstantTadHelper &ConstantTadHelper::getInstance() {
   static ConstantTadHelper instance;
@@ -65,8 +62,7 @@ TadPack ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::ve
 TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
   const int deviceId = 0;
 
-  std::lock_guard<std::mutex> lock(_mutex);
-  if (_cache[deviceId].count(descriptor) == 0) {
+  return _cache[deviceId]->getOrCreate(descriptor, [&]() -> TadPack {
     // if there's no TadPack matching this descriptor - create one
     const auto shapeInfo = descriptor.originalShape().toShapeInfo();
     const int rank = shape::rank(shapeInfo);
@@ -89,12 +85,10 @@ TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
     ConstantShapeBuffer shapeBuffer(sPtr);
     ConstantOffsetsBuffer offsetsBuffer(oPtr);
     TadPack t(shapeBuffer, offsetsBuffer, numOfSubArrs);
-    _cache[deviceId][descriptor] = t;
 
     delete[] shapeInfo;
-  }
-
-  return _cache[deviceId][descriptor];
+    return t;
+  });
 }
 }  // namespace sd
 
@@ -27,72 +27,21 @@
 #include <execution/Threads.h>
 #include <helpers/BlasHelper.h>
 #include <helpers/ShapeUtils.h>
+#include <ops/impl/gemm_blocked.hpp>
 
 namespace sd {
 
 //////////////////////////////////////////////////////////////////////////////
-// MXK x KxN = MxN              -> actual sequence of axes doesn't matter
+// MXK x KxN = MxN, arbitrary strides of A, B and C are handled by panel packing
 template <typename T1, typename T2, typename T3>
-static void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC, const int aMaxis, const int aKaxis,
-                      const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis, const double alpha,
-                      const double beta) {
-  const T1* A = vA->bufferAsT<T1>();
-  const T2* B = vB->bufferAsT<T2>();
-  T3* C = vC->bufferAsT<T3>();
-
-  const T3 alphaZ = alpha;
-  const T3 betaZ = beta;
-
-  const bool betaPersent = beta;
-
-  const sd::LongType* aShapeInfo = vA->shapeInfo();
-  const sd::LongType* bShapeInfo = vB->shapeInfo();
-  const sd::LongType* cShapeInfo = vC->shapeInfo();
-
-  const int aRank = vA->rankOf();
-  const int bRank = vB->rankOf();
-  const int cRank = vC->rankOf();
-
-  const sd::LongType cLen = vC->lengthOf();
-
-  const int K = vA->sizeAt(aKaxis);
-
-  auto func = PRAGMA_THREADS_FOR {
-    std::vector<sd::LongType> aCoords(2), bCoords(2), cCoords(2);
-
-    for (auto i = start; i < stop; ++i) {
-      // evaluate C coordinates
-      shape::index2coordsCPU(start, i, cShapeInfo, cCoords.data());
-
-      // evaluate A coordinates
-      aCoords[aMaxis] = cCoords[cMaxis];
-      aCoords[aKaxis] = 0;
-
-      // evaluate B coordinates
-      bCoords[bKaxis] = 0;
-      bCoords[bNaxis] = cCoords[cNaxis];
-
-      auto aOffset = shape::getOffset(aShapeInfo, aCoords.data());
-      auto bOffset = shape::getOffset(bShapeInfo, bCoords.data());
-
-      T3 val = A[aOffset] * B[bOffset];  // first iteration
-
-      for (int j = 1; j < K; ++j) {  // rest iterations
-        aOffset += shape::stride(aShapeInfo)[aKaxis];
-        bOffset += shape::stride(bShapeInfo)[bKaxis];
-        val = val + A[aOffset] * B[bOffset];
-      }
-
-      auto cOffset = shape::getOffset(cShapeInfo, cCoords.data());
-
-      if (betaPersent)
-        C[cOffset] = alphaZ * val + betaZ * C[cOffset];
-      else
-        C[cOffset] = alphaZ * val;
-    }
-  };
-
-  samediff::Threads::parallel_tad(func, 0, cLen);
+static void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC, const double alpha, const double beta) {
+  const sd::LongType M = vA->sizeAt(0);
+  const sd::LongType K = vA->sizeAt(1);
+  const sd::LongType N = vB->sizeAt(1);
+
+  blas::BlockedGEMM<T1, T2, T3>::op(M, N, K, alpha, vA->bufferAsT<T1>(), vA->strideAt(0), vA->strideAt(1),
+                                    vB->bufferAsT<T2>(), vB->strideAt(0), vB->strideAt(1), beta, vC->bufferAsT<T3>(),
+                                    vC->strideAt(0), vC->strideAt(1));
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -209,7 +158,7 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
   const bool typeFloat = hasGemm && ABC && aType == DataType::FLOAT32;
 
   if (!typeFloat && !typeDouble) {
-    BUILD_SINGLE_SELECTOR_THRICE(aType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), SD_NUMERIC_TYPES);
+    BUILD_SINGLE_SELECTOR_THRICE(aType, usualGemm, (A, B, C, alpha, beta), SD_NUMERIC_TYPES);
     // BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), SD_COMMON_TYPES,
     // SD_FLOAT_TYPES, SD_FLOAT_TYPES);
   } else {
@@ -36,10 +36,7 @@ ConstantShapeHelper::ConstantShapeHelper() {
   auto numDevices = AffinityManager::numberOfDevices();
 
   _cache.resize(numDevices);
-  for (int e = 0; e < numDevices; e++) {
-    SD_MAP_IMPL<ShapeDescriptor, ConstantShapeBuffer *> cache;
-    _cache[e] = cache;
-  }
+  for (int e = 0; e < numDevices; e++) _cache[e] = new ConstantCache<ShapeDescriptor, ConstantShapeBuffer *>();
 }
 
 ConstantShapeHelper& ConstantShapeHelper::getInstance() {
@@ -66,21 +63,15 @@ ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::DataType
 ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(ShapeDescriptor *descriptor) {
   int deviceId = AffinityManager::currentDeviceId();
 
-  std::lock_guard<std::mutex> lock(_mutex);
-
-  if (_cache[deviceId].count(*descriptor) == 0) {
+  return _cache[deviceId]->getOrCreate(*descriptor, [&]() -> ConstantShapeBuffer * {
     auto hPtr =
         std::make_shared<PointerWrapper>(descriptor->toShapeInfo(), std::make_shared<PrimaryPointerDeallocator>());
     auto dPtr = std::make_shared<PointerWrapper>(
         ConstantHelper::getInstance().replicatePointer(hPtr->pointer(),
                                                        shape::shapeInfoByteLength(hPtr->pointerAsT<sd::LongType>())),
         std::make_shared<CudaPointerDeallocator>());
-    ConstantShapeBuffer *buffer = new ConstantShapeBuffer(hPtr, dPtr);
-    _cache[deviceId][*descriptor] = buffer;
-    return _cache[deviceId][*descriptor];
-  } else {
-    return _cache[deviceId].at(*descriptor);
-  }
+    return new ConstantShapeBuffer(hPtr, dPtr);
+  });
 }
 
 ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::LongType* shapeInfo) {
@@ -92,9 +83,8 @@ ConstantShapeBuffer* ConstantShapeHelper::bufferForShapeInfo(const sd::LongType*
 
 bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor *descriptor) {
   auto deviceId = AffinityManager::currentDeviceId();
-  std::lock_guard<std::mutex> lock(_mutex);
 
-  return _cache[deviceId].count(*descriptor) != 0;
+  return _cache[deviceId]->contains(*descriptor);
 }
 
 const sd::LongType * ConstantShapeHelper::createShapeInfo(const sd::DataType dataType, const char order, const int rank,
@@ -34,10 +34,7 @@ namespace sd {
 ConstantTadHelper::ConstantTadHelper() {
   auto numDevices = AffinityManager::numberOfDevices();
 
-  for (int e = 0; e < numDevices; e++) {
-    SD_MAP_IMPL<TadDescriptor, TadPack> pack;
-    _cache.emplace_back(pack);
-  }
+  for (int e = 0; e < numDevices; e++) _cache.emplace_back(new ConstantCache<TadDescriptor, TadPack>());
 }
 
 ConstantTadHelper &ConstantTadHelper::getInstance() {
@@ -70,9 +67,7 @@ TadPack ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::ve
 TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
   const int deviceId = AffinityManager::currentDeviceId();
 
-  std::lock_guard<std::mutex> lock(_mutex);
-
-  if (_cache[deviceId].count(descriptor) == 0) {
+  return _cache[deviceId]->getOrCreate(descriptor, [&]() -> TadPack {
     const auto shapeInfo = descriptor.originalShape().toShapeInfo();
     const int rank = shape::rank(shapeInfo);
     const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
@@ -106,17 +101,10 @@ TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         oPtr, std::make_shared<PointerWrapper>(soPtr, std::make_shared<CudaPointerDeallocator>()));
 
     TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-    _cache[deviceId][descriptor] = t;
-
-    TadPack r = _cache[deviceId][descriptor];
 
     delete[] shapeInfo;
 
-    return r;
-  } else {
-    TadPack r = _cache[deviceId][descriptor];
-
-    return r;
-  }
+    return t;
+  });
 }
 }  // namespace sd
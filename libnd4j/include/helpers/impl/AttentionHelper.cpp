@@ -26,8 +26,11 @@
 #define LIBND4J_ATTENTIONHELPER_CPP
 #include "../AttentionHelper.h"
 
+#include <execution/Threads.h>
 #include <helpers/AttentionHelper.h>
 #include <ops/declarable/CustomOperations.h>
+
+#include <numeric>
 #if NOT_EXCLUDED(OP_multi_head_dot_product_attention)
 
 namespace sd {
@@ -88,4 +91,358 @@ void AttentionHelper::multiHeadProjectBp(const sd::NDArray *input, const sd::NDA
 }  // namespace sd
 #endif
 
+#if NOT_EXCLUDED(OP_dot_product_attention)
+namespace sd {
+
+// queries of one block share every key/value block while it's still in cache
+static const sd::LongType ATTENTION_QUERY_BLOCK = 32;
+static const sd::LongType ATTENTION_KEY_BLOCK = 128;
+
+// [..., features, time] -> c-ordered [..., time, features] copy, so every time step is contiguous row
+static NDArray attentionTimeMajor(const NDArray *array) {
+  std::vector<sd::LongType> permutation(array->rankOf());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::swap(permutation[array->rankOf() - 1], permutation[array->rankOf() - 2]);
+
+  return array->permute(permutation).dup('c');
+}
+
+static void attentionFeaturesMajor(const NDArray &timeMajor, NDArray *target) {
+  std::vector<sd::LongType> permutation(target->rankOf());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::swap(permutation[target->rankOf() - 1], permutation[target->rankOf() - 2]);
+
+  target->permute(permutation).assign(timeMajor);
+}
+
+// additive mask bias per [batch, key], same (mask - 1) * 1e9 the materializing path uses
+template <typename T>
+static std::vector<T> attentionBias(const NDArray *mask) {
+  std::vector<T> bias;
+  if (mask == nullptr) return bias;
+
+  bias.resize(mask->lengthOf());
+  for (sd::LongType e = 0; e < mask->lengthOf(); e++) bias[e] = static_cast<T>((mask->e<double>(e) - 1.) * 1e9);
+
+  return bias;
+}
+
+// out[i * ldOut + j] = sum_c a[i * length + c] * b[j * length + c]
+template <typename T>
+static void attentionDots(const T *a, sd::LongType na, const T *b, sd::LongType nb, sd::LongType length, T *out,
+                          sd::LongType ldOut) {
+  for (sd::LongType i = 0; i < na; i++) {
+    auto ai = a + i * length;
+    for (sd::LongType j = 0; j < nb; j++) {
+      auto bj = b + j * length;
+      T sum = static_cast<T>(0);
+      PRAGMA_OMP_SIMD_SUM(sum)
+      for (sd::LongType c = 0; c < length; c++) sum += ai[c] * bj[c];
+
+      out[i * ldOut + j] = sum;
+    }
+  }
+}
+
+// scores of [nq, nk] block: scaled dot products plus mask bias of the keys
+template <typename T>
+static void attentionScores(const T *q, sd::LongType nq, const T *k, sd::LongType nk, sd::LongType d, T scale,
+                            const T *bias, T *scores, sd::LongType ldScores) {
+  attentionDots<T>(q, nq, k, nk, d, scores, ldScores);
+
+  for (sd::LongType i = 0; i < nq; i++) {
+    auto si = scores + i * ldScores;
+    if (bias != nullptr) {
+      PRAGMA_OMP_SIMD
+      for (sd::LongType j = 0; j < nk; j++) si[j] = si[j] * scale + bias[j];
+    } else {
+      PRAGMA_OMP_SIMD
+      for (sd::LongType j = 0; j < nk; j++) si[j] *= scale;
+    }
+  }
+}
+
+// time major arrays: q [slices, Tq, d], k [slices, Tk, d], v [slices, Tk, dv], out [slices, Tq, dv].
+// logSumExp of every query row is stored if requested, backward pass recomputes softmax weights from it
+template <typename T>
+static void attentionForward(const NDArray &q, const NDArray &k, const NDArray &v, const std::vector<T> &bias,
+                             sd::LongType numHeads, T scale, NDArray &out, T *logSumExp) {
+  const sd::LongType Tq = q.sizeAt(-2), d = q.sizeAt(-1), Tk = k.sizeAt(-2), dv = v.sizeAt(-1);
+  const sd::LongType slices = q.lengthOf() / (Tq * d);
+  const sd::LongType queryBlocks = (Tq + ATTENTION_QUERY_BLOCK - 1) / ATTENTION_QUERY_BLOCK;
+
+  auto qBuffer = q.bufferAsT<T>();
+  auto kBuffer = k.bufferAsT<T>();
+  auto vBuffer = v.bufferAsT<T>();
+  auto oBuffer = out.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<T> scores(ATTENTION_QUERY_BLOCK * ATTENTION_KEY_BLOCK), acc(ATTENTION_QUERY_BLOCK * dv);
+    std::vector<T> rowMax(ATTENTION_QUERY_BLOCK), rowSum(ATTENTION_QUERY_BLOCK);
+
+    for (auto job = start; job < stop; job++) {
+      const auto slice = job / queryBlocks;
+      const auto q0 = (job % queryBlocks) * ATTENTION_QUERY_BLOCK;
+      const auto nq = sd::math::sd_min<sd::LongType>(ATTENTION_QUERY_BLOCK, Tq - q0);
+
+      auto qs = qBuffer + (slice * Tq + q0) * d;
+      auto ks = kBuffer + slice * Tk * d;
+      auto vs = vBuffer + slice * Tk * dv;
+      auto bs = bias.empty() ? nullptr : bias.data() + (slice / numHeads) * Tk;
+
+      std::fill(acc.begin(), acc.begin() + nq * dv, static_cast<T>(0));
+
+      for (sd::LongType k0 = 0; k0 < Tk; k0 += ATTENTION_KEY_BLOCK) {
+        const auto nk = sd::math::sd_min<sd::LongType>(ATTENTION_KEY_BLOCK, Tk - k0);
+        attentionScores<T>(qs, nq, ks + k0 * d, nk, d, scale, bs == nullptr ? nullptr : bs + k0, scores.data(),
+                           ATTENTION_KEY_BLOCK);
+
+        for (sd::LongType i = 0; i < nq; i++) {
+          auto si = scores.data() + i * ATTENTION_KEY_BLOCK;
+          auto ai = acc.data() + i * dv;
+
+          T blockMax = si[0];
+          for (sd::LongType j = 1; j < nk; j++) blockMax = sd::math::sd_max<T>(blockMax, si[j]);
+
+          // running max can only grow, accumulated sum and output are rescaled to the new one
+          const bool first = k0 == 0;
+          const T newMax = first ? blockMax : sd::math::sd_max<T>(rowMax[i], blockMax);
+          const T correction = first ? static_cast<T>(0) : sd::math::sd_exp<T, T>(rowMax[i] - newMax);
+
+          T sum = static_cast<T>(0);
+          for (sd::LongType j = 0; j < nk; j++) {
+            si[j] = sd::math::sd_exp<T, T>(si[j] - newMax);
+            sum += si[j];
+          }
+
+          rowSum[i] = first ? sum : rowSum[i] * correction + sum;
+          rowMax[i] = newMax;
+
+          if (!first) {
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < dv; c++) ai[c] *= correction;
+          }
+
+          for (sd::LongType j = 0; j < nk; j++) {
+            const T p = si[j];
+            auto vj = vs + (k0 + j) * dv;
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < dv; c++) ai[c] += p * vj[c];
+          }
+        }
+      }
+
+      for (sd::LongType i = 0; i < nq; i++) {
+        auto oi = oBuffer + (slice * Tq + q0 + i) * dv;
+        auto ai = acc.data() + i * dv;
+        const T inverse = static_cast<T>(1) / rowSum[i];
+
+        PRAGMA_OMP_SIMD
+        for (sd::LongType c = 0; c < dv; c++) oi[c] = ai[c] * inverse;
+
+        if (logSumExp != nullptr)
+          logSumExp[slice * Tq + q0 + i] = rowMax[i] + sd::math::sd_log<T, T>(rowSum[i]);
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, slices * queryBlocks);
+}
+
+template <typename T>
+static void dotProductAttention_(const NDArray *queries, const NDArray *keys, const NDArray *values,
+                                 const NDArray *mask, bool normalization, NDArray *output) {
+  const auto numHeads = queries->rankOf() == 4 ? queries->sizeAt(1) : 1;
+  const T scale = static_cast<T>(normalization ? 1. / sqrt(static_cast<double>(queries->sizeAt(-2))) : 1.);
+
+  auto q = attentionTimeMajor(queries);
+  auto k = attentionTimeMajor(keys);
+  auto v = attentionTimeMajor(values);
+  auto bias = attentionBias<T>(mask);
+
+  auto outShape = output->getShapeAsVector();
+  std::swap(outShape[outShape.size() - 1], outShape[outShape.size() - 2]);
+  NDArray out('c', outShape, output->dataType(), output->getContext());
+
+  attentionForward<T>(q, k, v, bias, numHeads, scale, out, nullptr);
+
+  attentionFeaturesMajor(out, output);
+}
+
+template <typename T>
+static void dotProductAttentionBp_(const NDArray *queries, const NDArray *keys, const NDArray *values,
+                                   const NDArray *eps, const NDArray *mask, bool normalization, NDArray *dLdq,
+                                   NDArray *dLdk, NDArray *dLdv) {
+  const auto numHeads = queries->rankOf() == 4 ? queries->sizeAt(1) : 1;
+  const T scale = static_cast<T>(normalization ? 1. / sqrt(static_cast<double>(queries->sizeAt(-2))) : 1.);
+
+  auto q = attentionTimeMajor(queries);
+  auto k = attentionTimeMajor(keys);
+  auto v = attentionTimeMajor(values);
+  auto dO = attentionTimeMajor(eps);
+  auto bias = attentionBias<T>(mask);
+
+  const sd::LongType Tq = q.sizeAt(-2), d = q.sizeAt(-1), Tk = k.sizeAt(-2), dv = v.sizeAt(-1);
+  const sd::LongType slices = q.lengthOf() / (Tq * d);
+
+  // forward pass again, but keeping logsumexp per query instead of weights
+  NDArray out = dO.ulike();
+  std::vector<T> logSumExp(slices * Tq);
+  attentionForward<T>(q, k, v, bias, numHeads, scale, out, logSumExp.data());
+
+  auto qBuffer = q.bufferAsT<T>();
+  auto kBuffer = k.bufferAsT<T>();
+  auto vBuffer = v.bufferAsT<T>();
+  auto oBuffer = out.bufferAsT<T>();
+  auto dOBuffer = dO.bufferAsT<T>();
+
+  // softmax bp term: delta[q] = sum_k P[q, k] * dP[q, k] = dO[q] . O[q]
+  std::vector<T> delta(slices * Tq);
+  auto funcDelta = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      auto oi = oBuffer + r * dv;
+      auto gi = dOBuffer + r * dv;
+      T sum = static_cast<T>(0);
+      PRAGMA_OMP_SIMD_SUM(sum)
+      for (sd::LongType c = 0; c < dv; c++) sum += oi[c] * gi[c];
+      delta[r] = sum;
+    }
+  };
+  samediff::Threads::parallel_for(funcDelta, 0, slices * Tq);
+
+  NDArray dQ = q.ulike();
+  NDArray dK = k.ulike();
+  NDArray dV = v.ulike();
+  auto dQBuffer = dQ.bufferAsT<T>();
+  auto dKBuffer = dK.bufferAsT<T>();
+  auto dVBuffer = dV.bufferAsT<T>();
+
+  // recomputes P and scaled dL/dS for [nq, nk] block, both stored with ldScores row stride
+  auto gradients = [&](sd::LongType slice, sd::LongType q0, sd::LongType nq, sd::LongType k0, sd::LongType nk, T *p,
+                       T *dS, sd::LongType ldScores) {
+    auto bs = bias.empty() ? nullptr : bias.data() + (slice / numHeads) * Tk + k0;
+    attentionScores<T>(qBuffer + (slice * Tq + q0) * d, nq, kBuffer + (slice * Tk + k0) * d, nk, d, scale, bs, p,
+                       ldScores);
+    attentionDots<T>(dOBuffer + (slice * Tq + q0) * dv, nq, vBuffer + (slice * Tk + k0) * dv, nk, dv, dS, ldScores);
+
+    for (sd::LongType i = 0; i < nq; i++) {
+      const T lse = logSumExp[slice * Tq + q0 + i];
+      const T di = delta[slice * Tq + q0 + i];
+      auto pi = p + i * ldScores;
+      auto gi = dS + i * ldScores;
+      for (sd::LongType j = 0; j < nk; j++) {
+        pi[j] = sd::math::sd_exp<T, T>(pi[j] - lse);
+        gi[j] = pi[j] * (gi[j] - di) * scale;
+      }
+    }
+  };
+
+  // dL/dQ: every query block walks over all key blocks
+  const sd::LongType queryBlocks = (Tq + ATTENTION_QUERY_BLOCK - 1) / ATTENTION_QUERY_BLOCK;
+  auto funcQ = PRAGMA_THREADS_FOR {
+    std::vector<T> p(ATTENTION_QUERY_BLOCK * ATTENTION_KEY_BLOCK), dS(ATTENTION_QUERY_BLOCK * ATTENTION_KEY_BLOCK);
+
+    for (auto job = start; job < stop; job++) {
+      const auto slice = job / queryBlocks;
+      const auto q0 = (job % queryBlocks) * ATTENTION_QUERY_BLOCK;
+      const auto nq = sd::math::sd_min<sd::LongType>(ATTENTION_QUERY_BLOCK, Tq - q0);
+
+      auto dq = dQBuffer + (slice * Tq + q0) * d;
+      std::fill(dq, dq + nq * d, static_cast<T>(0));
+
+      for (sd::LongType k0 = 0; k0 < Tk; k0 += ATTENTION_KEY_BLOCK) {
+        const auto nk = sd::math::sd_min<sd::LongType>(ATTENTION_KEY_BLOCK, Tk - k0);
+        gradients(slice, q0, nq, k0, nk, p.data(), dS.data(), ATTENTION_KEY_BLOCK);
+
+        for (sd::LongType i = 0; i < nq; i++) {
+          auto dqi = dq + i * d;
+          auto gi = dS.data() + i * ATTENTION_KEY_BLOCK;
+          for (sd::LongType j = 0; j < nk; j++) {
+            const T g = gi[j];
+            auto kj = kBuffer + (slice * Tk + k0 + j) * d;
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < d; c++) dqi[c] += g * kj[c];
+          }
+        }
+      }
+    }
+  };
+  samediff::Threads::parallel_for(funcQ, 0, slices * queryBlocks);
+
+  // dL/dK and dL/dV: every key block walks over all query blocks, so no two threads write the same rows
+  const sd::LongType keyBlocks = (Tk + ATTENTION_KEY_BLOCK - 1) / ATTENTION_KEY_BLOCK;
+  auto funcKV = PRAGMA_THREADS_FOR {
+    std::vector<T> p(ATTENTION_QUERY_BLOCK * ATTENTION_KEY_BLOCK), dS(ATTENTION_QUERY_BLOCK * ATTENTION_KEY_BLOCK);
+
+    for (auto job = start; job < stop; job++) {
+      const auto slice = job / keyBlocks;
+      const auto k0 = (job % keyBlocks) * ATTENTION_KEY_BLOCK;
+      const auto nk = sd::math::sd_min<sd::LongType>(ATTENTION_KEY_BLOCK, Tk - k0);
+
+      auto dk = dKBuffer + (slice * Tk + k0) * d;
+      auto dvs = dVBuffer + (slice * Tk + k0) * dv;
+      std::fill(dk, dk + nk * d, static_cast<T>(0));
+      std::fill(dvs, dvs + nk * dv, static_cast<T>(0));
+
+      for (sd::LongType q0 = 0; q0 < Tq; q0 += ATTENTION_QUERY_BLOCK) {
+        const auto nq = sd::math::sd_min<sd::LongType>(ATTENTION_QUERY_BLOCK, Tq - q0);
+        gradients(slice, q0, nq, k0, nk, p.data(), dS.data(), ATTENTION_KEY_BLOCK);
+
+        for (sd::LongType i = 0; i < nq; i++) {
+          auto qi = qBuffer + (slice * Tq + q0 + i) * d;
+          auto gOi = dOBuffer + (slice * Tq + q0 + i) * dv;
+          auto pi = p.data() + i * ATTENTION_KEY_BLOCK;
+          auto gi = dS.data() + i * ATTENTION_KEY_BLOCK;
+
+          for (sd::LongType j = 0; j < nk; j++) {
+            const T pij = pi[j];
+            const T gij = gi[j];
+            auto dkj = dk + j * d;
+            auto dvj = dvs + j * dv;
+
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < dv; c++) dvj[c] += pij * gOi[c];
+
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < d; c++) dkj[c] += gij * qi[c];
+          }
+        }
+      }
+    }
+  };
+  samediff::Threads::parallel_for(funcKV, 0, slices * keyBlocks);
+
+  attentionFeaturesMajor(dQ, dLdq);
+  attentionFeaturesMajor(dK, dLdk);
+  attentionFeaturesMajor(dV, dLdv);
+}
+
+bool AttentionHelper::isBlockedAttentionApplicable(const std::vector<const sd::NDArray *> &arrays) {
+  auto dtype = arrays[0]->dataType();
+  if (dtype != sd::DataType::FLOAT32 && dtype != sd::DataType::DOUBLE) return false;
+
+  for (auto array : arrays)
+    if (array != nullptr && (array->dataType() != dtype || array->isEmpty())) return false;
+
+  return true;
+}
+
+void AttentionHelper::dotProductAttention(const sd::NDArray *queries, const sd::NDArray *keys,
+                                          const sd::NDArray *values, const sd::NDArray *mask, bool normalization,
+                                          sd::NDArray *output) {
+  BUILD_SINGLE_SELECTOR(queries->dataType(), dotProductAttention_,
+                        (queries, keys, values, mask, normalization, output), SD_FLOAT_TYPES);
+}
+
+void AttentionHelper::dotProductAttentionBp(const sd::NDArray *queries, const sd::NDArray *keys,
+                                            const sd::NDArray *values, const sd::NDArray *eps,
+                                            const sd::NDArray *mask, bool normalization, sd::NDArray *dLdq,
+                                            sd::NDArray *dLdk, sd::NDArray *dLdv) {
+  BUILD_SINGLE_SELECTOR(queries->dataType(), dotProductAttentionBp_,
+                        (queries, keys, values, eps, mask, normalization, dLdq, dLdk, dLdv), SD_FLOAT_TYPES);
+}
+
+}  // namespace sd
+#endif
+
 #endif
@@ -0,0 +1,250 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Always-on per-op counters and latency histograms
+//
+#include <array/ArrayOptions.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/OpStatistics.h>
+#include <helpers/shape.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace sd {
+
+void OpStatistics::Record::add(int64_t nanos, int64_t numBytes, bool helper) {
+  calls++;
+  if (helper) helperCalls++;
+
+  bytes += numBytes;
+  totalNanos += nanos;
+  minNanos = std::min(minNanos, nanos);
+  maxNanos = std::max(maxNanos, nanos);
+  histogram[bucket(nanos)]++;
+}
+
+void OpStatistics::Record::merge(const Record &other) {
+  calls += other.calls;
+  helperCalls += other.helperCalls;
+  bytes += other.bytes;
+  totalNanos += other.totalNanos;
+  minNanos = std::min(minNanos, other.minNanos);
+  maxNanos = std::max(maxNanos, other.maxNanos);
+
+  for (int e = 0; e < NUM_BUCKETS; e++) histogram[e] += other.histogram[e];
+}
+
+int64_t OpStatistics::Record::percentile(double fraction) const {
+  if (calls == 0) return 0;
+
+  auto target = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(fraction * calls)));
+  int64_t cumulative = 0;
+  for (int e = 0; e < NUM_BUCKETS; e++) {
+    cumulative += histogram[e];
+    if (cumulative >= target) return std::min(bucketUpperBound(e), maxNanos);
+  }
+
+  return maxNanos;
+}
+
+OpStatistics::ThreadRecords::ThreadRecords() { OpStatistics::getInstance().attach(this); }
+
+OpStatistics::ThreadRecords::~ThreadRecords() { OpStatistics::getInstance().detach(this); }
+
+OpStatistics &OpStatistics::getInstance() {
+  static OpStatistics instance;
+  return instance;
+}
+
+OpStatistics::ThreadRecords &OpStatistics::threadRecords() {
+  static thread_local ThreadRecords records;
+  return records;
+}
+
+void OpStatistics::attach(ThreadRecords *records) {
+  std::lock_guard<std::mutex> lock(_lock);
+  _threads.emplace_back(records);
+}
+
+void OpStatistics::detach(ThreadRecords *records) {
+  std::lock_guard<std::mutex> lock(_lock);
+  std::lock_guard<std::mutex> local(records->lock);
+
+  for (auto &v : records->records) {
+    auto &r = _retired[v.second.name];
+    r.name = v.second.name;
+    r.merge(v.second);
+  }
+
+  _threads.erase(std::remove(_threads.begin(), _threads.end(), records), _threads.end());
+}
+
+int OpStatistics::bucket(int64_t nanos) {
+  if (nanos < SUB_BUCKETS) return nanos < 0 ? 0 : static_cast<int>(nanos);
+
+  // position of the highest bit, SUB_BUCKETS is 2^3 so the first 3 bits below it select linear bucket
+  int magnitude = 3;
+  while (magnitude < 62 && (nanos >> (magnitude + 1)) != 0) magnitude++;
+
+  auto result = (magnitude - 2) * SUB_BUCKETS + static_cast<int>((nanos >> (magnitude - 3)) - SUB_BUCKETS);
+  return std::min(result, NUM_BUCKETS - 1);
+}
+
+int64_t OpStatistics::bucketUpperBound(int bucket) {
+  if (bucket < SUB_BUCKETS) return bucket + 1;
+
+  const int magnitude = bucket / SUB_BUCKETS + 2;
+  const int64_t sub = bucket % SUB_BUCKETS;
+  return (SUB_BUCKETS + sub + 1) << (magnitude - 3);
+}
+
+int64_t OpStatistics::bytesOf(const sd::LongType *shapeInfo) {
+  if (shapeInfo == nullptr || shape::isEmpty(shapeInfo)) return 0;
+
+  return shape::length(shapeInfo) * DataTypeUtils::sizeOfElement(ArrayOptions::dataType(shapeInfo));
+}
+
+uint64_t OpStatistics::legacyKey(const char *category, int opNum) {
+  // FNV-1a over category name, op number mixed in afterwards
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto c = category; *c != 0; c++) {
+    hash ^= static_cast<uint8_t>(*c);
+    hash *= 1099511628211ULL;
+  }
+
+  return hash ^ (static_cast<uint64_t>(opNum) * 0x9E3779B97F4A7C15ULL);
+}
+
+void OpStatistics::record(uint64_t key, const char *name, int opNum, int64_t nanos, int64_t bytes, bool helper) {
+  auto &local = threadRecords();
+  std::lock_guard<std::mutex> lock(local.lock);
+
+  auto it = local.records.find(key);
+  if (it == local.records.end()) {
+    it = local.records.emplace(key, Record()).first;
+    it->second.name = opNum < 0 ? std::string(name) : std::string(name) + ":" + std::to_string(opNum);
+  }
+
+  it->second.add(nanos, bytes, helper);
+}
+
+std::map<std::string, OpStatistics::Record> OpStatistics::snapshot() {
+  std::lock_guard<std::mutex> lock(_lock);
+
+  auto result = _retired;
+  for (auto t : _threads) {
+    std::lock_guard<std::mutex> local(t->lock);
+    for (auto &v : t->records) {
+      auto &r = result[v.second.name];
+      r.name = v.second.name;
+      r.merge(v.second);
+    }
+  }
+
+  return result;
+}
+
+static void appendJsonString(std::ostringstream &stream, const std::string &value) {
+  stream << '"';
+  for (auto c : value) {
+    if (c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      stream << ' ';
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+const char *OpStatistics::exportJson() {
+  auto records = snapshot();
+
+  std::ostringstream stream;
+  stream << "{\"ops\":[";
+
+  bool first = true;
+  for (auto &v : records) {
+    auto &r = v.second;
+    if (r.calls == 0) continue;
+
+    if (!first) stream << ",";
+    first = false;
+
+    stream << "{\"name\":";
+    appendJsonString(stream, v.first);
+    stream << ",\"calls\":" << r.calls << ",\"helperCalls\":" << r.helperCalls << ",\"bytes\":" << r.bytes
+           << ",\"totalNs\":" << r.totalNanos << ",\"minNs\":" << r.minNanos << ",\"maxNs\":" << r.maxNanos
+           << ",\"meanNs\":" << r.totalNanos / r.calls << ",\"p50Ns\":" << r.percentile(0.5)
+           << ",\"p90Ns\":" << r.percentile(0.9) << ",\"p99Ns\":" << r.percentile(0.99)
+           << ",\"p999Ns\":" << r.percentile(0.999) << ",\"histogram\":[";
+
+    // only non-empty buckets, as [upper bound in ns, count] pairs
+    bool firstBucket = true;
+    for (int e = 0; e < NUM_BUCKETS; e++) {
+      if (r.histogram[e] == 0) continue;
+
+      if (!firstBucket) stream << ",";
+      firstBucket = false;
+
+      stream << "[" << bucketUpperBound(e) << "," << r.histogram[e] << "]";
+    }
+
+    stream << "]}";
+  }
+
+  stream << "]}";
+
+  std::lock_guard<std::mutex> lock(_lock);
+  _export = stream.str();
+  return _export.c_str();
+}
+
+void OpStatistics::reset() {
+  std::lock_guard<std::mutex> lock(_lock);
+  _retired.clear();
+
+  for (auto t : _threads) {
+    std::lock_guard<std::mutex> local(t->lock);
+    t->records.clear();
+  }
+}
+
+OpStatisticsScope::OpStatisticsScope(const char *category, int opNum, const sd::LongType *xShapeInfo,
+                                     const sd::LongType *yShapeInfo, const sd::LongType *zShapeInfo)
+    : _category(category), _opNum(opNum), _bytes(0), _enabled(Environment::getInstance().isOpStatistics()) {
+  if (!_enabled) return;
+
+  _bytes = OpStatistics::bytesOf(xShapeInfo) + OpStatistics::bytesOf(yShapeInfo) + OpStatistics::bytesOf(zShapeInfo);
+  _start = std::chrono::steady_clock::now();
+}
+
+OpStatisticsScope::~OpStatisticsScope() {
+  if (!_enabled) return;
+
+  auto nanos =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+  OpStatistics::getInstance().record(OpStatistics::legacyKey(_category, _opNum), _category, _opNum, nanos, _bytes,
+                                     false);
+}
+
+}  // namespace sd
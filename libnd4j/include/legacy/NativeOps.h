@@ -630,6 +630,14 @@ SD_LIB_EXPORT int getDeviceMajor(int deviceId);
  */
 SD_LIB_EXPORT sd::LongType getCachedMemory(int deviceId);
 
+/**
+ * This method returns value of the counter of constant caches
+ * @param cacheType 0 for shapes cache, 1 for TADs cache
+ * @param counter 0 - thread-local hits, 1 - shared hits, 2 - misses, 3 - contended inserts, 4 - cached entries
+ * @return
+ */
+SD_LIB_EXPORT sd::LongType getConstantCacheCounter(int cacheType, int counter);
+
 /**
  *
  * @param ptrToDeviceId
@@ -1425,6 +1433,14 @@ SD_LIB_EXPORT const char* getAllCustomOps();
 
 SD_LIB_EXPORT const char* getAllOperations();
 
+/**
+ * This method returns per-op call counts, latency percentiles and histograms, bytes touched and platform helper hits,
+ * collected since start or last reset, as JSON document. Returned pointer stays valid until next call
+ */
+SD_LIB_EXPORT const char* getOpStatistics();
+
+SD_LIB_EXPORT void resetOpStatistics();
+
 // customOp executioner
 SD_LIB_EXPORT sd::Status execCustomOp(sd::Pointer* extraPointers, sd::LongType hash, sd::Pointer* inputBuffers,
                                       sd::Pointer* inputShapes, int numInputs, sd::Pointer* outputBuffers,
@@ -1456,6 +1472,12 @@ SD_LIB_EXPORT void deleteShapeList(sd::Pointer shapeList);
 
 SD_LIB_EXPORT sd::Status registerGraph(sd::Pointer* extraPointers, sd::LongType graphId, sd::Pointer flatBufferPointer);
 
+/**
+ * This method registers graph stored in FlatBuffers file, without reading the file into memory: file is mapped,
+ * and aligned weights in native byte order are used straight from the mapping
+ */
+SD_LIB_EXPORT sd::Status registerGraphFromFile(sd::Pointer* extraPointers, sd::LongType graphId, const char* fileName);
+
 typedef sd::graph::VariablesSet OpaqueVariablesSet;
 typedef sd::graph::Variable OpaqueVariable;
 
@@ -1463,6 +1485,30 @@ SD_LIB_EXPORT OpaqueVariablesSet* executeStoredGraph(sd::Pointer* extraPointers,
                                                      sd::Pointer* inputBuffers, sd::Pointer* inputShapes,
                                                      int* inputIndices, int numInputs);
 
+/**
+ * This method starts batching front-end for stored graph: requests passed to executeBatchedGraph() are coalesced
+ * along the first dimension, up to maxBatchSize rows or until the oldest one waited for maxLatencyMicros.
+ * padding: 0 - only equally shaped requests are batched together, 1 - ragged requests are padded with padValue
+ */
+SD_LIB_EXPORT sd::Status registerGraphBatcher(sd::Pointer* extraPointers, sd::LongType graphId, int* inputIndices,
+                                              int numInputs, int maxBatchSize, sd::LongType maxLatencyMicros,
+                                              int numWorkers, int padding, double padValue);
+
+SD_LIB_EXPORT sd::Status unregisterGraphBatcher(sd::Pointer* extraPointers, sd::LongType graphId);
+
+/**
+ * Same as executeStoredGraph, but request is executed as part of a batch if graph has batcher registered
+ */
+SD_LIB_EXPORT OpaqueVariablesSet* executeBatchedGraph(sd::Pointer* extraPointers, sd::LongType graphId,
+                                                      sd::Pointer* inputBuffers, sd::Pointer* inputShapes,
+                                                      int* inputIndices, int numInputs);
+
+/**
+ * Fills 8 values: requests, batches, failed requests, rows, padded elements, total queue time (us),
+ * current queue depth, max queue depth
+ */
+SD_LIB_EXPORT void getGraphBatcherStats(sd::Pointer* extraPointers, sd::LongType graphId, sd::LongType* stats);
+
 SD_LIB_EXPORT sd::LongType getVariablesSetSize(OpaqueVariablesSet* set);
 SD_LIB_EXPORT sd::Status getVariablesSetStatus(OpaqueVariablesSet* set);
 SD_LIB_EXPORT OpaqueVariable* getVariable(OpaqueVariablesSet* set, sd::LongType i);
@@ -1635,6 +1681,16 @@ SD_LIB_EXPORT int optimalLevel();
 SD_LIB_EXPORT bool isMinimalRequirementsMet();
 SD_LIB_EXPORT bool isOptimalRequirementsMet();
 
+/**
+ * ISA level used by runtime-dispatched CPU kernels (1 - generic, 2 - AVX2, 3 - AVX-512), 0 if dispatch isn't available
+ */
+SD_LIB_EXPORT int dispatchLevel();
+
+/**
+ * Caps ISA level of runtime-dispatched CPU kernels, 0 removes the cap
+ */
+SD_LIB_EXPORT void setMaxDispatchLevel(int level);
+
 SD_LIB_EXPORT void setVedaDeviceLibFolder(std::string path);
 
 }
@@ -28,6 +28,7 @@
 #include <graph/GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/OpStatistics.h>
 #include <helpers/helper_ptrmap.h>
 #include <helpers/logger.h>
 #include <legacy/NativeOpExecutioner.h>
@@ -65,11 +66,13 @@ bool experimentalSupport = false;
 #include <execution/Threads.h>
 #include <graph/Context.h>
 #include <graph/ResultWrapper.h>
+#include <helpers/ConstantShapeHelper.h>
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/TAD.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <ops/specials.h>
+#include <system/CpuDispatch.h>
 #include <system/Environment.h>
 
 #ifdef CPU_FEATURES
@@ -246,6 +249,7 @@ void execIndexReduceScalar(sd::Pointer *extraPointers, int opNum, OpaqueDataBuff
                            const sd::LongType *hXShapeInfo, const sd::LongType *dXShapeInfo, void *extraParams,
                            OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("index_reduce_scalar", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execIndexReduceScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                                extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo);
@@ -272,6 +276,7 @@ void execIndexReduce(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *db
                      const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension,
                      const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("index_reduce", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -311,6 +316,7 @@ void execBroadcast(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX,
                    const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension, const sd::LongType *hDimensionShape,
                    const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("broadcast", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -340,6 +346,7 @@ void execBroadcastBool(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *
                        const sd::LongType *dZShapeInfo, void *extraParams, OpaqueDataBuffer *dbDimension,
                        const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("broadcast_bool", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -433,6 +440,7 @@ void execPairwiseTransform(sd::Pointer *extraPointers, int opNum, OpaqueDataBuff
                            const sd::LongType *hYShapeInfo, const sd::LongType *dYShapeInfo, OpaqueDataBuffer *dbZ,
                            const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("pairwise_transform", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     NativeOpExecutioner::execPairwiseTransform(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                                dbY->primary(), hYShapeInfo, dbY->special(), dYShapeInfo, dbZ->primary(),
@@ -449,6 +457,7 @@ void execPairwiseTransformBool(sd::Pointer *extraPointers, int opNum, OpaqueData
                                const sd::LongType *hYShapeInfo, const sd::LongType *dYShapeInfo, OpaqueDataBuffer *dbZ,
                                const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("pairwise_transform_bool", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     NativeOpExecutioner::execPairwiseBoolTransform(
         nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo, dbY->primary(), hYShapeInfo,
@@ -473,6 +482,7 @@ void execReduceFloat(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *db
                      const sd::LongType *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
                      const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce_float", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execReduceFloatScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                                extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo);
@@ -487,6 +497,7 @@ void execReduceSame(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
                     const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce_same", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execReduceSameScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                               extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo);
@@ -501,6 +512,7 @@ void execReduceBool(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
                     const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce_bool", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execReduceBoolScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                               extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo);
@@ -515,6 +527,7 @@ void execReduceLong(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
                     const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce_long", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execReduceLongScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                               extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo);
@@ -539,6 +552,7 @@ void execReduceFloat2(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *d
                       const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension,
                       const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("reduce_float", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<int *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -574,6 +588,7 @@ void execReduceBool2(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *db
                      const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension,
                      const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("reduce_bool", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<int *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -609,6 +624,7 @@ void execReduceSame2(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *db
                      const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension,
                      const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("reduce_same", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<int *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -644,6 +660,7 @@ void execReduceLong2(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *db
                      const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbDimension,
                      const sd::LongType *hDimensionShape, const sd::LongType *dDimensionShape) {
   try {
+    sd::OpStatisticsScope statistics("reduce_long", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<int *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -690,6 +707,7 @@ void execReduce3(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX, c
                  const sd::LongType *hYShapeInfo, const sd::LongType *dYShapeInfo, OpaqueDataBuffer *dbZ,
                  const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce3", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     NativeOpExecutioner::execReduce3(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                      extraParams, dbY->primary(), hYShapeInfo, dbY->special(), dYShapeInfo,
@@ -715,6 +733,7 @@ void execReduce3Scalar(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *
                        const sd::LongType *hYShapeInfo, const sd::LongType *dYShapeInfo, OpaqueDataBuffer *dbZ,
                        const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo) {
   try {
+    sd::OpStatisticsScope statistics("reduce3_scalar", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     NativeOpExecutioner::execReduce3Scalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                            extraParams, dbY->primary(), hYShapeInfo, dbY->special(), dYShapeInfo,
@@ -746,6 +765,7 @@ void execReduce3Tad(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *tadOnlyShapeInfo, const sd::LongType *tadOffsets,
                     const sd::LongType *yTadOnlyShapeInfo, const sd::LongType *yTadOffsets) {
   try {
+    sd::OpStatisticsScope statistics("reduce3_tad", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -794,6 +814,7 @@ void execScalar(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX, co
                 const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbScalar, const sd::LongType *hScalarShapeInfo,
                 const sd::LongType *dScalarShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("scalar", opNum, hXShapeInfo, nullptr, hZShapeInfo);
 #if defined(HAVE_VEDA)
     auto helperIsUsed =
         execHelperScalar(opNum, dbX, hXShapeInfo, dbScalar, hScalarShapeInfo, dbZ, hZShapeInfo, extraParams);
@@ -818,6 +839,7 @@ void execScalarBool(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *dZShapeInfo, OpaqueDataBuffer *dbScalar, const sd::LongType *hScalarShapeInfo,
                     const sd::LongType *dScalarShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("scalar_bool", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execScalarBool(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                         dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, dbScalar->primary(),
@@ -841,6 +863,7 @@ void execSummaryStatsScalar(sd::Pointer *extraPointers, int opNum, OpaqueDataBuf
                             OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo,
                             bool biasCorrected) {
   try {
+    sd::OpStatisticsScope statistics("summary_stats_scalar", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execSummaryStatsScalar(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(),
                                                 dXShapeInfo, extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(),
@@ -864,6 +887,7 @@ void execSummaryStats(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *d
                       const sd::LongType *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
                       const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, bool biasCorrected) {
   try {
+    sd::OpStatisticsScope statistics("summary_stats", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execSummaryStats(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                           extraParams, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo,
@@ -892,6 +916,7 @@ void execSummaryStatsTad(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer
                          const sd::LongType *dDimensionShape, bool biasCorrected, const sd::LongType *tadShapeInfo,
                          const sd::LongType *tadOffsets) {
   try {
+    sd::OpStatisticsScope statistics("summary_stats_tad", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -920,6 +945,7 @@ void execTransformFloat(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer
                         const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo,
                         const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("transform_float", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execTransformFloat(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                             dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, extraParams,
@@ -935,6 +961,7 @@ void execTransformSame(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *
                        const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo,
                        const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("transform_same", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execTransformSame(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                            dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, extraParams,
@@ -950,6 +977,7 @@ void execTransformBool(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *
                        const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo,
                        const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("transform_bool", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execTransformBool(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                            dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, extraParams,
@@ -965,6 +993,7 @@ void execTransformAny(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *d
                       const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo,
                       const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("transform_any", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execTransformAny(nullptr, opNum, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                           dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, extraParams,
@@ -980,6 +1009,7 @@ void execTransformStrict(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer
                          const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ, const sd::LongType *hZShapeInfo,
                          const sd::LongType *dZShapeInfo, void *extraParams) {
   try {
+    sd::OpStatisticsScope statistics("transform_strict", opNum, hXShapeInfo, nullptr, hZShapeInfo);
 #if defined(HAVE_VEDA)
     auto helperIsUsed = execHelperTransformStrict(opNum, dbX, hXShapeInfo, dbZ, hZShapeInfo, extraParams);
     if (!helperIsUsed) {
@@ -1006,6 +1036,7 @@ void execReduce3All(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX
                     const sd::LongType *xTadShapeInfo, const sd::LongType *xOffsets, const sd::LongType *yTadShapeInfo,
                     const sd::LongType *yOffsets) {
   try {
+    sd::OpStatisticsScope statistics("reduce3_all", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     auto dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -1475,6 +1506,7 @@ void execScalarTad(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX,
                    sd::LongType const *tadShapeInfo, sd::LongType const *tadOffsets, sd::LongType const *tadShapeInfoZ,
                    sd::LongType const *tadOffsetsZ) {
   try {
+    sd::OpStatisticsScope statistics("scalar_tad", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -1500,6 +1532,7 @@ void execScalarBoolTad(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *
                        const sd::LongType *tadOffsets, const sd::LongType *tadShapeInfoZ,
                        const sd::LongType *tadOffsetsZ) {
   try {
+    sd::OpStatisticsScope statistics("scalar_bool_tad", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     auto dimension = reinterpret_cast<sd::LongType *>(dbDimension->primary());
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -1551,6 +1584,7 @@ void execAggregateBatch(sd::Pointer *extraPointers, int numAggregates, int opNum
 void execRandom(sd::Pointer *extraPointers, int opNum, sd::Pointer state, OpaqueDataBuffer *dbZ,
                 const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, void *extraArguments) {
   try {
+    sd::OpStatisticsScope statistics("random", opNum, nullptr, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {});
     NativeOpExecutioner::execRandom(nullptr, opNum, state, dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo,
                                     extraArguments);
@@ -1566,6 +1600,7 @@ void execRandom3(sd::Pointer *extraPointers, int opNum, sd::Pointer state, Opaqu
                  const sd::LongType *hYShapeInfo, const sd::LongType *dYShapeInfo, OpaqueDataBuffer *dbZ,
                  const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, void *extraArguments) {
   try {
+    sd::OpStatisticsScope statistics("random", opNum, hXShapeInfo, hYShapeInfo, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX, dbY});
     NativeOpExecutioner::execRandom(nullptr, opNum, state, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                     dbY->primary(), hYShapeInfo, dbY->special(), dYShapeInfo, dbZ->primary(),
@@ -1581,6 +1616,7 @@ void execRandom2(sd::Pointer *extraPointers, int opNum, sd::Pointer state, Opaqu
                  const sd::LongType *hXShapeInfo, const sd::LongType *dXShapeInfo, OpaqueDataBuffer *dbZ,
                  const sd::LongType *hZShapeInfo, const sd::LongType *dZShapeInfo, void *extraArguments) {
   try {
+    sd::OpStatisticsScope statistics("random", opNum, hXShapeInfo, nullptr, hZShapeInfo);
     OpaqueDataBuffer::preparePrimaryUse({dbZ}, {dbX});
     NativeOpExecutioner::execRandom(nullptr, opNum, state, dbX->primary(), hXShapeInfo, dbX->special(), dXShapeInfo,
                                     dbZ->primary(), hZShapeInfo, dbZ->special(), dZShapeInfo, extraArguments);
@@ -2154,55 +2190,173 @@ sd::Status registerGraph(sd::Pointer *extraPointers, sd::LongType graphId, sd::P
   }
 }
 
+sd::Status registerGraphFromFile(sd::Pointer *extraPointers, sd::LongType graphId, const char *fileName) {
+  try {
+    auto graph = sd::graph::GraphExecutioner::importFromMappedFile(fileName);
+
+    sd::graph::GraphHolder::getInstance().registerGraph(graphId, graph);
+
+    return sd::Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
 static VariablesSet *executeStoredGraphT(sd::Pointer *extraPointers, sd::LongType graphId, sd::Pointer *inputBuffers,
                                          sd::Pointer *inputShapes, int *inputIndices, int numInputs) {
-  auto graph = sd::graph::GraphHolder::getInstance().cloneGraph(graphId);
-  auto varSpace = graph->getVariableSpace();
+  auto &holder = sd::graph::GraphHolder::getInstance();
 
-  std::vector<sd::NDArray *> handles;
+  // session shares weights with the stored graph, so only inputs have to be bound here
+  holder.lockRead(graphId);
+  sd::graph::GraphSession *session = nullptr;
+  sd::graph::VariablesSet *varSet = nullptr;
 
-  for (int e = 0; e < numInputs; e++) {
-    auto idx = inputIndices[e];
-
-    // we'll delete this array later, together with cloned VariableSpace
-    auto array = new sd::NDArray(inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
-    handles.emplace_back(array);
+  try {
+    session = holder.checkoutSession(graphId);
 
-    if (varSpace->hasVariable(idx)) {
-      auto var = varSpace->getVariable(idx);
-      if (var->hasNDArray()) delete var->getNDArray();
+    for (int e = 0; e < numInputs; e++)
+      session->bindInput(inputIndices[e], inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
 
-      var->setNDArray(array);
-    } else
-      varSpace->putVariable(idx, array);
-  }
+    auto hZ = session->execute();
+    varSet = new sd::graph::VariablesSet(hZ);
 
-  auto hZ = sd::graph::GraphExecutioner::execute(graph, varSpace);
-  auto varSet = new sd::graph::VariablesSet(hZ);
+    if (hZ == sd::Status::OK) {
+      // pull back results, session arrays will be overwritten by the next request, so results are copied
+      auto graph = session->graph();
+      auto varSpace = session->variableSpace();
+      auto outputs = graph->fetchOutputs();
+      for (int e = 0; e < outputs->size(); e++) {
+        std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
 
-  if (hZ == sd::Status::OK) {
-    // pull back results, and provide them
-    auto outputs = graph->fetchOutputs();
-    for (int e = 0; e < outputs->size(); e++) {
-      // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
-      std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
+        auto var = varSpace->getVariable(varId);
 
-      auto var = varSpace->getVariable(varId);
+        varSet->push_back(var->clone());
+      }
 
-      varSet->push_back(var->clone());
+      delete outputs;
     }
-
-    delete outputs;
+  } catch (...) {
+    // session might be left in inconsistent state, so it isn't reused
+    holder.discardSession(graphId, session);
+    delete varSet;
+    holder.unlockRead(graphId);
+    throw;
   }
 
-  delete graph;
+  holder.releaseSession(graphId, session);
+  holder.unlockRead(graphId);
 
   return varSet;
 }
 
 sd::graph::VariablesSet *executeStoredGraph(sd::Pointer *extraPointers, sd::LongType graphId, sd::Pointer *inputBuffers,
                                             sd::Pointer *inputShapes, int *inputIndices, int numInputs) {
-  return nullptr;
+  try {
+    return executeStoredGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return nullptr;
+  }
+}
+
+static sd::graph::VariablesSet *executeBatchedGraphT(sd::Pointer *extraPointers, sd::LongType graphId,
+                                                     sd::Pointer *inputBuffers, sd::Pointer *inputShapes,
+                                                     int *inputIndices, int numInputs) {
+  auto batcher = sd::graph::GraphHolder::getInstance().batcher(graphId);
+
+  // graphs without batching front-end are executed right away
+  if (batcher == nullptr)
+    return executeStoredGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
+
+  // batcher expects inputs in the order it was registered with, wrappers don't own caller's buffers
+  auto &ids = batcher->inputIds();
+  std::vector<sd::NDArray> arrays;
+  arrays.reserve(ids.size());
+  for (auto id : ids) {
+    int e = 0;
+    while (e < numInputs && inputIndices[e] != id) e++;
+
+    if (e == numInputs) throw std::invalid_argument("executeBatchedGraph: request misses one of batched inputs");
+
+    arrays.emplace_back(inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
+  }
+
+  std::vector<const sd::NDArray *> inputs;
+  for (auto &array : arrays) inputs.emplace_back(&array);
+
+  auto result = batcher->submit(inputs).get();
+
+  auto varSet = new sd::graph::VariablesSet(result.status);
+  for (size_t e = 0; e < result.outputs.size(); e++)
+    varSet->push_back(new sd::graph::Variable(new sd::NDArray(std::move(result.outputs[e])), nullptr,
+                                              result.outputIds[e].first, result.outputIds[e].second));
+
+  return varSet;
+}
+
+sd::graph::VariablesSet *executeBatchedGraph(sd::Pointer *extraPointers, sd::LongType graphId,
+                                             sd::Pointer *inputBuffers, sd::Pointer *inputShapes, int *inputIndices,
+                                             int numInputs) {
+  try {
+    return executeBatchedGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return nullptr;
+  }
+}
+
+sd::Status registerGraphBatcher(sd::Pointer *extraPointers, sd::LongType graphId, int *inputIndices, int numInputs,
+                                int maxBatchSize, sd::LongType maxLatencyMicros, int numWorkers, int padding,
+                                double padValue) {
+  try {
+    sd::graph::BatcherOptions options;
+    options.maxBatchSize = maxBatchSize;
+    options.maxLatencyMicros = maxLatencyMicros;
+    options.numWorkers = numWorkers;
+    options.padding = static_cast<sd::graph::BatchPadding>(padding);
+    options.padValue = padValue;
+
+    std::vector<int> ids(inputIndices, inputIndices + numInputs);
+    sd::graph::GraphHolder::getInstance().enableBatching(graphId, ids, options);
+
+    return sd::Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+sd::Status unregisterGraphBatcher(sd::Pointer *extraPointers, sd::LongType graphId) {
+  try {
+    sd::graph::GraphHolder::getInstance().disableBatching(graphId);
+
+    return sd::Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+void getGraphBatcherStats(sd::Pointer *extraPointers, sd::LongType graphId, sd::LongType *stats) {
+  auto batcher = sd::graph::GraphHolder::getInstance().batcher(graphId);
+
+  sd::graph::BatcherStats snapshot;
+  if (batcher != nullptr) snapshot = batcher->stats();
+
+  stats[0] = snapshot.requests;
+  stats[1] = snapshot.batches;
+  stats[2] = snapshot.failed;
+  stats[3] = snapshot.rows;
+  stats[4] = snapshot.paddedElements;
+  stats[5] = snapshot.queueMicros;
+  stats[6] = snapshot.queueDepth;
+  stats[7] = snapshot.maxQueueDepth;
 }
 
 sd::LongType getVariablesSetSize(sd::graph::VariablesSet *set) { return set->size(); }
@@ -2253,6 +2407,10 @@ void deleteVariablesSet(sd::graph::VariablesSet *pointer) { delete pointer; }
 
 const char *getAllOperations() { return sd::OpTracker::getInstance().exportOperations(); }
 
+const char *getOpStatistics() { return sd::OpStatistics::getInstance().exportJson(); }
+
+void resetOpStatistics() { sd::OpStatistics::getInstance().reset(); }
+
 sd::Pointer getGraphState(sd::LongType id) { return (sd::Pointer) new sd::graph::GraphState(id); }
 
 void deleteGraphState(sd::Pointer state) {
@@ -2977,6 +3135,12 @@ void sortTadByValue(sd::Pointer *extraPointers, void *x, const sd::LongType *xSh
 
 sd::LongType getCachedMemory(int deviceId) { return sd::ConstantHelper::getInstance().getCachedAmount(deviceId); }
 
+sd::LongType getConstantCacheCounter(int cacheType, int counter) {
+  if (cacheType == 0) return sd::ConstantShapeHelper::getInstance().cacheCounter(counter);
+
+  return sd::ConstantTadHelper::getInstance().cacheCounter(counter);
+}
+
 sd::LaunchContext *defaultLaunchContext() { return LaunchContext::defaultContext(); }
 
 sd::Pointer lcScalarPointer(OpaqueLaunchContext *lc) { return nullptr; }
@@ -3064,13 +3228,18 @@ bool isOptimalRequirementsMet() {
 
   if (b == o)
     return true;
-  else
-    return false;
+
+  // generic binary still runs hot kernels with the best ISA available
+  return sd::CpuDispatch::isEnabled() && sd::CpuDispatch::detectedLevel() >= o;
 #else
   return true;
 #endif
 }
 
+int dispatchLevel() { return sd::CpuDispatch::isEnabled() ? sd::CpuDispatch::level() : 0; }
+
+void setMaxDispatchLevel(int level) { sd::Environment::getInstance().setMaxIsaLevel(level); }
+
 
 template <typename T>
 void _printHostBuffer(InteropDataBuffer *buffer) {
@@ -23,8 +23,11 @@
 #include <graph/GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/ConstantTadHelper.h>
 #include <helpers/CudaLaunchHelper.h>
 #include <helpers/DebugHelper.h>
+#include <helpers/OpStatistics.h>
 #include <helpers/PointersManager.h>
 #include <helpers/threshold.h>
 #include <legacy/NativeOpExecutioner.h>
@@ -2684,48 +2687,63 @@ Status registerGraph(sd::Pointer *extraPointers, sd::LongType graphId, sd::Point
   }
 }
 
+Status registerGraphFromFile(sd::Pointer *extraPointers, sd::LongType graphId, const char *fileName) {
+  try {
+    auto graph = sd::graph::GraphExecutioner::importFromMappedFile(fileName);
+
+    sd::graph::GraphHolder::getInstance().registerGraph(graphId, graph);
+
+    return Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return Status::BAD_INPUT;
+  }
+}
+
 static VariablesSet *executeStoredGraphT(sd::Pointer *extraPointers, sd::LongType graphId, sd::Pointer *inputBuffers,
                                          sd::Pointer *inputShapes, int *inputIndices, int numInputs) {
-  auto graph = sd::graph::GraphHolder::getInstance().pullGraph(graphId);
-  auto varSpace = graph->getVariableSpace()->clone();
+  auto &holder = sd::graph::GraphHolder::getInstance();
 
-  std::vector<sd::NDArray *> handles;
-
-  for (int e = 0; e < numInputs; e++) {
-    auto idx = inputIndices[e];
+  // session shares weights with the stored graph, so only inputs have to be bound here
+  holder.lockRead(graphId);
+  sd::graph::GraphSession *session = nullptr;
+  sd::graph::VariablesSet *varSet = nullptr;
 
-    // we'll delete this array later, together with cloned VariableSpace
-    auto array = new sd::NDArray(inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
-    handles.emplace_back(array);
+  try {
+    session = holder.checkoutSession(graphId);
 
-    if (varSpace->hasVariable(idx)) {
-      auto var = varSpace->getVariable(idx);
-      if (var->hasNDArray()) delete var->getNDArray();
+    for (int e = 0; e < numInputs; e++)
+      session->bindInput(inputIndices[e], inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
 
-      var->setNDArray(array);
-    } else
-      varSpace->putVariable(idx, array);
-  }
+    auto dZ = session->execute();
+    varSet = new sd::graph::VariablesSet(dZ);
 
-  auto dZ = sd::graph::GraphExecutioner::execute(graph, varSpace);
-  auto varSet = new sd::graph::VariablesSet(dZ);
+    if (dZ == Status::OK) {
+      // pull back results, session arrays will be overwritten by the next request, so results are copied
+      auto graph = session->graph();
+      auto varSpace = session->variableSpace();
+      auto outputs = graph->fetchOutputs();
+      for (int e = 0; e < outputs->size(); e++) {
+        std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
 
-  if (dZ == Status::OK) {
-    // pull back results, and provide them
-    auto outputs = graph->fetchOutputs();
-    for (int e = 0; e < outputs->size(); e++) {
-      // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
-      std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
+        auto var = varSpace->getVariable(varId);
 
-      auto var = varSpace->getVariable(varId);
+        varSet->push_back(var->clone());
+      }
 
-      varSet->push_back(var->clone());
+      delete outputs;
     }
-
-    delete outputs;
+  } catch (...) {
+    // session might be left in inconsistent state, so it isn't reused
+    holder.discardSession(graphId, session);
+    delete varSet;
+    holder.unlockRead(graphId);
+    throw;
   }
 
-  delete varSpace;
+  holder.releaseSession(graphId, session);
+  holder.unlockRead(graphId);
 
   return varSet;
 }
@@ -2741,6 +2759,101 @@ VariablesSet *executeStoredGraph(sd::Pointer *extraPointers, sd::LongType graphI
   }
 }
 
+static VariablesSet *executeBatchedGraphT(sd::Pointer *extraPointers, sd::LongType graphId, sd::Pointer *inputBuffers,
+                                          sd::Pointer *inputShapes, int *inputIndices, int numInputs) {
+  auto batcher = sd::graph::GraphHolder::getInstance().batcher(graphId);
+
+  // graphs without batching front-end are executed right away
+  if (batcher == nullptr)
+    return executeStoredGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
+
+  // batcher expects inputs in the order it was registered with, wrappers don't own caller's buffers
+  auto &ids = batcher->inputIds();
+  std::vector<sd::NDArray> arrays;
+  arrays.reserve(ids.size());
+  for (auto id : ids) {
+    int e = 0;
+    while (e < numInputs && inputIndices[e] != id) e++;
+
+    if (e == numInputs) throw std::invalid_argument("executeBatchedGraph: request misses one of batched inputs");
+
+    arrays.emplace_back(inputBuffers[e], reinterpret_cast<sd::LongType *>(inputShapes[e]));
+  }
+
+  std::vector<const sd::NDArray *> inputs;
+  for (auto &array : arrays) inputs.emplace_back(&array);
+
+  auto result = batcher->submit(inputs).get();
+
+  auto varSet = new sd::graph::VariablesSet(result.status);
+  for (size_t e = 0; e < result.outputs.size(); e++)
+    varSet->push_back(new sd::graph::Variable(new sd::NDArray(std::move(result.outputs[e])), nullptr,
+                                              result.outputIds[e].first, result.outputIds[e].second));
+
+  return varSet;
+}
+
+VariablesSet *executeBatchedGraph(sd::Pointer *extraPointers, sd::LongType graphId, sd::Pointer *inputBuffers,
+                                  sd::Pointer *inputShapes, int *inputIndices, int numInputs) {
+  try {
+    return executeBatchedGraphT(extraPointers, graphId, inputBuffers, inputShapes, inputIndices, numInputs);
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return nullptr;
+  }
+}
+
+sd::Status registerGraphBatcher(sd::Pointer *extraPointers, sd::LongType graphId, int *inputIndices, int numInputs,
+                                int maxBatchSize, sd::LongType maxLatencyMicros, int numWorkers, int padding,
+                                double padValue) {
+  try {
+    sd::graph::BatcherOptions options;
+    options.maxBatchSize = maxBatchSize;
+    options.maxLatencyMicros = maxLatencyMicros;
+    options.numWorkers = numWorkers;
+    options.padding = static_cast<sd::graph::BatchPadding>(padding);
+    options.padValue = padValue;
+
+    std::vector<int> ids(inputIndices, inputIndices + numInputs);
+    sd::graph::GraphHolder::getInstance().enableBatching(graphId, ids, options);
+
+    return sd::Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+sd::Status unregisterGraphBatcher(sd::Pointer *extraPointers, sd::LongType graphId) {
+  try {
+    sd::graph::GraphHolder::getInstance().disableBatching(graphId);
+
+    return sd::Status::OK;
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+void getGraphBatcherStats(sd::Pointer *extraPointers, sd::LongType graphId, sd::LongType *stats) {
+  auto batcher = sd::graph::GraphHolder::getInstance().batcher(graphId);
+
+  sd::graph::BatcherStats snapshot;
+  if (batcher != nullptr) snapshot = batcher->stats();
+
+  stats[0] = snapshot.requests;
+  stats[1] = snapshot.batches;
+  stats[2] = snapshot.failed;
+  stats[3] = snapshot.rows;
+  stats[4] = snapshot.paddedElements;
+  stats[5] = snapshot.queueMicros;
+  stats[6] = snapshot.queueDepth;
+  stats[7] = snapshot.maxQueueDepth;
+}
+
 sd::LongType getVariablesSetSize(sd::graph::VariablesSet *set) { return set->size(); }
 
 sd::Status getVariablesSetStatus(sd::graph::VariablesSet *set) { return set->status(); }
@@ -2800,6 +2913,10 @@ void deleteShapeList(sd::Pointer shapeList) {
 
 const char *getAllOperations() { return sd::OpTracker::getInstance().exportOperations(); }
 
+const char *getOpStatistics() { return sd::OpStatistics::getInstance().exportJson(); }
+
+void resetOpStatistics() { sd::OpStatistics::getInstance().reset(); }
+
 sd::Pointer getGraphState(sd::LongType id) { return (sd::Pointer) new sd::graph::GraphState(id); }
 
 void deleteGraphState(sd::Pointer state) {
@@ -3450,6 +3567,12 @@ sd::Pointer shapeBufferForNumpy(sd::Pointer npyArray) {
 
 sd::LongType getCachedMemory(int deviceId) { return sd::ConstantHelper::getInstance().getCachedAmount(deviceId); }
 
+sd::LongType getConstantCacheCounter(int cacheType, int counter) {
+  if (cacheType == 0) return sd::ConstantShapeHelper::getInstance().cacheCounter(counter);
+
+  return sd::ConstantTadHelper::getInstance().cacheCounter(counter);
+}
+
 sd::LaunchContext *defaultLaunchContext() { return LaunchContext::defaultContext(); }
 
 sd::Pointer lcScalarPointer(OpaqueLaunchContext *lc) { return lc->getScalarPointer(); }
@@ -3484,6 +3607,10 @@ bool isMinimalRequirementsMet() { return true; }
 
 bool isOptimalRequirementsMet() { return true; }
 
+int dispatchLevel() { return 0; }
+
+void setMaxDispatchLevel(int level) {}
+
 void ctxAllowHelpers(OpaqueContext *ptr, bool reallyAllow) { ptr->allowHelpers(reallyAllow); }
 
 void ctxSetExecutionMode(OpaqueContext *ptr, int execMode) {
@@ -0,0 +1,69 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Runtime selection of ISA-specific variants of hot CPU kernels
+//
+#include <system/CpuDispatch.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+
+#ifdef SD_ISA_DISPATCH
+#include <cpuinfo_x86.h>
+#endif
+
+namespace sd {
+
+static int detectIsaLevel() {
+#ifdef SD_ISA_DISPATCH
+  auto features = cpu_features::GetX86Info().features;
+
+  // AVX-512 variants are built for skylake-avx512 feature set, same as AVX-512 binaries
+  if (features.avx && features.avx2 && features.fma3 && features.f16c && features.avx512f && features.avx512vl &&
+      features.avx512bw && features.avx512dq && features.avx512cd && features.bmi1 && features.bmi2)
+    return ISA_AVX512;
+
+  if (features.avx && features.avx2 && features.fma3 && features.f16c && features.bmi1 && features.bmi2)
+    return ISA_AVX2;
+#endif
+
+  return ISA_GENERIC;
+}
+
+int CpuDispatch::detectedLevel() {
+  static const int level = detectIsaLevel();
+  return level;
+}
+
+int CpuDispatch::level() {
+  auto cap = Environment::getInstance().maxIsaLevel();
+  auto level = detectedLevel();
+
+  return cap > 0 ? std::max<int>(ISA_GENERIC, std::min(cap, level)) : level;
+}
+
+bool CpuDispatch::isEnabled() {
+#ifdef SD_ISA_DISPATCH
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace sd
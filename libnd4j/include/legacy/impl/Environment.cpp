@@ -25,6 +25,7 @@
 #include <helpers/logger.h>
 #include <memory/MemoryCounter.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
@@ -103,6 +104,56 @@ sd::Environment::Environment() {
     }
   }
 
+  /**
+   * Defines number of graph nodes that can be executed concurrently
+   */
+  const char *inter_op_threads = std::getenv("SD_INTER_OP_THREADS");
+  if (inter_op_threads != nullptr) {
+    try {
+      std::string t(inter_op_threads);
+      int val = std::stoi(t);
+      _interOpThreads.store(val < 1 ? 1 : val);
+    } catch (std::invalid_argument &e) {
+      // just do nothing
+    } catch (std::out_of_range &e) {
+      // still do nothing
+    }
+  }
+
+  const char *memory_planning = std::getenv("SD_MEMORY_PLANNING");
+  if (memory_planning != nullptr) {
+    std::string t(memory_planning);
+    _memoryPlanning.store(t == "1" || t == "true");
+  }
+
+  const char *graph_fusion = std::getenv("SD_GRAPH_FUSION");
+  if (graph_fusion != nullptr) {
+    std::string t(graph_fusion);
+    _graphFusion.store(t == "1" || t == "true");
+  }
+
+  const char *op_statistics = std::getenv("SD_OP_STATISTICS");
+  if (op_statistics != nullptr) {
+    std::string t(op_statistics);
+    _opStatistics.store(t == "1" || t == "true");
+  }
+
+  /**
+   * Caps ISA level of dispatched CPU kernels: 1 - generic x86-64, 2 - AVX2, 3 - AVX-512
+   */
+  const char *max_isa_level = std::getenv("SD_MAX_ISA_LEVEL");
+  if (max_isa_level != nullptr) {
+    try {
+      std::string t(max_isa_level);
+      int val = std::stoi(t);
+      _maxIsaLevel.store(val < 0 ? 0 : val);
+    } catch (std::invalid_argument &e) {
+      // just do nothing
+    } catch (std::out_of_range &e) {
+      // still do nothing
+    }
+  }
+
   if (_maxMasterThreads.load() > _maxThreads.load()) {
     sd_printf("Warning! MAX_MASTER_THREADS > MAX_THREADS, tuning them down to match each other\n", "");
     _maxMasterThreads.store(_maxThreads.load());
@@ -254,7 +305,37 @@ void Environment::setElementwiseThreshold(int threshold) { _elementThreshold = t
 
 int Environment::maxThreads() { return _maxThreads.load(); }
 
-int Environment::maxMasterThreads() { return _maxMasterThreads.load(); }
+// per-thread limit, used while the thread executes one of concurrently dispatched graph nodes
+static thread_local int _threadMaxMasterThreads = 0;
+
+int Environment::maxMasterThreads() {
+  return _threadMaxMasterThreads > 0 ? std::min<int>(_threadMaxMasterThreads, _maxMasterThreads.load())
+                                     : _maxMasterThreads.load();
+}
+
+void Environment::setThreadMaxMasterThreads(int max) { _threadMaxMasterThreads = max < 0 ? 0 : max; }
+
+int Environment::interOpThreads() { return _interOpThreads.load(); }
+
+void Environment::setInterOpThreads(int numThreads) { _interOpThreads.store(numThreads < 1 ? 1 : numThreads); }
+
+bool Environment::isMemoryPlanning() { return _memoryPlanning.load(); }
+
+void Environment::setMemoryPlanning(bool reallyPlan) { _memoryPlanning.store(reallyPlan); }
+
+bool Environment::isGraphFusion() { return _graphFusion.load(); }
+
+void Environment::setGraphFusion(bool reallyFuse) { _graphFusion.store(reallyFuse); }
+
+bool Environment::isOpStatistics() { return _opStatistics.load(); }
+
+void Environment::setOpStatistics(bool reallyCollect) { _opStatistics.store(reallyCollect); }
+
+int Environment::maxIsaLevel() { return _maxIsaLevel.load(std::memory_order_relaxed); }
+
+void Environment::setMaxIsaLevel(int level) { _maxIsaLevel.store(level < 0 ? 0 : level); }
+
+int Environment::intraOpThreads() { return std::max<int>(1, _maxMasterThreads.load() / _interOpThreads.load()); }
 
 void Environment::setMaxThreads(int max) {
   // allocate more threads if we want or limit number of threads
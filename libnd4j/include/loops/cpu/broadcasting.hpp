@@ -25,6 +25,7 @@
 #include <helpers/ShapeUtils.h>
 #include <loops/broadcasting.h>
 #include <loops/legacy_ops.h>
+#include <system/CpuDispatch.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -33,6 +34,36 @@ using namespace simdOps;
 namespace functions {
 namespace broadcast {
 
+// tads [start, stop) of contiguous x combined with contiguous y, built for every ISA level via IsaDispatch
+template <typename X, typename Y, typename Z, typename OpType>
+struct BroadcastKernel {
+  static SD_INLINE void run(const X *x, const sd::LongType *xOffsets, const Y *y, Z *z, const sd::LongType *zOffsets,
+                            const unsigned int tadLength, const uint64_t start, const uint64_t stop) {
+    for (auto i = start; i < stop; i++) {
+      auto oX = x + xOffsets[i];
+      auto oZ = z + zOffsets[i];
+
+      PRAGMA_OMP_SIMD
+      for (unsigned int f = 0; f < tadLength; f++) oZ[f] = OpType::op(oX[f], y[f]);
+    }
+  }
+};
+
+// same as BroadcastKernel, but tads are taken from y
+template <typename X, typename Y, typename Z, typename OpType>
+struct BroadcastInverseKernel {
+  static SD_INLINE void run(const X *x, const Y *y, const sd::LongType *yOffsets, Z *z, const sd::LongType *zOffsets,
+                            const unsigned int tadLength, const uint64_t start, const uint64_t stop) {
+    for (auto i = start; i < stop; i++) {
+      auto oY = y + yOffsets[i];
+      auto oZ = z + zOffsets[i];
+
+      PRAGMA_OMP_SIMD
+      for (unsigned int f = 0; f < tadLength; f++) oZ[f] = OpType::op(x[f], oY[f]);
+    }
+  }
+};
+
 template <typename X, typename Y, typename Z>
 void Broadcast<X, Y, Z>::execInverse(int opNum, const void *x, const sd::LongType *xShapeInfo, const void *y,
                                      const sd::LongType *yShapeInfo, void *z, const sd::LongType *zShapeInfo,
@@ -108,13 +139,7 @@ void Broadcast<X, Y, Z>::exec(const void *vx, const sd::LongType *xShapeInfo, co
           : sd::LoopKind::deduceKindOfLoopXYZ(xTadShapeShapeInfo, yShapeInfo, zTadShapeInfo);
 
   if (kindOfLoop == sd::LoopKind::EWS1) {
-    for (auto i = start; i < stop; i++) {
-      auto oX = x + tadOffsets[i];
-      auto oZ = z + zTadOffset[i];
-
-      PRAGMA_OMP_SIMD
-      for (unsigned int f = 0; f < tadLength; f++) oZ[f] = OpType::op(oX[f], y[f]);
-    }
+    sd::IsaDispatch<BroadcastKernel<X, Y, Z, OpType>>::run(x, tadOffsets, y, z, zTadOffset, tadLength, start, stop);
   } else if (kindOfLoop == sd::LoopKind::EWSNONZERO) {
     for (auto i = start; i < stop; i++) {
       auto oX = x + tadOffsets[i];
@@ -377,13 +402,8 @@ void Broadcast<X, Y, Z>::execInverse(const void *vx, const sd::LongType *xShapeI
       sd::LoopKind::deduceKindOfLoopXYZ(yTadShapeShapeInfo, xShapeInfo, zTadShapeInfo);
 
   if (kindOfLoop == sd::LoopKind::EWS1) {
-    for (auto i = start; i < stop; i++) {
-      auto oY = y + tadOffsets[i];
-      auto oZ = z + zTadOffset[i];
-
-      PRAGMA_OMP_SIMD
-      for (unsigned int f = 0; f < tadLength; f++) oZ[f] = OpType::op(x[f], oY[f]);
-    }
+    sd::IsaDispatch<BroadcastInverseKernel<X, Y, Z, OpType>>::run(x, y, tadOffsets, z, zTadOffset, tadLength, start,
+                                                                  stop);
   } else if (kindOfLoop == sd::LoopKind::EWSNONZERO) {
     for (auto i = start; i < stop; i++) {
       auto oY = y + tadOffsets[i];
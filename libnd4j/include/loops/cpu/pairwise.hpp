@@ -26,6 +26,7 @@
 #include <loops/pairwise_transform.h>
 #include <math/templatemath.h>
 #include <ops/ops.h>
+#include <system/CpuDispatch.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -34,6 +35,15 @@ using namespace simdOps;
 namespace functions {
 namespace pairwise_transforms {
 
+// contiguous loop, built for every ISA level via IsaDispatch
+template <typename X, typename Y, typename Z, typename OpType>
+struct PairwiseKernel {
+  static SD_INLINE void run(const X *x, const Y *y, Z *z, Z *extraParams, const uint64_t start, const uint64_t stop) {
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], y[i], extraParams);
+  }
+};
+
 template <typename X, typename Y, typename Z>
 void PairWiseTransform<X, Y, Z>::exec(const int opNum, const void *x, sd::LongType xEws, const void *y,
                                       sd::LongType yEws, void *z, sd::LongType zEws, void *extraParams, sd::LongType n,
@@ -52,8 +62,7 @@ void PairWiseTransform<X, Y, Z>::exec(const void *vx, sd::LongType xEws, const v
   auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
   if (xEws == 1 && yEws == 1 && zEws == 1) {
-    PRAGMA_OMP_SIMD
-    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], y[i], extraParams);
+    sd::IsaDispatch<PairwiseKernel<X, Y, Z, OpType>>::run(x, y, z, extraParams, start, stop);
   } else {
     PRAGMA_OMP_SIMD
     for (auto i = start; i < stop; i++) z[i * zEws] = OpType::op(x[i * xEws], y[i * yEws], extraParams);
@@ -131,8 +131,8 @@ Z SD_HOST ReduceBoolFunction<X, Z>::execScalar(const void *vx, sd::LongType xEws
 
   auto func = PRAGMA_THREADS_FOR {
     if (xEws == 1) {
-      for (auto i = start; i < stop; i++)
-        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], extraParams), extraParams);
+      sd::IsaDispatch<sd::ReduceRowKernel<X, Z, X, OpType>>::run(x + start, static_cast<sd::LongType>(stop - start),
+                                                                  &intermediate[thread_id], extraParams);
     } else {
       for (auto i = start; i < stop; i++)
         intermediate[thread_id] =
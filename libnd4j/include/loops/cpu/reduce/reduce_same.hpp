@@ -147,8 +147,8 @@ X SD_HOST ReduceSameFunction<X>::execScalar(const void *vx, sd::LongType xEws, s
 
   auto func = PRAGMA_THREADS_FOR {
     if (xEws == 1) {
-      for (auto i = start; i < stop; i++)
-        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], extraParams), extraParams);
+      sd::IsaDispatch<sd::ReduceRowKernel<X, X, X, OpType>>::run(x + start, static_cast<sd::LongType>(stop - start),
+                                                                  &intermediate[thread_id], extraParams);
     } else {
       for (auto i = start; i < stop; i++)
         intermediate[thread_id] =
@@ -21,6 +21,7 @@
 //
 #include <execution/Threads.h>
 #include <helpers/LoopKind.h>
+#include <system/CpuDispatch.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -34,6 +35,16 @@ using namespace simdOps;
 namespace functions {
 namespace scalar {
 
+// contiguous loop, built for every ISA level via IsaDispatch
+template <typename X, typename Y, typename Z, typename OpType>
+struct ScalarKernel {
+  static SD_INLINE void run(const X *x, Z *z, const Y scalar, Z *extraParams, const uint64_t start,
+                            const uint64_t stop) {
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], scalar, extraParams);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y, typename Z>
 template <typename OpType>
@@ -171,8 +182,7 @@ void ScalarTransform<X, Y, Z>::transform(const void *vx, sd::LongType xEws, void
   auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
   if (xEws == 1 && zEws == 1) {
-    PRAGMA_OMP_SIMD
-    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], scalar, extraParams);
+    sd::IsaDispatch<ScalarKernel<X, Y, Z, OpType>>::run(x, z, scalar, extraParams, start, stop);
   } else {
     PRAGMA_OMP_SIMD
     for (auto i = start; i < stop; i++) z[i * zEws] = OpType::op(x[i * xEws], scalar, extraParams);
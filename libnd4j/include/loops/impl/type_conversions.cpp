@@ -22,11 +22,39 @@
 #include <execution/Threads.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <loops/type_conversions.h>
+#include <system/CpuDispatch.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
+#include <vector>
+
 namespace sd {
 
+// elementwise loops of conversions below, built for every ISA level via IsaDispatch
+template <typename S, typename T>
+struct ConvertKernel {
+  static SD_INLINE void run(const S *x, T *z, sd::LongType start, sd::LongType stop) {
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) z[i] = static_cast<T>(static_cast<float>(x[i]));
+  }
+};
+
+template <typename T>
+struct DequantizeKernel {
+  static SD_INLINE void run(const char *x, T *z, float maxByte, float amax, sd::LongType N) {
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < N; e++) z[e] = static_cast<T>(static_cast<float>(x[e]) / maxByte * amax);
+  }
+};
+
+template <typename T>
+struct QuantizeKernel {
+  static SD_INLINE void run(const T *x, char *z, float amax, int maxByte, sd::LongType start, sd::LongType stop) {
+    for (auto e = start; e < stop; e++)
+      z[e] = static_cast<char>(sd::math::sd_round<float, char>(1.0f * static_cast<float>(x[e]) / amax * maxByte));
+  }
+};
+
 template <typename T>
 SD_HOST void TypeCast::convertFromQuantized(sd::Pointer *extras, void *dx, sd::LongType N, void *dz) {
   //
@@ -38,10 +66,8 @@ SD_HOST void TypeCast::convertFromQuantized(sd::Pointer *extras, void *dx, sd::L
 
   auto x = reinterpret_cast<char *>(dx) + 8;
 
-  for (sd::LongType e = 0; e < N; e++) {
-    z[e] = static_cast<T>(static_cast<float>(x[e]) / static_cast<float>(DataTypeUtils::max<int8_t>()) *
-                          sd::math::sd_max<float>(amin, amax));
-  }
+  IsaDispatch<DequantizeKernel<T>>::run(x, z, static_cast<float>(DataTypeUtils::max<int8_t>()),
+                                        sd::math::sd_max<float>(amin, amax), N);
 }
 
 template <typename T>
@@ -79,15 +105,21 @@ SD_HOST void TypeCast::convertToQuantized(sd::Pointer *extras, void *dx, sd::Lon
 
   // now we actually apply quantization
   auto func = PRAGMA_THREADS_FOR {
-    for (auto e = start; e < stop; e++) {
-      rz[e] = static_cast<char>(sd::math::sd_round<float, char>(1.0f * static_cast<float>(x[e]) /
-                                                                sd::math::sd_max<float>(amax, amin) * max_byte));
-    }
+    IsaDispatch<QuantizeKernel<T>>::run(x, rz, sd::math::sd_max<float>(amax, amin), max_byte, start, stop);
   };
 
   samediff::Threads::parallel_for(func, 0, N);
 }
 
+// number of elements encoded by single task: encoded values of every chunk go to precomputed offsets
+static const sd::LongType THRESHOLD_CHUNK = 1 << 16;
+
+// 1 for updates >= threshold, -1 for updates <= -threshold, 0 otherwise. Positive side wins for zero threshold
+template <typename T>
+SD_INLINE int thresholdSign(const T value, const T tt, const T mtt) {
+  return static_cast<int>(value >= tt) - static_cast<int>(value < tt && value <= mtt);
+}
+
 template <typename T>
 void TypeCast::convertToThreshold(sd::Pointer *extras, void *dx, sd::LongType N, void *dz) {
   // we suppose that first 4 bytes are integer, second 4 bytes are float
@@ -97,71 +129,68 @@ void TypeCast::convertToThreshold(sd::Pointer *extras, void *dx, sd::LongType N,
   FloatBits fb;
   auto x = reinterpret_cast<T *>(dx);
   auto z = reinterpret_cast<int *>(dz);
-  int limit = z[0];
+  sd::LongType limit = z[0];
   fb.i_ = z[2];
   float threshold = fb.f_;
 
-  // TODO: int limit is sad thing here, 2B elements limitation
-  auto l = static_cast<int>(N);
-  z[1] = l;
+  // encoded values are signed 1-based int indices
+  if (N >= DataTypeUtils::max<int>())
+    throw std::invalid_argument("convertToThreshold: threshold encoding supports up to 2^31 - 2 elements");
 
-#ifdef _OPENMP
-  int threads = OmpLaunchHelper::betterThreads(N);
-  auto span = OmpLaunchHelper::betterSpan(N, threads);
-#else
-  int threads = 1;
-  auto span = N;
-#endif
+  z[1] = static_cast<int>(N);
 
-  T tt = static_cast<T>(threshold);
-  T mtt = -tt;
-
-  // we use 3 as offset, since first 12 bytes are occupied with header
-  int flimit = limit + 4;
-  volatile int cnt = 4;
-  volatile bool flag = false;
-  PRAGMA_OMP_PARALLEL_THREADS(threads) {
-    int tid = omp_get_thread_num();
-    int start = span * tid;
-    int stop = span * (tid + 1);
-    if (stop > l) stop = l;
-
-    for (int e = start; e < stop; e++) {
-      bool flag_load;
-      PRAGMA_OMP_ATOMIC_ARGS(read)
-      flag_load = flag;
-      if (flag_load) break;
-
-      T cUpd = x[e];
-      if (cUpd >= tt) {
-        int idx;
-        PRAGMA_OMP_ATOMIC_ARGS(capture)
-        idx = cnt++;
-
-        if (idx >= flimit) {
-          PRAGMA_OMP_ATOMIC_ARGS(write)
-          flag = true;
-          break;
-        }
+  const T tt = static_cast<T>(threshold);
+  const T mtt = -tt;
+  const auto numChunks = (N + THRESHOLD_CHUNK - 1) / THRESHOLD_CHUNK;
+
+  // first pass: number of elements to encode in every chunk
+  std::vector<sd::LongType> offsets(numChunks + 1, 0);
+  auto count = PRAGMA_THREADS_FOR {
+    for (auto c = start; c < stop; c++) {
+      const auto cStop = sd::math::sd_min<sd::LongType>((c + 1) * THRESHOLD_CHUNK, N);
+      sd::LongType cnt = 0;
+
+      PRAGMA_OMP_SIMD_SUM(cnt)
+      for (auto e = c * THRESHOLD_CHUNK; e < cStop; e++) cnt += thresholdSign<T>(x[e], tt, mtt) != 0;
+
+      offsets[c + 1] = cnt;
+    }
+  };
+  samediff::Threads::parallel_tad(count, 0, numChunks);
+
+  for (sd::LongType c = 0; c < numChunks; c++) offsets[c + 1] += offsets[c];
+
+  // second pass: every chunk writes its own range of encoded array, elements beyond limit are left intact
+  auto encode = PRAGMA_THREADS_FOR {
+    for (auto c = start; c < stop; c++) {
+      if (offsets[c] >= limit) continue;
 
-        z[idx] = e + 1;
-        x[e] -= tt;
-      } else if (cUpd <= mtt) {
-        int idx;
-        PRAGMA_OMP_ATOMIC_ARGS(capture)
-        idx = cnt++;
-
-        if (idx >= flimit) {
-          PRAGMA_OMP_ATOMIC_ARGS(write)
-          flag = true;
-          break;
+      const auto cStart = c * THRESHOLD_CHUNK;
+      const auto cStop = sd::math::sd_min<sd::LongType>(cStart + THRESHOLD_CHUNK, N);
+
+      // we use 4 as offset, since first 16 bytes are occupied with header
+      auto idx = offsets[c] + 4;
+
+      if (offsets[c + 1] <= limit) {
+        for (auto e = cStart; e < cStop; e++) {
+          const int sign = thresholdSign<T>(x[e], tt, mtt);
+          if (sign != 0) z[idx++] = sign * static_cast<int>(e + 1);
         }
 
-        z[idx] = -e - 1;
-        x[e] += tt;
+        PRAGMA_OMP_SIMD
+        for (auto e = cStart; e < cStop; e++) x[e] -= tt * static_cast<T>(thresholdSign<T>(x[e], tt, mtt));
+      } else {
+        for (auto e = cStart; e < cStop && idx < limit + 4; e++) {
+          const int sign = thresholdSign<T>(x[e], tt, mtt);
+          if (sign != 0) {
+            z[idx++] = sign * static_cast<int>(e + 1);
+            x[e] -= tt * static_cast<T>(sign);
+          }
+        }
       }
     }
-  }
+  };
+  samediff::Threads::parallel_tad(encode, 0, numChunks);
 }
 
 template <typename T>
@@ -169,18 +198,20 @@ void TypeCast::convertFromThreshold(sd::Pointer *extras, const void *dx, sd::Lon
   FloatBits fb;
   auto z = reinterpret_cast<T *>(dz);
   auto x = reinterpret_cast<const int *>(dx);
-  int limit = x[0];
+  sd::LongType limit = x[0];
   fb.i_ = x[2];
-  float threshold = fb.f_;
+  const T threshold = static_cast<T>(fb.f_);
 
-  // we use 3 as offset, since first 12 bytes are occupied with header
-  int flimit = limit + 4;
+  // we use 4 as offset, since first 16 bytes are occupied with header
+  sd::LongType flimit = limit + 4;
 
+  // encoded indices are unique, so scattered updates never collide
   auto func = PRAGMA_THREADS_FOR {
+    PRAGMA_OMP_SIMD
     for (auto e = start; e < stop; e++) {
-      int el = x[e];
-      int ael = sd::math::sd_abs<int>(el) - 1;
-      z[ael] += el > 0 ? static_cast<T>(threshold) : static_cast<T>(-threshold);
+      const int el = x[e];
+      const int sign = el >> 31;
+      z[(el ^ sign) - sign - 1] += threshold * static_cast<T>(sign | 1);
     }
   };
 
@@ -201,11 +232,7 @@ void TypeCast::convertGeneric(sd::Pointer *extras, void *dx, sd::LongType N, voi
   auto x = reinterpret_cast<S *>(dx);
   auto z = reinterpret_cast<T *>(dz);
 
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      z[i] = static_cast<T>(static_cast<float>(x[i]));
-    }
-  };
+  auto func = PRAGMA_THREADS_FOR { IsaDispatch<ConvertKernel<S, T>>::run(x, z, start, stop); };
   samediff::Threads::parallel_for(func, 0, N);
 };
 
@@ -52,6 +52,9 @@ class SD_LIB_EXPORT MemoryCounter {
   // per-group limits
   std::map<sd::memory::MemoryType, sd::LongType> _groupLimits;
 
+  // per-group high water marks, since start or last reset
+  std::map<sd::memory::MemoryType, sd::LongType> _groupPeaks;
+
   MemoryCounter();
   ~MemoryCounter() = default;
 
@@ -111,6 +114,20 @@ class SD_LIB_EXPORT MemoryCounter {
    */
   sd::LongType allocatedGroup(sd::memory::MemoryType group);
 
+  /**
+   * This method returns the highest amount of memory allocated in specified group of devices since start,
+   * or since last resetPeakGroup() call
+   * @param group
+   * @return
+   */
+  sd::LongType peakGroup(sd::memory::MemoryType group);
+
+  /**
+   * This method resets high water mark of specified group to the amount of memory allocated right now
+   * @param group
+   */
+  void resetPeakGroup(sd::memory::MemoryType group);
+
   /**
    * This method allows to set per-device memory limits
    * @param deviceId
@@ -69,8 +69,28 @@ class SD_LIB_EXPORT Workspace {
   std::atomic<sd::LongType> _spillsSizeSecondary;
   std::atomic<sd::LongType> _cycleAllocationsSecondary;
 
+  // largest _cycleAllocations value seen by scopeOut() since last scopeIn()
+  std::atomic<sd::LongType> _peakCycleAllocations{0};
+
+  // spill statistics, never reset
+  std::atomic<sd::LongType> _spillsCount{0};
+  std::atomic<sd::LongType> _spillsRecycled{0};
+  std::atomic<sd::LongType> _spillsTotalSize{0};
+
+  // size class of every block in _spills, and blocks released by scopeOut() grouped by size class
+  std::vector<int> _spillsClasses;
+  std::vector<std::vector<void*>> _freeSpills;
+
+  // unique id and arena generation, used to invalidate thread-local sub-arenas
+  sd::LongType _id = 0;
+  std::atomic<sd::LongType> _generation{0};
+
   void init(sd::LongType primaryBytes, sd::LongType secondaryBytes = 0L);
   void freeSpills();
+  void recycleSpills();
+
+  void* allocateSpill(sd::LongType numBytes);
+  void* allocateShared(sd::LongType numBytes, bool& contended);
 
  public:
   explicit Workspace(ExternalWorkspace* external);
@@ -83,6 +103,19 @@ class SD_LIB_EXPORT Workspace {
   sd::LongType getSpilledSize();
   sd::LongType getUsedSize();
 
+  /**
+   * Spill statistics: number of allocations that didn't fit into workspace, number of them served by blocks
+   * recycled from previous cycles, and total number of spilled bytes
+   */
+  sd::LongType getSpillsCount();
+  sd::LongType getRecycledSpillsCount();
+  sd::LongType getTotalSpilledSize();
+
+  /**
+   * This method returns largest amount of memory allocated within single scopeIn/scopeOut cycle
+   */
+  sd::LongType getPeakCycleAllocations();
+
   sd::LongType getAllocatedSecondarySize();
   sd::LongType getCurrentSecondarySize();
   sd::LongType getCurrentSecondaryOffset();
@@ -35,6 +35,44 @@
 
 namespace sd {
 namespace memory {
+// allocations of threads working in sub-arena mode are served from chunks of this size
+static const sd::LongType SUB_ARENA_SIZE = 65536;
+static const int NUM_SUB_ARENAS = 4;
+
+struct SubArena {
+  sd::LongType owner = 0;
+  sd::LongType generation = -1;
+  char *ptr = nullptr;
+  char *end = nullptr;
+};
+
+static SD_INLINE SubArena &subArena(sd::LongType workspaceId) {
+  static thread_local SubArena arenas[NUM_SUB_ARENAS];
+  return arenas[workspaceId % NUM_SUB_ARENAS];
+}
+
+static sd::LongType nextWorkspaceId() {
+  static std::atomic<sd::LongType> counter(0);
+  return ++counter;
+}
+
+// spilled blocks are rounded up to 4 size classes per power of 2, so at most 25% of the block is wasted
+static SD_INLINE int spillClass(sd::LongType numBytes, sd::LongType &classBytes) {
+  if (numBytes <= 256) {
+    classBytes = 256;
+    return 0;
+  }
+
+  int p = 8;
+  while ((1LL << (p + 1)) < numBytes) p++;
+
+  auto step = 1LL << (p - 2);
+  auto k = (numBytes + step - 1) / step;
+  classBytes = k * step;
+
+  return 1 + (p - 8) * 4 + (int)(k - 5);
+}
+
 Workspace::Workspace(ExternalWorkspace *external) {
   if (external->sizeHost() > 0) {
     _ptrHost = (char *)external->pointerHost();
@@ -49,6 +87,8 @@ Workspace::Workspace(ExternalWorkspace *external) {
 
     _externalized = true;
   }
+
+  _id = nextWorkspaceId();
 };
 
 Workspace::Workspace(sd::LongType initialSize, sd::LongType secondaryBytes) {
@@ -70,6 +110,7 @@ Workspace::Workspace(sd::LongType initialSize, sd::LongType secondaryBytes) {
   this->_offsetSecondary = 0;
   this->_cycleAllocations = 0;
   this->_spillsSize = 0;
+  this->_id = nextWorkspaceId();
 }
 
 void Workspace::init(sd::LongType bytes, sd::LongType secondaryBytes) {
@@ -83,6 +124,9 @@ void Workspace::init(sd::LongType bytes, sd::LongType secondaryBytes) {
     memset(this->_ptrHost, 0, bytes);
     this->_currentSize = bytes;
     this->_allocatedHost = true;
+
+    // sub-arenas carved from previous buffer are gone
+    _generation++;
   }
 }
 
@@ -95,11 +139,29 @@ void Workspace::expandTo(sd::LongType numBytes, sd::LongType secondaryBytes) { t
 void Workspace::freeSpills() {
   _spillsSize = 0;
 
-  if (_spills.size() < 1) return;
-
   for (auto v : _spills) free(v);
 
+  for (auto &list : _freeSpills)
+    for (auto v : list) free(v);
+
   _spills.clear();
+  _spillsClasses.clear();
+  _freeSpills.clear();
+}
+
+void Workspace::recycleSpills() {
+  std::lock_guard<std::mutex> lock(_mutexSpills);
+
+  for (size_t e = 0; e < _spills.size(); e++) {
+    auto sizeClass = _spillsClasses[e];
+    if ((int)_freeSpills.size() <= sizeClass) _freeSpills.resize(sizeClass + 1);
+
+    _freeSpills[sizeClass].push_back(_spills[e]);
+  }
+
+  _spills.clear();
+  _spillsClasses.clear();
+  _spillsSize = 0;
 }
 
 Workspace::~Workspace() {
@@ -114,41 +176,96 @@ sd::LongType Workspace::getCurrentSize() { return _currentSize; }
 
 sd::LongType Workspace::getCurrentOffset() { return _offset.load(); }
 
-void *Workspace::allocateBytes(sd::LongType numBytes) {
-  if (numBytes < 1) throw allocation_exception::build("Number of bytes for allocation should be positive", numBytes);
+void *Workspace::allocateShared(sd::LongType numBytes, bool &contended) {
+  auto offset = _offset.load();
+  while (true) {
+    if (offset + numBytes > _currentSize) return nullptr;
 
-  // numBytes += 32;
-  void *result = nullptr;
-  this->_cycleAllocations += numBytes;
-  this->_mutexAllocation.lock();
+    if (_offset.compare_exchange_weak(offset, offset + numBytes)) return (void *)(_ptrHost + offset);
 
-  if (_offset.load() + numBytes > _currentSize) {
+    contended = true;
+  }
+}
+
+void *Workspace::allocateSpill(sd::LongType numBytes) {
+  sd::LongType classBytes = 0;
+  auto sizeClass = spillClass(numBytes, classBytes);
+
+  void *p = nullptr;
+  _mutexSpills.lock();
+  if (sizeClass < (int)_freeSpills.size() && !_freeSpills[sizeClass].empty()) {
+    p = _freeSpills[sizeClass].back();
+    _freeSpills[sizeClass].pop_back();
+  }
+  _mutexSpills.unlock();
+
+  if (p != nullptr) {
+    sd_debug("Reusing %lld bytes block for %lld bytes spill\n", classBytes, numBytes);
+    _spillsRecycled++;
+  } else {
     sd_debug("Allocating %lld bytes in spills\n", numBytes);
-    this->_mutexAllocation.unlock();
 #if defined(SD_ALIGNED_ALLOC)
-    void *p = aligned_alloc(SD_DESIRED_ALIGNMENT, (numBytes + SD_DESIRED_ALIGNMENT - 1) & (-SD_DESIRED_ALIGNMENT));
+    p = aligned_alloc(SD_DESIRED_ALIGNMENT, (classBytes + SD_DESIRED_ALIGNMENT - 1) & (-SD_DESIRED_ALIGNMENT));
 #else
-    void *p = malloc(numBytes);
+    p = malloc(classBytes);
 #endif
-    CHECK_ALLOC(p, "Failed to allocate new workspace", numBytes);
+    CHECK_ALLOC(p, "Failed to allocate new workspace", classBytes);
+  }
 
-    _mutexSpills.lock();
-    _spills.push_back(p);
-    _mutexSpills.unlock();
+  _mutexSpills.lock();
+  _spills.push_back(p);
+  _spillsClasses.push_back(sizeClass);
+  _mutexSpills.unlock();
+
+  _spillsSize += numBytes;
+  _spillsTotalSize += numBytes;
+  _spillsCount++;
+
+  return p;
+}
+
+void *Workspace::allocateBytes(sd::LongType numBytes) {
+  if (numBytes < 1) throw allocation_exception::build("Number of bytes for allocation should be positive", numBytes);
 
-    _spillsSize += numBytes;
+  this->_cycleAllocations += numBytes;
 
-    return p;
+  // threads that met contention on shared offset switch to bump allocation within their own sub-arena
+  auto &local = subArena(_id);
+  if (local.owner == _id && numBytes <= SUB_ARENA_SIZE / 8) {
+    if (local.generation != _generation.load(std::memory_order_relaxed)) {
+      local.owner = 0;
+    } else if (local.end - local.ptr < numBytes) {
+      bool contended = false;
+      auto chunk = sd::math::sd_min<sd::LongType>(SUB_ARENA_SIZE, (_currentSize - _offset.load()) / 8);
+      auto p = chunk >= numBytes ? reinterpret_cast<char *>(allocateShared(chunk, contended)) : nullptr;
+      if (p != nullptr) {
+        local.ptr = p;
+        local.end = p + chunk;
+      } else {
+        local.owner = 0;
+      }
+    }
+
+    if (local.owner == _id) {
+      auto result = local.ptr;
+      local.ptr += numBytes;
+      return result;
+    }
   }
 
-  result = (void *)(_ptrHost + _offset.load());
-  _offset += numBytes;
-  // memset(result, 0, (int) numBytes);
+  bool contended = false;
+  auto result = allocateShared(numBytes, contended);
+  if (result == nullptr) return allocateSpill(numBytes);
 
   sd_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result,
            _offset.load());
 
-  this->_mutexAllocation.unlock();
+  if (contended) {
+    local.owner = _id;
+    local.generation = _generation.load();
+    local.ptr = nullptr;
+    local.end = nullptr;
+  }
 
   return result;
 }
@@ -156,18 +273,44 @@ void *Workspace::allocateBytes(sd::LongType numBytes) {
 sd::LongType Workspace::getAllocatedSize() { return getCurrentSize() + getSpilledSize(); }
 
 void Workspace::scopeIn() {
-  freeSpills();
-  init(_cycleAllocations.load());
+  // workspace grows to the high-water mark of previous cycles, so next ones fit into it. external memory can't grow,
+  // so spilled blocks are kept for reuse instead
+  if (!_externalized) {
+    freeSpills();
+    init(sd::math::sd_max<sd::LongType>(_cycleAllocations.load(), _peakCycleAllocations.load()));
+  } else {
+    recycleSpills();
+  }
+
   _cycleAllocations = 0;
+  _peakCycleAllocations = 0;
 }
 
 void Workspace::scopeOut() {
+  auto cycle = _cycleAllocations.load();
+  if (cycle > _peakCycleAllocations.load()) _peakCycleAllocations = cycle;
+
+  // only offsets are reset here: buffer and spilled blocks stay where they are, growth is left to next scopeIn()
+  recycleSpills();
+
+  _cycleAllocations = 0;
   _offset = 0;
   _offsetSecondary = 0;
+  _generation++;
 }
 
 sd::LongType Workspace::getSpilledSize() { return _spillsSize.load(); }
 
+sd::LongType Workspace::getSpillsCount() { return _spillsCount.load(); }
+
+sd::LongType Workspace::getRecycledSpillsCount() { return _spillsRecycled.load(); }
+
+sd::LongType Workspace::getTotalSpilledSize() { return _spillsTotalSize.load(); }
+
+sd::LongType Workspace::getPeakCycleAllocations() {
+  return sd::math::sd_max<sd::LongType>(_peakCycleAllocations.load(), _cycleAllocations.load());
+}
+
 void *Workspace::allocateBytes(sd::memory::MemoryType type, sd::LongType numBytes) {
   if (type == DEVICE) throw std::runtime_error("CPU backend doesn't have device memory");
 
@@ -186,7 +329,7 @@ sd::LongType Workspace::getUsedSecondarySize() { return 0L; }
 
 Workspace *Workspace::clone() {
   // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-  return new Workspace(sd::math::sd_max<sd::LongType>(this->getCurrentSize(), this->_cycleAllocations.load()));
+  return new Workspace(sd::math::sd_max<sd::LongType>(this->getCurrentSize(), this->getPeakCycleAllocations()));
 }
 }  // namespace memory
 }  // namespace sd
@@ -149,14 +149,31 @@ sd::LongType Workspace::getAllocatedSize() { return getCurrentSize() + getSpille
 
 void Workspace::scopeIn() {
   freeSpills();
-  init(_cycleAllocations.load());
+  init(sd::math::sd_max<sd::LongType>(_cycleAllocations.load(), _peakCycleAllocations.load()));
   _cycleAllocations = 0;
+  _peakCycleAllocations = 0;
 }
 
-void Workspace::scopeOut() { _offset = 0; }
+void Workspace::scopeOut() {
+  auto cycle = _cycleAllocations.load();
+  if (cycle > _peakCycleAllocations.load()) _peakCycleAllocations = cycle;
+
+  _cycleAllocations = 0;
+  _offset = 0;
+}
 
 sd::LongType Workspace::getSpilledSize() { return _spillsSize.load(); }
 
+sd::LongType Workspace::getSpillsCount() { return _spillsCount.load(); }
+
+sd::LongType Workspace::getRecycledSpillsCount() { return _spillsRecycled.load(); }
+
+sd::LongType Workspace::getTotalSpilledSize() { return _spillsTotalSize.load(); }
+
+sd::LongType Workspace::getPeakCycleAllocations() {
+  return sd::math::sd_max<sd::LongType>(_peakCycleAllocations.load(), _cycleAllocations.load());
+}
+
 void *Workspace::allocateBytes(sd::memory::MemoryType type, sd::LongType numBytes) {
   switch (type) {
     case HOST: {
@@ -181,6 +198,8 @@ void *Workspace::allocateBytes(sd::memory::MemoryType type, sd::LongType numByte
         _mutexSpills.unlock();
 
         _spillsSizeSecondary += numBytes;
+        _spillsTotalSize += numBytes;
+        _spillsCount++;
 
         return p;
       }
@@ -218,6 +237,8 @@ void *Workspace::allocateBytes(sd::memory::MemoryType type, sd::LongType numByte
         _mutexSpills.unlock();
 
         _spillsSize += numBytes;
+        _spillsTotalSize += numBytes;
+        _spillsCount++;
 
         return p;
       }
@@ -240,7 +261,7 @@ void *Workspace::allocateBytes(sd::memory::MemoryType type, sd::LongType numByte
 
 Workspace *Workspace::clone() {
   // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-  return new Workspace(sd::math::sd_max<sd::LongType>(this->getCurrentSize(), this->_cycleAllocations.load()));
+  return new Workspace(sd::math::sd_max<sd::LongType>(this->getCurrentSize(), this->getPeakCycleAllocations()));
 }
 
 sd::LongType Workspace::getAllocatedSecondarySize() { return getCurrentSecondarySize() + getSpilledSecondarySize(); }
@@ -44,6 +44,9 @@ MemoryCounter::MemoryCounter() {
   // setting initial counter values
   _groupCounters[sd::memory::MemoryType::HOST] = 0;
   _groupCounters[sd::memory::MemoryType::DEVICE] = 0;
+
+  _groupPeaks[sd::memory::MemoryType::HOST] = 0;
+  _groupPeaks[sd::memory::MemoryType::DEVICE] = 0;
 }
 
 MemoryCounter& MemoryCounter::getInstance() {
@@ -58,7 +61,10 @@ void MemoryCounter::countIn(int deviceId, sd::LongType numBytes) {
 
 void MemoryCounter::countIn(sd::memory::MemoryType group, sd::LongType numBytes) {
   std::lock_guard<std::mutex> lock(_locker);
-  _groupCounters[group] += numBytes;
+  auto current = _groupCounters[group] += numBytes;
+
+  auto &peak = _groupPeaks[group];
+  if (current > peak) peak = current;
 }
 
 void MemoryCounter::countOut(int deviceId, sd::LongType numBytes) {
@@ -106,6 +112,16 @@ sd::LongType MemoryCounter::allocatedGroup(sd::memory::MemoryType group) {
   return _groupCounters[group];
 }
 
+sd::LongType MemoryCounter::peakGroup(sd::memory::MemoryType group) {
+  std::lock_guard<std::mutex> lock(_locker);
+  return _groupPeaks[group];
+}
+
+void MemoryCounter::resetPeakGroup(sd::memory::MemoryType group) {
+  std::lock_guard<std::mutex> lock(_locker);
+  _groupPeaks[group] = _groupCounters[group];
+}
+
 void MemoryCounter::setDeviceLimit(int deviceId, sd::LongType numBytes) {
   std::lock_guard<std::mutex> lock(_locker);
   _deviceLimits[deviceId] = numBytes;
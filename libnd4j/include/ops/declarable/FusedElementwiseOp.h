@@ -0,0 +1,77 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Chain of elementwise ops executed as single op, built by Graph fusion pass
+//
+#ifndef LIBND4J_FUSEDELEMENTWISEOP_H
+#define LIBND4J_FUSEDELEMENTWISEOP_H
+
+#include <graph/scheme/node_generated.h>
+#include <ops/declarable/DeclarableOp.h>
+
+#include <vector>
+
+namespace sd {
+namespace ops {
+/**
+ * Single op of the fused chain. Running value of the chain is X operand of every step, or Y operand if step is
+ * reversed. Supported op types are OpType_TRANSFORM_STRICT, OpType_TRANSFORM_SAME, OpType_SCALAR and OpType_PAIRWISE
+ */
+struct SD_LIB_EXPORT FusedStep {
+  sd::graph::OpType opType = sd::graph::OpType_TRANSFORM_SAME;
+  int opNum = 0;
+
+  // index of the op input used as second operand of pairwise step
+  int operand = -1;
+  bool reversed = false;
+
+  double scalar = 0.0;
+  std::vector<double> extras;
+};
+
+/**
+ * This op applies chain of elementwise steps to its first input. If all arrays share the same floating point data
+ * type and c-order, the whole chain is applied to cache-sized blocks of output in a single pass over memory.
+ * Second operands of pairwise steps can be arrays of the same shape, scalars, or arrays matching trailing dimensions
+ * of the output (i.e. bias). Everything else falls back to separate NDArray ops.
+ */
+class SD_LIB_EXPORT FusedElementwiseOp : public DeclarableOp {
+ protected:
+  std::vector<FusedStep> _steps;
+
+  sd::Status validateAndExecute(Context& block) override;
+  void registerTypes() override;
+
+ public:
+  FusedElementwiseOp(int numInputs, const std::vector<FusedStep>& steps);
+  ~FusedElementwiseOp() = default;
+
+  ShapeList* calculateOutputShape(ShapeList* inputShape, sd::graph::Context& block) override;
+
+  const std::vector<FusedStep>& steps() const { return _steps; }
+
+  /**
+   * This method checks if legacy op with given type and number can be used as step of fused chain
+   */
+  static bool isFusable(sd::graph::OpType opType, int opNum);
+};
+}  // namespace ops
+}  // namespace sd
+
+#endif  // LIBND4J_FUSEDELEMENTWISEOP_H
@@ -0,0 +1,80 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Hogwild word2vec training over corpus chunk
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_word2vec_corpus)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/sg_cb.h>
+
+namespace sd {
+namespace ops {
+
+CONFIGURABLE_OP_IMPL(word2vec_corpus, 5, 5, true, 1, 2) {
+  auto tokens = INPUT_VARIABLE(0);
+  auto syn0 = INPUT_VARIABLE(1);
+  auto syn1Neg = INPUT_VARIABLE(2);
+  auto expTable = INPUT_VARIABLE(3);
+  auto negTable = INPUT_VARIABLE(4);
+
+  auto window = INT_ARG(0);
+  auto nsRounds = INT_ARG(1);
+  auto seed = block.numI() > 2 ? INT_ARG(2) : 0;
+  auto numWorkers = block.numI() > 3 ? INT_ARG(3) : omp_get_max_threads();
+
+  auto isCbow = block.numB() > 0 ? B_ARG(0) : false;
+
+  auto alpha = T_ARG(0);
+  auto minLearningRate = block.numT() > 1 ? T_ARG(1) : alpha;
+
+  REQUIRE_TRUE(block.isInplace(), 0, "word2vec_corpus: this operation requires inplace execution only");
+  REQUIRE_TRUE(tokens->isVector() && tokens->ews() == 1, 0, "word2vec_corpus: tokens must be a contiguous vector");
+  REQUIRE_TRUE(window > 0, 0, "word2vec_corpus: window size must be positive, but got %i", window);
+  REQUIRE_TRUE(nsRounds >= 0, 0, "word2vec_corpus: number of negative samples can't be negative");
+  REQUIRE_TRUE(syn0->rankOf() == 2 && syn0->isSameShape(syn1Neg), 0,
+               "word2vec_corpus: syn0 and syn1Neg must be matrices of the same shape");
+  REQUIRE_TRUE(syn0->ews() == 1 && syn1Neg->ews() == 1 && syn0->ordering() == 'c' && syn1Neg->ordering() == 'c', 0,
+               "word2vec_corpus: syn0 and syn1Neg must be contiguous c-ordered arrays");
+  REQUIRE_TRUE(syn0->dataType() == syn1Neg->dataType() && syn0->dataType() == expTable->dataType(), 0,
+               "word2vec_corpus: syn tables and expTable must have the same data type");
+  REQUIRE_TRUE(nsRounds == 0 || (negTable->dataType() == syn0->dataType() && syn0->sizeAt(0) > 1), 0,
+               "word2vec_corpus: negative sampling requires negTable of syn0 data type and vocabulary of 2+ words");
+
+  sd::ops::helpers::word2vecCorpus(*tokens, *syn0, *syn1Neg, *expTable, *negTable, window, nsRounds, isCbow, alpha,
+                                   minLearningRate, seed, numWorkers);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(word2vec_corpus) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, sd::DataType::INT32)
+      ->setAllowedInputTypes(1, {ALL_FLOATS})
+      ->setAllowedInputTypes(2, {ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_FLOATS})
+      ->setAllowedInputTypes(4, {ALL_FLOATS})
+      ->setAllowedOutputTypes(sd::DataType::ANY);
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
@@ -25,6 +25,7 @@
 #include <system/op_boilerplate.h>
 #if NOT_EXCLUDED(OP_dot_product_attention)
 
+#include <helpers/AttentionHelper.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
 
@@ -38,14 +39,7 @@ CUSTOM_OP_IMPL(dot_product_attention, 3, -1, false, 0, 2) {
   auto mask = block.width() > 3 ? INPUT_VARIABLE(3) : nullptr;
 
   auto output = OUTPUT_VARIABLE(0);
-  NDArray *weights;
   bool outputWeights = INT_ARG(1);
-  if (outputWeights) {
-    weights = OUTPUT_VARIABLE(1);
-  } else {
-    auto weightShape = ShapeUtils::evalShapeForMatmul(keys->shapeInfo(), queries->shapeInfo(), true, false);
-    weights = new NDArray('c', weightShape, values->dataType(), block.launchContext());
-  }
 
   int normalization = INT_ARG(0);
 
@@ -75,6 +69,21 @@ CUSTOM_OP_IMPL(dot_product_attention, 3, -1, false, 0, 2) {
                "But got keys = %i, values = %i",
                keys->sizeAt(-1), values->sizeAt(-1));
 
+  // weights aren't requested, so there's no need to materialize them
+  if (!outputWeights && Environment::getInstance().isCPU() &&
+      AttentionHelper::isBlockedAttentionApplicable({queries, keys, values, output})) {
+    AttentionHelper::dotProductAttention(queries, keys, values, mask, normalization, output);
+    return sd::Status::OK;
+  }
+
+  NDArray *weights;
+  if (outputWeights) {
+    weights = OUTPUT_VARIABLE(1);
+  } else {
+    auto weightShape = ShapeUtils::evalShapeForMatmul(keys->shapeInfo(), queries->shapeInfo(), true, false);
+    weights = new NDArray('c', weightShape, values->dataType(), block.launchContext());
+  }
+
   sd::ops::matmul mmul;
   mmul.execute({keys, queries}, {weights}, {}, {1}, {});
   if (normalization) {
@@ -173,6 +182,12 @@ CUSTOM_OP_IMPL(dot_product_attention_bp, 4, 3, false, 0, 1) {
                "But got keys = %i, values = %i",
                keys->sizeAt(-1), values->sizeAt(-1));
 
+  if (Environment::getInstance().isCPU() &&
+      AttentionHelper::isBlockedAttentionApplicable({queries, keys, values, eps, dLdq, dLdk, dLdv})) {
+    AttentionHelper::dotProductAttentionBp(queries, keys, values, eps, mask, normalization, dLdq, dLdk, dLdv);
+    return sd::Status::OK;
+  }
+
   double factor;
   if (normalization) factor = sqrt((double)keys->sizeAt(-2));
 
@@ -60,7 +60,7 @@ CONFIGURABLE_OP_IMPL(log_softmax_bp, 3, 1, true, 0, 0) {
   auto gradO = INPUT_VARIABLE(1);
   auto softmaxOut = INPUT_VARIABLE(2);
   auto gradI = OUTPUT_VARIABLE(0);
-  gradI->assign(softmaxOut);
+
   const int rank = input->rankOf();
   const int dim = block.getIArguments()->size() > 0 ? INT_ARG(0) : rank - 1;
 
@@ -69,12 +69,8 @@ CONFIGURABLE_OP_IMPL(log_softmax_bp, 3, 1, true, 0, 0) {
                "%i, but got dimension = %i instead !",
                rank, dim);
 
-  helpers::softmax(block.launchContext(), *input, *gradI, dim);
-
-  auto sumGradOj = gradO->reduceAlongDimension(reduce::Sum, {dim}, true);
-  //gradInputi = gradOutputi - softMax(xi) . sum_j( gradOutputj )
-  //we stored softmax inside gradI
-  gradI->assign(*gradO - *gradI * sumGradOj);
+  // gradI = gradO - softmax(x) * sum(gradO), softmax is recomputed from input
+  helpers::logSoftmaxBp(block.launchContext(), *input, *gradO, *gradI, dim);
 
   return sd::Status::OK;
 }
@@ -56,7 +56,7 @@ CONFIGURABLE_OP_IMPL(softmax_bp, 3, 1, true, 0, 0) {
   auto gradO = INPUT_VARIABLE(1);
   auto softmaxedOut = INPUT_VARIABLE(2);
   auto gradI = OUTPUT_VARIABLE(0);
-  gradI->assign(softmaxedOut);
+
   const int rank = input->rankOf();
   const int dim = block.getIArguments()->size() > 0 ? INT_ARG(0) : rank - 1;
 
@@ -65,9 +65,7 @@ CONFIGURABLE_OP_IMPL(softmax_bp, 3, 1, true, 0, 0) {
                "but got dimension = %i instead !",
                rank, dim);
 
-
-  auto sumAlongDim = (*gradI * *gradO).reduceAlongDimension(reduce::Sum, {dim}, true);
-  gradI->assign(*gradI * (*gradO - sumAlongDim));
+  helpers::softmaxBp(block.launchContext(), *softmaxedOut, *gradO, *gradI, dim);
 
   return sd::Status::OK;
 }
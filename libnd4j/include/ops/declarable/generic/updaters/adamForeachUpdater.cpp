@@ -0,0 +1,75 @@
+/*
+ *  ******************************************************************************
+ *  *
+ *  *
+ *  * This program and the accompanying materials are made available under the
+ *  * terms of the Apache License, Version 2.0 which is available at
+ *  * https://www.apache.org/licenses/LICENSE-2.0.
+ *  *
+ *  * See the NOTICE file distributed with this work for additional
+ *  * information regarding copyright ownership.
+ *  * Unless required by applicable law or agreed to in writing, software
+ *  * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  * License for the specific language governing permissions and limitations
+ *  * under the License.
+ *  *
+ *  * SPDX-License-Identifier: Apache-2.0
+ *  *****************************************************************************
+ */
+
+#include <array/NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/headers/updaters.h>
+#if NOT_EXCLUDED(OP_adam_updater_foreach)
+namespace sd {
+namespace ops {
+
+CONFIGURABLE_OP_IMPL(adam_updater_foreach, -1, -1, true, 0, 0) {
+  // inputs and outputs are grouped by role: all gradients first, then all states U, then all states M
+  const int numArrays = block.width() / 3;
+
+  REQUIRE_TRUE(numArrays > 0 && block.width() % 3 == 0, 0,
+               "ADAM UPDATER FOREACH OP: number of inputs has to be a multiple of 3, but got %i!", block.width());
+  REQUIRE_TRUE(4 == block.getTArguments()->size(), 0,
+               "ADAM UPDATER FOREACH OP: learning rate, beta 1, beta 2 and epsilon were not provided!");
+
+  std::vector<NDArray*> gradients(numArrays), initStatesU(numArrays), initStatesM(numArrays);
+  std::vector<NDArray*> updates(numArrays), statesU(numArrays), statesM(numArrays);
+
+  for (int e = 0; e < numArrays; e++) {
+    gradients[e] = INPUT_VARIABLE(e);
+    initStatesU[e] = INPUT_VARIABLE(numArrays + e);
+    initStatesM[e] = INPUT_VARIABLE(2 * numArrays + e);
+
+    updates[e] = OUTPUT_VARIABLE(e);
+    statesU[e] = OUTPUT_VARIABLE(numArrays + e);
+    statesM[e] = OUTPUT_VARIABLE(2 * numArrays + e);
+
+    REQUIRE_TRUE(gradients[e]->dataType() == gradients[0]->dataType(), 0,
+                 "ADAM UPDATER FOREACH OP: all gradients must have the same data type, but gradient %i has %s!", e,
+                 DataTypeUtils::asString(gradients[e]->dataType()).c_str());
+    REQUIRE_TRUE(gradients[e]->isSameShape(initStatesU[e]), 0,
+                 "ADAM UPDATER FOREACH OP: input state U %i must have the same shape as gradient,"
+                 "  expected shape %s, but got %s!",
+                 e, ShapeUtils::shapeAsString(gradients[e]->shapeInfo()).c_str(),
+                 ShapeUtils::shapeAsString(initStatesU[e]->shapeInfo()).c_str());
+    REQUIRE_TRUE(gradients[e]->isSameShape(initStatesM[e]), 0,
+                 "ADAM UPDATER FOREACH OP: input state M %i must have the same shape as gradient,"
+                 "  expected shape %s, but got %s!",
+                 e, ShapeUtils::shapeAsString(gradients[e]->shapeInfo()).c_str(),
+                 ShapeUtils::shapeAsString(initStatesM[e]->shapeInfo()).c_str());
+  }
+
+  auto iteration = block.getIArguments()->size() > 0 ? INT_ARG(0) : 0;
+
+  helpers::updaterAdamForeach(block.launchContext(), gradients, initStatesU, initStatesM, updates, statesU, statesM,
+                              T_ARG(0), T_ARG(1), T_ARG(2), T_ARG(3), iteration);
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(adam_updater_foreach) { getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS})->setSameMode(true); }
+
+}  // namespace ops
+}  // namespace sd
+#endif
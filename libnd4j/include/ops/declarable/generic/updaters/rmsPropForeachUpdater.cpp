@@ -0,0 +1,67 @@
+/*
+ *  ******************************************************************************
+ *  *
+ *  *
+ *  * This program and the accompanying materials are made available under the
+ *  * terms of the Apache License, Version 2.0 which is available at
+ *  * https://www.apache.org/licenses/LICENSE-2.0.
+ *  *
+ *  * See the NOTICE file distributed with this work for additional
+ *  * information regarding copyright ownership.
+ *  * Unless required by applicable law or agreed to in writing, software
+ *  * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  * License for the specific language governing permissions and limitations
+ *  * under the License.
+ *  *
+ *  * SPDX-License-Identifier: Apache-2.0
+ *  *****************************************************************************
+ */
+
+#include <array/NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/headers/updaters.h>
+#if NOT_EXCLUDED(OP_rms_prop_updater_foreach)
+namespace sd {
+namespace ops {
+
+CONFIGURABLE_OP_IMPL(rms_prop_updater_foreach, -1, -1, true, 0, 0) {
+  // inputs and outputs are grouped by role: all gradients first, then all states
+  const int numArrays = block.width() / 2;
+
+  REQUIRE_TRUE(numArrays > 0 && block.width() % 2 == 0, 0,
+               "RMS_PROP UPDATER FOREACH OP: number of inputs has to be a multiple of 2, but got %i!", block.width());
+  REQUIRE_TRUE(3 == block.getTArguments()->size(), 0,
+               "RMS_PROP UPDATER FOREACH OP: learning rate, rms decay and epsilon were not provided!");
+
+  std::vector<NDArray*> gradients(numArrays), initStates(numArrays), updates(numArrays), statesG(numArrays);
+
+  for (int e = 0; e < numArrays; e++) {
+    gradients[e] = INPUT_VARIABLE(e);
+    initStates[e] = INPUT_VARIABLE(numArrays + e);
+
+    updates[e] = OUTPUT_VARIABLE(e);
+    statesG[e] = OUTPUT_VARIABLE(numArrays + e);
+
+    REQUIRE_TRUE(gradients[e]->dataType() == gradients[0]->dataType(), 0,
+                 "RMS_PROP UPDATER FOREACH OP: all gradients must have the same data type, but gradient %i has %s!", e,
+                 DataTypeUtils::asString(gradients[e]->dataType()).c_str());
+    REQUIRE_TRUE(gradients[e]->isSameShape(initStates[e]), 0,
+                 "RMS_PROP UPDATER FOREACH OP: input state %i must have the same shape as gradient,"
+                 "  expected shape %s, but got %s!",
+                 e, ShapeUtils::shapeAsString(gradients[e]->shapeInfo()).c_str(),
+                 ShapeUtils::shapeAsString(initStates[e]->shapeInfo()).c_str());
+  }
+
+  helpers::updaterRmsPropForeach(block.launchContext(), gradients, initStates, updates, statesG, T_ARG(0), T_ARG(1),
+                                 T_ARG(2));
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(rms_prop_updater_foreach) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS})->setSameMode(true);
+}
+
+}  // namespace ops
+}  // namespace sd
+#endif
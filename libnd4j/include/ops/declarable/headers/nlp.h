@@ -42,6 +42,34 @@ DECLARE_CONFIGURABLE_OP(cbow, 15, 15, true, 0, 0);
 #if NOT_EXCLUDED(OP_cbow_inference)
 DECLARE_CONFIGURABLE_OP(cbow_inference,6, 6, true, -2, -2);
 #endif
+
+/**
+ * This op trains word2vec embeddings with negative sampling over whole chunk of corpus at once.
+ * Threads process separate spans of the chunk, updating syn0/syn1Neg without locks (Hogwild).
+ *
+ * Input arrays:
+ * 0: tokens - INT32 vector of word ids, negative ids act as sentence separators
+ * 1: syn0 - [vocabSize, vectorLength] input embeddings
+ * 2: syn1Neg - [vocabSize, vectorLength] output embeddings
+ * 3: expTable - precomputed sigmoid table
+ * 4: negTable - unigram table used for negative samples
+ *
+ * Int arguments:
+ * 0: window size
+ * 1: number of negative samples
+ * 2: optional, random seed, 0 by default
+ * 3: optional, number of threads, all threads by default
+ *
+ * Boolean arguments:
+ * 0: optional, true for CBOW, false (default) for skip-gram
+ *
+ * T arguments:
+ * 0: starting learning rate
+ * 1: optional, learning rate reached at the end of the chunk, same as starting one by default
+ */
+#if NOT_EXCLUDED(OP_word2vec_corpus)
+DECLARE_CONFIGURABLE_OP(word2vec_corpus, 5, 5, true, 1, 2);
+#endif
 }  // namespace ops
 }  // namespace sd
 
@@ -227,6 +227,57 @@ DECLARE_CONFIGURABLE_OP(nadam_updater, 3, 3, true, 0, 0);
 #if NOT_EXCLUDED(OP_ams_grad_updater)
 DECLARE_CONFIGURABLE_OP(ams_grad_updater, 4, 4, true, 0, 0);
 #endif
+// Adam over many parameters at once
+/* Input arrays, N arrays of each kind, grouped by kind :
+ *  0 .. N-1 - gradients
+ *  N .. 2N-1 - gradient states V
+ *  2N .. 3N-1 - gradient states M
+ * Output arrays follow the same layout: updates, states V, states M.
+ * Arrays of one parameter must have the same shape, all arrays the same data type.
+ * Views of a single flat buffer are updated as one contiguous range.
+ * T args
+ * 0 - scalar learning rate value
+ * 1 - beta 1 value
+ * 2 - beta 2 value
+ * 3 - epsilon
+ * Optional:
+ * I args
+ * 0 - iteration
+ */
+#if NOT_EXCLUDED(OP_adam_updater_foreach)
+DECLARE_CONFIGURABLE_OP(adam_updater_foreach, -1, -1, true, 0, 0);
+#endif
+// Nadam over many parameters at once
+/* Input arrays, N arrays of each kind, grouped by kind :
+ *  0 .. N-1 - gradients
+ *  N .. 2N-1 - gradient states V
+ *  2N .. 3N-1 - gradient states M
+ * Output arrays follow the same layout: updates, states V, states M.
+ * T args
+ * 0 - scalar learning rate value
+ * 1 - beta 1 value
+ * 2 - beta 2 value
+ * 3 - epsilon
+ * Optional:
+ * I args
+ * 0 - iteration
+ */
+#if NOT_EXCLUDED(OP_nadam_updater_foreach)
+DECLARE_CONFIGURABLE_OP(nadam_updater_foreach, -1, -1, true, 0, 0);
+#endif
+// RmsProp over many parameters at once
+/* Input arrays, N arrays of each kind, grouped by kind :
+ *  0 .. N-1 - gradients
+ *  N .. 2N-1 - initial states
+ * Output arrays follow the same layout: updates, states.
+ * T args
+ * 0 - scalar learning rate value
+ * 1 - scalar rms decay
+ * 2 - epsilon
+ */
+#if NOT_EXCLUDED(OP_rms_prop_updater_foreach)
+DECLARE_CONFIGURABLE_OP(rms_prop_updater_foreach, -1, -1, true, 0, 0);
+#endif
 }  // namespace ops
 }  // namespace sd
 
@@ -39,6 +39,12 @@ SD_LIB_HIDDEN void logSoftmax(sd::LaunchContext *context, const NDArray &input,
 SD_LIB_HIDDEN void softmaxDerivative(sd::LaunchContext *context, const NDArray &input, NDArray &output,
                                      const int dimension);
 
+SD_LIB_HIDDEN void softmaxBp(sd::LaunchContext *context, const NDArray &output, const NDArray &gradO, NDArray &gradI,
+                             const int dimension);
+
+SD_LIB_HIDDEN void logSoftmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO, NDArray &gradI,
+                                const int dimension);
+
 SD_LIB_HIDDEN void prelu(sd::LaunchContext *context, const NDArray &input, const NDArray &alpha, NDArray &output);
 
 SD_LIB_HIDDEN void preluBP(sd::LaunchContext *context, const NDArray &input, const NDArray &alpha, const NDArray &dLdO,
@@ -35,6 +35,15 @@ enum PoolingType {
   PNORM_POOL = 2,
 };
 
+// algorithms of CPU conv2d, CONV2D_IM2COL stands for im2col + gemm, others never materialize columns
+enum Conv2dAlgorithm {
+  CONV2D_IM2COL = 0,
+  CONV2D_DIRECT = 1,
+  CONV2D_IMPLICIT_GEMM = 2,
+  CONV2D_WINOGRAD_2X2 = 3,
+  CONV2D_WINOGRAD_4X4 = 4,
+};
+
 class SD_LIB_HIDDEN ConvolutionUtils {
  public:
   static inline void calcOutSizePool2D(int& oH, int& oW, const int kH, const int kW, const int sH, const int sW,
@@ -329,6 +338,42 @@ class SD_LIB_HIDDEN ConvolutionUtils {
                        const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode,
                        const int isNCHW, const int wFormat);
 
+  /**
+   * This method checks if native CPU conv2d engine supports given arrays: FLOAT32 or DOUBLE, all of the same type
+   */
+  static bool isNativeConvApplicable(const std::vector<const NDArray*>& arrays);
+
+  /**
+   * This method picks conv2d algorithm of CPU backend for given shapes. Native algorithms are used for FLOAT32 and
+   * DOUBLE arrays of the same type only, everything else goes through CONV2D_IM2COL
+   */
+  static Conv2dAlgorithm conv2dAlgorithm(const std::vector<const NDArray*>& arrays, const int iC, const int oC,
+                                         const int oH, const int oW, const int kH, const int kW, const int sH,
+                                         const int sW, const int dH, const int dW);
+
+  /**
+   * These methods are native CPU conv2d and conv2d_bp engine: input, output and weights can have any layout and format
+   * ops accept, paddings are expected to be calculated already. Biases are left to the caller.
+   * Available on CPU backend only
+   */
+  static void conv2dNative(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                           NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH,
+                           const int pW, const int dH, const int dW, const int isNCHW, const int wFormat);
+
+  static void conv2dBPNative(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                             const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW,
+                             const int sH, const int sW, const int pH, const int pW, const int dH, const int dW,
+                             const int isNCHW, const int wFormat);
+
+  static void depthwiseConv2dNative(const NDArray* input, const NDArray* weights, NDArray* output, const int kH,
+                                    const int kW, const int sH, const int sW, const int pH, const int pW, const int dH,
+                                    const int dW, const int isNCHW, const int wFormat);
+
+  static void depthwiseConv2dBPNative(const NDArray* input, const NDArray* weights, const NDArray* gradO,
+                                      NDArray* gradI, NDArray* gradW, const int kH, const int kW, const int sH,
+                                      const int sW, const int pH, const int pW, const int dH, const int dW,
+                                      const int isNCHW, const int wFormat);
+
   static void depthwiseConv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights,
                               const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH,
                               const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode,
@@ -31,52 +31,6 @@ namespace sd {
 namespace ops {
 namespace helpers {
 
-///////////////////////////////////////////////////////////////////
-template <typename T>
-void static _softMaxDerivForVector(sd::LaunchContext* context, const void* input, const sd::LongType* inShapeInfo,
-                                   void* output) {
-  const T* inBuff = reinterpret_cast<const T*>(input);
-  T* outBuff = reinterpret_cast<T*>(output);
-
-  T max = -DataTypeUtils::max<T>();
-  T sum = 0.;
-  int length = shape::length(inShapeInfo);
-
-  for (int i = 0; i < length; i++) {
-    const sd::LongType offset = shape::getIndexOffset(i, inShapeInfo);
-    max = sd::math::sd_max<T>(max, inBuff[offset]);
-  }
-
-  for (int i = 0; i < length; i++) {
-    const sd::LongType offset = shape::getIndexOffset(i, inShapeInfo);
-    outBuff[offset] = sd::math::sd_exp<T, T>(inBuff[offset] - max);
-    sum += outBuff[offset];
-  }
-
-  for (int i = 0; i < length; i++) {
-    const sd::LongType offset = shape::getIndexOffset(i, inShapeInfo);
-    outBuff[offset] /= sum;
-    outBuff[offset] *= (1.f - outBuff[offset]);  // derivative
-  }
-}
-
-///////////////////////////////////////////////////////////////////
-void softmaxDerivative(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  const int rank = input.rankOf();
-  int temp;
-
-  if (shape::isCommonVector(input.shapeInfo(), temp)) {
-    BUILD_SINGLE_SELECTOR(input.dataType(), _softMaxDerivForVector,
-                          (context, input.buffer(), input.shapeInfo(), output.buffer()), SD_FLOAT_TYPES);
-  } else {
-    auto maxAlongDim = const_cast<NDArray&>(input).reduceAlongDimension(reduce::Max, {dimension}, true);
-    (input - maxAlongDim).applyTransform(transform::Exp, output);  // output contains exponents temporarily
-    auto sumAlongDim = output.reduceAlongDimension(reduce::Sum, {dimension}, true);
-    output /= sumAlongDim;
-    output *= (1.f - output);  // derivative
-  }
-}
-
 ///////////////////////////////////////////////////////////////////
 template <typename T>
 void logSoftMaxForVector_(void const* input, sd::LongType const* inShapeInfo, void* output,
@@ -211,25 +165,6 @@ void thresholdReluDerivative(sd::LaunchContext* context, NDArray* input, double
                         SD_FLOAT_TYPES);
 }
 
-///////////////////////////////////////////////////////////////////
-void logSoftmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  const int rank = input.rankOf();
-
-  if (input.isVector()) {
-    if (rank == 1 || input.sizeAt(dimension) != 1) {
-      BUILD_SINGLE_SELECTOR(input.dataType(), logSoftMaxForVector_,
-                            (input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo()), SD_FLOAT_TYPES);
-    } else
-      output = 0.;
-  } else {
-    auto maxAlongDim = const_cast<NDArray&>(input).reduceAlongDimension(reduce::Max, {dimension}, true);
-    (input - maxAlongDim).applyTransform(transform::Exp, output);  // output contains exponents temporarily
-    auto sumAlongDim = output.reduceAlongDimension(reduce::Sum, {dimension}, true);
-    output /= sumAlongDim;
-    output.applyTransform(transform::Log, output);
-  }
-}
-
 BUILD_SINGLE_TEMPLATE(template void thresholdReluDerivative_,
                       (sd::LaunchContext * context, NDArray* input, double threshold, NDArray* dLdO, NDArray* output),
                       SD_FLOAT_TYPES);
@@ -237,9 +172,6 @@ BUILD_SINGLE_TEMPLATE(template void logSoftMaxForVector_,
                       (void const* input, sd::LongType const* inShapeInfo, void* output,
                        sd::LongType const* outShapeInfo),
                       SD_FLOAT_TYPES);
-BUILD_SINGLE_TEMPLATE(template void _softMaxDerivForVector,
-                      (sd::LaunchContext * context, const void* input, const sd::LongType* inShapeInfo, void* output),
-                      SD_FLOAT_TYPES);
 
 }  // namespace helpers
 }  // namespace ops
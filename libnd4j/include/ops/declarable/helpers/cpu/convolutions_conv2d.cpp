@@ -62,6 +62,16 @@ static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArr
 
   sd_debug("ONEDNN is not used for conv2d!\n", 0);
 
+  auto algorithm =
+      ConvolutionUtils::conv2dAlgorithm({input, weights, bias, output}, iC, oC, oH, oW, kH, kW, sH, sW, dH, dW);
+  if (algorithm != CONV2D_IM2COL) {
+    ConvolutionUtils::conv2dNative(algorithm, input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat);
+
+    if (bias) helpers::addBias(block, *output, *bias, *output, isNCHW);
+
+    return;
+  }
+
   std::vector<sd::LongType> permutForOutput;
 
   if (isNCHW)
@@ -66,14 +66,28 @@ static void conv2dBP_(sd::graph::Context& block, const NDArray* input, const NDA
 
   sd_debug("MKL-DNN is not used for conv2d_bp!\n", 0);
 
-  std::vector<sd::LongType > gradOaxesForDot;
+  std::vector<sd::LongType> gradOaxesForDot = isNCHW ? std::vector<sd::LongType>{0, 2, 3}   // bS, oH, oW
+                                                     : std::vector<sd::LongType>{0, 1, 2};  // bS, oH, oW
+
+  // ----- calculation of gradB ----- //
+  if (gradB) {
+    NDArray* gradBR = gradB;
+    if (gradB->rankOf() == 2) gradBR = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}));
+    gradO->reduceAlongDimension(reduce::Sum, *gradBR, gradOaxesForDot);  // sum over bS, oH, oW
+    if (gradBR != gradB) delete gradBR;
+  }
+
+  auto algorithm = ConvolutionUtils::conv2dAlgorithm({input, weights, gradO, gradI, gradW}, iC, oC, oH, oW, kH, kW, sH,
+                                                     sW, dH, dW);
+  if (algorithm != CONV2D_IM2COL) {
+    ConvolutionUtils::conv2dBPNative(algorithm, input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW,
+                                     isNCHW, wFormat);
+    return;
+  }
 
   if (!isNCHW) {
-    gradOaxesForDot = {0, 1, 2};                        // bS, oH, oW
     input = new NDArray(input->permute({0, 3, 1, 2}));  // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
     gradI = new NDArray(gradI->permute({0, 3, 1, 2}));  // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
-  } else {
-    gradOaxesForDot = {0, 2, 3};  // bS, oH, oW
   }
 
   std::vector<sd::LongType> wPermut, colPermut;
@@ -102,14 +116,6 @@ static void conv2dBP_(sd::graph::Context& block, const NDArray* input, const NDA
         wPermut);  // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
   }
 
-  // ----- calculation of gradB ----- //
-  if (gradB) {
-    NDArray* gradBR = gradB;
-    if (gradB->rankOf() == 2) gradBR = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}));
-    gradO->reduceAlongDimension(reduce::Sum, *gradBR, gradOaxesForDot);  // sum over bS, oH, oW
-    if (gradBR != gradB) delete gradBR;
-  }
-
   //----- calculation of gradI -----//
   // [kH, kW, iC, oC] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [kH, kW, iC, bS, oH, oW]
   // [oC, iC, kH, kW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, bS, oH, oW]
@@ -0,0 +1,850 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Native conv2d engine: direct, implicit gemm and Winograd kernels, none of them builds im2col columns
+//
+#include <execution/Threads.h>
+#include <ops/declarable/helpers/convolutions.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace sd {
+namespace ops {
+
+// kernels below work on c-ordered NHWC input/output and [kH, kW, iC, oC] weights
+struct ConvGeometry {
+  sd::LongType bS, iH, iW, iC, oH, oW, oC, kH, kW, sH, sW, pH, pW, dH, dW;
+};
+
+// output pixels gathered by single implicit gemm task: columns of the block stay in L2
+static const sd::LongType CONV_PIXEL_BLOCK = 32;
+
+// Winograd F(m x m, 3 x 3) transforms, alpha = m + 2: Y = AT * [(G * g * GT) . (BT * d * B)] * A
+static const double WINOGRAD_2X2_BT[] = {1, 0, -1, 0, 0, 1, 1, 0, 0, -1, 1, 0, 0, 1, 0, -1};
+static const double WINOGRAD_2X2_G[] = {1, 0, 0, 0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0, 0, 1};
+static const double WINOGRAD_2X2_AT[] = {1, 1, 1, 0, 0, 1, -1, -1};
+
+static const double WINOGRAD_4X4_BT[] = {4, 0, -5, 0, 1, 0, 0, -4, -4, 1, 1, 0, 0, 4, -4, -1, 1, 0,
+                                         0, -2, -1, 2, 1, 0, 0, 2, -1, -2, 1, 0, 0, 4, 0, -5, 0, 1};
+static const double WINOGRAD_4X4_G[] = {1. / 4,  0,       0,      -1. / 6, -1. / 6, -1. / 6, -1. / 6, 1. / 6, -1. / 6,
+                                        1. / 24, 1. / 12, 1. / 6, 1. / 24, -1. / 12, 1. / 6, 0,       0,      1};
+static const double WINOGRAD_4X4_AT[] = {1, 1, 1, 1, 1, 0, 0, 1, -1, 2, -2, 0, 0, 1, 1, 4, 4, 0, 0, 1, -1, 8, -8, 1};
+
+// permutation turning weights of given format into [kH, kW, iC, oC], depthwise [kH, kW, iC, mC] as well
+static std::vector<sd::LongType> convWeightsPermutation(const int wFormat) {
+  if (0 == wFormat) return {0, 1, 2, 3};
+
+  if (1 == wFormat) return {2, 3, 1, 0};  // [oC, iC, kH, kW]
+
+  return {1, 2, 3, 0};  // [oC, kH, kW, iC]
+}
+
+static std::vector<sd::LongType> convImagePermutation(const int isNCHW) {
+  if (isNCHW) return {0, 2, 3, 1};
+
+  return {0, 1, 2, 3};
+}
+
+static bool isConvLayout(const NDArray* array, const std::vector<sd::LongType>& permutation) {
+  for (int e = 0; e < (int)permutation.size(); e++)
+    if (permutation[e] != e) return false;
+
+  return array->ordering() == 'c' && array->ews() == 1;
+}
+
+// c-ordered buffer of permuted array, copy is made only if array isn't laid out this way already
+template <typename T>
+static const T* convBuffer(const NDArray* array, const std::vector<sd::LongType>& permutation, NDArray& copy) {
+  if (isConvLayout(array, permutation)) return array->bufferAsT<T>();
+
+  copy = array->permute(permutation).dup('c');
+  return copy.bufferAsT<T>();
+}
+
+// c-ordered buffer to write permuted array into, convStore() copies temporary buffer back if one was needed
+template <typename T>
+static T* convTarget(NDArray* array, const std::vector<sd::LongType>& permutation, NDArray& temp) {
+  if (isConvLayout(array, permutation)) return array->bufferAsT<T>();
+
+  std::vector<sd::LongType> shape(permutation.size());
+  for (int e = 0; e < (int)permutation.size(); e++) shape[e] = array->sizeAt(permutation[e]);
+
+  temp = NDArray('c', shape, array->dataType(), array->getContext());
+  return temp.bufferAsT<T>();
+}
+
+static void convStore(NDArray* array, const std::vector<sd::LongType>& permutation, NDArray& temp) {
+  if (!isConvLayout(array, permutation)) array->permute(permutation).assign(temp);
+}
+
+static ConvGeometry convGeometry(const NDArray* input, const NDArray* output, const sd::LongType iC,
+                                 const sd::LongType oC, const int isNCHW, const int kH, const int kW, const int sH,
+                                 const int sW, const int pH, const int pW, const int dH, const int dW) {
+  auto permutation = convImagePermutation(isNCHW);
+
+  ConvGeometry g;
+  g.bS = input->sizeAt(0);
+  g.iH = input->sizeAt(permutation[1]);
+  g.iW = input->sizeAt(permutation[2]);
+  g.iC = iC;
+  g.oH = output->sizeAt(permutation[1]);
+  g.oW = output->sizeAt(permutation[2]);
+  g.oC = oC;
+  g.kH = kH;
+  g.kW = kW;
+  g.sH = sH;
+  g.sW = sW;
+  g.pH = pH;
+  g.pW = pW;
+  g.dH = dH;
+  g.dW = dW;
+  return g;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// C[M, N] = A[M, K] * B[K, N], with MR x NR block of C kept in registers
+template <typename T>
+static void convGemm(const sd::LongType M, const sd::LongType N, const sd::LongType K, const T* A,
+                     const sd::LongType lda, const T* B, const sd::LongType ldb, T* C, const sd::LongType ldc) {
+  constexpr int MR = 4;
+  constexpr int NR = sizeof(T) >= 8 ? 8 : 16;
+
+  for (sd::LongType i = 0; i < M; i += MR) {
+    const auto mr = sd::math::sd_min<sd::LongType>(MR, M - i);
+
+    for (sd::LongType j = 0; j < N; j += NR) {
+      const auto nr = sd::math::sd_min<sd::LongType>(NR, N - j);
+      T acc[MR][NR] = {};
+
+      if (mr == MR && nr == NR) {
+        for (sd::LongType k = 0; k < K; k++) {
+          auto b = B + k * ldb + j;
+          for (int r = 0; r < MR; r++) {
+            const T a = A[(i + r) * lda + k];
+            PRAGMA_OMP_SIMD
+            for (int c = 0; c < NR; c++) acc[r][c] += a * b[c];
+          }
+        }
+      } else {
+        for (sd::LongType k = 0; k < K; k++) {
+          auto b = B + k * ldb + j;
+          for (int r = 0; r < mr; r++) {
+            const T a = A[(i + r) * lda + k];
+            for (int c = 0; c < nr; c++) acc[r][c] += a * b[c];
+          }
+        }
+      }
+
+      for (int r = 0; r < mr; r++)
+        for (int c = 0; c < nr; c++) C[(i + r) * ldc + j + c] = acc[r][c];
+    }
+  }
+}
+
+// rows of [kH * kW * iC] input patches for np output pixels starting from p0, padding is filled with zeros
+template <typename T>
+static void convGatherPatches(const T* x, const ConvGeometry& g, const sd::LongType p0, const sd::LongType np,
+                              T* patches) {
+  const auto K = g.kH * g.kW * g.iC;
+  const auto pixels = g.oH * g.oW;
+
+  for (sd::LongType p = 0; p < np; p++) {
+    const auto b = (p0 + p) / pixels;
+    const auto oh = ((p0 + p) % pixels) / g.oW;
+    const auto ow = (p0 + p) % g.oW;
+
+    for (sd::LongType kh = 0; kh < g.kH; kh++) {
+      const auto ih = oh * g.sH - g.pH + kh * g.dH;
+
+      for (sd::LongType kw = 0; kw < g.kW; kw++) {
+        const auto iw = ow * g.sW - g.pW + kw * g.dW;
+        auto dst = patches + p * K + (kh * g.kW + kw) * g.iC;
+
+        if (ih < 0 || ih >= g.iH || iw < 0 || iw >= g.iW)
+          std::fill(dst, dst + g.iC, static_cast<T>(0));
+        else
+          memcpy(dst, x + ((b * g.iH + ih) * g.iW + iw) * g.iC, g.iC * sizeof(T));
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// every output pixel accumulates rows of weights scaled by its input pixels, vectorized over output channels
+template <typename T>
+static void conv2dDirect(const T* x, const T* w, T* z, const ConvGeometry& g) {
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto row = start; row < stop; row++) {
+      const auto b = row / g.oH;
+      const auto oh = row % g.oH;
+
+      for (sd::LongType ow = 0; ow < g.oW; ow++) {
+        auto zp = z + (row * g.oW + ow) * g.oC;
+        std::fill(zp, zp + g.oC, static_cast<T>(0));
+
+        for (sd::LongType kh = 0; kh < g.kH; kh++) {
+          const auto ih = oh * g.sH - g.pH + kh * g.dH;
+          if (ih < 0 || ih >= g.iH) continue;
+
+          for (sd::LongType kw = 0; kw < g.kW; kw++) {
+            const auto iw = ow * g.sW - g.pW + kw * g.dW;
+            if (iw < 0 || iw >= g.iW) continue;
+
+            auto xp = x + ((b * g.iH + ih) * g.iW + iw) * g.iC;
+            auto wp = w + (kh * g.kW + kw) * g.iC * g.oC;
+
+            for (sd::LongType c = 0; c < g.iC; c++) {
+              const T a = xp[c];
+              auto wr = wp + c * g.oC;
+              PRAGMA_OMP_SIMD
+              for (sd::LongType o = 0; o < g.oC; o++) zp[o] += a * wr[o];
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, g.bS * g.oH);
+}
+
+// patches of a pixel block are gathered into thread-local buffer and multiplied by weights right away
+template <typename T>
+static void conv2dImplicitGemm(const T* x, const T* w, T* z, const ConvGeometry& g) {
+  const auto K = g.kH * g.kW * g.iC;
+  const auto numPixels = g.bS * g.oH * g.oW;
+  const auto numBlocks = (numPixels + CONV_PIXEL_BLOCK - 1) / CONV_PIXEL_BLOCK;
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<T> patches(CONV_PIXEL_BLOCK * K);
+
+    for (auto block = start; block < stop; block++) {
+      const auto p0 = block * CONV_PIXEL_BLOCK;
+      const auto np = sd::math::sd_min<sd::LongType>(CONV_PIXEL_BLOCK, numPixels - p0);
+
+      convGatherPatches<T>(x, g, p0, np, patches.data());
+      convGemm<T>(np, g.oC, K, patches.data(), K, w, g.oC, z + p0 * g.oC, g.oC);
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numBlocks);
+}
+
+// 3x3 kernel, unit strides and dilations: every m x m output tile costs (m + 2)^2 products instead of 9 * m^2
+template <typename T>
+static void conv2dWinograd(const T* x, const T* w, T* z, const ConvGeometry& g, const int m) {
+  const int a = m + 2;
+  const sd::LongType aa = a * a;
+  const auto iC = g.iC;
+  const auto oC = g.oC;
+
+  T bt[36], gt[18], at[24];
+  for (int e = 0; e < a * a; e++) bt[e] = static_cast<T>(m == 2 ? WINOGRAD_2X2_BT[e] : WINOGRAD_4X4_BT[e]);
+  for (int e = 0; e < a * 3; e++) gt[e] = static_cast<T>(m == 2 ? WINOGRAD_2X2_G[e] : WINOGRAD_4X4_G[e]);
+  for (int e = 0; e < m * a; e++) at[e] = static_cast<T>(m == 2 ? WINOGRAD_2X2_AT[e] : WINOGRAD_4X4_AT[e]);
+
+  // transformed weights U = G * g * GT, [a * a, iC, oC]
+  std::vector<T> U(aa * iC * oC);
+  auto funcU = PRAGMA_THREADS_FOR {
+    std::vector<T> tmp(a * 3 * oC);
+
+    for (auto c = start; c < stop; c++) {
+      for (int r = 0; r < a; r++) {
+        for (int j = 0; j < 3; j++) {
+          auto t = tmp.data() + (r * 3 + j) * oC;
+          std::fill(t, t + oC, static_cast<T>(0));
+
+          for (int i = 0; i < 3; i++) {
+            const T coef = gt[r * 3 + i];
+            if (coef == static_cast<T>(0)) continue;
+
+            auto wr = w + ((i * 3 + j) * iC + c) * oC;
+            PRAGMA_OMP_SIMD
+            for (sd::LongType o = 0; o < oC; o++) t[o] += coef * wr[o];
+          }
+        }
+
+        for (int s = 0; s < a; s++) {
+          auto u = U.data() + ((r * a + s) * iC + c) * oC;
+          std::fill(u, u + oC, static_cast<T>(0));
+
+          for (int j = 0; j < 3; j++) {
+            const T coef = gt[s * 3 + j];
+            if (coef == static_cast<T>(0)) continue;
+
+            auto t = tmp.data() + (r * 3 + j) * oC;
+            PRAGMA_OMP_SIMD
+            for (sd::LongType o = 0; o < oC; o++) u[o] += coef * t[o];
+          }
+        }
+      }
+    }
+  };
+  samediff::Threads::parallel_for(funcU, 0, iC);
+
+  const auto tilesH = (g.oH + m - 1) / m;
+  const auto tilesW = (g.oW + m - 1) / m;
+  const auto numTiles = g.bS * tilesH * tilesW;
+
+  // tiles transformed at once: V and M buffers of the block should fit into L2
+  const sd::LongType tileBlock =
+      sd::math::sd_max<sd::LongType>(1, sd::math::sd_min<sd::LongType>(64, 65536 / (aa * (iC + oC))));
+  const auto numBlocks = (numTiles + tileBlock - 1) / tileBlock;
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<T> V(aa * tileBlock * iC), M(aa * tileBlock * oC), d(aa * iC);
+    std::vector<T> tmp(aa * sd::math::sd_max<sd::LongType>(iC, oC));
+
+    for (auto block = start; block < stop; block++) {
+      const auto t0 = block * tileBlock;
+      const auto nt = sd::math::sd_min<sd::LongType>(tileBlock, numTiles - t0);
+
+      // input transform V = BT * d * B, vectorized over input channels
+      for (sd::LongType t = 0; t < nt; t++) {
+        const auto b = (t0 + t) / (tilesH * tilesW);
+        const auto ih0 = (((t0 + t) % (tilesH * tilesW)) / tilesW) * m - g.pH;
+        const auto iw0 = ((t0 + t) % tilesW) * m - g.pW;
+
+        for (int r = 0; r < a; r++) {
+          for (int s = 0; s < a; s++) {
+            const auto ih = ih0 + r;
+            const auto iw = iw0 + s;
+            auto dst = d.data() + (r * a + s) * iC;
+
+            if (ih < 0 || ih >= g.iH || iw < 0 || iw >= g.iW)
+              std::fill(dst, dst + iC, static_cast<T>(0));
+            else
+              memcpy(dst, x + ((b * g.iH + ih) * g.iW + iw) * iC, iC * sizeof(T));
+          }
+        }
+
+        for (int r = 0; r < a; r++) {
+          for (int s = 0; s < a; s++) {
+            auto tr = tmp.data() + (r * a + s) * iC;
+            std::fill(tr, tr + iC, static_cast<T>(0));
+
+            for (int i = 0; i < a; i++) {
+              const T coef = bt[r * a + i];
+              if (coef == static_cast<T>(0)) continue;
+
+              auto src = d.data() + (i * a + s) * iC;
+              PRAGMA_OMP_SIMD
+              for (sd::LongType c = 0; c < iC; c++) tr[c] += coef * src[c];
+            }
+          }
+        }
+
+        for (int r = 0; r < a; r++) {
+          for (int s = 0; s < a; s++) {
+            auto v = V.data() + ((r * a + s) * tileBlock + t) * iC;
+            std::fill(v, v + iC, static_cast<T>(0));
+
+            for (int j = 0; j < a; j++) {
+              const T coef = bt[s * a + j];
+              if (coef == static_cast<T>(0)) continue;
+
+              auto src = tmp.data() + (r * a + j) * iC;
+              PRAGMA_OMP_SIMD
+              for (sd::LongType c = 0; c < iC; c++) v[c] += coef * src[c];
+            }
+          }
+        }
+      }
+
+      // elementwise products of transforms are a * a independent gemms over channels
+      for (sd::LongType xi = 0; xi < aa; xi++)
+        convGemm<T>(nt, oC, iC, V.data() + xi * tileBlock * iC, iC, U.data() + xi * iC * oC, oC,
+                    M.data() + xi * tileBlock * oC, oC);
+
+      // output transform Y = AT * M * A, tiles crossing output border are cropped
+      for (sd::LongType t = 0; t < nt; t++) {
+        const auto b = (t0 + t) / (tilesH * tilesW);
+        const auto oh0 = (((t0 + t) % (tilesH * tilesW)) / tilesW) * m;
+        const auto ow0 = ((t0 + t) % tilesW) * m;
+
+        for (int r = 0; r < m; r++) {
+          for (int s = 0; s < a; s++) {
+            auto tr = tmp.data() + (r * a + s) * oC;
+            std::fill(tr, tr + oC, static_cast<T>(0));
+
+            for (int i = 0; i < a; i++) {
+              const T coef = at[r * a + i];
+              if (coef == static_cast<T>(0)) continue;
+
+              auto src = M.data() + ((i * a + s) * tileBlock + t) * oC;
+              PRAGMA_OMP_SIMD
+              for (sd::LongType o = 0; o < oC; o++) tr[o] += coef * src[o];
+            }
+          }
+        }
+
+        for (int r = 0; r < m && oh0 + r < g.oH; r++) {
+          for (int q = 0; q < m && ow0 + q < g.oW; q++) {
+            auto zp = z + ((b * g.oH + oh0 + r) * g.oW + ow0 + q) * oC;
+            std::fill(zp, zp + oC, static_cast<T>(0));
+
+            for (int j = 0; j < a; j++) {
+              const T coef = at[q * a + j];
+              if (coef == static_cast<T>(0)) continue;
+
+              auto src = tmp.data() + (r * a + j) * oC;
+              PRAGMA_OMP_SIMD
+              for (sd::LongType o = 0; o < oC; o++) zp[o] += coef * src[o];
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numBlocks);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradW = patches^T * gradO: every thread owns disjoint rows of gradW, so no partial sums are needed
+template <typename T>
+static void conv2dGradWeights(const T* x, const T* gO, T* gW, const ConvGeometry& g) {
+  const auto K = g.kH * g.kW * g.iC;
+  const auto numPixels = g.bS * g.oH * g.oW;
+  const auto pixels = g.oH * g.oW;
+
+  auto func = PRAGMA_THREADS_FOR {
+    sd::LongType base[CONV_PIXEL_BLOCK], bh[CONV_PIXEL_BLOCK], bw[CONV_PIXEL_BLOCK];
+
+    std::fill(gW + start * g.oC, gW + stop * g.oC, static_cast<T>(0));
+
+    // block of gradO rows stays in cache while all rows of this thread are updated
+    for (sd::LongType p0 = 0; p0 < numPixels; p0 += CONV_PIXEL_BLOCK) {
+      const auto np = sd::math::sd_min<sd::LongType>(CONV_PIXEL_BLOCK, numPixels - p0);
+
+      for (sd::LongType p = 0; p < np; p++) {
+        base[p] = (p0 + p) / pixels * g.iH * g.iW;
+        bh[p] = ((p0 + p) % pixels) / g.oW * g.sH - g.pH;
+        bw[p] = (p0 + p) % g.oW * g.sW - g.pW;
+      }
+
+      for (auto k = start; k < stop; k++) {
+        const auto kh = k / (g.kW * g.iC);
+        const auto kw = (k / g.iC) % g.kW;
+        const auto c = k % g.iC;
+        auto ar = gW + k * g.oC;
+
+        for (sd::LongType p = 0; p < np; p++) {
+          const auto ih = bh[p] + kh * g.dH;
+          const auto iw = bw[p] + kw * g.dW;
+          if (ih < 0 || ih >= g.iH || iw < 0 || iw >= g.iW) continue;
+
+          const T v = x[(base[p] + ih * g.iW + iw) * g.iC + c];
+          auto gp = gO + (p0 + p) * g.oC;
+          PRAGMA_OMP_SIMD
+          for (sd::LongType o = 0; o < g.oC; o++) ar[o] += v * gp[o];
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, K);
+}
+
+// every input pixel gathers gradients of output pixels it contributed to, so no two threads write the same pixel
+template <typename T>
+static void conv2dGradInput(const T* w, const T* gO, T* gI, const ConvGeometry& g) {
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto row = start; row < stop; row++) {
+      const auto b = row / g.iH;
+      const auto ih = row % g.iH;
+
+      for (sd::LongType iw = 0; iw < g.iW; iw++) {
+        auto gp = gI + (row * g.iW + iw) * g.iC;
+        std::fill(gp, gp + g.iC, static_cast<T>(0));
+
+        for (sd::LongType kh = 0; kh < g.kH; kh++) {
+          const auto th = ih + g.pH - kh * g.dH;
+          if (th < 0 || th % g.sH != 0 || th / g.sH >= g.oH) continue;
+
+          for (sd::LongType kw = 0; kw < g.kW; kw++) {
+            const auto tw = iw + g.pW - kw * g.dW;
+            if (tw < 0 || tw % g.sW != 0 || tw / g.sW >= g.oW) continue;
+
+            auto go = gO + ((b * g.oH + th / g.sH) * g.oW + tw / g.sW) * g.oC;
+            auto wp = w + (kh * g.kW + kw) * g.iC * g.oC;
+
+            for (sd::LongType c = 0; c < g.iC; c++) {
+              auto wr = wp + c * g.oC;
+              T sum = static_cast<T>(0);
+              PRAGMA_OMP_SIMD_SUM(sum)
+              for (sd::LongType o = 0; o < g.oC; o++) sum += wr[o] * go[o];
+              gp[c] += sum;
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, g.bS * g.iH);
+}
+
+// for 3x3 kernel with unit strides gradI is full convolution of gradO with flipped and transposed weights
+template <typename T>
+static void conv2dGradInputWinograd(const T* w, const T* gO, T* gI, const ConvGeometry& g, const int m) {
+  std::vector<T> flipped(9 * g.iC * g.oC);
+  for (sd::LongType kh = 0; kh < 3; kh++)
+    for (sd::LongType kw = 0; kw < 3; kw++)
+      for (sd::LongType c = 0; c < g.iC; c++)
+        for (sd::LongType o = 0; o < g.oC; o++)
+          flipped[((kh * 3 + kw) * g.oC + o) * g.iC + c] = w[(((2 - kh) * 3 + (2 - kw)) * g.iC + c) * g.oC + o];
+
+  ConvGeometry t = g;
+  t.iH = g.oH;
+  t.iW = g.oW;
+  t.iC = g.oC;
+  t.oH = g.iH;
+  t.oW = g.iW;
+  t.oC = g.iC;
+  t.pH = g.kH - 1 - g.pH;
+  t.pW = g.kW - 1 - g.pW;
+
+  conv2dWinograd<T>(gO, flipped.data(), gI, t, m);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// depthwise weights [kH, kW, iC, mC]: output channel c * mC + j only depends on input channel c
+template <typename T>
+static void depthwiseConv2dDirect(const T* x, const T* w, T* z, const ConvGeometry& g) {
+  const auto mC = g.oC / g.iC;
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto row = start; row < stop; row++) {
+      const auto b = row / g.oH;
+      const auto oh = row % g.oH;
+
+      for (sd::LongType ow = 0; ow < g.oW; ow++) {
+        auto zp = z + (row * g.oW + ow) * g.oC;
+        std::fill(zp, zp + g.oC, static_cast<T>(0));
+
+        for (sd::LongType kh = 0; kh < g.kH; kh++) {
+          const auto ih = oh * g.sH - g.pH + kh * g.dH;
+          if (ih < 0 || ih >= g.iH) continue;
+
+          for (sd::LongType kw = 0; kw < g.kW; kw++) {
+            const auto iw = ow * g.sW - g.pW + kw * g.dW;
+            if (iw < 0 || iw >= g.iW) continue;
+
+            auto xp = x + ((b * g.iH + ih) * g.iW + iw) * g.iC;
+            auto wp = w + (kh * g.kW + kw) * g.oC;
+
+            if (mC == 1) {
+              PRAGMA_OMP_SIMD
+              for (sd::LongType c = 0; c < g.iC; c++) zp[c] += xp[c] * wp[c];
+            } else {
+              for (sd::LongType c = 0; c < g.iC; c++)
+                for (sd::LongType j = 0; j < mC; j++) zp[c * mC + j] += xp[c] * wp[c * mC + j];
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, g.bS * g.oH);
+}
+
+template <typename T>
+static void depthwiseConv2dGradWeights(const T* x, const T* gO, T* gW, const ConvGeometry& g) {
+  const auto mC = g.oC / g.iC;
+  const auto numRows = g.bS * g.oH;
+  const auto length = g.kH * g.kW * g.oC;
+  const auto numChunks = sd::math::sd_max<sd::LongType>(
+      1, sd::math::sd_min<sd::LongType>(sd::Environment::getInstance().maxMasterThreads(), numRows));
+
+  std::vector<T> partials(numChunks * length, static_cast<T>(0));
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto chunk = start; chunk < stop; chunk++) {
+      auto acc = partials.data() + chunk * length;
+
+      for (auto row = chunk * numRows / numChunks; row < (chunk + 1) * numRows / numChunks; row++) {
+        const auto b = row / g.oH;
+        const auto oh = row % g.oH;
+
+        for (sd::LongType ow = 0; ow < g.oW; ow++) {
+          auto gp = gO + (row * g.oW + ow) * g.oC;
+
+          for (sd::LongType kh = 0; kh < g.kH; kh++) {
+            const auto ih = oh * g.sH - g.pH + kh * g.dH;
+            if (ih < 0 || ih >= g.iH) continue;
+
+            for (sd::LongType kw = 0; kw < g.kW; kw++) {
+              const auto iw = ow * g.sW - g.pW + kw * g.dW;
+              if (iw < 0 || iw >= g.iW) continue;
+
+              auto xp = x + ((b * g.iH + ih) * g.iW + iw) * g.iC;
+              auto ap = acc + (kh * g.kW + kw) * g.oC;
+
+              for (sd::LongType c = 0; c < g.iC; c++)
+                for (sd::LongType j = 0; j < mC; j++) ap[c * mC + j] += xp[c] * gp[c * mC + j];
+            }
+          }
+        }
+      }
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, numChunks);
+
+  auto funcSum = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      T sum = static_cast<T>(0);
+      for (sd::LongType chunk = 0; chunk < numChunks; chunk++) sum += partials[chunk * length + e];
+      gW[e] = sum;
+    }
+  };
+  samediff::Threads::parallel_for(funcSum, 0, length);
+}
+
+template <typename T>
+static void depthwiseConv2dGradInput(const T* w, const T* gO, T* gI, const ConvGeometry& g) {
+  const auto mC = g.oC / g.iC;
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto row = start; row < stop; row++) {
+      const auto b = row / g.iH;
+      const auto ih = row % g.iH;
+
+      for (sd::LongType iw = 0; iw < g.iW; iw++) {
+        auto gp = gI + (row * g.iW + iw) * g.iC;
+        std::fill(gp, gp + g.iC, static_cast<T>(0));
+
+        for (sd::LongType kh = 0; kh < g.kH; kh++) {
+          const auto th = ih + g.pH - kh * g.dH;
+          if (th < 0 || th % g.sH != 0 || th / g.sH >= g.oH) continue;
+
+          for (sd::LongType kw = 0; kw < g.kW; kw++) {
+            const auto tw = iw + g.pW - kw * g.dW;
+            if (tw < 0 || tw % g.sW != 0 || tw / g.sW >= g.oW) continue;
+
+            auto go = gO + ((b * g.oH + th / g.sH) * g.oW + tw / g.sW) * g.oC;
+            auto wp = w + (kh * g.kW + kw) * g.oC;
+
+            for (sd::LongType c = 0; c < g.iC; c++) {
+              T sum = static_cast<T>(0);
+              for (sd::LongType j = 0; j < mC; j++) sum += wp[c * mC + j] * go[c * mC + j];
+              gp[c] += sum;
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, g.bS * g.iH);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv2dNative_(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                          NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH,
+                          const int pW, const int dH, const int dW, const int isNCHW, const int wFormat) {
+  const auto imagePermutation = convImagePermutation(isNCHW);
+  const auto weightsPermutation = convWeightsPermutation(wFormat);
+  const auto g = convGeometry(input, output, weights->sizeAt(weightsPermutation[2]),
+                              weights->sizeAt(weightsPermutation[3]), isNCHW, kH, kW, sH, sW, pH, pW, dH, dW);
+
+  NDArray xCopy, wCopy, zTemp;
+  auto x = convBuffer<T>(input, imagePermutation, xCopy);
+  auto w = convBuffer<T>(weights, weightsPermutation, wCopy);
+  auto z = convTarget<T>(output, imagePermutation, zTemp);
+
+  switch (algorithm) {
+    case CONV2D_DIRECT:
+      conv2dDirect<T>(x, w, z, g);
+      break;
+    case CONV2D_WINOGRAD_2X2:
+      conv2dWinograd<T>(x, w, z, g, 2);
+      break;
+    case CONV2D_WINOGRAD_4X4:
+      conv2dWinograd<T>(x, w, z, g, 4);
+      break;
+    default:
+      conv2dImplicitGemm<T>(x, w, z, g);
+      break;
+  }
+
+  convStore(output, imagePermutation, zTemp);
+}
+
+template <typename T>
+static void conv2dBPNative_(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                            const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW,
+                            const int sH, const int sW, const int pH, const int pW, const int dH, const int dW,
+                            const int isNCHW, const int wFormat) {
+  const auto imagePermutation = convImagePermutation(isNCHW);
+  const auto weightsPermutation = convWeightsPermutation(wFormat);
+  const auto g = convGeometry(input, gradO, weights->sizeAt(weightsPermutation[2]),
+                              weights->sizeAt(weightsPermutation[3]), isNCHW, kH, kW, sH, sW, pH, pW, dH, dW);
+
+  NDArray gCopy;
+  auto gO = convBuffer<T>(gradO, imagePermutation, gCopy);
+
+  if (gradW != nullptr) {
+    NDArray xCopy, gWTemp;
+    auto x = convBuffer<T>(input, imagePermutation, xCopy);
+    auto gW = convTarget<T>(gradW, weightsPermutation, gWTemp);
+
+    conv2dGradWeights<T>(x, gO, gW, g);
+
+    convStore(gradW, weightsPermutation, gWTemp);
+  }
+
+  if (gradI != nullptr) {
+    NDArray wCopy, gITemp;
+    auto w = convBuffer<T>(weights, weightsPermutation, wCopy);
+    auto gI = convTarget<T>(gradI, imagePermutation, gITemp);
+
+    if (algorithm == CONV2D_WINOGRAD_2X2 || algorithm == CONV2D_WINOGRAD_4X4)
+      conv2dGradInputWinograd<T>(w, gO, gI, g, algorithm == CONV2D_WINOGRAD_2X2 ? 2 : 4);
+    else
+      conv2dGradInput<T>(w, gO, gI, g);
+
+    convStore(gradI, imagePermutation, gITemp);
+  }
+}
+
+template <typename T>
+static void depthwiseConv2dNative_(const NDArray* input, const NDArray* weights, NDArray* output, const int kH,
+                                   const int kW, const int sH, const int sW, const int pH, const int pW, const int dH,
+                                   const int dW, const int isNCHW, const int wFormat) {
+  const auto imagePermutation = convImagePermutation(isNCHW);
+  const auto weightsPermutation = convWeightsPermutation(wFormat);
+  const auto iC = weights->sizeAt(weightsPermutation[2]);
+  const auto g = convGeometry(input, output, iC, iC * weights->sizeAt(weightsPermutation[3]), isNCHW, kH, kW, sH, sW,
+                              pH, pW, dH, dW);
+
+  NDArray xCopy, wCopy, zTemp;
+  auto x = convBuffer<T>(input, imagePermutation, xCopy);
+  auto w = convBuffer<T>(weights, weightsPermutation, wCopy);
+  auto z = convTarget<T>(output, imagePermutation, zTemp);
+
+  depthwiseConv2dDirect<T>(x, w, z, g);
+
+  convStore(output, imagePermutation, zTemp);
+}
+
+template <typename T>
+static void depthwiseConv2dBPNative_(const NDArray* input, const NDArray* weights, const NDArray* gradO,
+                                     NDArray* gradI, NDArray* gradW, const int kH, const int kW, const int sH,
+                                     const int sW, const int pH, const int pW, const int dH, const int dW,
+                                     const int isNCHW, const int wFormat) {
+  const auto imagePermutation = convImagePermutation(isNCHW);
+  const auto weightsPermutation = convWeightsPermutation(wFormat);
+  const auto iC = weights->sizeAt(weightsPermutation[2]);
+  const auto g = convGeometry(input, gradO, iC, iC * weights->sizeAt(weightsPermutation[3]), isNCHW, kH, kW, sH, sW,
+                              pH, pW, dH, dW);
+
+  NDArray gCopy;
+  auto gO = convBuffer<T>(gradO, imagePermutation, gCopy);
+
+  if (gradW != nullptr) {
+    NDArray xCopy, gWTemp;
+    auto x = convBuffer<T>(input, imagePermutation, xCopy);
+    auto gW = convTarget<T>(gradW, weightsPermutation, gWTemp);
+
+    depthwiseConv2dGradWeights<T>(x, gO, gW, g);
+
+    convStore(gradW, weightsPermutation, gWTemp);
+  }
+
+  if (gradI != nullptr) {
+    NDArray wCopy, gITemp;
+    auto w = convBuffer<T>(weights, weightsPermutation, wCopy);
+    auto gI = convTarget<T>(gradI, imagePermutation, gITemp);
+
+    depthwiseConv2dGradInput<T>(w, gO, gI, g);
+
+    convStore(gradI, imagePermutation, gITemp);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ConvolutionUtils::isNativeConvApplicable(const std::vector<const NDArray*>& arrays) {
+  const auto dtype = arrays[0]->dataType();
+  if (dtype != sd::DataType::FLOAT32 && dtype != sd::DataType::DOUBLE) return false;
+
+  for (auto array : arrays)
+    if (array != nullptr && (array->dataType() != dtype || array->isEmpty())) return false;
+
+  return true;
+}
+
+Conv2dAlgorithm ConvolutionUtils::conv2dAlgorithm(const std::vector<const NDArray*>& arrays, const int iC,
+                                                  const int oC, const int oH, const int oW, const int kH, const int kW,
+                                                  const int sH, const int sW, const int dH, const int dW) {
+  if (!isNativeConvApplicable(arrays)) return CONV2D_IM2COL;
+
+  // transforms pay off only if there are enough channels to amortize them over
+  if (kH == 3 && kW == 3 && sH == 1 && sW == 1 && dH == 1 && dW == 1 && iC >= 16 && oC >= 16)
+    return oH >= 8 && oW >= 8 ? CONV2D_WINOGRAD_4X4 : CONV2D_WINOGRAD_2X2;
+
+  // too few input channels to block gemm over them
+  if (iC <= 4) return CONV2D_DIRECT;
+
+  return CONV2D_IMPLICIT_GEMM;
+}
+
+void ConvolutionUtils::conv2dNative(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                                    NDArray* output, const int kH, const int kW, const int sH, const int sW,
+                                    const int pH, const int pW, const int dH, const int dW, const int isNCHW,
+                                    const int wFormat) {
+  BUILD_SINGLE_SELECTOR(input->dataType(), conv2dNative_,
+                        (algorithm, input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat),
+                        SD_FLOAT_TYPES);
+}
+
+void ConvolutionUtils::conv2dBPNative(const Conv2dAlgorithm algorithm, const NDArray* input, const NDArray* weights,
+                                      const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW,
+                                      const int sH, const int sW, const int pH, const int pW, const int dH,
+                                      const int dW, const int isNCHW, const int wFormat) {
+  BUILD_SINGLE_SELECTOR(
+      input->dataType(), conv2dBPNative_,
+      (algorithm, input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat),
+      SD_FLOAT_TYPES);
+}
+
+void ConvolutionUtils::depthwiseConv2dNative(const NDArray* input, const NDArray* weights, NDArray* output,
+                                             const int kH, const int kW, const int sH, const int sW, const int pH,
+                                             const int pW, const int dH, const int dW, const int isNCHW,
+                                             const int wFormat) {
+  BUILD_SINGLE_SELECTOR(input->dataType(), depthwiseConv2dNative_,
+                        (input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat), SD_FLOAT_TYPES);
+}
+
+void ConvolutionUtils::depthwiseConv2dBPNative(const NDArray* input, const NDArray* weights, const NDArray* gradO,
+                                               NDArray* gradI, NDArray* gradW, const int kH, const int kW,
+                                               const int sH, const int sW, const int pH, const int pW, const int dH,
+                                               const int dW, const int isNCHW, const int wFormat) {
+  BUILD_SINGLE_SELECTOR(input->dataType(), depthwiseConv2dBPNative_,
+                        (input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat),
+                        SD_FLOAT_TYPES);
+}
+
+}  // namespace ops
+}  // namespace sd
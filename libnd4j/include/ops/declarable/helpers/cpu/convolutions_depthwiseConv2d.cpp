@@ -59,6 +59,17 @@ static void depthwiseConv2d_(sd::graph::Context& block, const NDArray* input, co
                                              indIiH, indWiC, indWmC, indWkH, indOoH);
   mC = weights->sizeAt(indWmC);  // channels multiplier
 
+  if (paddingMode == 1)  // SAME
+    ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+  if (ConvolutionUtils::isNativeConvApplicable({input, weights, bias, output})) {
+    ConvolutionUtils::depthwiseConv2dNative(input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat);
+
+    if (bias) helpers::addBias(block, *output, *bias, *output, isNCHW);
+
+    return;
+  }
+
   std::vector<std::vector<sd::LongType>> modifColumns = {
       {1, 0, 4, 5, 2, 3},
       {iC, bS * oH * oW, kH * kW}};  // [bS,iC,kH,kW,oH,oW] -> [iC,bS,oH,oW,kH,kW] -> [iC,bS*oH*oW,kH*kW]
@@ -83,9 +94,6 @@ static void depthwiseConv2d_(sd::graph::Context& block, const NDArray* input, co
   else
     modifWeights = {{3, 1, 2, 0}, {iC, kH * kW, mC}};
 
-  if (paddingMode == 1)  // SAME
-    ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
   NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getContext());
   NDArray outputReshaped = output->reshape(output->ordering(), outReShape, false);
 
@@ -61,6 +61,24 @@ static void depthwiseConv2dBP_(const NDArray* input, const NDArray* weights, con
                                              indIiH, indWiC, indWmC, indWkH, indOoH);
   mC = weights->sizeAt(indWmC);  // channels multiplier
 
+  if (paddingMode == 1)  // SAME
+    ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+  // ----- calculation of gradB ----- //
+  if (gradB) {
+    NDArray* gradBR = gradB;
+    if (gradB->rankOf() == 2) gradBR = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}, false));
+    gradO->reduceAlongDimension(reduce::Sum, *gradBR, {0, indOoH, indOoH + 1});  // sum over bS, oH, oW
+
+    if (gradBR != gradB) delete gradBR;
+  }
+
+  if (ConvolutionUtils::isNativeConvApplicable({input, weights, gradO, gradI, gradW})) {
+    ConvolutionUtils::depthwiseConv2dBPNative(input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW,
+                                              isNCHW, wFormat);
+    return;
+  }
+
   std::vector<std::vector<sd::LongType>> modifColumns = {
       {1, 2, 3, 0, 4, 5}, {iC, kH * kW, bS * oH * oW}};  // [bS,iC,kH,kW,oH,oW] -> [iC, kH*kW, bS*oH*oW]
   std::vector<std::vector<sd::LongType>> modifGradO1, modifGradO2, modifWeights;
@@ -87,9 +105,6 @@ static void depthwiseConv2dBP_(const NDArray* input, const NDArray* weights, con
   else
     modifWeights = {{3, 1, 2, 0}, {iC, kH * kW, mC}};
 
-  if (paddingMode == 1)  // SAME
-    ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
   NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getContext());
   NDArray gradOreshaped = gradO->reshape(gradO->ordering(), gradOreShape);
 
@@ -101,15 +116,6 @@ static void depthwiseConv2dBP_(const NDArray* input, const NDArray* weights, con
   sd::MmulHelper::tensorDot(&columns, &gradOreshaped, gradW, modifColumns, modifGradO1,
                             modifWeights);  // [iC, kW*kH, bS*oH*oW] x [iC, bS*oH*oW, mC] = [iC, kH*kW, mC]
 
-  // ----- calculation of gradB ----- //
-  if (gradB) {
-    NDArray* gradBR = gradB;
-    if (gradB->rankOf() == 2) gradBR = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}, false));
-    gradO->reduceAlongDimension(reduce::Sum, *gradBR, {0, indOoH, indOoH + 1});  // sum over bS, oH, oW
-
-    if (gradBR != gradB) delete gradBR;
-  }
-
   //----- calculation of gradI -----//
   sd::MmulHelper::tensorDot(weights, gradO, &columns, modifWeights, modifGradO2,
                             modifColumns);  // [iC, kH*kW, mC] x [iC, mC, bS*oH*oW] = [iC, kW*kH, bS*oH*oW]
@@ -35,6 +35,27 @@ static void dropoutSimple(NDArray const* input, NDArray* output, double probValu
   sd::graph::RandomGenerator nodeRng(3019L, seed);
   int inLen = input->lengthOf();
 
+  if (input->ews() == 1 && output->ews() == 1 && input->ordering() == 'c' && output->ordering() == 'c' &&
+      input->dataType() == DataTypeUtils::fromT<T>() && output->dataType() == DataTypeUtils::fromT<T>()) {
+    auto x = input->bufferAsT<T>();
+    auto z = output->bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+      T randVal[sd::graph::RandomGenerator::BLOCK_LENGTH];
+
+      for (auto b = start; b < stop; b += sd::graph::RandomGenerator::BLOCK_LENGTH) {
+        auto n = sd::math::sd_min<sd::LongType>(sd::graph::RandomGenerator::BLOCK_LENGTH, stop - b);
+        nodeRng.relativeBlock<T>(b, n, randVal, T(0.f), T(1.f));
+
+        for (sd::LongType e = 0; e < n; e++)
+          if (static_cast<float>(randVal[e]) < probValue) z[b + e] = x[b + e];
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, inLen);
+    return;
+  }
+
   auto func = PRAGMA_THREADS_FOR {
     for (auto e = start; e < stop; e++) {
       float val = nodeRng.relativeT<T>(e, T(0.f), T(1.f));
@@ -121,6 +142,30 @@ static sd::Status alphaDropOutFunctor_(graph::Context& context, NDArray* input,
 
   sd::graph::RandomGenerator nodeRng(3019L, seed);
 
+  if (input->ews() == 1 && output->ews() == 1 && input->ordering() == 'c' && output->ordering() == 'c' &&
+      input->dataType() == DataTypeUtils::fromT<T>() && output->dataType() == DataTypeUtils::fromT<T>()) {
+    auto x = input->bufferAsT<T>();
+    auto z = output->bufferAsT<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+      T randVal[sd::graph::RandomGenerator::BLOCK_LENGTH];
+
+      for (auto b = start; b < stop; b += sd::graph::RandomGenerator::BLOCK_LENGTH) {
+        auto n = sd::math::sd_min<sd::LongType>(sd::graph::RandomGenerator::BLOCK_LENGTH, stop - b);
+        nodeRng.relativeBlock<T>(b, n, randVal, T(0.f), T(1.f));
+
+        for (sd::LongType e = 0; e < n; e++) {
+          float xVal = x[b + e];
+          float zVal = static_cast<float>(randVal[e]) >= probValue ? alpha * beta + alpha1 : alpha * xVal + alpha1;
+          z[b + e] = static_cast<T>(zVal);
+        }
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, input->lengthOf());
+    return sd::Status::OK;
+  }
+
   auto func = PRAGMA_THREADS_FOR {
     for (auto e = start; e < stop; e++) {
       float randVal = nodeRng.relativeT(e, T(0.f), T(1.f));
@@ -36,6 +36,7 @@ limitations under the License.
 //  @author sgazeos@gmail.com
 //
 #include <execution/Threads.h>
+#include <helpers/ConstantCache.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <ops/declarable/helpers/image_resize.h>
 
@@ -630,152 +631,322 @@ sd::Status resizeAreaFunctor(sd::LaunchContext* context, NDArray const* image, i
                         (context, image, width, height, alignCorners, output), SD_NUMERIC_TYPES);
 }
 
-static sd::Status computeSpans(IKernelFunc<float>* kernel, sd::LongType const outSize, sd::LongType const inSize,
-                               float const scale, float const translate, bool const antialias, Spans& spans) {
-  // When sampling, we need the inverse scale and translation, to map from an
-  // output to an input pixel.
+// ------------------------------------------------------------------------------------------------------------------ //
+// Separable kernel resize
+//
+// Coefficients depend only on (inSize, outSize, kernel, antialias), so they're computed once per geometry and cached.
+// The image is filtered horizontally into {bS, iH, oW, C} buffer first, then vertically into the output.
+// 8-bit images are filtered with fixed point weights, all the way to the final scaling into output.
+static const int RESIZE_WEIGHT_BITS = 14;
+static const int RESIZE_INTERMEDIATE_SHIFT = 7;
+
+struct ResizePlan {
+  bool valid = true;
+  int spanSize = 0;
+  // output pixel x is the weighted sum of input[starts[x] : starts[x] + lengths[x]]
+  std::vector<int> starts;
+  std::vector<int> lengths;
+  // {outSize, spanSize}, padded with zeros
+  std::vector<float> weights;
+  // same weights scaled by 2^RESIZE_WEIGHT_BITS, every non-empty row sums up to exactly 2^RESIZE_WEIGHT_BITS
+  std::vector<int32_t> fixedWeights;
+};
+
+static void computeResizePlan(IKernelFunc<float>* kernel, sd::LongType const outSize, sd::LongType const inSize,
+                              bool const antialias, ResizePlan& plan) {
+  // When sampling, we need the inverse scale, to map from an output to an input pixel.
+  float const scale = static_cast<float>(outSize) / static_cast<float>(inSize);
   float const invScale = 1.f / scale;
-  float const invTranslate = -invScale * translate;
   // When downsampling the kernel should be scaled since we want to low pass
   // filter and interpolate, but when upsampling it should not be since we only
   // want to interpolate.
   float const kernelScale = antialias ? math::sd_max(invScale, 1.f) : 1.f;
-  spans._spanSize =
+  float const invKernelScale = 1.f / kernelScale;
+  plan.spanSize =
       math::sd_min(2 * static_cast<int>(std::ceil(kernel->radius() * kernelScale)) + 1, static_cast<int>(inSize));
-  spans._starts = NDArrayFactory::create<int>('c', {outSize});
-  spans._weights = NDArrayFactory::create<float>('c', {outSize, spans._spanSize});
-
-  auto startsVec = spans._starts.bufferAsT<int>();
-  auto weightsVector = spans._weights.bufferAsT<float>();
-  spans._weights.nullify();
-
-  const float invKernelScale = 1.f / kernelScale;
-  int maxSpanSize = 0;
-  std::vector<float> tempWeights;
-
-  // return value if within bounds or bounds otherwise
-  auto boundsAmp = [](sd::LongType const low, sd::LongType const high, sd::LongType const value) {
-    if (high < value) return high;
-    if (value < low) return low;
-    return value;
-  };
+  plan.starts.assign(outSize, 0);
+  plan.lengths.assign(outSize, 0);
+  plan.weights.assign(outSize * plan.spanSize, 0.f);
+  plan.fixedWeights.assign(outSize * plan.spanSize, 0);
 
-  for (auto x = 0LL; x < outSize; ++x) {
-    const float columnFloat = x + 0.5f;
-    const float sampleFloat = columnFloat * invScale + invTranslate;
+  for (sd::LongType x = 0; x < outSize; ++x) {
+    const float sampleFloat = (x + 0.5f) * invScale;
 
     // Don't sample when the sampling location is outside the source image.
-    if (sampleFloat < 0 || sampleFloat > inSize) {
-      // Add an empty span.
-      startsVec[x] = 0;
-      continue;
-    }
+    if (sampleFloat < 0 || sampleFloat > inSize) continue;
+
     sd::LongType spanStart = math::sd_ceil<float, float>(sampleFloat - kernel->radius() * kernelScale - 0.5f);
     sd::LongType spanEnd = math::sd_floor<float, float>(sampleFloat + kernel->radius() * kernelScale - 0.5f);
-    spanStart = boundsAmp(0LL, inSize - 1, spanStart);
-    spanEnd = boundsAmp(0LL, inSize - 1, spanEnd) + 1;
+    spanStart = math::sd_min<sd::LongType>(math::sd_max<sd::LongType>(spanStart, 0), inSize - 1);
+    spanEnd = math::sd_min<sd::LongType>(math::sd_max<sd::LongType>(spanEnd, 0), inSize - 1) + 1;
     int const spanSize = spanEnd - spanStart;
-    if (spanSize > spans._spanSize) {
-      return Logger::logStatusMsg(
-          Status::BAD_INPUT,
-          "Span is too large: ");  // + spanSize + " vs " + spans._spanSize);//, spanSize, spans._spanSize));
+    if (spanSize > plan.spanSize) {
+      plan.valid = false;
+      return;
     }
+
+    auto weights = plan.weights.data() + x * plan.spanSize;
     float totalWeightSum = 0.f;
-    tempWeights.clear();
-    for (int source = spanStart; source < spanEnd; ++source) {
-      float kernelPos = static_cast<float>(source) + 0.5f - sampleFloat;
-      float weight = (*kernel)(kernelPos * invKernelScale);
-      totalWeightSum += weight;
-      tempWeights.push_back(weight);
+    for (int e = 0; e < spanSize; ++e) {
+      float kernelPos = static_cast<float>(spanStart + e) + 0.5f - sampleFloat;
+      weights[e] = (*kernel)(kernelPos * invKernelScale);
+      totalWeightSum += weights[e];
     }
-    maxSpanSize = std::max(maxSpanSize, spanSize);
-    if (math::sd_abs(totalWeightSum) >= 1000.f * DataTypeUtils::min_positive<float>()) {  //
-      auto totalWeightSumInverted = 1.0f / totalWeightSum;
-      auto outIndex = spans._spanSize * x;
-      for (auto weight : tempWeights) {
-        weightsVector[outIndex] = weight * totalWeightSumInverted;
-        ++outIndex;
-      }
+
+    plan.starts[x] = spanStart;
+    if (math::sd_abs(totalWeightSum) < 1000.f * DataTypeUtils::min_positive<float>()) {
+      for (int e = 0; e < spanSize; ++e) weights[e] = 0.f;
+      continue;
+    }
+
+    plan.lengths[x] = spanSize;
+    auto fixedWeights = plan.fixedWeights.data() + x * plan.spanSize;
+    int32_t fixedSum = 0;
+    int largest = 0;
+    for (int e = 0; e < spanSize; ++e) {
+      weights[e] /= totalWeightSum;
+      fixedWeights[e] = static_cast<int32_t>(std::lround(weights[e] * (1 << RESIZE_WEIGHT_BITS)));
+      fixedSum += fixedWeights[e];
+      if (math::sd_abs(weights[e]) > math::sd_abs(weights[largest])) largest = e;
     }
-    startsVec[x] = spanStart;
+
+    // rounding error goes to the largest tap, so flat areas stay flat
+    fixedWeights[largest] += (1 << RESIZE_WEIGHT_BITS) - fixedSum;
   }
-  return sd::Status::OK;
 }
 
-template <typename X, typename Z>
-static void gatherSpans(int const rowSpanSize, NDArray const& rowStarts, NDArray const& rowWeights,
-                        int const colSpanSize, NDArray const& columnStarts, NDArray const& columnWeights,
-                        NDArray const* images, NDArray& intermediate, NDArray* output) {
-  auto batchSize = images->sizeAt(0);
-  auto inputHeight = images->sizeAt(1);
-  auto inputWidth = images->sizeAt(2);
-  auto channels = images->sizeAt(3);
-
-  auto outputHeight = output->sizeAt(1);
-  auto outputWidth = output->sizeAt(2);
-
-  auto inputPixPerBatch = images->strideAt(0);
-  auto intermediatePixPerBatch = inputWidth * outputHeight * channels;
-  auto outputPixPerBatch = outputWidth * outputHeight * channels;
-  Z* intermediatePtr = intermediate.bufferAsT<Z>();
-  bool inputEws1 = images->ews() == 1;
-  auto inRowStride = images->strideAt(1);
-  auto wStride = images->strideAt(2);
-  auto cStride = images->strideAt(3);
-  const X* imagePtr = images->bufferAsT<X>();
-  Z* outPtr = output->bufferAsT<Z>();
-  for (int b = 0; b < batchSize;
-       ++b, imagePtr += inputPixPerBatch, intermediatePtr += intermediatePixPerBatch, outPtr += outputPixPerBatch) {
-    gatherRows<X, Z>(rowSpanSize, rowStarts.bufferAsT<int>(), rowWeights.bufferAsT<Z>(), imagePtr, inputHeight,
-                     inputWidth, outputHeight, inputWidth, channels, intermediatePtr, inputEws1, inRowStride, wStride,
-                     cStride);
-    gatherColumns<Z>(colSpanSize, columnStarts.bufferAsT<int>(), columnWeights.bufferAsT<Z>(), intermediatePtr,
-                     outputHeight, inputWidth, outputHeight, outputWidth, channels, outPtr);
+struct ResizePlanDescriptor {
+  sd::LongType inSize;
+  sd::LongType outSize;
+  int method;
+  float coefficient;
+  bool antialias;
+
+  bool operator==(const ResizePlanDescriptor& other) const {
+    return inSize == other.inSize && outSize == other.outSize && method == other.method &&
+           coefficient == other.coefficient && antialias == other.antialias;
+  }
+};
+
+struct ResizePlanDescriptorHash {
+  size_t operator()(const ResizePlanDescriptor& d) const {
+    auto hash = std::hash<sd::LongType>()(d.inSize) * 31 + std::hash<sd::LongType>()(d.outSize);
+    hash = hash * 31 + std::hash<int>()(d.method);
+    hash = hash * 31 + std::hash<float>()(d.coefficient);
+    return hash * 31 + (d.antialias ? 1 : 0);
   }
+};
+
+static const ResizePlan& resizePlan(IKernelFunc<float>* kernel, ImageResizeMethods method, float coefficient,
+                                    sd::LongType inSize, sd::LongType outSize, bool antialias) {
+  // plans are tiny and there are only so many geometries in use, so they are kept forever
+  static ConstantCache<ResizePlanDescriptor, ResizePlan*, ResizePlanDescriptorHash> cache;
+
+  ResizePlanDescriptor descriptor = {inSize, outSize, static_cast<int>(method), coefficient, antialias};
+  return *cache.getOrCreate(descriptor, [&]() {
+    auto plan = new ResizePlan();
+    computeResizePlan(kernel, outSize, inSize, antialias, *plan);
+    return plan;
+  });
 }
 
-template <typename X, typename Z>
-static sd::Status resizeKernel(IKernelFunc<float>* transformationKernel, NDArray const* input, sd::LongType outWidth,
-                               sd::LongType outHeight, bool antialias, NDArray* output) {
-  sd::LongType const batchSize = input->sizeAt(0);
-  sd::LongType const inputHeight = input->sizeAt(1);
-  sd::LongType const inputWidth = input->sizeAt(2);
-  sd::LongType const channels = input->sizeAt(3);
+// float math for everything but 8-bit images
+template <typename X>
+struct ResizeArithmetic {
+  typedef float Acc;
+
+  static SD_INLINE const float* weights(const ResizePlan& plan) { return plan.weights.data(); }
+  static SD_INLINE float narrow(float value) { return value; }
+  static SD_INLINE float output(float value) { return value; }
+};
+
+template <>
+struct ResizeArithmetic<uint8_t> {
+  typedef int32_t Acc;
+
+  static SD_INLINE const int32_t* weights(const ResizePlan& plan) { return plan.fixedWeights.data(); }
+  // horizontal pass result is kept with RESIZE_WEIGHT_BITS - RESIZE_INTERMEDIATE_SHIFT fractional bits
+  static SD_INLINE int32_t narrow(int32_t value) {
+    return (value + (1 << (RESIZE_INTERMEDIATE_SHIFT - 1))) >> RESIZE_INTERMEDIATE_SHIFT;
+  }
+  static SD_INLINE float output(int32_t value) {
+    return static_cast<float>(value) / static_cast<float>(1 << (2 * RESIZE_WEIGHT_BITS - RESIZE_INTERMEDIATE_SHIFT));
+  }
+};
+
+// Images rarely have more than 4 channels, too few to fill a vector, so horizontal pass works on blocks of rows:
+// block is transposed into {inWidth * channels, RESIZE_ROW_BLOCK} tile and every tap becomes a vector op over rows.
+static const int RESIZE_ROW_BLOCK = 8;
+
+// taps of one output pixel for CHANNELS consecutive channels, all of them accumulated side by side
+template <typename X, int CHANNELS>
+static void resizePixelHorizontal(const typename ResizeArithmetic<X>::Acc* w, int length,
+                                  const typename ResizeArithmetic<X>::Acc* pixels, sd::LongType pixelStride,
+                                  int numRows, typename ResizeArithmetic<X>::Acc* out, sd::LongType outRowLength) {
+  typedef typename ResizeArithmetic<X>::Acc A;
+  const int width = CHANNELS * RESIZE_ROW_BLOCK;
+  A acc[width] = {};
+
+  for (int k = 0; k < length; ++k, pixels += pixelStride) {
+    const A weight = w[k];
+    PRAGMA_OMP_SIMD
+    for (int e = 0; e < width; e++) acc[e] += weight * pixels[e];
+  }
 
-  Z rowScale = Z(outHeight) / Z(inputHeight);
-  Z columnScale = Z(outWidth) / Z(inputWidth);
+  for (int r = 0; r < numRows; r++)
+    for (int c = 0; c < CHANNELS; c++)
+      out[r * outRowLength + c] = ResizeArithmetic<X>::narrow(acc[c * RESIZE_ROW_BLOCK + r]);
+}
 
+template <typename X>
+static void resizeRowsHorizontal(const ResizePlan& plan, const X* in, int numRows, sd::LongType inRowLength,
+                                 sd::LongType outWidth, sd::LongType channels, typename ResizeArithmetic<X>::Acc* tile,
+                                 typename ResizeArithmetic<X>::Acc* out, sd::LongType outRowLength) {
+  typedef typename ResizeArithmetic<X>::Acc A;
+  const A* weights = ResizeArithmetic<X>::weights(plan);
+
+  // tile is written sequentially, rows are read as RESIZE_ROW_BLOCK streams
+  if (numRows == RESIZE_ROW_BLOCK) {
+    for (sd::LongType e = 0; e < inRowLength; e++)
+      for (int r = 0; r < RESIZE_ROW_BLOCK; r++)
+        tile[e * RESIZE_ROW_BLOCK + r] = static_cast<A>(in[r * inRowLength + e]);
+  } else {
+    for (sd::LongType e = 0; e < inRowLength; e++)
+      for (int r = 0; r < RESIZE_ROW_BLOCK; r++)
+        tile[e * RESIZE_ROW_BLOCK + r] = r < numRows ? static_cast<A>(in[r * inRowLength + e]) : static_cast<A>(0);
+  }
+
+  const sd::LongType pixelStride = channels * RESIZE_ROW_BLOCK;
+  for (sd::LongType x = 0; x < outWidth; ++x) {
+    const A* w = weights + x * plan.spanSize;
+    const int length = plan.lengths[x];
+
+    // channels go in groups of up to 4, so every tap has a few independent vectors to work on
+    for (sd::LongType c = 0; c < channels; c += 4) {
+      const A* pixels = tile + (plan.starts[x] * channels + c) * RESIZE_ROW_BLOCK;
+      auto pixel = out + x * channels + c;
+      switch (math::sd_min<sd::LongType>(4, channels - c)) {
+        case 1:
+          resizePixelHorizontal<X, 1>(w, length, pixels, pixelStride, numRows, pixel, outRowLength);
+          break;
+        case 2:
+          resizePixelHorizontal<X, 2>(w, length, pixels, pixelStride, numRows, pixel, outRowLength);
+          break;
+        case 3:
+          resizePixelHorizontal<X, 3>(w, length, pixels, pixelStride, numRows, pixel, outRowLength);
+          break;
+        default:
+          resizePixelHorizontal<X, 4>(w, length, pixels, pixelStride, numRows, pixel, outRowLength);
+      }
+    }
+  }
+}
+
+// output row is the weighted sum of whole intermediate rows, so this one is vectorized over width * channels
+template <typename X>
+static void resizeRowVertical(const ResizePlan& plan, sd::LongType y, const typename ResizeArithmetic<X>::Acc* in,
+                              sd::LongType rowLength, typename ResizeArithmetic<X>::Acc* acc, float* out) {
+  typedef typename ResizeArithmetic<X>::Acc A;
+  const A* w = ResizeArithmetic<X>::weights(plan) + y * plan.spanSize;
+  in += plan.starts[y] * rowLength;
+
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < rowLength; ++e) acc[e] = static_cast<A>(0);
+
+  for (int k = 0; k < plan.lengths[y]; ++k, in += rowLength) {
+    const A weight = w[k];
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < rowLength; ++e) acc[e] += weight * in[e];
+  }
+
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < rowLength; ++e) out[e] = ResizeArithmetic<X>::output(acc[e]);
+}
+
+// input is {bS, iH, iW, C} with contiguous pixels, output is {bS, oH, oW, C} c-ordered
+template <typename X>
+static void resizeSeparable(const ResizePlan& rowPlan, const ResizePlan& columnPlan, const X* input,
+                            sd::LongType batchSize, sd::LongType inHeight, sd::LongType inWidth, sd::LongType channels,
+                            sd::LongType outHeight, sd::LongType outWidth, float* output) {
+  typedef typename ResizeArithmetic<X>::Acc A;
+  const sd::LongType inRowLength = inWidth * channels;
+  const sd::LongType outRowLength = outWidth * channels;
+  std::vector<A> intermediate(batchSize * inHeight * outRowLength);
+  auto buffer = intermediate.data();
+
+  const sd::LongType numRows = batchSize * inHeight;
+  auto horizontal = PRAGMA_THREADS_FOR {
+    std::vector<A> tile(inRowLength * RESIZE_ROW_BLOCK);
+    for (auto block = start; block < stop; block++) {
+      auto r = block * RESIZE_ROW_BLOCK;
+      resizeRowsHorizontal<X>(columnPlan, input + r * inRowLength,
+                              static_cast<int>(math::sd_min<sd::LongType>(RESIZE_ROW_BLOCK, numRows - r)), inRowLength,
+                              outWidth, channels, tile.data(), buffer + r * outRowLength, outRowLength);
+    }
+  };
+  samediff::Threads::parallel_for(horizontal, 0, (numRows + RESIZE_ROW_BLOCK - 1) / RESIZE_ROW_BLOCK, 1);
+
+  auto vertical = PRAGMA_THREADS_FOR {
+    std::vector<A> acc(outRowLength);
+    for (auto r = start; r < stop; r++) {
+      auto b = r / outHeight;
+      resizeRowVertical<X>(rowPlan, r % outHeight, buffer + b * inHeight * outRowLength, outRowLength, acc.data(),
+                           output + r * outRowLength);
+    }
+  };
+  samediff::Threads::parallel_for(vertical, 0, batchSize * outHeight, 1);
+}
+
+template <typename X>
+static sd::Status resizeKernel(IKernelFunc<float>* transformationKernel, ImageResizeMethods method,
+                               float coefficient, NDArray const* input, sd::LongType outWidth, sd::LongType outHeight,
+                               bool antialias, NDArray* output) {
   // Return if the output is empty.
   if (output->lengthOf() == 0) return sd::Status::OK;
 
-  Spans colSpans;
+  if (output->dataType() != DataType::FLOAT32)
+    return Logger::logStatusMsg(Status::VALIDATION, "helpers::resizeKernel: output should be FLOAT32");
 
-  auto res = computeSpans(transformationKernel, outWidth, inputWidth, columnScale, 0.f, antialias, colSpans);
-  if (res != sd::Status::OK) return res;
-  Spans rowSpans;
-  res = computeSpans(transformationKernel, outHeight, inputHeight, rowScale, 0.f, antialias, rowSpans);
+  const bool batched = input->rankOf() == 4;
+  sd::LongType const batchSize = batched ? input->sizeAt(0) : 1;
+  sd::LongType const inputHeight = input->sizeAt(-3);
+  sd::LongType const inputWidth = input->sizeAt(-2);
+  sd::LongType const channels = input->sizeAt(-1);
 
-  NDArray intermediate = NDArrayFactory::create<Z>('c', {batchSize, outHeight, inputWidth, channels});
+  auto& rowPlan = resizePlan(transformationKernel, method, coefficient, inputHeight, outHeight, antialias);
+  auto& columnPlan = resizePlan(transformationKernel, method, coefficient, inputWidth, outWidth, antialias);
+  if (!rowPlan.valid || !columnPlan.valid) return Logger::logStatusMsg(Status::BAD_INPUT, "Span is too large: ");
 
-  // const functor::Spans& const_row_spans = row_spans;
-  // typename TTypes<int32, 1>::ConstTensor row_starts(
-  // const_row_spans.starts.tensor<int32, 1>());
-  auto& rowStarts = rowSpans._starts;       // shape {outWidth}
-  auto& rowWeights = rowSpans._weights;     // shape {outWidth, numSpans}
-  auto& columnStarts = colSpans._starts;    // shape {outHeights}
-  auto& columnWeights = colSpans._weights;  // shape {outHeights, numSpans}
+  // both passes want plain c-ordered buffers, anything else goes through a copy
+  NDArray inputCopy;
+  if (input->ordering() != 'c' || input->ews() != 1) {
+    inputCopy = input->dup('c');
+    input = &inputCopy;
+  }
 
-  gatherSpans<X, Z>(rowSpans._spanSize, rowStarts, rowWeights, colSpans._spanSize, columnStarts, columnWeights, input,
-                    intermediate, output);
-  return res;
+  NDArray outputCopy;
+  auto target = output;
+  if (output->ordering() != 'c' || output->ews() != 1) {
+    outputCopy = output->ulike();
+    target = &outputCopy;
+  }
+
+  resizeSeparable<X>(rowPlan, columnPlan, input->bufferAsT<X>(), batchSize, inputHeight, inputWidth, channels,
+                     outHeight, outWidth, target->bufferAsT<float>());
+
+  if (target != output) output->assign(outputCopy);
+
+  return sd::Status::OK;
 }
+
 #if defined(HAS_FLOAT32)
 static sd::Status resizeBilinear(sd::LaunchContext* context, NDArray const* image, int const width, int const height,
                                  bool const antialias, NDArray* output) {
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new TriangleKernelFunc());
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeBilinear, 0.f, image, (sd::LongType)width, (sd::LongType)height,
+                         antialias, output),
+                        SD_NUMERIC_TYPES);
   return Logger::logStatusMsg(Status::VALIDATION, "helpers::resizeBilinear: Unknown error occured.");
 }
 
@@ -791,9 +962,10 @@ static sd::Status resizeBicubicAntialias(sd::LaunchContext* context, NDArray con
                                          int const height, bool const antialias, double coefficient, NDArray* output) {
   // coorMode is HALF_PIXEL exlude_outside is True
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new KeysCubicKernelFunc<float>(coefficient));
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeBicubic, (float)coefficient, image, (sd::LongType)width,
+                         (sd::LongType)height, antialias, output),
+                        SD_NUMERIC_TYPES);
   return sd::Status::OK;
 }
 #endif
@@ -806,36 +978,40 @@ static sd::Status resizeArea(sd::LaunchContext* context, NDArray const* image, i
 static sd::Status resizeLanczos3(sd::LaunchContext* context, NDArray const* image, int const width, int const height,
                                  bool const antialias, NDArray* output) {
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new LanczosKernelFunc(3.f));
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeLanczos3, 0.f, image, (sd::LongType)width, (sd::LongType)height,
+                         antialias, output),
+                        SD_NUMERIC_TYPES);
   return Logger::logStatusMsg(Status::VALIDATION, "helpers::resizeLanczos3: Unknown error occured.");
 }
 
 static sd::Status resizeLanczos5(sd::LaunchContext* context, NDArray const* image, int const width, int const height,
                                  bool const antialias, NDArray* output) {
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new LanczosKernelFunc(5.f));
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeLanczos5, 0.f, image, (sd::LongType)width, (sd::LongType)height,
+                         antialias, output),
+                        SD_NUMERIC_TYPES);
   return Logger::logStatusMsg(Status::VALIDATION, "helpers::resizeLanczos5: Unknown error occured.");
 }
 
 static sd::Status resizeGaussian(sd::LaunchContext* context, NDArray const* image, int const width, int const height,
                                  bool const antialias, NDArray* output) {
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new GaussianKernelFunc());
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeGaussian, 0.f, image, (sd::LongType)width, (sd::LongType)height,
+                         antialias, output),
+                        SD_NUMERIC_TYPES);
   return Logger::logStatusMsg(Status::VALIDATION, "helpers::resizeGaussian: Unknown error occured.");
 }
 
 static sd::Status resizeMitchellcubic(sd::LaunchContext* context, NDArray const* image, int const width,
                                       int const height, bool const antialias, NDArray* output) {
   auto kernel = std::unique_ptr<IKernelFunc<float>>(new MitchellCubicKernelFunc());
-  BUILD_DOUBLE_SELECTOR(image->dataType(), output->dataType(), return resizeKernel,
-                        (kernel.get(), image, (sd::LongType)width, (sd::LongType)height, antialias, output),
-                        SD_NUMERIC_TYPES, SKIP_FIRST_COMMA(TTYPE_FLOAT32));
+  BUILD_SINGLE_SELECTOR(image->dataType(), return resizeKernel,
+                        (kernel.get(), kResizeMitchellcubic, 0.f, image, (sd::LongType)width, (sd::LongType)height,
+                         antialias, output),
+                        SD_NUMERIC_TYPES);
   return Logger::logStatusMsg(Status::VALIDATION, "helpers::ResizeMitchellcubic: Unknown error occured.");
 }
 #endif
@@ -24,13 +24,318 @@
 #include <execution/Threads.h>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/helpers/segment.h>
+#include <system/Environment.h>
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 #if NOT_EXCLUDED(OP_segment)
 namespace sd {
 namespace ops {
 namespace helpers {
 
+// -------------------------------------------------------------------------------------------------------------- //
+// Segment reduction engine
+//
+// Index plan groups input rows by class once: class of every row, first position of every class and, for unsorted
+// indices, rows reordered by class with counting sort. Reduction walks that sequence split evenly between threads,
+// so skewed classes don't hurt. Classes that fit into one chunk are reduced straight into output, classes cut by
+// chunk boundaries go through per-chunk carries merged afterwards. No atomics and no sorting, and backprop
+// reuses the same plan for both forward pass and gradient distribution.
+// -------------------------------------------------------------------------------------------------------------- //
+enum SegmentReduction { SEGMENT_SUM, SEGMENT_MEAN, SEGMENT_SQRTN, SEGMENT_MAX, SEGMENT_MIN, SEGMENT_PROD };
+
+// don't split work into chunks smaller than this number of elements
+static const sd::LongType SEGMENT_MIN_CHUNK = 16384;
+
+struct SegmentPlan {
+  sd::LongType numClasses = 0;
+  // class of every input row
+  std::vector<sd::LongType> classes;
+  // positions of class c are [offsets[c], offsets[c + 1])
+  std::vector<sd::LongType> offsets;
+  // input row at every position, empty if rows are already grouped by class
+  std::vector<sd::LongType> order;
+
+  SD_INLINE sd::LongType numRows() const { return static_cast<sd::LongType>(classes.size()); }
+  SD_INLINE sd::LongType count(sd::LongType c) const { return offsets[c + 1] - offsets[c]; }
+  SD_INLINE sd::LongType row(sd::LongType position) const { return order.empty() ? position : order[position]; }
+};
+
+template <typename I>
+static bool readSegmentIndices_(NDArray* indices, sd::LongType numClasses, std::vector<sd::LongType>& classes) {
+  const auto length = indices->lengthOf();
+  classes.resize(length);
+
+  if (indices->ews() == 1) {
+    auto buffer = indices->bufferAsT<I>();
+    for (sd::LongType e = 0; e < length; e++) classes[e] = static_cast<sd::LongType>(buffer[e]);
+  } else {
+    for (sd::LongType e = 0; e < length; e++) classes[e] = indices->e<sd::LongType>(e);
+  }
+
+  for (auto c : classes)
+    if (c < 0 || c >= numClasses) return false;
+
+  return true;
+}
+
+static bool buildSegmentPlan(NDArray* indices, sd::LongType numClasses, SegmentPlan& plan) {
+  bool valid = false;
+  BUILD_SINGLE_SELECTOR(indices->dataType(), valid = readSegmentIndices_, (indices, numClasses, plan.classes),
+                        SD_INTEGER_TYPES);
+  if (!valid) return false;
+
+  plan.numClasses = numClasses;
+  plan.offsets.assign(numClasses + 1, 0);
+  for (auto c : plan.classes) plan.offsets[c + 1]++;
+  for (sd::LongType c = 0; c < numClasses; c++) plan.offsets[c + 1] += plan.offsets[c];
+
+  // unsorted indices are often sorted anyway, only reorder if they aren't
+  plan.order.clear();
+  if (!std::is_sorted(plan.classes.begin(), plan.classes.end())) {
+    std::vector<sd::LongType> next(plan.offsets.begin(), plan.offsets.end() - 1);
+    plan.order.resize(plan.classes.size());
+    for (sd::LongType r = 0; r < plan.numRows(); r++) plan.order[next[plan.classes[r]]++] = r;
+  }
+
+  return true;
+}
+
+// contiguous rows of the same type, one input row per index
+static bool segmentFastPath(NDArray* input, NDArray* indices, NDArray* output, sd::LongType numClasses) {
+  if (input->rankOf() < 1 || input->isEmpty() || input->sizeAt(0) != indices->lengthOf()) return false;
+
+  if (input->dataType() != output->dataType() || input->dataType() == sd::DataType::BOOL ||
+      !(input->isR() || input->isZ()))
+    return false;
+
+  if (input->ordering() != 'c' || input->ews() != 1 || output->ordering() != 'c' || output->ews() != 1) return false;
+
+  return output->lengthOf() == numClasses * (input->lengthOf() / input->sizeAt(0));
+}
+
+template <typename T>
+struct SegmentAccumulator {
+  typedef T type;
+};
+
+template <>
+struct SegmentAccumulator<float16> {
+  typedef float type;
+};
+
+template <>
+struct SegmentAccumulator<bfloat16> {
+  typedef float type;
+};
+
+template <typename S, typename A>
+static SD_INLINE void segmentCombine(int reduction, A* acc, const S* row, sd::LongType length) {
+  switch (reduction) {
+    case SEGMENT_MAX:
+      PRAGMA_OMP_SIMD
+      for (sd::LongType e = 0; e < length; e++) acc[e] = sd::math::sd_max<A>(acc[e], static_cast<A>(row[e]));
+      break;
+    case SEGMENT_MIN:
+      PRAGMA_OMP_SIMD
+      for (sd::LongType e = 0; e < length; e++) acc[e] = sd::math::sd_min<A>(acc[e], static_cast<A>(row[e]));
+      break;
+    case SEGMENT_PROD:
+      PRAGMA_OMP_SIMD
+      for (sd::LongType e = 0; e < length; e++) acc[e] *= static_cast<A>(row[e]);
+      break;
+    default:
+      PRAGMA_OMP_SIMD
+      for (sd::LongType e = 0; e < length; e++) acc[e] += static_cast<A>(row[e]);
+  }
+}
+
+template <typename T, typename A>
+static SD_INLINE void segmentFinalize(int reduction, const A* acc, sd::LongType count, sd::LongType length, T* out) {
+  if (reduction == SEGMENT_MEAN || reduction == SEGMENT_SQRTN) {
+    const double divisor = reduction == SEGMENT_MEAN ? static_cast<double>(count)
+                                                     : sd::math::sd_sqrt<double, double>(static_cast<double>(count));
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < length; e++) out[e] = static_cast<T>(static_cast<double>(acc[e]) / divisor);
+  } else {
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < length; e++) out[e] = static_cast<T>(acc[e]);
+  }
+}
+
+template <typename T>
+static void segmentReduce_(const SegmentPlan& plan, int reduction, bool sorted, NDArray* input, NDArray* output) {
+  typedef typename SegmentAccumulator<T>::type A;
+  const sd::LongType numRows = plan.numRows();
+  const sd::LongType rowLength = input->lengthOf() / numRows;
+  const T* x = input->bufferAsT<T>();
+  T* z = output->bufferAsT<T>();
+
+  // classes without rows, legacy values are kept for them
+  T emptyValue = static_cast<T>(0);
+  if (reduction == SEGMENT_PROD)
+    emptyValue = static_cast<T>(1);
+  else if (!sorted && reduction == SEGMENT_MAX)
+    emptyValue = -DataTypeUtils::max<T>();
+  else if (!sorted && reduction == SEGMENT_MIN)
+    emptyValue = DataTypeUtils::max<T>();
+
+  auto reduceRange = [&](sd::LongType from, sd::LongType to, A* acc) {
+    const T* first = x + plan.row(from) * rowLength;
+    for (sd::LongType e = 0; e < rowLength; e++) acc[e] = static_cast<A>(first[e]);
+
+    for (auto p = from + 1; p < to; p++) segmentCombine<T, A>(reduction, acc, x + plan.row(p) * rowLength, rowLength);
+  };
+
+  const sd::LongType numChunks = math::sd_max<sd::LongType>(
+      1, math::sd_min<sd::LongType>(math::sd_min<sd::LongType>(Environment::getInstance().maxMasterThreads(), numRows),
+                                    input->lengthOf() / SEGMENT_MIN_CHUNK));
+
+  // every chunk may cut at most two classes: the one it starts in and the one it ends in
+  std::vector<A> carries(numChunks * 2 * rowLength);
+  std::vector<sd::LongType> carryClasses(numChunks * 2, -1);
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<A> acc(rowLength);
+    for (auto chunk = start; chunk < stop; chunk++) {
+      const sd::LongType from = numRows * chunk / numChunks;
+      const sd::LongType to = numRows * (chunk + 1) / numChunks;
+
+      for (auto p = from; p < to;) {
+        const auto c = plan.classes[plan.row(p)];
+        const auto end = math::sd_min<sd::LongType>(plan.offsets[c + 1], to);
+
+        if (p == plan.offsets[c] && end == plan.offsets[c + 1]) {
+          reduceRange(p, end, acc.data());
+          segmentFinalize<T, A>(reduction, acc.data(), plan.count(c), rowLength, z + c * rowLength);
+        } else {
+          const auto slot = chunk * 2 + (p == from ? 0 : 1);
+          reduceRange(p, end, carries.data() + slot * rowLength);
+          carryClasses[slot] = c;
+        }
+
+        p = end;
+      }
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, numChunks, 1);
+
+  // carries of the same class are adjacent, since chunks follow class order
+  sd::LongType current = -1;
+  A* running = nullptr;
+  for (sd::LongType slot = 0; slot < numChunks * 2; slot++) {
+    const auto c = carryClasses[slot];
+    if (c < 0) continue;
+
+    auto carry = carries.data() + slot * rowLength;
+    if (c == current) {
+      segmentCombine<A, A>(reduction, running, carry, rowLength);
+    } else {
+      if (current >= 0) segmentFinalize<T, A>(reduction, running, plan.count(current), rowLength, z + current * rowLength);
+
+      current = c;
+      running = carry;
+    }
+  }
+  if (current >= 0) segmentFinalize<T, A>(reduction, running, plan.count(current), rowLength, z + current * rowLength);
+
+  auto empty = PRAGMA_THREADS_FOR {
+    for (auto c = start; c < stop; c++) {
+      if (plan.count(c) != 0) continue;
+
+      auto out = z + c * rowLength;
+      for (sd::LongType e = 0; e < rowLength; e++) out[e] = emptyValue;
+    }
+  };
+  samediff::Threads::parallel_for(empty, 0, plan.numClasses);
+}
+
+// returns false if given arrays can't go through the engine, legacy implementation is used then
+static bool segmentReduce(NDArray* input, NDArray* indices, sd::LongType numClasses, int reduction, bool sorted,
+                          NDArray* output) {
+  if (!segmentFastPath(input, indices, output, numClasses)) return false;
+
+  SegmentPlan plan;
+  if (!buildSegmentPlan(indices, numClasses, plan)) return false;
+
+  BUILD_SINGLE_SELECTOR(input->dataType(), segmentReduce_, (plan, reduction, sorted, input, output), SD_NUMERIC_TYPES);
+  return true;
+}
+
+template <typename T>
+static void segmentGradient_(const SegmentPlan& plan, int reduction, double eps, NDArray* input, NDArray* gradOut,
+                             NDArray* forward, NDArray* output) {
+  const sd::LongType numRows = plan.numRows();
+  const sd::LongType rowLength = input->lengthOf() / numRows;
+  const T* x = input->bufferAsT<T>();
+  const T* g = gradOut->bufferAsT<T>();
+  const T* f = forward != nullptr ? forward->bufferAsT<T>() : nullptr;
+  T* z = output->bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      const auto c = plan.classes[r];
+      const T* in = x + r * rowLength;
+      const T* grad = g + c * rowLength;
+      T* out = z + r * rowLength;
+
+      switch (reduction) {
+        case SEGMENT_MEAN:
+        case SEGMENT_SQRTN: {
+          const double divisor = reduction == SEGMENT_MEAN
+                                     ? static_cast<double>(plan.count(c))
+                                     : sd::math::sd_sqrt<double, double>(static_cast<double>(plan.count(c)));
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < rowLength; e++)
+            out[e] = static_cast<T>(static_cast<double>(grad[e]) / divisor);
+        } break;
+        case SEGMENT_MAX:
+        case SEGMENT_MIN: {
+          const T* fwd = f + c * rowLength;
+          for (sd::LongType e = 0; e < rowLength; e++)
+            out[e] = sd::math::sd_abs<double>(static_cast<double>(fwd[e]) - static_cast<double>(in[e])) <= eps
+                         ? grad[e]
+                         : static_cast<T>(0);
+        } break;
+        case SEGMENT_PROD: {
+          const T* fwd = f + c * rowLength;
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < rowLength; e++) out[e] = fwd[e] * grad[e] / in[e];
+        } break;
+        default:
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < rowLength; e++) out[e] = grad[e];
+      }
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, numRows);
+}
+
+// backprop counterpart of segmentReduce, eps is used to find max/min elements
+static bool segmentReduceBP(NDArray* input, NDArray* indices, NDArray* gradOut, sd::LongType numClasses,
+                            int reduction, bool sorted, double eps, NDArray* output) {
+  if (!segmentFastPath(input, indices, gradOut, numClasses) || output->dataType() != input->dataType() ||
+      output->ordering() != 'c' || output->ews() != 1 || output->lengthOf() != input->lengthOf())
+    return false;
+
+  SegmentPlan plan;
+  if (!buildSegmentPlan(indices, numClasses, plan)) return false;
+
+  NDArray forward;
+  const bool needsForward = reduction == SEGMENT_MAX || reduction == SEGMENT_MIN || reduction == SEGMENT_PROD;
+  if (needsForward) {
+    forward = gradOut->ulike();
+    BUILD_SINGLE_SELECTOR(input->dataType(), segmentReduce_, (plan, reduction, sorted, input, &forward),
+                          SD_NUMERIC_TYPES);
+  }
+
+  BUILD_SINGLE_SELECTOR(input->dataType(), segmentGradient_,
+                        (plan, reduction, eps, input, gradOut, needsForward ? &forward : nullptr, output),
+                        SD_NUMERIC_TYPES);
+  return true;
+}
+
 // segment max
 template <typename T>
 static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
@@ -277,22 +582,32 @@ static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* outpu
 //      }
 
 void segmentMaxFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* output) {
+  if (segmentReduce(input, indices, output->sizeAt(0), SEGMENT_MAX, true, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), segmentMaxFunctor_, (input, indices, output), SD_COMMON_TYPES);
 }
 
 void segmentMinFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* output) {
+  if (segmentReduce(input, indices, output->sizeAt(0), SEGMENT_MIN, true, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), segmentMinFunctor_, (input, indices, output), SD_COMMON_TYPES);
 }
 
 void segmentMeanFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* output) {
+  if (segmentReduce(input, indices, output->sizeAt(0), SEGMENT_MEAN, true, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), segmentMeanFunctor_, (input, indices, output), SD_COMMON_TYPES);
 }
 
 void segmentSumFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* output) {
+  if (segmentReduce(input, indices, output->sizeAt(0), SEGMENT_SUM, true, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), segmentSumFunctor_, (input, indices, output), SD_COMMON_TYPES);
 }
 
 void segmentProdFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* output) {
+  if (segmentReduce(input, indices, output->sizeAt(0), SEGMENT_PROD, true, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), segmentProdFunctor_, (input, indices, output), SD_COMMON_TYPES);
 }
 
@@ -384,6 +699,8 @@ static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, sd::Lon
 }
 void unsortedSegmentMaxFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, sd::LongType numOfClasses,
                                NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_MAX, false, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output),
                         SD_NUMERIC_TYPES);
 }
@@ -438,6 +755,8 @@ static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, sd::Lon
 }
 void unsortedSegmentMinFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, sd::LongType numOfClasses,
                                NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_MIN, false, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
                         SD_NUMERIC_TYPES);
 }
@@ -448,6 +767,8 @@ BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_,
 
 void unsortedSegmentMeanFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, sd::LongType numOfClasses,
                                 NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_MEAN, false, output)) return;
+
   SD_MAP_IMPL<sd::LongType, std::vector<sd::LongType>> idxs;  //(indices->lengthOf());
   for (sd::LongType e = 0; e < indices->lengthOf(); ++e) idxs[indices->e<sd::LongType>(e)].push_back(e);
 
@@ -489,6 +810,8 @@ void unsortedSegmentMeanFunctor(sd::LaunchContext* context, NDArray* input, NDAr
 
 void unsortedSegmentSumFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, sd::LongType numOfClasses,
                                NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_SUM, false, output)) return;
+
   SD_MAP_IMPL<sd::LongType, std::vector<sd::LongType>> idxs;  //(indices->lengthOf());
   for (sd::LongType e = 0; e < indices->lengthOf(); ++e) idxs[indices->e<sd::LongType>(e)].push_back(e);
 
@@ -562,6 +885,8 @@ void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, sd::LongType
 
 void unsortedSegmentProdFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices, sd::LongType numOfClasses,
                                 NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_PROD, false, output)) return;
+
   BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output),
                         SD_NUMERIC_TYPES);
 }
@@ -571,6 +896,8 @@ BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_,
 
 void unsortedSegmentSqrtNFunctor(sd::LaunchContext* context, NDArray* input, NDArray* indices,
                                  sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduce(input, indices, numOfClasses, SEGMENT_SQRTN, false, output)) return;
+
   SD_MAP_IMPL<sd::LongType, std::vector<sd::LongType>> idxs;  //(indices->lengthOf());
   for (sd::LongType e = 0; e < indices->lengthOf(); ++e) idxs[indices->e<sd::LongType>(e)].push_back(e);
 
@@ -660,6 +987,9 @@ sd::Status segmentMaxFunctorBP_(sd::LaunchContext* context, NDArray* input, NDAr
 
 sd::Status segmentMaxFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MAX, true, 1.e-6, output))
+    return sd::Status::OK;
+
   BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (context, input, indices, gradOut, output),
                         SD_NUMERIC_TYPES);
 }
@@ -671,6 +1001,9 @@ BUILD_SINGLE_TEMPLATE(template sd::Status segmentMaxFunctorBP_,
 // segmen min
 sd::Status segmentMinFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MIN, true, 1.e-5, output))
+    return sd::Status::OK;
+
   NDArray tempRes = gradOut->dup();
   segmentMinFunctor(context, input, indices, &tempRes);
   if (input->isVector() || input->isScalar()) {
@@ -717,6 +1050,9 @@ sd::Status segmentMinFunctorBP(sd::LaunchContext* context, NDArray* input, NDArr
 // segmen mean
 sd::Status segmentMeanFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                 NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MEAN, true, 0., output))
+    return sd::Status::OK;
+
   int numClasses = output->sizeAt(0);
   SD_MAP_IMPL<sd::LongType, sd::LongType> classCount;  //(numClasses);
 
@@ -763,6 +1099,9 @@ sd::Status segmentMeanFunctorBP(sd::LaunchContext* context, NDArray* input, NDAr
 
 sd::Status segmentSumFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_SUM, true, 0., output))
+    return sd::Status::OK;
+
   //        int numClasses = output->sizeAt(0);
   // if input is a vector: (as if in doc sample)
   sd::LongType idx = indices->e<sd::LongType>(0);
@@ -796,6 +1135,9 @@ sd::Status segmentSumFunctorBP(sd::LaunchContext* context, NDArray* input, NDArr
 
 sd::Status segmentProdFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                 NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_PROD, true, 0., output))
+    return sd::Status::OK;
+
   auto tempRes = gradOut->dup();
   segmentProdFunctor(context, input, indices, &tempRes);
   if (input->isVector() || input->isScalar()) {
@@ -874,6 +1216,9 @@ static sd::Status unsortedSegmentMaxFunctorBP_(sd::LaunchContext* context, NDArr
 
 sd::Status unsortedSegmentMaxFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                        sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_MAX, false, 1.e-5, output))
+    return sd::Status::OK;
+
   BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMaxFunctorBP_,
                         (context, input, indices, gradOut, numOfClasses, output), SD_NUMERIC_TYPES);
 }
@@ -927,6 +1272,9 @@ static sd::Status unsortedSegmentMinFunctorBP_(sd::LaunchContext* context, NDArr
 
 sd::Status unsortedSegmentMinFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                        sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_MIN, false, 1.e-6, output))
+    return sd::Status::OK;
+
   BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMinFunctorBP_,
                         (context, input, indices, gradOut, numOfClasses, output), SD_NUMERIC_TYPES);
 }
@@ -937,6 +1285,9 @@ BUILD_SINGLE_TEMPLATE(template sd::Status unsortedSegmentMinFunctorBP_,
 
 sd::Status unsortedSegmentMeanFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                         sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_MEAN, false, 0., output))
+    return sd::Status::OK;
+
   SD_MAP_IMPL<sd::LongType, sd::LongType> classCount;  //(numClasses);
 
   for (sd::LongType count = 0; count < numOfClasses; ++count) {
@@ -973,6 +1324,9 @@ sd::Status unsortedSegmentMeanFunctorBP(sd::LaunchContext* context, NDArray* inp
 
 sd::Status unsortedSegmentSumFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                        sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_SUM, false, 0., output))
+    return sd::Status::OK;
+
   // if input is a vector: (as if in doc sample)
   sd::LongType idx = indices->e<sd::LongType>(0);
   if (input->isVector() || input->isScalar()) {
@@ -1004,6 +1358,9 @@ sd::Status unsortedSegmentSumFunctorBP(sd::LaunchContext* context, NDArray* inpu
 
 sd::Status unsortedSegmentProdFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                         sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_PROD, false, 0., output))
+    return sd::Status::OK;
+
   auto tempRes = gradOut->dup();
   unsortedSegmentProdFunctor(context, input, indices, numOfClasses, &tempRes);
   if (input->isVector() || input->isScalar()) {
@@ -1044,6 +1401,9 @@ sd::Status unsortedSegmentProdFunctorBP(sd::LaunchContext* context, NDArray* inp
 //    template <typename T>
 sd::Status unsortedSegmentSqrtNFunctorBP(sd::LaunchContext* context, NDArray* input, NDArray* indices, NDArray* gradOut,
                                          sd::LongType numOfClasses, NDArray* output) {
+  if (segmentReduceBP(input, indices, gradOut, numOfClasses, SEGMENT_SQRTN, false, 0., output))
+    return sd::Status::OK;
+
   SD_MAP_IMPL<sd::LongType, sd::LongType> classCount;  //(numClasses);
 
   for (sd::LongType count = 0; count < numOfClasses; ++count) {
@@ -22,6 +22,9 @@
 #include <execution/Threads.h>
 #include <ops/declarable/helpers/sg_cb.h>
 #include <math/templatemath.h>
+
+#include <algorithm>
+#include <vector>
 #define HS_MAX_EXP 6.0f
 
 namespace sd {
@@ -42,7 +45,7 @@ void hSoftmax_(T *vsyn0, T *vsyn1, T *vexpTable, T *vneu1e, const double alpha,
 
 
   // dot
-  PRAGMA_OMP_SIMD
+  PRAGMA_OMP_SIMD_SUM(dot)
   for (int e = 0; e < vectorLength; e++) {
     dot += syn0[e] * syn1[e];
 
@@ -84,7 +87,7 @@ void nSampling_(void *vsyn0, void *vsyn1Neg, void *vexpTable, void *vneu1e, doub
   T dot = (T)0.0f;
   T g = (T)0.0f;
 
-  PRAGMA_OMP_SIMD
+  PRAGMA_OMP_SIMD_SUM(dot)
   for (int e = 0; e < vectorLength; e++) {
     dot += syn0[e] * syn1Neg[e];
   }
@@ -696,6 +699,186 @@ BUILD_SINGLE_TEMPLATE(template void cbowBatchExec_,
                       SD_FLOAT_TYPES);
 
 
+template <typename T>
+static SD_INLINE T w2vDot(const T *x, const T *y, const int vectorLength) {
+  T dot(0.0f);
+  PRAGMA_OMP_SIMD_SUM(dot)
+  for (int e = 0; e < vectorLength; e++) dot += x[e] * y[e];
+
+  return dot;
+}
+
+template <typename T>
+static SD_INLINE void w2vAxpy(const T g, const T *x, T *y, const int vectorLength) {
+  PRAGMA_OMP_SIMD
+  for (int e = 0; e < vectorLength; e++) y[e] += g * x[e];
+}
+
+template <typename T>
+static SD_INLINE void w2vPrefetch(const T *row, const int vectorLength) {
+#if defined(__GNUC__) || defined(__clang__)
+  for (int e = 0; e < vectorLength; e += 64 / sizeof(T)) __builtin_prefetch(row + e, 1);
+#endif
+}
+
+// same sigmoid lookup nSampling_ uses, scaled by learning rate
+template <typename T>
+static SD_INLINE T w2vGradient(const T dot, const int label, const T *expTable, const int expLength, const double alpha) {
+  if (dot > (T)HS_MAX_EXP) return static_cast<T>((label - 1) * alpha);
+  if (dot < (T)-HS_MAX_EXP) return static_cast<T>(label * alpha);
+
+  int idx = static_cast<int>((dot + (T)HS_MAX_EXP) * ((T)expLength / HS_MAX_EXP / 2.0));
+  if (idx >= expLength || idx < 0) return static_cast<T>(0.0f);
+
+  return static_cast<T>((static_cast<T>(label) - expTable[idx]) * static_cast<T>(alpha));
+}
+
+template <typename T>
+static void word2vecCorpus_(NDArray &vtokens, NDArray &vsyn0, NDArray &vsyn1Neg, NDArray &vexpTable,
+                            NDArray &vnegTable, const int window, const int nsRounds, const bool isCbow,
+                            const double alpha, const double minLearningRate, const sd::LongType seed,
+                            const int numWorkers) {
+  const auto tokens = vtokens.bufferAsT<int>();
+  const auto syn0 = vsyn0.bufferAsT<T>();
+  const auto syn1Neg = vsyn1Neg.bufferAsT<T>();
+  const auto expTable = vexpTable.bufferAsT<T>();
+  const auto negTable = vnegTable.isEmpty() ? nullptr : vnegTable.bufferAsT<T>();
+
+  const sd::LongType numTokens = vtokens.lengthOf();
+  const int vocabSize = vsyn0.sizeAt(0);
+  const int vectorLength = vsyn0.sizeAt(1);
+  const int expLength = vexpTable.lengthOf();
+  const int negLength = vnegTable.isEmpty() ? 0 : vnegTable.lengthOf();
+  const int numSamples = negLength > 0 ? nsRounds : 0;
+  const int maxContext = 2 * window;
+
+  // Hogwild: every thread trains its own contiguous span of corpus, syn0/syn1Neg rows are updated without locks
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<int> contextRows(maxContext);
+    std::vector<int> outputRows(numSamples + 1);
+    std::vector<T> grads(maxContext * (numSamples + 1));
+    std::vector<T> inputGrads(maxContext * vectorLength);
+    std::vector<T> outputGrads((numSamples + 1) * vectorLength);
+    std::vector<T> neu1(vectorLength);
+
+    for (auto i = start; i < stop; i++) {
+      const int word = tokens[i];
+
+      // negative ids are sentence separators
+      if (word < 0 || word >= vocabSize) continue;
+
+      // rows needed on the next step: next center in syn1Neg, and the word entering window in syn0
+      if (i + 1 < stop && tokens[i + 1] >= 0 && tokens[i + 1] < vocabSize)
+        w2vPrefetch(syn1Neg + static_cast<sd::LongType>(tokens[i + 1]) * vectorLength, vectorLength);
+
+      if (i + window + 1 < numTokens && tokens[i + window + 1] >= 0 && tokens[i + window + 1] < vocabSize)
+        w2vPrefetch(syn0 + static_cast<sd::LongType>(tokens[i + window + 1]) * vectorLength, vectorLength);
+
+      // random stream depends on position only, so split between threads doesn't affect sampling
+      unsigned long long randomValue =
+          static_cast<unsigned long long>(seed) ^ (static_cast<unsigned long long>(i) * 0x9E3779B97F4A7C15ULL);
+      randomValue = randomValue * (unsigned long long)25214903917 + 11;
+
+      // learning rate decays linearly over the chunk
+      const double lr = alpha + (minLearningRate - alpha) * static_cast<double>(i) / static_cast<double>(numTokens);
+
+      // reduced window, same as original word2vec, never crossing sentence boundaries
+      const int span = window - static_cast<int>((randomValue >> 16) % window);
+      int numContext = 0;
+      for (sd::LongType c = i - 1; c >= 0 && c >= i - span && tokens[c] >= 0; c--)
+        if (tokens[c] < vocabSize) contextRows[numContext++] = tokens[c];
+
+      for (sd::LongType c = i + 1; c < numTokens && c <= i + span && tokens[c] >= 0; c++)
+        if (tokens[c] < vocabSize) contextRows[numContext++] = tokens[c];
+
+      if (numContext == 0) continue;
+
+      // positive target goes first, negatives are shared by the whole window
+      int numOutputs = 0;
+      outputRows[numOutputs++] = word;
+      for (int r = 0; r < numSamples; r++) {
+        randomValue = randomValue * (unsigned long long)25214903917 + 11;
+        auto idx = sd::math::sd_abs<sd::LongType>((randomValue >> 16) % negLength);
+        int irow = static_cast<int>(negTable[idx]);
+
+        if (irow < 0 || irow >= vocabSize) irow = randomValue % (vocabSize - 1) + 1;
+        if (irow == word) continue;
+
+        outputRows[numOutputs++] = irow;
+      }
+
+      if (isCbow) {
+        // averaged context against every output row
+        std::fill(neu1.begin(), neu1.end(), static_cast<T>(0.0f));
+        for (int c = 0; c < numContext; c++)
+          w2vAxpy(static_cast<T>(1.0f), syn0 + static_cast<sd::LongType>(contextRows[c]) * vectorLength, neu1.data(),
+                  vectorLength);
+
+        const T scale = static_cast<T>(1.0f) / static_cast<T>(numContext);
+        PRAGMA_OMP_SIMD
+        for (int e = 0; e < vectorLength; e++) neu1[e] *= scale;
+
+        auto neu1e = inputGrads.data();
+        std::fill(neu1e, neu1e + vectorLength, static_cast<T>(0.0f));
+        for (int o = 0; o < numOutputs; o++) {
+          auto outRow = syn1Neg + static_cast<sd::LongType>(outputRows[o]) * vectorLength;
+          auto g = w2vGradient<T>(w2vDot(neu1.data(), outRow, vectorLength), o == 0 ? 1 : 0, expTable, expLength, lr);
+
+          w2vAxpy(g, outRow, neu1e, vectorLength);
+          w2vAxpy(g, neu1.data(), outRow, vectorLength);
+        }
+
+        for (int c = 0; c < numContext; c++)
+          w2vAxpy(static_cast<T>(1.0f), neu1e, syn0 + static_cast<sd::LongType>(contextRows[c]) * vectorLength,
+                  vectorLength);
+      } else {
+        // skip-gram window as [numContext x vectorLength] x [vectorLength x numOutputs] product
+        for (int c = 0; c < numContext; c++) {
+          auto inRow = syn0 + static_cast<sd::LongType>(contextRows[c]) * vectorLength;
+          for (int o = 0; o < numOutputs; o++) {
+            auto outRow = syn1Neg + static_cast<sd::LongType>(outputRows[o]) * vectorLength;
+            grads[c * numOutputs + o] =
+                w2vGradient<T>(w2vDot(inRow, outRow, vectorLength), o == 0 ? 1 : 0, expTable, expLength, lr);
+          }
+        }
+
+        // both gradients are built from pre-update rows, and applied afterwards
+        std::fill(inputGrads.begin(), inputGrads.begin() + numContext * vectorLength, static_cast<T>(0.0f));
+        std::fill(outputGrads.begin(), outputGrads.begin() + numOutputs * vectorLength, static_cast<T>(0.0f));
+        for (int c = 0; c < numContext; c++) {
+          auto inRow = syn0 + static_cast<sd::LongType>(contextRows[c]) * vectorLength;
+          for (int o = 0; o < numOutputs; o++) {
+            auto g = grads[c * numOutputs + o];
+            if (g == static_cast<T>(0.0f)) continue;
+
+            auto outRow = syn1Neg + static_cast<sd::LongType>(outputRows[o]) * vectorLength;
+            w2vAxpy(g, outRow, inputGrads.data() + c * vectorLength, vectorLength);
+            w2vAxpy(g, inRow, outputGrads.data() + o * vectorLength, vectorLength);
+          }
+        }
+
+        for (int c = 0; c < numContext; c++)
+          w2vAxpy(static_cast<T>(1.0f), inputGrads.data() + c * vectorLength,
+                  syn0 + static_cast<sd::LongType>(contextRows[c]) * vectorLength, vectorLength);
+
+        for (int o = 0; o < numOutputs; o++)
+          w2vAxpy(static_cast<T>(1.0f), outputGrads.data() + o * vectorLength,
+                  syn1Neg + static_cast<sd::LongType>(outputRows[o]) * vectorLength, vectorLength);
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numTokens, 1, numWorkers);
+}
+
+void word2vecCorpus(NDArray &tokens, NDArray &syn0, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable,
+                    const int window, const int nsRounds, const bool isCbow, const double alpha,
+                    const double minLearningRate, const sd::LongType seed, const int numWorkers) {
+  BUILD_SINGLE_SELECTOR(syn0.dataType(), word2vecCorpus_,
+                        (tokens, syn0, syn1Neg, expTable, negTable, window, nsRounds, isCbow, alpha, minLearningRate,
+                         seed, numWorkers),
+                        SD_FLOAT_TYPES);
+}
 
 void skipgramInference(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, int target,
                        int ngStarter, int nsRounds, NDArray &indices, NDArray &codes, double alpha, sd::LongType randomValue,
@@ -21,214 +21,591 @@
 // @author raver119@gmail.com
 //
 #include <execution/Threads.h>
-#include <helpers/ConstantTadHelper.h>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/helpers/activations.h>
+#include <system/CpuDispatch.h>
 
+#include <cstring>
 #include <numeric>
-#if NOT_EXCLUDED(OP_softmax)
+#if NOT_EXCLUDED(OP_softmax) || NOT_EXCLUDED(OP_log_softmax)
 namespace sd {
 namespace ops {
 namespace helpers {
 
+// Softmax, log-softmax and their derivatives share one engine. Every array is viewed as [outer, axis, inner] with
+// single stride per part, so any axis of c/f-ordered arrays (and of most views) is processed in place:
+//  - inner > 1: up to kLanes inner positions are processed together, vectorized across lanes;
+//  - inner == 1: every row is split into kRowLanes lanes, which are combined once row is done.
+// Max and sum of exponents are accumulated in one pass (online softmax), second pass writes the result.
+
+// inner positions processed together
+static constexpr int kLanes = 64;
+
+// lanes of a row, fewer of them keep combining cheap for short rows
+static constexpr int kRowLanes = 16;
+
+// axis elements processed per rescale of running sums
+static constexpr int kChunk = 16;
+
+enum SoftmaxMode {
+  SOFTMAX_FORWARD = 0,
+  SOFTMAX_LOG = 1,
+  SOFTMAX_DERIVATIVE = 2,
+};
+
+// up to 3 arrays of the same shape: 0 and 1 are inputs, 2 is output
+struct SoftmaxLayout {
+  sd::LongType outer = 1;
+  sd::LongType axis = 1;
+  sd::LongType inner = 1;
+
+  sd::LongType outerStride[3] = {0, 0, 0};
+  sd::LongType axisStride[3] = {0, 0, 0};
+  sd::LongType innerStride[3] = {0, 0, 0};
+};
+
+// part of the layout handled by one kernel call
+struct SoftmaxBlock {
+  // axis elements per lane, and elements left over by row split into lanes
+  sd::LongType len;
+  sd::LongType tail;
+  int lanes;
+  bool row;
+
+  sd::LongType axis[3];
+  sd::LongType lane[3];
+};
+
+// dimensions [from, to) have to form single strided run, unit dimensions don't matter
+static bool collapseDims(const sd::LongType* shapeInfo, int from, int to, sd::LongType& stride) {
+  sd::LongType run = -1;
+  stride = 0;
+
+  for (int d = to - 1; d >= from; d--) {
+    const sd::LongType len = shape::sizeAt(shapeInfo, d);
+    if (len == 1) continue;
+
+    const auto st = shape::strideAt(shapeInfo, d);
+    if (run < 0)
+      stride = st;
+    else if (st != run)
+      return false;
+
+    run = st * len;
+  }
+
+  return true;
+}
+
+static bool buildLayout(const NDArray& a, const NDArray& b, const NDArray& c, const int dimension,
+                        SoftmaxLayout& layout) {
+  const int rank = a.rankOf();
+  if (!a.isSameShape(b) || !a.isSameShape(c)) return false;
+  if (a.dataType() != b.dataType() || a.dataType() != c.dataType()) return false;
+
+  const sd::LongType* shapes[3] = {a.shapeInfo(), b.shapeInfo(), c.shapeInfo()};
+  for (int e = 0; e < 3; e++) {
+    if (!collapseDims(shapes[e], 0, dimension, layout.outerStride[e]) ||
+        !collapseDims(shapes[e], dimension + 1, rank, layout.innerStride[e]))
+      return false;
+
+    layout.axisStride[e] = shape::strideAt(shapes[e], dimension);
+  }
+
+  layout.axis = a.sizeAt(dimension);
+  for (int d = 0; d < dimension; d++) layout.outer *= a.sizeAt(d);
+  for (int d = dimension + 1; d < rank; d++) layout.inner *= a.sizeAt(d);
+
+  // outer and inner positions are equivalent, so unit-strided outer part (i.e. f order) becomes lanes
+  if (layout.inner == 1 && layout.outer > 1 && layout.outerStride[0] == 1) {
+    std::swap(layout.outer, layout.inner);
+    for (int e = 0; e < 3; e++) std::swap(layout.outerStride[e], layout.innerStride[e]);
+  }
+
+  return true;
+}
+
+// exp which vectorizes within simd loops: float is evaluated via range reduction and cephes expf polynomial, within
+// 2 ulp of expf. Only integer selects are used, since float compares prevent vectorization under -ftrapping-math.
 template <typename T>
-static void softMaxForVector_(void const* input, sd::LongType const* inShapeInfo, void* output,
-                              sd::LongType const* outShapeInfo) {
-  auto inBuff = reinterpret_cast<T const*>(input);
-  auto outBuff = reinterpret_cast<T*>(output);
+static SD_INLINE T simdExp(const T x) {
+  return sd::math::sd_exp<T, T>(x);
+}
 
-  T max = -DataTypeUtils::max<T>();
-  T sum = 0.;
-  int inEWS = shape::elementWiseStride(inShapeInfo);
-  int outEWS = shape::elementWiseStride(outShapeInfo);
-  int length = shape::length(inShapeInfo);
+template <>
+SD_INLINE float simdExp(const float x) {
+  // exp(x) = 2^n * exp(r), n = round(x / ln2), |r| <= ln2 / 2; adding 1.5 * 2^23 leaves n in low mantissa bits
+  const float magic = 12582912.f;
+  const float shifted = x * 1.44269504088896341f + magic;
+  const float fn = shifted - magic;
+  const float r = x - fn * 0.693359375f + fn * 2.12194440e-4f;
+
+  float p = 1.9875691500E-4f;
+  p = p * r + 1.3981999507E-3f;
+  p = p * r + 8.3334519073E-3f;
+  p = p * r + 4.1665795894E-2f;
+  p = p * r + 1.6666665459E-1f;
+  p = p * r + 5.0000001201E-1f;
+  p = p * r * r + r + 1.f;
+
+  uint32_t shiftedBits, magicBits, xBits;
+  memcpy(&shiftedBits, &shifted, sizeof(float));
+  memcpy(&magicBits, &magic, sizeof(float));
+  memcpy(&xBits, &x, sizeof(float));
+
+  // results below normal range flush to zero, x below -88 (-inf included) is checked by its bits since n wraps
+  // around for huge |x|; above ln(FLT_MAX) (+inf included) inf is selected the same way, NaN propagates
+  auto n = static_cast<int32_t>(shiftedBits - magicBits);
+  const bool nan = (xBits & 0x7fffffffu) > 0x7f800000u;
+  const uint32_t keep = ((n > -127) & (xBits <= 0xc2b00000u)) | nan ? 0xffffffffu : 0u;
+  const uint32_t overflow = (static_cast<int32_t>(xBits) > 0x42b17218) & !nan ? 0xffffffffu : 0u;
+
+  // 2^n is applied as two factors, so n = 128 still produces finite results below FLT_MAX
+  n = n < -127 ? -127 : (n > 128 ? 128 : n);
+  const int32_t n1 = n / 2;
+  const uint32_t scaleBits1 = static_cast<uint32_t>(n1 + 127) << 23;
+  const uint32_t scaleBits2 = static_cast<uint32_t>(n - n1 + 127) << 23;
+  float scale1, scale2;
+  memcpy(&scale1, &scaleBits1, sizeof(float));
+  memcpy(&scale2, &scaleBits2, sizeof(float));
+
+  float result = p * scale1 * scale2;
+  uint32_t resultBits;
+  memcpy(&resultBits, &result, sizeof(float));
+  resultBits = (resultBits & keep & ~overflow) | (0x7f800000u & overflow);
+  memcpy(&result, &resultBits, sizeof(float));
+
+  return result;
+}
 
-  if (inEWS >= 1 && outEWS >= 1) {
-    if (inEWS == 1 && outEWS == 1) {
-      for (int i = 0; i < length; i++) max = sd::math::sd_max<T>(max, inBuff[i]);
+template <bool UNIT>
+static SD_INLINE sd::LongType laneOffset(const int k, const sd::LongType stride) {
+  return UNIT ? k : k * stride;
+}
 
-      for (int i = 0; i < length; i++) {
-        outBuff[i] = sd::math::sd_exp<T, T>(inBuff[i] - max);
-        sum += outBuff[i];
-      }
+// running max m and sum of exponents s of every lane, rescaled once per chunk
+template <typename T, bool UNIT>
+static SD_INLINE void maxSumLanes(const T* x, const sd::LongType len, const sd::LongType xAxis,
+                                  const sd::LongType xLane, const int lanes, T* m, T* s) {
+  T cm[kLanes];
 
-      for (int i = 0; i < length; i++) outBuff[i] /= sum;
-    } else {
-      for (int i = 0; i < length; i++) max = sd::math::sd_max<T>(max, inBuff[i * inEWS]);
+  for (sd::LongType j0 = 0; j0 < len; j0 += kChunk) {
+    const auto j1 = sd::math::sd_min<sd::LongType>(j0 + kChunk, len);
 
-      for (int i = 0; i < length; i++) {
-        T r = sd::math::sd_exp<T, T>(inBuff[i * inEWS] - max);
-        outBuff[i * outEWS] = r;
-        sum += r;
-      }
+    for (int k = 0; k < lanes; k++) cm[k] = m[k];
 
-      for (int i = 0; i < length; i++) outBuff[i * outEWS] /= sum;
+    for (auto j = j0; j < j1; j++) {
+      auto xj = x + j * xAxis;
+      PRAGMA_OMP_SIMD
+      for (int k = 0; k < lanes; k++) cm[k] = sd::math::sd_max<T>(cm[k], xj[laneOffset<UNIT>(k, xLane)]);
+    }
+
+    PRAGMA_OMP_SIMD
+    for (int k = 0; k < lanes; k++) {
+      s[k] *= simdExp<T>(m[k] - cm[k]);
+      m[k] = cm[k];
+    }
+
+    for (auto j = j0; j < j1; j++) {
+      auto xj = x + j * xAxis;
+      PRAGMA_OMP_SIMD
+      for (int k = 0; k < lanes; k++) s[k] += simdExp<T>(xj[laneOffset<UNIT>(k, xLane)] - m[k]);
     }
   }
 }
 
-///////////////////////////////////////////////////////////////////
-void softMaxForVector(sd::LaunchContext* context, const NDArray& input, NDArray& output) {
-  if (!input.isVector() || !output.isVector())
-    throw std::runtime_error("ops::helpers::softMaxForVector function: input and output arrays must be vectors !");
+template <typename T>
+static SD_INLINE void maxSum(const T* x, const sd::LongType len, const sd::LongType xAxis, const sd::LongType xLane,
+                             const int lanes, T* m, T* s) {
+  if (xLane == 1)
+    maxSumLanes<T, true>(x, len, xAxis, xLane, lanes, m, s);
+  else
+    maxSumLanes<T, false>(x, len, xAxis, xLane, lanes, m, s);
+}
 
-  auto xType = input.dataType();
-  BUILD_SINGLE_SELECTOR(xType, softMaxForVector_,
-                        (input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo()), SD_FLOAT_TYPES);
+// sum of x (or of x * y) of every lane
+template <typename T, bool UNIT, bool DOT>
+static SD_INLINE void sumLanes(const T* x, const T* y, const sd::LongType len, const sd::LongType xAxis,
+                               const sd::LongType yAxis, const sd::LongType xLane, const sd::LongType yLane,
+                               const int lanes, T* d) {
+  for (sd::LongType j = 0; j < len; j++) {
+    auto xj = x + j * xAxis;
+    auto yj = y + j * yAxis;
+    PRAGMA_OMP_SIMD
+    for (int k = 0; k < lanes; k++)
+      d[k] += DOT ? xj[laneOffset<UNIT>(k, xLane)] * yj[laneOffset<UNIT>(k, yLane)] : xj[laneOffset<UNIT>(k, xLane)];
+  }
 }
 
+template <typename T, bool DOT>
+static SD_INLINE void sum(const T* x, const T* y, const sd::LongType len, const sd::LongType xAxis,
+                          const sd::LongType yAxis, const sd::LongType xLane, const sd::LongType yLane, const int lanes,
+                          T* d) {
+  if (xLane == 1 && yLane == 1)
+    sumLanes<T, true, DOT>(x, y, len, xAxis, yAxis, xLane, yLane, lanes, d);
+  else
+    sumLanes<T, false, DOT>(x, y, len, xAxis, yAxis, xLane, yLane, lanes, d);
+}
+
+// row split into lanes: all lanes get max and sum of the whole row
 template <typename T>
-void softmax_loop(const T* input, T* output, const sd::LongType* offsets, sd::LongType numOfSubArrs, uint32_t tadLen);
+static SD_INLINE void combineMaxSum(const int lanes, T* m, T* s) {
+  T max = m[0];
+  for (int k = 1; k < lanes; k++) max = sd::math::sd_max<T>(max, m[k]);
 
-#if defined(_OPENMP) && !defined(__NEC__)
-template <>
-SD_INLINE void softmax_loop(const float* input, float* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-#pragma omp parallel for default(shared)
-  for (sd::LongType i = 0; i < numOfSubArrs; i++) {
-    auto inBuff = input + offsets[i];
-    auto outBuff = output + offsets[i];
-
-    float max = -DataTypeUtils::max<float>();
-    float sum = 0.f;
-
-#pragma omp simd reduction(max : max)
-    for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<float>(max, inBuff[j]);
-
-#pragma omp simd reduction(+ : sum)
-    for (sd::Unsigned j = 0; j < tadLen; ++j) {
-      float temp = sd::math::sd_exp<float, float>(inBuff[j] - max);
-      outBuff[j] = temp;
-      sum += temp;
-    }
+  T total(0.f);
+  for (int k = 0; k < lanes; k++) total += s[k] * simdExp<T>(m[k] - max);
 
-    for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
+  for (int k = 0; k < lanes; k++) {
+    m[k] = max;
+    s[k] = total;
   }
 }
-#else
-template <>
-SD_INLINE void softmax_loop(const float* input, float* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      auto inBuff = input + offsets[i];
-      auto outBuff = output + offsets[i];
-
-      float max = -DataTypeUtils::max<float>();
-      float sum = 0.f;
-
-      for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<float>(max, inBuff[j]);
-
-      for (sd::Unsigned j = 0; j < tadLen; ++j) {
-        float temp = sd::math::sd_exp<float, float>(inBuff[j] - max);
-        outBuff[j] = temp;
-        sum += temp;
+
+template <typename T>
+static SD_INLINE void combineSum(const int lanes, T* d) {
+  T total(0.f);
+  for (int k = 0; k < lanes; k++) total += d[k];
+
+  for (int k = 0; k < lanes; k++) d[k] = total;
+}
+
+// f is 1 / sum for softmax and derivative, m + log(sum) for log-softmax
+template <typename T, int MODE, bool UNIT>
+static SD_INLINE void writeLanes(const T* x, T* z, const sd::LongType len, const sd::LongType xAxis,
+                                 const sd::LongType zAxis, const sd::LongType xLane, const sd::LongType zLane,
+                                 const int lanes, const T* m, const T* f) {
+  for (sd::LongType j = 0; j < len; j++) {
+    auto xj = x + j * xAxis;
+    auto zj = z + j * zAxis;
+
+    PRAGMA_OMP_SIMD
+    for (int k = 0; k < lanes; k++) {
+      const T v = xj[laneOffset<UNIT>(k, xLane)];
+      T r;
+      if (MODE == SOFTMAX_LOG) {
+        r = v - f[k];
+      } else {
+        r = simdExp<T>(v - m[k]) * f[k];
+        if (MODE == SOFTMAX_DERIVATIVE) r *= (T(1.f) - r);
       }
 
-      for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
+      zj[laneOffset<UNIT>(k, zLane)] = r;
     }
-  };
-
-  samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+  }
 }
 
-#endif
+template <typename T, int MODE>
+static SD_INLINE void write(const T* x, T* z, const sd::LongType len, const sd::LongType xAxis,
+                            const sd::LongType zAxis, const sd::LongType xLane, const sd::LongType zLane,
+                            const int lanes, const T* m, const T* f) {
+  if (xLane == 1 && zLane == 1)
+    writeLanes<T, MODE, true>(x, z, len, xAxis, zAxis, xLane, zLane, lanes, m, f);
+  else
+    writeLanes<T, MODE, false>(x, z, len, xAxis, zAxis, xLane, zLane, lanes, m, f);
+}
 
-template <typename T>
-SD_INLINE void softmax_loop(const T* input, T* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      auto inBuff = input + offsets[i];
-      auto outBuff = output + offsets[i];
-
-      T max = -DataTypeUtils::max<T>();
-      T sum(0.f);
-
-      PRAGMA_OMP_SIMD_MAX_2(max)
-      for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<T>(max, inBuff[j]);
-      PRAGMA_OMP_SIMD_SUM(sum)
-      for (sd::Unsigned j = 0; j < tadLen; ++j) {
-        T temp = sd::math::sd_exp<T, T>(inBuff[j] - max);
-        outBuff[j] = temp;
-        sum += temp;
-      }
+// softmax, log-softmax or softmax derivative of x (y is unused), built for every ISA level via IsaDispatch
+template <typename T, int MODE>
+struct SoftmaxKernel {
+  static SD_INLINE void run(const T* x, const T* y, T* z, const SoftmaxBlock b) {
+    T m[kLanes], f[kLanes];
+    for (int k = 0; k < kLanes; k++) {
+      m[k] = -DataTypeUtils::max<T>();
+      f[k] = static_cast<T>(0.f);
+    }
 
-      for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
+    maxSum(x, b.len, b.axis[0], b.lane[0], b.lanes, m, f);
+    if (b.row) {
+      maxSum(x + b.len * b.axis[0], b.tail > 0 ? 1 : 0, b.axis[0], b.lane[0], static_cast<int>(b.tail), m, f);
+      combineMaxSum(b.lanes, m, f);
     }
-  };
 
-  samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+    for (int k = 0; k < b.lanes; k++)
+      f[k] = MODE == SOFTMAX_LOG ? m[k] + sd::math::sd_log<T, T>(f[k]) : static_cast<T>(1.f) / f[k];
+
+    write<T, MODE>(x, z, b.len, b.axis[0], b.axis[2], b.lane[0], b.lane[2], b.lanes, m, f);
+    if (b.row && b.tail > 0)
+      write<T, MODE>(x + b.len * b.axis[0], z + b.len * b.axis[2], 1, b.axis[0], b.axis[2], b.lane[0], b.lane[2],
+                     static_cast<int>(b.tail), m, f);
+  }
+};
+
+// gradI = y * (gradO - sum(y * gradO)), where y is softmax output
+template <typename T, bool UNIT>
+static SD_INLINE void softmaxBpLanes(const T* y, const T* g, T* z, const sd::LongType len, const SoftmaxBlock& b,
+                                     const int lanes, const T* d) {
+  for (sd::LongType j = 0; j < len; j++) {
+    auto yj = y + j * b.axis[0];
+    auto gj = g + j * b.axis[1];
+    auto zj = z + j * b.axis[2];
+
+    PRAGMA_OMP_SIMD
+    for (int k = 0; k < lanes; k++)
+      zj[laneOffset<UNIT>(k, b.lane[2])] =
+          yj[laneOffset<UNIT>(k, b.lane[0])] * (gj[laneOffset<UNIT>(k, b.lane[1])] - d[k]);
+  }
 }
 
-//////////////////////////////////////////////////////////////////////////
+// gradI = gradO - softmax(x) * sum(gradO), f is sum(gradO) / sum(exp(x - m))
+template <typename T, bool UNIT>
+static SD_INLINE void logSoftmaxBpLanes(const T* x, const T* g, T* z, const sd::LongType len, const SoftmaxBlock& b,
+                                        const int lanes, const T* m, const T* f) {
+  for (sd::LongType j = 0; j < len; j++) {
+    auto xj = x + j * b.axis[0];
+    auto gj = g + j * b.axis[1];
+    auto zj = z + j * b.axis[2];
+
+    PRAGMA_OMP_SIMD
+    for (int k = 0; k < lanes; k++)
+      zj[laneOffset<UNIT>(k, b.lane[2])] =
+          gj[laneOffset<UNIT>(k, b.lane[1])] - simdExp<T>(xj[laneOffset<UNIT>(k, b.lane[0])] - m[k]) * f[k];
+  }
+}
+
+static SD_INLINE bool unitLanes(const SoftmaxBlock& b) { return b.lane[0] == 1 && b.lane[1] == 1 && b.lane[2] == 1; }
+
 template <typename T>
-static void softmax_(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  const int rank = input.rankOf();
+struct SoftmaxBpKernel {
+  static SD_INLINE void run(const T* y, const T* g, T* z, const SoftmaxBlock b) {
+    T d[kLanes];
+    for (int k = 0; k < kLanes; k++) d[k] = static_cast<T>(0.f);
+
+    const auto tail = static_cast<int>(b.tail);
+    const auto yTail = y + b.len * b.axis[0];
+    const auto gTail = g + b.len * b.axis[1];
+    const auto zTail = z + b.len * b.axis[2];
+
+    sum<T, true>(y, g, b.len, b.axis[0], b.axis[1], b.lane[0], b.lane[1], b.lanes, d);
+    if (b.row) {
+      sum<T, true>(yTail, gTail, tail > 0 ? 1 : 0, b.axis[0], b.axis[1], b.lane[0], b.lane[1], tail, d);
+      combineSum(b.lanes, d);
+    }
 
-  if (input.isVector()) {
-    if (rank == 1 || input.sizeAt(dimension) != 1)
-      softMaxForVector_<T>(input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo());
-    else
-      output = 1.;
-  } else if (input.isSameShapeStrict(output)) {
-    TadPack tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(input.shapeInfo(), dimension);
-    auto tadShapeInfo = tadPack.primaryShapeInfo();
-    auto tadOffsets = tadPack.primaryOffsets();
-    const sd::Unsigned numOfSubArrs = tadPack.numberOfTads();
-    const sd::Unsigned tadLen = shape::length(tadShapeInfo);
-
-    if (shape::elementWiseStride(tadShapeInfo) == 1) {
-      auto inBuff = input.bufferAsT<T>();
-      T* outBuff = output.bufferAsT<T>();
-
-      softmax_loop(inBuff, outBuff, tadOffsets, numOfSubArrs, tadLen);
+    if (unitLanes(b)) {
+      softmaxBpLanes<T, true>(y, g, z, b.len, b, b.lanes, d);
+      if (b.row && tail > 0) softmaxBpLanes<T, true>(yTail, gTail, zTail, 1, b, tail, d);
     } else {
-      sd::Unsigned inShapeInfoCast[SD_MAX_RANK];
-      bool canCast = sd::DataTypeUtils::castShapeInfo(tadShapeInfo, inShapeInfoCast);
+      softmaxBpLanes<T, false>(y, g, z, b.len, b, b.lanes, d);
+      if (b.row && tail > 0) softmaxBpLanes<T, false>(yTail, gTail, zTail, 1, b, tail, d);
+    }
+  }
+};
 
-      auto offsets = new sd::LongType[tadLen];
-      shape::calcOffsets(tadShapeInfo, offsets);
+template <typename T>
+struct LogSoftmaxBpKernel {
+  static SD_INLINE void run(const T* x, const T* g, T* z, const SoftmaxBlock b) {
+    T m[kLanes], s[kLanes], f[kLanes];
+    for (int k = 0; k < kLanes; k++) {
+      m[k] = -DataTypeUtils::max<T>();
+      s[k] = static_cast<T>(0.f);
+      f[k] = static_cast<T>(0.f);
+    }
 
-      auto func = PRAGMA_THREADS_FOR {
-        for (auto i = start; i < stop; i++) {
-          auto inBuff = input.bufferAsT<T>() + tadOffsets[i];
-          auto outBuff = output.bufferAsT<T>() + tadOffsets[i];
+    const auto tail = static_cast<int>(b.tail);
+    const auto xTail = x + b.len * b.axis[0];
+    const auto gTail = g + b.len * b.axis[1];
+    const auto zTail = z + b.len * b.axis[2];
+
+    maxSum(x, b.len, b.axis[0], b.lane[0], b.lanes, m, s);
+    sum<T, false>(g, g, b.len, b.axis[1], b.axis[1], b.lane[1], b.lane[1], b.lanes, f);
+    if (b.row) {
+      maxSum(xTail, tail > 0 ? 1 : 0, b.axis[0], b.lane[0], tail, m, s);
+      sum<T, false>(gTail, gTail, tail > 0 ? 1 : 0, b.axis[1], b.axis[1], b.lane[1], b.lane[1], tail, f);
+      combineMaxSum(b.lanes, m, s);
+      combineSum(b.lanes, f);
+    }
 
-          T max = -DataTypeUtils::max<T>();
-          T sum = 0.f;
+    for (int k = 0; k < b.lanes; k++) f[k] /= s[k];
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<T>(max, inBuff[offsets[j]]);
+    if (unitLanes(b)) {
+      logSoftmaxBpLanes<T, true>(x, g, z, b.len, b, b.lanes, m, f);
+      if (b.row && tail > 0) logSoftmaxBpLanes<T, true>(xTail, gTail, zTail, 1, b, tail, m, f);
+    } else {
+      logSoftmaxBpLanes<T, false>(x, g, z, b.len, b, b.lanes, m, f);
+      if (b.row && tail > 0) logSoftmaxBpLanes<T, false>(xTail, gTail, zTail, 1, b, tail, m, f);
+    }
+  }
+};
+
+// single row of given length, with element strides of every array
+static SoftmaxBlock rowBlock(const sd::LongType length, const sd::LongType* strides) {
+  SoftmaxBlock block;
+  block.len = length / kRowLanes;
+  block.tail = length % kRowLanes;
+  block.lanes = kRowLanes;
+  block.row = true;
+
+  for (int e = 0; e < 3; e++) {
+    block.axis[e] = strides[e] * kRowLanes;
+    block.lane[e] = strides[e];
+  }
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) {
-            T temp = sd::math::sd_exp<T, T>(inBuff[offsets[j]] - max);
-            outBuff[offsets[j]] = temp;
-            sum += temp;
-          }
+  return block;
+}
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[offsets[j]] /= sum;
-        }
-      };
+template <typename Kernel, typename T>
+static void execSoftmax(const SoftmaxLayout& l, const T* x, const T* y, T* z) {
+  if (l.inner == 1) {
+    auto func = PRAGMA_THREADS_FOR {
+      const auto block = rowBlock(l.axis, l.axisStride);
 
-      samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+      for (auto i = start; i < stop; i++)
+        IsaDispatch<Kernel>::run(x + i * l.outerStride[0], y + i * l.outerStride[1], z + i * l.outerStride[2], block);
+    };
 
-      delete[] offsets;
-    }
+    samediff::Threads::parallel_tad(func, 0, l.outer);
   } else {
-    NDArray max = input.reduceAlongDimension(sd::reduce::Max, {dimension}, true);
-    input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), max, output, false);
-    output.applyTransform(sd::transform::Exp, output);
-    NDArray sum = output.reduceAlongDimension(sd::reduce::Sum, {dimension}, true);
-    output /= sum;
+    const sd::LongType numBlocks = (l.inner + kLanes - 1) / kLanes;
+
+    auto func = PRAGMA_THREADS_FOR {
+      SoftmaxBlock block;
+      block.len = l.axis;
+      block.tail = 0;
+      block.row = false;
+      for (int e = 0; e < 3; e++) {
+        block.axis[e] = l.axisStride[e];
+        block.lane[e] = l.innerStride[e];
+      }
+
+      for (auto i = start; i < stop; i++) {
+        const auto o = i / numBlocks;
+        const auto first = (i % numBlocks) * kLanes;
+        block.lanes = static_cast<int>(sd::math::sd_min<sd::LongType>(kLanes, l.inner - first));
+
+        sd::LongType offsets[3];
+        for (int e = 0; e < 3; e++) offsets[e] = o * l.outerStride[e] + first * l.innerStride[e];
+
+        IsaDispatch<Kernel>::run(x + offsets[0], y + offsets[1], z + offsets[2], block);
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, l.outer * numBlocks);
+  }
+}
+
+template <typename T>
+static void softMaxForVector_(void const* input, sd::LongType const* inShapeInfo, void* output,
+                              sd::LongType const* outShapeInfo) {
+  auto inBuff = reinterpret_cast<T const*>(input);
+  auto outBuff = reinterpret_cast<T*>(output);
+
+  sd::LongType inEWS = shape::elementWiseStride(inShapeInfo);
+  sd::LongType outEWS = shape::elementWiseStride(outShapeInfo);
+  sd::LongType length = shape::length(inShapeInfo);
+
+  if (inEWS >= 1 && outEWS >= 1) {
+    const sd::LongType strides[3] = {inEWS, inEWS, outEWS};
+    IsaDispatch<SoftmaxKernel<T, SOFTMAX_FORWARD>>::run(inBuff, inBuff, outBuff, rowBlock(length, strides));
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+void softMaxForVector(sd::LaunchContext* context, const NDArray& input, NDArray& output) {
+  if (!input.isVector() || !output.isVector())
+    throw std::runtime_error("ops::helpers::softMaxForVector function: input and output arrays must be vectors !");
+
+  auto xType = input.dataType();
+  BUILD_SINGLE_SELECTOR(xType, softMaxForVector_,
+                        (input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo()), SD_FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void softmax_(sd::LaunchContext* context, const NDArray& input, NDArray& output, int dimension,
+                     const int mode) {
+  if (input.isEmpty()) return;
+  if (dimension < 0) dimension += input.rankOf();
+
+  SoftmaxLayout layout;
+  if (buildLayout(input, input, output, dimension, layout)) {
+    auto x = input.bufferAsT<T>();
+    auto z = output.bufferAsT<T>();
+
+    if (mode == SOFTMAX_LOG)
+      execSoftmax<SoftmaxKernel<T, SOFTMAX_LOG>>(layout, x, x, z);
+    else if (mode == SOFTMAX_DERIVATIVE)
+      execSoftmax<SoftmaxKernel<T, SOFTMAX_DERIVATIVE>>(layout, x, x, z);
+    else
+      execSoftmax<SoftmaxKernel<T, SOFTMAX_FORWARD>>(layout, x, x, z);
+
+    return;
+  }
+
+  // views which can't be described by [outer, axis, inner] layout
+  NDArray max = input.reduceAlongDimension(sd::reduce::Max, {dimension}, true);
+  input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), max, output, false);
+  output.applyTransform(sd::transform::Exp, output);
+  NDArray sum = output.reduceAlongDimension(sd::reduce::Sum, {dimension}, true);
+  output /= sum;
+
+  if (mode == SOFTMAX_LOG) output.applyTransform(sd::transform::Log, output);
+  if (mode == SOFTMAX_DERIVATIVE) output *= (1.f - output);
+}
+
+template <typename T>
+static void softmaxBp_(sd::LaunchContext* context, const NDArray& output, const NDArray& gradO, NDArray& gradI,
+                       int dimension) {
+  if (output.isEmpty()) return;
+  if (dimension < 0) dimension += output.rankOf();
+
+  SoftmaxLayout layout;
+  if (buildLayout(output, gradO, gradI, dimension, layout)) {
+    execSoftmax<SoftmaxBpKernel<T>>(layout, output.bufferAsT<T>(), gradO.bufferAsT<T>(), gradI.bufferAsT<T>());
+    return;
+  }
+
+  auto sumAlongDim = (output * gradO).reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(output * (gradO - sumAlongDim));
+}
+
+template <typename T>
+static void logSoftmaxBp_(sd::LaunchContext* context, const NDArray& input, const NDArray& gradO, NDArray& gradI,
+                          int dimension) {
+  if (input.isEmpty()) return;
+  if (dimension < 0) dimension += input.rankOf();
+
+  SoftmaxLayout layout;
+  if (buildLayout(input, gradO, gradI, dimension, layout)) {
+    execSoftmax<LogSoftmaxBpKernel<T>>(layout, input.bufferAsT<T>(), gradO.bufferAsT<T>(), gradI.bufferAsT<T>());
+    return;
   }
+
+  softmax_<T>(context, input, gradI, dimension, SOFTMAX_FORWARD);
+  auto sumGradO = gradO.reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(gradO - gradI * sumGradO);
 }
 
 ///////////////////////////////////////////////////////////////////
 void softmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (context, input, output, dimension), SD_FLOAT_TYPES);
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (context, input, output, dimension, SOFTMAX_FORWARD),
+                        SD_FLOAT_TYPES);
+}
+
+///////////////////////////////////////////////////////////////////
+void logSoftmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (context, input, output, dimension, SOFTMAX_LOG), SD_FLOAT_TYPES);
+}
+
+///////////////////////////////////////////////////////////////////
+void softmaxDerivative(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (context, input, output, dimension, SOFTMAX_DERIVATIVE),
+                        SD_FLOAT_TYPES);
+}
+
+///////////////////////////////////////////////////////////////////
+void softmaxBp(sd::LaunchContext* context, const NDArray& output, const NDArray& gradO, NDArray& gradI,
+               const int dimension) {
+  BUILD_SINGLE_SELECTOR(output.dataType(), softmaxBp_, (context, output, gradO, gradI, dimension), SD_FLOAT_TYPES);
+}
+
+///////////////////////////////////////////////////////////////////
+void logSoftmaxBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gradO, NDArray& gradI,
+                  const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), logSoftmaxBp_, (context, input, gradO, gradI, dimension), SD_FLOAT_TYPES);
 }
 
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
-#endif
\ No newline at end of file
+#endif
@@ -21,108 +21,133 @@
 //
 #include <array/NDArrayFactory.h>
 #include <execution/Threads.h>
+#include <helpers/ConstantTadHelper.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <ops/declarable/helpers/top_k.h>
+
+#include <algorithm>
 #if NOT_EXCLUDED(OP_top_k)
 namespace sd {
 namespace ops {
 namespace helpers {
 
+// elements are compared by value first, and among equal values the one with lower index wins
 template <typename T>
+static SD_INLINE bool topKBetter(const std::pair<T, sd::LongType>& a, const std::pair<T, sd::LongType>& b) {
+  return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+// number of row elements checked against the running threshold at once
+static const sd::LongType TOP_K_BLOCK = 64;
+
+template <typename T, typename I>
 static sd::Status topKFunctor_(const NDArray* input, NDArray* values, NDArray* indices, const sd::Unsigned k,
                                bool needSort) {
-  sd::LongType width = input->sizeAt(-1);
-  int lastDim = input->rankOf() - 1;
-  // ----------------------------------------------------------------------------------------------- //
-  // this assumption is right:
-  //        if (values->lengthOf() != k * lastDimList->size()) {
-  //            sd_printf("top_k: something is wrong. %i expected, but %i given.\n",
-  //                values->lengthOf(), k * lastDimList->size());
-  //        }
-  // ----------------------------------------------------------------------------------------------- //
-  std::vector<sd::LongType> dimsToExclude(input->rankOf() - 1);
-  for (size_t d = 0; d < dimsToExclude.size(); ++d) dimsToExclude[d] = d;
-
-  const sd::LongType numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->shapeInfo(), dimsToExclude);
-
-  if (k == 1) {
-    for (sd::LongType e = 0; e < numOfSubArrs; ++e) {
-      auto trial = (*input)(e, dimsToExclude);
-      sd::LongType maxPos = 0;
-      T maxVal = trial.e<T>(0);
-      for (sd::LongType pos = 1; pos < trial.lengthOf(); pos++)
-        if (maxVal < trial.e<T>(pos)) {
-          maxPos = pos;
-          maxVal = trial.e<T>(pos);
-        }
-      if (indices) indices->p(e, maxPos);  // topIndex;
-      if (values) values->p(e, maxVal);
-    }
-  } else {
-    int nextPos = 0;
-
-    for (sd::LongType e = 0; e < numOfSubArrs; ++e) {
-      auto trial = (*input)(e, dimsToExclude);
-
-      // fill up the first k elements
-      NDArray topValues = NDArrayFactory::create<T>('c', {k}, input->getContext());
-      NDArray sortedVals = NDArrayFactory::create<T>('c', {k}, input->getContext());
-      NDArray topIndices = NDArrayFactory::create<sd::LongType>('c', {k}, input->getContext());
-      for (sd::Unsigned pos = 0; pos < k; ++pos) {
-        topIndices.r<sd::LongType>(pos) = pos;
-        topValues.r<T>(pos) = trial.t<T>(pos);
-      }
-      // std::vector<T> sortedVals(topValues);
-      sortedVals.assign(topValues);  // = NDArrayFactory::create<T>('c', {k});
-      // std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-      SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-      for (sd::LongType i = static_cast<sd::LongType>(k); i < width; ++i) {
-        T val = trial.e<T>(i);
-        T minTopVal = sortedVals.t<T>(0);
-        if (minTopVal < val) {  // value should be inserted to top k
-          // only if it is not contained in
-          T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-          T* end = begin + k;
-          bool exists = std::binary_search(begin, end, val);
-          if (!exists) {
-            // exchangePos - a distance between begin and minimal existed to be suppressed by val
-            T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-            T* topEnd = topBegin + k;
-            auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-            topValues.r<T>(exchangePos) = val;  //*exchangeIt = val;
-            topIndices.r<sd::LongType>(exchangePos) = i;
-            sortedVals.r<T>(0) = val;  // suppress in sorted
-            // std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-            SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
+  const sd::LongType width = input->sizeAt(-1);
+  const sd::LongType lastDim = input->rankOf() - 1;
+
+  if (input->isEmpty() || width == 0) return sd::Status::OK;
+
+  // rows are read and written in place, with strides
+  auto packX = sd::ConstantTadHelper::getInstance().tadForDimensions(input->shapeInfo(), lastDim);
+  const sd::LongType numOfRows = packX.numberOfTads();
+  const sd::LongType xStride = input->strideAt(lastDim);
+  const auto xOffsets = packX.primaryOffsets();
+  const auto x = input->bufferAsT<T>();
+
+  const sd::LongType* vOffsets = nullptr;
+  const sd::LongType* iOffsets = nullptr;
+  sd::LongType vStride = 0, iStride = 0;
+  T* v = nullptr;
+  I* idx = nullptr;
+
+  if (values != nullptr) {
+    auto packV = sd::ConstantTadHelper::getInstance().tadForDimensions(values->shapeInfo(), lastDim);
+    vOffsets = packV.primaryOffsets();
+    vStride = values->strideAt(lastDim);
+    v = values->bufferAsT<T>();
+  }
+
+  if (indices != nullptr) {
+    auto packI = sd::ConstantTadHelper::getInstance().tadForDimensions(indices->shapeInfo(), lastDim);
+    iOffsets = packI.primaryOffsets();
+    iStride = indices->strideAt(lastDim);
+    idx = indices->bufferAsT<I>();
+  }
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<std::pair<T, sd::LongType>> heap(k);
+
+    for (auto r = start; r < stop; r++) {
+      const T* row = x + xOffsets[r];
+
+      if (k == 1) {
+        sd::LongType maxPos = 0;
+        T maxVal = row[0];
+        for (sd::LongType pos = 1; pos < width; pos++)
+          if (maxVal < row[pos * xStride]) {
+            maxPos = pos;
+            maxVal = row[pos * xStride];
+          }
+
+        heap[0] = std::make_pair(maxVal, maxPos);
+      } else {
+        // heap of the best k elements seen so far, ordered so that the worst of them is on top
+        for (sd::Unsigned pos = 0; pos < k; pos++) heap[pos] = std::make_pair(row[pos * xStride], pos);
+        std::make_heap(heap.begin(), heap.end(), topKBetter<T>);
+
+        for (sd::LongType b = k; b < width; b += TOP_K_BLOCK) {
+          const sd::LongType blockEnd = sd::math::sd_min<sd::LongType>(b + TOP_K_BLOCK, width);
+          const T threshold = heap.front().first;
+
+          // most blocks have nothing above the threshold, so they are rejected with single vectorized pass
+          int above = 0;
+          if (xStride == 1) {
+            PRAGMA_OMP_SIMD_SUM(above)
+            for (sd::LongType i = b; i < blockEnd; i++) above += row[i] > threshold ? 1 : 0;
+          } else {
+            for (sd::LongType i = b; i < blockEnd; i++) above += row[i * xStride] > threshold ? 1 : 0;
+          }
+
+          if (above == 0) continue;
+
+          for (sd::LongType i = b; i < blockEnd; i++) {
+            const T val = row[i * xStride];
+
+            // equal value can't win: it has higher index than anything in the heap
+            if (!(val > heap.front().first)) continue;
+
+            std::pop_heap(heap.begin(), heap.end(), topKBetter<T>);
+            heap.back() = std::make_pair(val, i);
+            std::push_heap(heap.begin(), heap.end(), topKBetter<T>);
           }
         }
+
+        if (needSort)
+          std::sort(heap.begin(), heap.end(), topKBetter<T>);
+        else
+          std::sort(heap.begin(), heap.end(),
+                    [](const std::pair<T, sd::LongType>& a, const std::pair<T, sd::LongType>& b) -> bool {
+                      return a.second < b.second;
+                    });
       }
-      if (needSort) {
-        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
-
-        for (sd::LongType j = 0; j < width; j++)
-          for (sd::Unsigned pos = 0; pos < k; ++pos)
-            if (topValues.t<T>(pos) == trial.t<T>(j)) topIndices.r<sd::LongType>(pos) = j;
-      } else {  // else sort by indices
-        std::map<sd::LongType, T> sortValsMap;
-        // std::vector<std::pair<int, T>> data(topValues.lengthOf());
-        for (sd::LongType e = 0; e < topValues.lengthOf(); ++e) {
-          sortValsMap[topIndices.t<sd::LongType>(e)] = topValues.t<T>(e);
-        }
 
-        // std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-        //    return a.first < b.first;
-        //});
-        sd::LongType e = 0;
-        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-          topIndices.r<sd::LongType>(e) = it->first;
-          topValues.r<T>(e) = it->second;
-        }
+      if (v != nullptr) {
+        auto vRow = v + vOffsets[r];
+        for (sd::Unsigned pos = 0; pos < k; pos++) vRow[pos * vStride] = heap[pos].first;
+      }
+
+      if (idx != nullptr) {
+        auto iRow = idx + iOffsets[r];
+        for (sd::Unsigned pos = 0; pos < k; pos++) iRow[pos * iStride] = static_cast<I>(heap[pos].second);
       }
-      if (values) (*values)(e, dimsToExclude).assign(topValues);
-      if (indices) (*indices)(e, dimsToExclude).assign(topIndices);
     }
-  }
+  };
+
+  NDArray::preparePrimaryUse({values, indices}, {input});
+  samediff::Threads::parallel_tad(func, 0, numOfRows);
+  NDArray::registerPrimaryUse({values, indices}, {input});
+
   return sd::Status::OK;
 }
 // ----------------------------------------------------------------------------------------------- //
@@ -158,8 +183,10 @@ static sd::Status inTopKFunctor_(sd::LaunchContext* context, const NDArray* inpu
 
 sd::Status topKFunctor(sd::LaunchContext* context, const NDArray* input, NDArray* values, NDArray* indices,
                        const sd::Unsigned k, bool needSort) {
-  BUILD_SINGLE_SELECTOR(input->dataType(), return topKFunctor_, (input, values, indices, k, needSort),
-                        SD_NUMERIC_TYPES);
+  // indices output may be of any indexing type, and without it the index type doesn't matter
+  const auto indexType = indices != nullptr ? indices->dataType() : sd::DataType::INT64;
+  BUILD_DOUBLE_SELECTOR(input->dataType(), indexType, return topKFunctor_, (input, values, indices, k, needSort),
+                        SD_NUMERIC_TYPES, SD_INDEXING_TYPES);
 }
 
 sd::Status inTopKFunctor(sd::LaunchContext* context, const NDArray* input, const NDArray* target, NDArray* result,
@@ -168,9 +195,9 @@ sd::Status inTopKFunctor(sd::LaunchContext* context, const NDArray* input, const
                         SD_NUMERIC_TYPES);
 }
 
-BUILD_SINGLE_TEMPLATE(template sd::Status topKFunctor_,
+BUILD_DOUBLE_TEMPLATE(template sd::Status topKFunctor_,
                       (const NDArray* input, NDArray* values, NDArray* indices, const sd::Unsigned k, bool needSort),
-                      SD_NUMERIC_TYPES);
+                      SD_NUMERIC_TYPES, SD_INDEXING_TYPES);
 BUILD_SINGLE_TEMPLATE(template sd::Status inTopKFunctor_,
                       (sd::LaunchContext * context, const NDArray* input, const NDArray* target, NDArray* result,
                        const sd::Unsigned k),
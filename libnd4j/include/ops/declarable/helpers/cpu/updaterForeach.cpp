@@ -0,0 +1,257 @@
+/*
+ *  ******************************************************************************
+ *  *
+ *  *
+ *  * This program and the accompanying materials are made available under the
+ *  * terms of the Apache License, Version 2.0 which is available at
+ *  * https://www.apache.org/licenses/LICENSE-2.0.
+ *  *
+ *  * See the NOTICE file distributed with this work for additional
+ *  * information regarding copyright ownership.
+ *  * Unless required by applicable law or agreed to in writing, software
+ *  * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  * License for the specific language governing permissions and limitations
+ *  * under the License.
+ *  *
+ *  * SPDX-License-Identifier: Apache-2.0
+ *  *****************************************************************************
+ */
+
+//
+// Multi-tensor updaters: all parameters of a model are updated within one parallel pass
+//
+#include <execution/Threads.h>
+#include <math/platformmath.h>
+#include <math/templatemath.h>
+#include <ops/declarable/helpers/updatersHelpers.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// buffers of every role (inputs first, outputs after them) for a run of elements stored one after another
+template <typename T, int ROLES>
+struct ForeachRange {
+  T* buffers[ROLES];
+  sd::LongType length;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dense tensors are joined into a single element space, which is split evenly between threads regardless of
+// tensor boundaries. Tensors that are views of one flat buffer (allocated that way on java side) continue each other
+// in memory, such tensors are merged into one range. Strided tensors go to the single-tensor helper instead.
+template <typename T, int ROLES, typename KERNEL, typename FALLBACK>
+static void updaterForeach_(const std::vector<NDArray*>* const (&roles)[ROLES], const KERNEL& kernel,
+                            const FALLBACK& fallback) {
+  std::vector<ForeachRange<T, ROLES>> ranges;
+  // range k covers elements [offsets[k], offsets[k + 1])
+  std::vector<sd::LongType> offsets(1, 0);
+
+  const auto numTensors = roles[0]->size();
+  for (size_t i = 0; i < numTensors; i++) {
+    auto gradient = roles[0]->at(i);
+    if (gradient->isEmpty()) continue;
+
+    bool dense = true;
+    for (int r = 0; r < ROLES; r++)
+      dense &= roles[r]->at(i)->ews() == 1 && roles[r]->at(i)->ordering() == gradient->ordering();
+
+    if (!dense) {
+      fallback(i);
+      continue;
+    }
+
+    ForeachRange<T, ROLES> range;
+    for (int r = 0; r < ROLES; r++) range.buffers[r] = roles[r]->at(i)->template bufferAsT<T>();
+    range.length = gradient->lengthOf();
+
+    bool adjacent = !ranges.empty();
+    for (int r = 0; r < ROLES && adjacent; r++)
+      adjacent = ranges.back().buffers[r] + ranges.back().length == range.buffers[r];
+
+    if (adjacent) {
+      ranges.back().length += range.length;
+      offsets.back() += range.length;
+    } else {
+      ranges.emplace_back(range);
+      offsets.emplace_back(offsets.back() + range.length);
+    }
+  }
+
+  if (ranges.empty()) return;
+
+  auto func = PRAGMA_THREADS_FOR {
+    auto k = std::upper_bound(offsets.begin(), offsets.end(), start) - offsets.begin() - 1;
+    for (auto e = start; e < stop; k++) {
+      const auto end = sd::math::sd_min<sd::LongType>(stop, offsets[k + 1]);
+      kernel(ranges[k].buffers, e - offsets[k], end - offsets[k]);
+      e = end;
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, offsets.back(), 1);
+}
+
+#if NOT_EXCLUDED(OP_adam_updater_foreach)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void adamUpdaterForeach_(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                const std::vector<NDArray*>& initStatesU, const std::vector<NDArray*>& initStatesM,
+                                const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesU,
+                                const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                                const double dBeta2, const double dEpsilon, const int nIteration) {
+  const T lr = static_cast<T>(dLr);
+  const T beta1 = static_cast<T>(dBeta1);
+  const T beta2 = static_cast<T>(dBeta2);
+  const T epsilon = static_cast<T>(dEpsilon);
+  const T iteration = static_cast<T>(nIteration);
+
+  const T beta1T = sd::math::sd_pow<T, T, T>(beta1, (iteration + 1));
+  const T beta2T = sd::math::sd_pow<T, T, T>(beta2, (iteration + 1));
+
+  T epsilonT = lr * sd::math::sd_sqrt<T, T>(1. - beta2T) / (1.0 - beta1T);
+  if (sd::math::sd_isnan(epsilonT) || 0 == epsilonT || sd::math::sd_isinf(epsilonT)) epsilonT = epsilon;
+
+  auto kernel = [&](T* const* buffers, sd::LongType start, sd::LongType stop) {
+    const T* grad = buffers[0];
+    const T* initU = buffers[1];
+    const T* initM = buffers[2];
+    T* up = buffers[3];
+    T* stU = buffers[4];
+    T* stM = buffers[5];
+
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) {
+      stM[i] = beta1 * initM[i] + grad[i] * (1 - beta1);
+      stU[i] = beta2 * initU[i] + grad[i] * grad[i] * (1 - beta2);
+      up[i] = (stM[i] * epsilonT) / (sd::math::sd_sqrt<T, T>(stU[i]) + epsilon);
+    }
+  };
+
+  auto fallback = [&](size_t i) {
+    updaterAdam(context, *gradients[i], *initStatesU[i], *initStatesM[i], *updates[i], *statesU[i], *statesM[i], dLr,
+                dBeta1, dBeta2, dEpsilon, nIteration);
+  };
+
+  const std::vector<NDArray*>* const roles[6] = {&gradients, &initStatesU, &initStatesM, &updates, &statesU, &statesM};
+  updaterForeach_<T, 6>(roles, kernel, fallback);
+}
+
+void updaterAdamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                        const std::vector<NDArray*>& initStatesU, const std::vector<NDArray*>& initStatesM,
+                        const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesU,
+                        const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                        const double dBeta2, const double dEpsilon, const int nIteration) {
+  BUILD_SINGLE_SELECTOR(gradients[0]->dataType(), adamUpdaterForeach_,
+                        (context, gradients, initStatesU, initStatesM, updates, statesU, statesM, dLr, dBeta1, dBeta2,
+                         dEpsilon, nIteration),
+                        SD_FLOAT_TYPES);
+}
+#endif
+
+#if NOT_EXCLUDED(OP_nadam_updater_foreach)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void nadamUpdaterForeach_(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                 const std::vector<NDArray*>& initStatesV, const std::vector<NDArray*>& initStatesM,
+                                 const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesV,
+                                 const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                                 const double dBeta2, const double dEpsilon, const int nIteration) {
+  const T lr = static_cast<T>(dLr);
+  const T beta1 = static_cast<T>(dBeta1);
+  const T beta2 = static_cast<T>(dBeta2);
+  const T epsilon = static_cast<T>(dEpsilon);
+  const T iteration = static_cast<T>(nIteration);
+
+  const T mbeta1T = 1.0 - sd::math::sd_pow<T, T, T>(beta1, (iteration + 1));
+  const T mbeta1 = (1 - beta1);
+  const T mbeta2 = (1 - beta2);
+
+  auto kernel = [&](T* const* buffers, sd::LongType start, sd::LongType stop) {
+    const T* grad = buffers[0];
+    const T* initV = buffers[1];
+    const T* initM = buffers[2];
+    T* up = buffers[3];
+    T* stV = buffers[4];
+    T* stM = buffers[5];
+
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) {
+      auto oneMinusBeta1Grad = grad[i] * mbeta1;
+
+      stM[i] = beta1 * initM[i] + oneMinusBeta1Grad;
+      stV[i] = beta2 * initV[i] + grad[i] * grad[i] * mbeta2;
+
+      up[i] = (lr * ((stM[i] * beta1 + oneMinusBeta1Grad) / mbeta1T)) / (sd::math::sd_sqrt<T, T>(stV[i]) + epsilon);
+    }
+  };
+
+  auto fallback = [&](size_t i) {
+    updaterNadam(context, *gradients[i], *initStatesV[i], *initStatesM[i], *updates[i], *statesV[i], *statesM[i],
+                 dLr, dBeta1, dBeta2, dEpsilon, nIteration);
+  };
+
+  const std::vector<NDArray*>* const roles[6] = {&gradients, &initStatesV, &initStatesM, &updates, &statesV, &statesM};
+  updaterForeach_<T, 6>(roles, kernel, fallback);
+}
+
+void updaterNadamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                         const std::vector<NDArray*>& initStatesV, const std::vector<NDArray*>& initStatesM,
+                         const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesV,
+                         const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                         const double dBeta2, const double dEpsilon, const int nIteration) {
+  BUILD_SINGLE_SELECTOR(gradients[0]->dataType(), nadamUpdaterForeach_,
+                        (context, gradients, initStatesV, initStatesM, updates, statesV, statesM, dLr, dBeta1, dBeta2,
+                         dEpsilon, nIteration),
+                        SD_FLOAT_TYPES);
+}
+#endif
+
+#if NOT_EXCLUDED(OP_rms_prop_updater_foreach)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void rmsPropUpdaterForeach_(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                   const std::vector<NDArray*>& initStates, const std::vector<NDArray*>& updates,
+                                   const std::vector<NDArray*>& statesG, const double dLr, const double dRmsDecay,
+                                   const double dEpsilon) {
+  const T lr = static_cast<T>(dLr);
+  const T rmsDecay = static_cast<T>(dRmsDecay);
+  const T epsilon = static_cast<T>(dEpsilon);
+
+  auto kernel = [&](T* const* buffers, sd::LongType start, sd::LongType stop) {
+    const T* grad = buffers[0];
+    const T* init = buffers[1];
+    T* up = buffers[2];
+    T* st = buffers[3];
+
+    PRAGMA_OMP_SIMD
+    for (auto i = start; i < stop; i++) {
+      st[i] = init[i] * rmsDecay + grad[i] * grad[i] * (1 - rmsDecay);
+      up[i] = (lr * grad[i]) / (math::sd_sqrt<T, T>(st[i]) + epsilon);
+    }
+  };
+
+  auto fallback = [&](size_t i) {
+    updaterRmsProp(context, *gradients[i], *initStates[i], *updates[i], *statesG[i], dLr, dRmsDecay, dEpsilon);
+  };
+
+  const std::vector<NDArray*>* const roles[4] = {&gradients, &initStates, &updates, &statesG};
+  updaterForeach_<T, 4>(roles, kernel, fallback);
+}
+
+void updaterRmsPropForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                           const std::vector<NDArray*>& initStates, const std::vector<NDArray*>& updates,
+                           const std::vector<NDArray*>& statesG, const double dLr, const double dRmsDecay,
+                           const double dEpsilon) {
+  BUILD_SINGLE_SELECTOR(gradients[0]->dataType(), rmsPropUpdaterForeach_,
+                        (context, gradients, initStates, updates, statesG, dLr, dRmsDecay, dEpsilon), SD_FLOAT_TYPES);
+}
+#endif
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
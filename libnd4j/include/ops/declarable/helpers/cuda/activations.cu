@@ -588,6 +588,23 @@ void softmaxDerivative(sd::LaunchContext *context, const NDArray &input, NDArray
   output.tickWriteDevice();
 }
 
+///////////////////////////////////////////////////////////////////
+void softmaxBp(sd::LaunchContext *context, const NDArray &output, const NDArray &gradO, NDArray &gradI,
+               const int dimension) {
+  auto sumAlongDim = (output * gradO).reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(output * (gradO - sumAlongDim));
+}
+
+///////////////////////////////////////////////////////////////////
+void logSoftmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO, NDArray &gradI,
+                  const int dimension) {
+  softmax(context, input, gradI, dimension);
+
+  // gradI = gradO - softmax(x) * sum(gradO)
+  auto sumGradO = gradO.reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(gradO - gradI * sumGradO);
+}
+
 template <typename T>
 void thresholdRelu_(NDArray const &input, double threshold, NDArray &output) {
   auto routine = LAMBDA_T(_x, threshold) { return _x > (T)threshold ? _x : (T)0.f; };
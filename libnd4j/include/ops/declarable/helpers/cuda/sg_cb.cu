@@ -806,6 +806,13 @@ void cbow(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDA
       {&context, &lockedWords, &indices, &codes, &alpha, &randomValue, &numLabels, &inferenceVector});
 }
 
+void word2vecCorpus(NDArray &tokens, NDArray &syn0, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable,
+                    const int window, const int nsRounds, const bool isCbow, const double alpha,
+                    const double minLearningRate, const sd::LongType seed, const int numWorkers) {
+  // Hogwild training relies on lock-free host threads updating shared rows
+  throw std::runtime_error("word2vec_corpus: this operation isn't supported on CUDA");
+}
+
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
@@ -0,0 +1,70 @@
+/*
+ *  ******************************************************************************
+ *  *
+ *  *
+ *  * This program and the accompanying materials are made available under the
+ *  * terms of the Apache License, Version 2.0 which is available at
+ *  * https://www.apache.org/licenses/LICENSE-2.0.
+ *  *
+ *  * See the NOTICE file distributed with this work for additional
+ *  * information regarding copyright ownership.
+ *  * Unless required by applicable law or agreed to in writing, software
+ *  * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ *  * License for the specific language governing permissions and limitations
+ *  * under the License.
+ *  *
+ *  * SPDX-License-Identifier: Apache-2.0
+ *  *****************************************************************************
+ */
+
+//
+// Multi-tensor updaters, on CUDA every parameter is still updated by its own kernel launch
+//
+#include <ops/declarable/helpers/updatersHelpers.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+void updaterAdamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                        const std::vector<NDArray*>& initStatesU, const std::vector<NDArray*>& initStatesM,
+                        const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesU,
+                        const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                        const double dBeta2, const double dEpsilon, const int nIteration) {
+  for (size_t e = 0; e < gradients.size(); e++) {
+    if (gradients[e]->isEmpty()) continue;
+
+    updaterAdam(context, *gradients[e], *initStatesU[e], *initStatesM[e], *updates[e], *statesU[e], *statesM[e], dLr,
+                dBeta1, dBeta2, dEpsilon, nIteration);
+  }
+}
+
+void updaterNadamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                         const std::vector<NDArray*>& initStatesV, const std::vector<NDArray*>& initStatesM,
+                         const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesV,
+                         const std::vector<NDArray*>& statesM, const double dLr, const double dBeta1,
+                         const double dBeta2, const double dEpsilon, const int nIteration) {
+  for (size_t e = 0; e < gradients.size(); e++) {
+    if (gradients[e]->isEmpty()) continue;
+
+    updaterNadam(context, *gradients[e], *initStatesV[e], *initStatesM[e], *updates[e], *statesV[e], *statesM[e],
+                 dLr, dBeta1, dBeta2, dEpsilon, nIteration);
+  }
+}
+
+void updaterRmsPropForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                           const std::vector<NDArray*>& initStates, const std::vector<NDArray*>& updates,
+                           const std::vector<NDArray*>& statesG, const double dLr, const double dRmsDecay,
+                           const double dEpsilon) {
+  for (size_t e = 0; e < gradients.size(); e++) {
+    if (gradients[e]->isEmpty()) continue;
+
+    updaterRmsProp(context, *gradients[e], *initStates[e], *updates[e], *statesG[e], dLr, dRmsDecay, dEpsilon);
+  }
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
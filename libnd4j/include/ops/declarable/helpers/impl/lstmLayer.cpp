@@ -38,6 +38,10 @@
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/helpers/activations.h>
 #include <ops/declarable/helpers/lstmLayer.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+#include <cstring>
 // #include <VariableSpace.h>
 // #include <ops/declarable/CustomOperations.h>
 // #include<ops/declarable/helpers/transforms.h>
@@ -581,6 +585,515 @@ void lstmLayerCellBp(const NDArray* x, const NDArray* Wx, const NDArray* Wr, con
   }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// fused time loops: input projections of all time steps are calculated by single gemm before the loop, only h × Wr
+// stays inside the loop, and the whole gate math of the step is done by one elementwise pass per batch row
+
+template <typename T>
+static SD_INLINE T lstmAct(const T x, const int opId, const T alpha, const T beta) {
+  switch (opId) {
+    case 0:
+      return sd::math::sd_tanh<T, T>(x);
+    case 1:
+      return x < static_cast<T>(0) ? static_cast<T>(0) : x;
+    case 2:
+      return sd::math::sd_sigmoid<T, T>(x);
+    case 3:
+      return alpha * x + beta;
+    case 4:
+      return x < static_cast<T>(0) ? alpha * x : x;
+    case 5:
+      return x > alpha ? x : static_cast<T>(0);
+    case 6:
+      return alpha * sd::math::sd_tanh<T, T>(beta * x);
+    case 7:
+      return sd::math::sd_min<T>(static_cast<T>(1),
+                                 sd::math::sd_max<T>(static_cast<T>(0), static_cast<T>(0.2f) * x + static_cast<T>(0.5f)));
+    case 8:
+      return sd::math::sd_elu<T, T>(x, alpha);
+    case 9:
+      return sd::math::sd_softsign<T, T>(x);
+    default:
+      return sd::math::sd_softplus<T, T>(x);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static SD_INLINE T lstmActDeriv(const T x, const int opId, const T alpha, const T beta) {
+  switch (opId) {
+    case 0:
+      return sd::math::sd_tanhderivative<T, T>(x);
+    case 1:
+      return x > static_cast<T>(0) ? static_cast<T>(1) : static_cast<T>(0);
+    case 2:
+      return sd::math::sd_sigmoidderivative<T, T>(x);
+    case 3:
+      return alpha;
+    case 4:
+      return x >= static_cast<T>(0) ? static_cast<T>(1) : alpha;
+    case 5:
+      return x > alpha ? static_cast<T>(1) : static_cast<T>(0);
+    case 6: {
+      const T th = sd::math::sd_tanh<T, T>(beta * x);
+      return alpha * beta * (static_cast<T>(1) - th * th);
+    }
+    case 7:
+      return x < static_cast<T>(-2.5f) || x > static_cast<T>(2.5f) ? static_cast<T>(0) : static_cast<T>(0.2f);
+    case 8:
+      return sd::math::sd_eluderivative<T, T>(x, alpha);
+    case 9:
+      return sd::math::sd_softsignderivative<T, T>(x);
+    default: {
+      const T ex = sd::math::sd_exp<T, T>(x);
+      return ex / (static_cast<T>(1) + ex);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct LstmActivations {
+  T clip;
+  int gateAct, cellAct, outAct;
+  T gateAlpha, gateBeta, cellAlpha, cellBeta, outAlpha, outBeta;
+
+  explicit LstmActivations(const std::vector<float>& params)
+      : clip(params[2]),
+        gateAct(params[3]),
+        cellAct(params[6]),
+        outAct(params[9]),
+        gateAlpha(params[4]),
+        gateBeta(params[5]),
+        cellAlpha(params[7]),
+        cellBeta(params[8]),
+        outAlpha(params[10]),
+        outBeta(params[11]) {}
+};
+
+//////////////////////////////////////////////////////////////////////////
+// single batch row at single time step
+// zx, zr - input and recurrent projections [4*nOut], b - biases [4*nOut], Wp - peephole weights [3*nOut], both may be
+// nullptr, h, c - previous output and cell state on input, current ones on output [nOut]
+// z, a - if not nullptr, preactivations and activations of gates are stored there for backprop [4*nOut]
+template <typename T>
+static void lstmFusedCell(const LstmActivations<T>& p, const sd::LongType nOut, const T* zx, const T* zr, const T* b,
+                          const T* Wp, T* h, T* c, T* z, T* a) {
+  for (sd::LongType j = 0; j < nOut; ++j) {
+    T zi = zx[j] + zr[j];
+    T zf = zx[nOut + j] + zr[nOut + j];
+    T zg = zx[2 * nOut + j] + zr[2 * nOut + j];
+    T zo = zx[3 * nOut + j] + zr[3 * nOut + j];
+
+    if (b != nullptr) {
+      zi += b[j];
+      zf += b[nOut + j];
+      zg += b[2 * nOut + j];
+      zo += b[3 * nOut + j];
+    }
+
+    const T cI = c[j];
+    if (Wp != nullptr) {
+      zi += cI * Wp[j];
+      zf += cI * Wp[nOut + j];
+    }
+
+    const T i = lstmAct<T>(zi, p.gateAct, p.gateAlpha, p.gateBeta);
+    const T f = lstmAct<T>(zf, p.gateAct, p.gateAlpha, p.gateBeta);
+    const T g = lstmAct<T>(zg, p.cellAct, p.cellAlpha, p.cellBeta);
+
+    T ct = f * cI + i * g;
+    if (p.clip != static_cast<T>(0)) ct = ct > p.clip ? p.clip : (ct < -p.clip ? -p.clip : ct);
+
+    if (Wp != nullptr) zo += ct * Wp[2 * nOut + j];
+
+    const T o = lstmAct<T>(zo, p.gateAct, p.gateAlpha, p.gateBeta);
+
+    c[j] = ct;
+    h[j] = o * lstmAct<T>(ct, p.outAct, p.outAlpha, p.outBeta);
+
+    if (z != nullptr) {
+      z[j] = zi;
+      z[nOut + j] = zf;
+      z[2 * nOut + j] = zg;
+      z[3 * nOut + j] = zo;
+
+      a[j] = i;
+      a[nOut + j] = f;
+      a[2 * nOut + j] = g;
+      a[3 * nOut + j] = o;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// backprop of single batch row at single time step, see lstmLayerCellBp for equations
+// z, a - stored preactivations and activations [4*nOut], cI, c - previous and current cell state [nOut]
+// dLdh, dLdhL, dLdcL - incoming gradients, any of them may be nullptr, dLdh is strided [nOut]
+// dLdhI, dLdcI - running gradients vs. previous output and cell state [nOut], dLdcI is updated here, while dLdhI is
+// calculated by caller as dLdz × WrT afterwards
+// dLdz - gradient vs. preactivations [4*nOut]
+template <typename T>
+static void lstmFusedCellBp(const LstmActivations<T>& p, const sd::LongType nOut, const T* z, const T* a,
+                            const T* cI, const T* c, const T* Wp, const T* dLdh, const sd::LongType dLdhStride,
+                            const T* dLdhL, const T* dLdcL, const T* dLdhI, T* dLdcI, T* dLdz) {
+  for (sd::LongType j = 0; j < nOut; ++j) {
+    const T i = a[j];
+    const T f = a[nOut + j];
+    const T g = a[2 * nOut + j];
+    const T o = a[3 * nOut + j];
+
+    T dzi = lstmActDeriv<T>(z[j], p.gateAct, p.gateAlpha, p.gateBeta) * g;
+    T dzf = lstmActDeriv<T>(z[nOut + j], p.gateAct, p.gateAlpha, p.gateBeta) * cI[j];
+    T dzg = lstmActDeriv<T>(z[2 * nOut + j], p.cellAct, p.cellAlpha, p.cellBeta) * i;
+    T dzo = lstmActDeriv<T>(z[3 * nOut + j], p.gateAct, p.gateAlpha, p.gateBeta) *
+            lstmAct<T>(c[j], p.outAct, p.outAlpha, p.outBeta);
+
+    T dcdcI = f;
+
+    // clipped cell state doesn't depend on anything
+    if (p.clip != static_cast<T>(0) && (c[j] == p.clip || c[j] == -p.clip))
+      dzi = dzf = dzg = dcdcI = static_cast<T>(0);
+
+    T dhdc = lstmActDeriv<T>(c[j], p.outAct, p.outAlpha, p.outBeta) * o;
+
+    if (Wp != nullptr) {
+      dhdc += dzo * Wp[2 * nOut + j];
+      dcdcI += dzi * Wp[j] + dzf * Wp[nOut + j];
+    }
+
+    T dh = dLdhI[j];
+    if (dLdh != nullptr) dh += dLdh[j * dLdhStride];
+    if (dLdhL != nullptr) dh += dLdhL[j];
+
+    T dc = dLdcI[j];
+    if (dLdcL != nullptr) dc += dLdcL[j];
+    dc += dh * dhdc;
+
+    dLdz[j] = dzi * dc;
+    dLdz[nOut + j] = dzf * dc;
+    dLdz[2 * nOut + j] = dzg * dc;
+    dLdz[3 * nOut + j] = dzo * dh;
+
+    dLdcI[j] = dc * dcdcI;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// time index of s-th step of the batch row with given sequence length
+static SD_INLINE sd::LongType lstmStepTime(const bool forward, const int directionMode, const sd::LongType sL,
+                                           const sd::LongType limit, const sd::LongType s) {
+  if (forward) return s;
+
+  // backward mode runs from the end of the whole sequence, bidirectional one from the end of the given length
+  return directionMode == 1 ? sL - 1 - s : limit - 1 - s;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool lstmFusedLoopApplicable(const std::vector<const NDArray*>& arrays, const std::vector<float>& params) {
+  if (!Environment::getInstance().isCPU()) return false;
+
+  for (auto e : {3, 6, 9})
+    if (params[e] < 0 || params[e] > 10) return false;
+
+  const auto dtype = arrays[0]->dataType();
+  if (!DataTypeUtils::isR(dtype)) return false;
+
+  for (auto array : arrays)
+    if (array != nullptr && (array->dataType() != dtype || array->isEmpty())) return false;
+
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static std::vector<T> lstmVectorOf(const NDArray* array) {
+  std::vector<T> result;
+  if (array == nullptr) return result;
+
+  result.resize(array->lengthOf());
+  for (sd::LongType e = 0; e < array->lengthOf(); ++e) result[e] = array->e<T>(e);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// strides of time, batch and feature axes of array given in one of data formats
+static void lstmStrides(const NDArray* arr, const int dataFormat, sd::LongType& tStride, sd::LongType& bStride,
+                        sd::LongType& nStride) {
+  if (dataFormat == 0 || dataFormat == 3) {  // [sL, bS, nOut]
+    tStride = arr->strideAt(0);
+    bStride = arr->strideAt(1);
+    nStride = arr->strideAt(2);
+  } else if (dataFormat == 1) {  // [bS, sL, nOut]
+    tStride = arr->strideAt(1);
+    bStride = arr->strideAt(0);
+    nStride = arr->strideAt(2);
+  } else {  // [bS, nOut, sL]
+    tStride = arr->strideAt(2);
+    bStride = arr->strideAt(0);
+    nStride = arr->strideAt(1);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// input projections of all time steps, [sL*bS, 4*nOut], rows are ordered as getBatchTimeTotalIndex says
+static NDArray lstmInputProjection(const NDArray* x, const NDArray* Wx, const int dataFormat, const sd::LongType sL,
+                                   const sd::LongType bS, NDArray& xR) {
+  const sd::LongType nIn = Wx->sizeAt(0);
+  const sd::LongType nOut = Wx->sizeAt(-1) / 4;
+
+  // NST is the only format where features are not the last axis, so it gets permuted into NTS copy
+  xR = dataFormat == 2 ? x->permute({0, 2, 1}).reshape('c', {sL * bS, nIn}) : x->reshape('c', {sL * bS, nIn});
+
+  NDArray zx('c', {sL * bS, 4 * nOut}, x->dataType(), x->getContext());
+  MmulHelper::mmul(&xR, Wx, &zx, 1.0, 0.0);  // [sL*bS, nIn] × [nIn, 4*nOut] = [sL*bS, 4*nOut]
+
+  return zx;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmLayerTimeLoopFused_(const NDArray* x, const NDArray* Wx, const NDArray* Wr, const NDArray* b,
+                                    const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                                    const std::vector<float>& params, const bool forward, NDArray* h, NDArray* hL,
+                                    NDArray* cL) {
+  const int dataFormat = params[0];
+  const int directionMode = params[1];
+
+  const sd::LongType sL = dataFormat == 3 ? x->sizeAt(0) : x->sizeAt(dataFormat);
+  const sd::LongType bS = dataFormat == 1 || dataFormat == 2 ? x->sizeAt(0) : x->sizeAt(1);
+  const sd::LongType nOut = Wx->sizeAt(-1) / 4;
+
+  const LstmActivations<T> p(params);
+
+  std::vector<sd::LongType> limits(bS, sL);
+  if (seqLen)
+    for (sd::LongType e = 0; e < bS; ++e) limits[e] = seqLen->e<sd::LongType>(e);
+  const sd::LongType maxLimit = bS > 0 ? *std::max_element(limits.begin(), limits.end()) : 0;
+
+  NDArray xR;
+  NDArray zx = lstmInputProjection(x, Wx, dataFormat, sL, bS, xR);
+
+  NDArray ht('c', {bS, nOut}, x->dataType(), x->getContext());
+  NDArray ct('c', {bS, nOut}, x->dataType(), x->getContext());
+  NDArray zr('c', {bS, 4 * nOut}, x->dataType(), x->getContext());
+
+  if (hI) ht.assign(hI);
+  if (cI) ct.assign(cI);
+
+  const auto bias = lstmVectorOf<T>(b);
+  const auto peephole = lstmVectorOf<T>(Wp);
+
+  // time steps beyond sequence length are zeros
+  if (h && seqLen) h->nullify();
+
+  sd::LongType hT(0), hB(0), hN(0);
+  if (h) lstmStrides(h, dataFormat, hT, hB, hN);
+
+  const T* zxBuf = zx.bufferAsT<T>();
+  const T* zrBuf = zr.bufferAsT<T>();
+  T* htBuf = ht.bufferAsT<T>();
+  T* ctBuf = ct.bufferAsT<T>();
+  T* hBuf = h ? h->bufferAsT<T>() : nullptr;
+
+  for (sd::LongType s = 0; s < maxLimit; ++s) {
+    MmulHelper::mmul(&ht, Wr, &zr, 1.0, 0.0);  // [bS, nOut] × [nOut, 4*nOut] = [bS, 4*nOut]
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto e = start; e < stop; ++e) {
+        if (s >= limits[e]) continue;
+
+        const auto t = lstmStepTime(forward, directionMode, sL, limits[e], s);
+        const auto row = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
+
+        lstmFusedCell<T>(p, nOut, zxBuf + row * 4 * nOut, zrBuf + e * 4 * nOut, bias.empty() ? nullptr : bias.data(),
+                         peephole.empty() ? nullptr : peephole.data(), htBuf + e * nOut, ctBuf + e * nOut, nullptr,
+                         nullptr);
+
+        if (hBuf != nullptr) {
+          auto hOut = hBuf + t * hT + e * hB;
+          for (sd::LongType j = 0; j < nOut; ++j) hOut[j * hN] = htBuf[e * nOut + j];
+        }
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, bS);
+  }
+
+  // rows of zero length have zero output and cell state
+  for (sd::LongType e = 0; e < bS; ++e) {
+    if (limits[e] != 0) continue;
+    ht({e, e + 1, 0, 0}).nullify();
+    ct({e, e + 1, 0, 0}).nullify();
+  }
+
+  if (hL) hL->assign(ht);
+  if (cL) cL->assign(ct);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmLayerTimeLoopBpFused_(const NDArray* x, const NDArray* Wx, const NDArray* Wr, const NDArray* b,
+                                      const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                                      const NDArray* dLdh, const NDArray* dLdhL, const NDArray* dLdcL,
+                                      const std::vector<float>& params, const bool forward, NDArray* dLdx,
+                                      NDArray* dLdWx, NDArray* dLdWr, NDArray* dLdb, NDArray* dLdhI, NDArray* dLdcI,
+                                      NDArray* dLdWp) {
+  const int dataFormat = params[0];
+  const int directionMode = params[1];
+
+  const sd::LongType sL = dataFormat == 3 ? x->sizeAt(0) : x->sizeAt(dataFormat);
+  const sd::LongType bS = dataFormat == 1 || dataFormat == 2 ? x->sizeAt(0) : x->sizeAt(1);
+  const sd::LongType nIn = Wx->sizeAt(0);
+  const sd::LongType nOut = Wx->sizeAt(-1) / 4;
+  const sd::LongType rows = sL * bS;
+
+  const LstmActivations<T> p(params);
+
+  std::vector<sd::LongType> limits(bS, sL);
+  if (seqLen)
+    for (sd::LongType e = 0; e < bS; ++e) limits[e] = seqLen->e<sd::LongType>(e);
+  const sd::LongType maxLimit = bS > 0 ? *std::max_element(limits.begin(), limits.end()) : 0;
+
+  const auto type = x->dataType();
+  auto context = x->getContext();
+
+  NDArray xR;
+  NDArray zx = lstmInputProjection(x, Wx, dataFormat, sL, bS, xR);
+
+  // everything backprop needs is kept per (time, batch) row, in the same order as rows of xR
+  // rows beyond sequence length stay zero, so they don't contribute to batched gemms below
+  NDArray z('c', {rows, 4 * nOut}, type, context);
+  NDArray a('c', {rows, 4 * nOut}, type, context);
+  NDArray hP('c', {rows, nOut}, type, context);  // previous output
+  NDArray cP('c', {rows, nOut}, type, context);  // previous cell state
+  NDArray c('c', {rows, nOut}, type, context);   // current cell state
+  NDArray dLdz('c', {rows, 4 * nOut}, type, context);
+
+  NDArray ht('c', {bS, nOut}, type, context);
+  NDArray ct('c', {bS, nOut}, type, context);
+  NDArray zr('c', {bS, 4 * nOut}, type, context);
+
+  hP.nullify();
+  dLdz.nullify();
+
+  if (hI) ht.assign(hI);
+  if (cI) ct.assign(cI);
+
+  const auto bias = lstmVectorOf<T>(b);
+  const auto peephole = lstmVectorOf<T>(Wp);
+  const T* bBuf = bias.empty() ? nullptr : bias.data();
+  const T* WpBuf = peephole.empty() ? nullptr : peephole.data();
+
+  T* zBuf = z.bufferAsT<T>();
+  T* aBuf = a.bufferAsT<T>();
+  T* hPBuf = hP.bufferAsT<T>();
+  T* cPBuf = cP.bufferAsT<T>();
+  T* cBuf = c.bufferAsT<T>();
+  T* dLdzBuf = dLdz.bufferAsT<T>();
+  T* htBuf = ht.bufferAsT<T>();
+  T* ctBuf = ct.bufferAsT<T>();
+  const T* zxBuf = zx.bufferAsT<T>();
+  const T* zrBuf = zr.bufferAsT<T>();
+
+  // ff
+  for (sd::LongType s = 0; s < maxLimit; ++s) {
+    MmulHelper::mmul(&ht, Wr, &zr, 1.0, 0.0);  // [bS, nOut] × [nOut, 4*nOut] = [bS, 4*nOut]
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto e = start; e < stop; ++e) {
+        if (s >= limits[e]) continue;
+
+        const auto t = lstmStepTime(forward, directionMode, sL, limits[e], s);
+        const auto row = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
+
+        memcpy(hPBuf + row * nOut, htBuf + e * nOut, nOut * sizeof(T));
+        memcpy(cPBuf + row * nOut, ctBuf + e * nOut, nOut * sizeof(T));
+
+        lstmFusedCell<T>(p, nOut, zxBuf + row * 4 * nOut, zrBuf + e * 4 * nOut, bBuf, WpBuf, htBuf + e * nOut,
+                         ctBuf + e * nOut, zBuf + row * 4 * nOut, aBuf + row * 4 * nOut);
+
+        memcpy(cBuf + row * nOut, ctBuf + e * nOut, nOut * sizeof(T));
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, bS);
+  }
+
+  // bp, ht and ct are reused as running gradients vs. previous output and cell state
+  NDArray dLdzt('c', {bS, 4 * nOut}, type, context);
+  NDArray WrT = Wr->transpose();
+
+  ht.nullify();
+  ct.nullify();
+  dLdzt.nullify();
+
+  NDArray dLdhLc, dLdcLc;
+  if (dLdhL) dLdhLc = dLdhL->dup('c');
+  if (dLdcL) dLdcLc = dLdcL->dup('c');
+
+  const T* dLdhBuf = dLdh ? dLdh->bufferAsT<T>() : nullptr;
+  const T* dLdhLBuf = dLdhL ? dLdhLc.bufferAsT<T>() : nullptr;
+  const T* dLdcLBuf = dLdcL ? dLdcLc.bufferAsT<T>() : nullptr;
+  T* dLdztBuf = dLdzt.bufferAsT<T>();
+
+  sd::LongType dT(0), dB(0), dN(0);
+  if (dLdh) lstmStrides(dLdh, dataFormat, dT, dB, dN);
+
+  for (sd::LongType s = maxLimit - 1; s >= 0; --s) {
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto e = start; e < stop; ++e) {
+        if (s >= limits[e]) continue;
+
+        const auto t = lstmStepTime(forward, directionMode, sL, limits[e], s);
+        const auto row = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
+        const bool last = s == limits[e] - 1;
+
+        lstmFusedCellBp<T>(p, nOut, zBuf + row * 4 * nOut, aBuf + row * 4 * nOut, cPBuf + row * nOut,
+                           cBuf + row * nOut, WpBuf, dLdhBuf ? dLdhBuf + t * dT + e * dB : nullptr, dN,
+                           last && dLdhLBuf ? dLdhLBuf + e * nOut : nullptr,
+                           last && dLdcLBuf ? dLdcLBuf + e * nOut : nullptr, htBuf + e * nOut, ctBuf + e * nOut,
+                           dLdztBuf + e * 4 * nOut);
+
+        memcpy(dLdzBuf + row * 4 * nOut, dLdztBuf + e * 4 * nOut, 4 * nOut * sizeof(T));
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, bS);
+
+    MmulHelper::mmul(&dLdzt, &WrT, &ht, 1.0, 0.0);  // [bS, 4*nOut] × [4*nOut, nOut] = [bS, nOut]
+  }
+
+  if (hI && dLdhI) dLdhI->assign(ht);
+  if (cI && dLdcI) dLdcI->assign(ct);
+
+  // weight gradients of all time steps at once
+  NDArray dLdxR('c', {rows, nIn}, type, context);
+  NDArray WxT = Wx->transpose();
+  MmulHelper::mmul(&dLdz, &WxT, &dLdxR, 1.0, 0.0);  // [sL*bS, 4*nOut] × [4*nOut, nIn] = [sL*bS, nIn]
+
+  if (dataFormat == 2)
+    dLdx->permute({0, 2, 1}).assign(dLdxR.reshape('c', {bS, sL, nIn}));
+  else
+    dLdx->assign(dLdxR.reshape('c', dLdx->getShapeAsVector()));
+
+  *dLdWx += mmul(xR.transpose(), dLdz);  // [nIn, sL*bS] × [sL*bS, 4*nOut] = [nIn, 4*nOut]
+  *dLdWr += mmul(hP.transpose(), dLdz);  // [nOut, sL*bS] × [sL*bS, 4*nOut] = [nOut, 4*nOut]
+
+  if (b) *dLdb += dLdz.reduceAlongDimension(reduce::Sum, {0});  // [sL*bS, 4*nOut] -> reduce -> [4*nOut]
+
+  if (Wp) {
+    NDArray temp('c', {nOut}, type, context);
+    (dLdz({0, 0, 0, nOut}) * cP).reduceAlongDimension(reduce::Sum, temp, {0});  // [sL*bS, nOut] -> reduce -> [nOut]
+    (*dLdWp)({0, nOut}) += temp;
+    (dLdz({0, 0, nOut, 2 * nOut}) * cP).reduceAlongDimension(reduce::Sum, temp, {0});
+    (*dLdWp)({nOut, 2 * nOut}) += temp;
+    (dLdz({0, 0, 3 * nOut, 4 * nOut}) * c).reduceAlongDimension(reduce::Sum, temp, {0});
+    (*dLdWp)({2 * nOut, 3 * nOut}) += temp;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr, const NDArray* b, const NDArray* seqLen,
                        const NDArray* hI, const NDArray* cI, const NDArray* Wp, const std::vector<float>& params,
@@ -603,6 +1116,12 @@ void lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr, c
   // params = {dataFormat, directionMode, cellClip, gateAct, gateAlpha, gateBeta, cellAct, cellAlpha, cellBeta, outAct,
   // outAlpha, outBeta}; dataFormat: 0,3 = [sL, bS, nIn], 1 = [bS, sL ,nIn], 2 = [bS, nIn, sL]
 
+  if (lstmFusedLoopApplicable({x, Wx, Wr, b, hI, cI, Wp, h, hL, cL}, params)) {
+    BUILD_SINGLE_SELECTOR(x->dataType(), lstmLayerTimeLoopFused_,
+                          (x, Wx, Wr, b, seqLen, hI, cI, Wp, params, forward, h, hL, cL), SD_FLOAT_TYPES);
+    return;
+  }
+
   const int dataFormat = params[0];
   const int directionMode = params[1];
 
@@ -900,6 +1419,15 @@ void lstmLayerTimeLoopBp(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
   // params = {dataFormat, directionMode, cellClip, gateAct, gateAlpha, gateBeta, cellAct, cellAlpha, cellBeta, outAct,
   // outAlpha, outBeta}; dataFormat: 0,3 = [sL, bS, nIn], 1 = [bS, sL ,nIn], 2 = [bS, nIn, sL]
 
+  if (lstmFusedLoopApplicable({x, Wx, Wr, b, hI, cI, Wp, dLdh, dLdhL, dLdcL, dLdx, dLdWx, dLdWr, dLdb, dLdWp},
+                              params)) {
+    BUILD_SINGLE_SELECTOR(x->dataType(), lstmLayerTimeLoopBpFused_,
+                          (x, Wx, Wr, b, seqLen, hI, cI, Wp, dLdh, dLdhL, dLdcL, params, forward, dLdx, dLdWx, dLdWr,
+                           dLdb, dLdhI, dLdcI, dLdWp),
+                          SD_FLOAT_TYPES);
+    return;
+  }
+
   const int dataFormat = params[0];
   const int directionMode = params[1];
 
@@ -54,6 +54,15 @@ SD_LIB_HIDDEN void cbowInference(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg,
                                  double alpha, sd::LongType randomValue, int numLabels, NDArray &inferenceVector, const bool trainWords,
                                  int numWorkers,int iterations,double minLearningRate);
 
+/**
+ * Trains syn0/syn1Neg with negative sampling over whole chunk of corpus (token ids, negative ids split sentences).
+ * Threads update shared rows without locks, Hogwild style
+ */
+SD_LIB_HIDDEN void word2vecCorpus(NDArray &tokens, NDArray &syn0, NDArray &syn1Neg, NDArray &expTable,
+                                  NDArray &negTable, const int window, const int nsRounds, const bool isCbow,
+                                  const double alpha, const double minLearningRate, const sd::LongType seed,
+                                  const int numWorkers);
+
 SD_LIB_HIDDEN int binarySearch(const int *haystack, const int needle, const int totalElements);
 }  // namespace helpers
 }  // namespace ops
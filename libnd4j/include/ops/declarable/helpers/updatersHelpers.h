@@ -27,6 +27,8 @@
 #include <array/NDArray.h>
 #include <system/op_boilerplate.h>
 
+#include <vector>
+
 namespace sd {
 namespace ops {
 namespace helpers {
@@ -62,6 +64,24 @@ SD_LIB_HIDDEN void updaterAdaBelief(sd::LaunchContext* context, const NDArray& g
                                     const NDArray& initStateM, NDArray& update, NDArray& stateU, NDArray& stateM,
                                     const double dLr, const double dBeta1, const double dBeta2, const double dEpsilon,
                                     const int nIteration);
+
+// multi-tensor variants: every vector holds one array per parameter, arrays with the same position form one update
+SD_LIB_HIDDEN void updaterAdamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                      const std::vector<NDArray*>& initStatesU,
+                                      const std::vector<NDArray*>& initStatesM, const std::vector<NDArray*>& updates,
+                                      const std::vector<NDArray*>& statesU, const std::vector<NDArray*>& statesM,
+                                      const double dLr, const double dBeta1, const double dBeta2,
+                                      const double dEpsilon, const int nIteration);
+SD_LIB_HIDDEN void updaterNadamForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                       const std::vector<NDArray*>& initStatesV,
+                                       const std::vector<NDArray*>& initStatesM, const std::vector<NDArray*>& updates,
+                                       const std::vector<NDArray*>& statesV, const std::vector<NDArray*>& statesM,
+                                       const double dLr, const double dBeta1, const double dBeta2,
+                                       const double dEpsilon, const int nIteration);
+SD_LIB_HIDDEN void updaterRmsPropForeach(sd::LaunchContext* context, const std::vector<NDArray*>& gradients,
+                                         const std::vector<NDArray*>& initStates,
+                                         const std::vector<NDArray*>& updates, const std::vector<NDArray*>& statesG,
+                                         const double dLr, const double dRmsDecay, const double dEpsilon);
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
@@ -23,9 +23,11 @@
 #include <exceptions/datatype_exception.h>
 #include <exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
+#include <helpers/OpStatistics.h>
 #include <helpers/ShapeUtils.h>
 #include <helpers/StringUtils.h>
 #include <ops/declarable/DeclarableOp.h>
+#include <ops/declarable/LegacyOp.h>
 #include <ops/declarable/OpRegistrator.h>
 
 #include <cstdarg>
@@ -656,12 +658,41 @@ sd::Status sd::ops::DeclarableOp::validateDataTypes(Context &block) {
   return sd::Status::OK;
 }
 
+// size of all input and output arrays of the op, rough estimate of memory traffic it causes
+static sd::LongType touchedBytes(Context &block, int numOutputs) {
+  sd::LongType bytes = 0;
+  for (int e = 0; e < block.width(); e++) {
+    auto array = block.array(e);
+    if (array != nullptr && !array->isEmpty()) bytes += array->lengthOf() * array->sizeOfT();
+  }
+
+  auto vs = block.getVariableSpace();
+  for (int e = 0; e < numOutputs; e++) {
+    NDArray *array = nullptr;
+    if (block.isFastPath()) {
+      if (e < (int)block.fastpath_out().size()) array = block.fastpath_out()[e];
+    } else if (vs != nullptr && vs->hasVariable(block.nodeId(), e)) {
+      array = vs->getVariable(block.nodeId(), e)->getNDArray();
+    }
+
+    if (array != nullptr && !array->isEmpty()) bytes += array->lengthOf() * array->sizeOfT();
+  }
+
+  return bytes;
+}
+
 sd::Status sd::ops::DeclarableOp::execute(Context *block) {
   sd_debug("Executing op: [%s]\n", this->getOpName()->c_str());
 
   std::chrono::time_point<std::chrono::system_clock> timeEnter, timeStart, timeEnd;
   sd::LongType prepTime, outerTime;
 
+  // legacy op wrappers share the same name, their calls are accounted by NativeOps entry points instead
+  const bool collectStatistics =
+      Environment::getInstance().isOpStatistics() && dynamic_cast<LegacyOp *>(this) == nullptr;
+  std::chrono::steady_clock::time_point statisticsStart;
+  if (collectStatistics) statisticsStart = std::chrono::steady_clock::now();
+
   sd::LongType memoryBefore =
       block->workspace() == nullptr ? 0L : block->workspace()->getSpilledSize() + block->workspace()->getUsedSize();
   if (Environment::getInstance().isProfiling()) timeEnter = std::chrono::system_clock::now();
@@ -799,6 +830,13 @@ sd::Status sd::ops::DeclarableOp::execute(Context *block) {
     }
   }
 
+  if (collectStatistics && status == sd::Status::OK) {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                       statisticsStart).count();
+    OpStatistics::getInstance().record(this->getOpHash(), this->getOpName()->c_str(), -1, nanos,
+                                       touchedBytes(*block, numOutputs), hasHelper);
+  }
+
   // now we print out all outputs for this node
   if (sd::Environment::getInstance().isDebugAndVerbose()) {
     auto vs = block->getVariableSpace();
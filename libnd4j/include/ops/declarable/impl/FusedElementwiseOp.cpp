@@ -0,0 +1,307 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Chain of elementwise ops executed as single op, built by Graph fusion pass
+//
+#include <array/ExtraArguments.h>
+#include <execution/Threads.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/ShapeUtils.h>
+#include <loops/legacy_ops.h>
+#include <ops/BroadcastOpsTuple.h>
+#include <ops/declarable/FusedElementwiseOp.h>
+#include <ops/ops.h>
+#include <system/op_boilerplate.h>
+
+#include <cstring>
+
+// pairwise ops which have broadcastable counterparts, so they can be used with non-matching operands too
+#define FUSED_PAIRWISE_OPS (0, Add), (2, Divide), (3, Multiply), (6, Subtract)
+
+using namespace simdOps;
+
+namespace sd {
+namespace ops {
+
+// number of elements passed through the whole chain at once: block of doubles still fits into L1
+static const sd::LongType FUSED_BLOCK_SIZE = 2048;
+
+template <typename X>
+class FusedElementwise {
+ public:
+  template <typename OpType>
+  static void plain(bool &result) {
+    result = !OpType::requiresSpecial;
+  }
+
+  template <typename OpType>
+  static void transform(X *z, sd::LongType length, X *extras) {
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(z[e], extras);
+  }
+
+  template <typename OpType>
+  static void scalar(X *z, sd::LongType length, X value, X *extras) {
+    PRAGMA_OMP_SIMD
+    for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(z[e], value, extras);
+  }
+
+  template <typename OpType>
+  static void pairwise(X *z, sd::LongType length, const X *y, sd::LongType yLength, sd::LongType offset, bool reversed,
+                       X *extras) {
+    if (yLength == 1) {
+      const X value = y[0];
+      if (reversed) {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(value, z[e], extras);
+      } else {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(z[e], value, extras);
+      }
+      return;
+    }
+
+    // operand is either of the same length, or matches trailing dimensions and repeats along leading ones
+    auto j = offset % yLength;
+    if (j + length <= yLength) {
+      auto yp = y + j;
+      if (reversed) {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(yp[e], z[e], extras);
+      } else {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < length; e++) z[e] = OpType::op(z[e], yp[e], extras);
+      }
+      return;
+    }
+
+    for (sd::LongType e = 0; e < length; e++) {
+      z[e] = reversed ? OpType::op(y[j], z[e], extras) : OpType::op(z[e], y[j], extras);
+      if (++j == yLength) j = 0;
+    }
+  }
+
+  static bool isPlainStrict(int opNum) {
+    bool result = false;
+    DISPATCH_BY_OPNUM_T(plain, PARAMS(result), TRANSFORM_STRICT_OPS);
+    return result;
+  }
+
+  static bool isPlainSame(int opNum) {
+    bool result = false;
+    DISPATCH_BY_OPNUM_T(plain, PARAMS(result), TRANSFORM_SAME_OPS);
+    return result;
+  }
+
+  static void exec(const std::vector<FusedStep> &steps, const void *vx, const std::vector<const void *> &operands,
+                   const std::vector<sd::LongType> &lengths, void *vz, sd::LongType length) {
+    typedef X Y;
+    typedef X Z;
+
+    auto x = reinterpret_cast<const X *>(vx);
+    auto z = reinterpret_cast<X *>(vz);
+
+    std::vector<std::vector<X>> extras(steps.size());
+    for (size_t s = 0; s < steps.size(); s++)
+      for (auto v : steps[s].extras) extras[s].emplace_back(static_cast<X>(v));
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto b = start; b < stop; b += FUSED_BLOCK_SIZE) {
+        auto blockLength = sd::math::sd_min<sd::LongType>(FUSED_BLOCK_SIZE, stop - b);
+        auto zb = z + b;
+
+        if (zb != x + b) memcpy(zb, x + b, blockLength * sizeof(X));
+
+        for (size_t s = 0; s < steps.size(); s++) {
+          auto &step = steps[s];
+          auto opNum = step.opNum;
+          auto ex = extras[s].empty() ? nullptr : const_cast<X *>(extras[s].data());
+
+          switch (step.opType) {
+            case sd::graph::OpType_TRANSFORM_STRICT: {
+              DISPATCH_BY_OPNUM_T(transform, PARAMS(zb, blockLength, ex), TRANSFORM_STRICT_OPS);
+            } break;
+            case sd::graph::OpType_TRANSFORM_SAME: {
+              DISPATCH_BY_OPNUM_T(transform, PARAMS(zb, blockLength, ex), TRANSFORM_SAME_OPS);
+            } break;
+            case sd::graph::OpType_SCALAR: {
+              auto value = static_cast<X>(step.scalar);
+              DISPATCH_BY_OPNUM_TTT(scalar, PARAMS(zb, blockLength, value, ex), SCALAR_OPS);
+            } break;
+            case sd::graph::OpType_PAIRWISE: {
+              auto y = reinterpret_cast<const X *>(operands[s]);
+              DISPATCH_BY_OPNUM_TTT(pairwise, PARAMS(zb, blockLength, y, lengths[s], b, step.reversed, ex),
+                                    FUSED_PAIRWISE_OPS);
+            } break;
+            default:
+              break;
+          }
+        }
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, length);
+  }
+};
+
+static BroadcastOpsTuple broadcastTuple(int opNum) {
+  switch (opNum) {
+    case 0:
+      return BroadcastOpsTuple::Add();
+    case 2:
+      return BroadcastOpsTuple::Divide();
+    case 3:
+      return BroadcastOpsTuple::Multiply();
+    case 6:
+      return BroadcastOpsTuple::Subtract();
+    default:
+      throw std::runtime_error("FusedElementwiseOp: unsupported pairwise op");
+  }
+}
+
+static bool isPlain(const NDArray *array, sd::DataType dtype) {
+  return array->dataType() == dtype && !array->isEmpty() && array->ordering() == 'c' && array->ews() == 1;
+}
+
+// length of the operand if it can be used by fused kernel against output of given shape, or -1 otherwise
+static sd::LongType operandLength(const NDArray *y, const NDArray *z) {
+  if (y->lengthOf() == 1 || y->isSameShape(z)) return y->lengthOf();
+
+  // leading unities don't change memory layout, so [1, 3] bias works same as [3] does
+  int first = 0;
+  while (first < y->rankOf() && y->sizeAt(first) == 1) first++;
+
+  const int numDims = y->rankOf() - first;
+  if (numDims > z->rankOf()) return -1;
+
+  for (int e = 0; e < numDims; e++)
+    if (y->sizeAt(first + e) != z->sizeAt(z->rankOf() - numDims + e)) return -1;
+
+  return y->lengthOf();
+}
+
+FusedElementwiseOp::FusedElementwiseOp(int numInputs, const std::vector<FusedStep> &steps)
+    : DeclarableOp(numInputs, 1, "fused_elementwise", false), _steps(steps) {
+  //
+}
+
+void FusedElementwiseOp::registerTypes() {
+  getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setAllowedOutputTypes(sd::DataType::ANY);
+}
+
+bool FusedElementwiseOp::isFusable(sd::graph::OpType opType, int opNum) {
+  switch (opType) {
+    case sd::graph::OpType_TRANSFORM_STRICT:
+      return FusedElementwise<float>::isPlainStrict(opNum);
+    case sd::graph::OpType_TRANSFORM_SAME:
+      return FusedElementwise<float>::isPlainSame(opNum);
+    case sd::graph::OpType_SCALAR:
+      return true;
+    case sd::graph::OpType_PAIRWISE:
+      return opNum == 0 || opNum == 2 || opNum == 3 || opNum == 6;
+    default:
+      return false;
+  }
+}
+
+ShapeList *FusedElementwiseOp::calculateOutputShape(ShapeList *inputShape, sd::graph::Context &block) {
+  auto shapeInfo = inputShape->at(0);
+  auto dtype = ArrayOptions::dataType(shapeInfo);
+
+  // result of pairwise step takes data type of its X operand, just like BroadcastableOp does
+  for (auto &step : _steps) {
+    if (step.opType != sd::graph::OpType_PAIRWISE) continue;
+
+    auto other = inputShape->at(step.operand);
+    if (step.reversed) dtype = ArrayOptions::dataType(other);
+
+    if (!shape::equalsSoft(shapeInfo, other)) {
+      const sd::LongType *newShape = nullptr;
+      ShapeUtils::evalBroadcastShapeInfo(shapeInfo, other, true, newShape, block.workspace());
+      shapeInfo = newShape;
+    }
+  }
+
+  auto desc = new ShapeDescriptor(shapeInfo, dtype);
+  auto result = SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(desc));
+  delete desc;
+  return result;
+}
+
+sd::Status FusedElementwiseOp::validateAndExecute(Context &block) {
+  auto x = INPUT_VARIABLE(0);
+  auto z = OUTPUT_VARIABLE(0);
+
+  const auto dtype = x->dataType();
+  bool fast = Environment::getInstance().isCPU() && DataTypeUtils::isR(dtype) && isPlain(x, dtype) &&
+              isPlain(z, dtype) && x->isSameShape(z);
+
+  std::vector<const void *> operands(_steps.size(), nullptr);
+  std::vector<sd::LongType> lengths(_steps.size(), 0);
+  for (size_t s = 0; s < _steps.size() && fast; s++) {
+    if (_steps[s].opType != sd::graph::OpType_PAIRWISE) continue;
+
+    auto y = INPUT_VARIABLE(_steps[s].operand);
+    lengths[s] = operandLength(y, z);
+    operands[s] = y->buffer();
+    fast = isPlain(y, dtype) && lengths[s] > 0;
+  }
+
+  if (fast) {
+    NDArray::preparePrimaryUse({z}, {x});
+    BUILD_SINGLE_SELECTOR(dtype, FusedElementwise, ::exec(_steps, x->buffer(), operands, lengths, z->buffer(), z->lengthOf()),
+                          SD_FLOAT_TYPES);
+    NDArray::registerPrimaryUse({z}, {x});
+    return sd::Status::OK;
+  }
+
+  // generic path: every step is executed as separate op
+  NDArray current = x->dup();
+  for (auto &step : _steps) {
+    ExtraArguments extras(step.extras);
+    auto ex = step.extras.empty() ? nullptr : extras.argumentsAsT(current.dataType());
+
+    switch (step.opType) {
+      case sd::graph::OpType_TRANSFORM_STRICT:
+        current = current.transform(static_cast<sd::transform::StrictOps>(step.opNum), ex);
+        break;
+      case sd::graph::OpType_TRANSFORM_SAME:
+        current = current.transform(static_cast<sd::transform::SameOps>(step.opNum), ex);
+        break;
+      case sd::graph::OpType_SCALAR:
+        current.applyScalar(static_cast<sd::scalar::Ops>(step.opNum), step.scalar, current,
+                            step.extras.empty() ? nullptr : &extras);
+        break;
+      case sd::graph::OpType_PAIRWISE: {
+        auto y = INPUT_VARIABLE(step.operand);
+        auto tuple = broadcastTuple(step.opNum);
+        current = step.reversed ? y->applyTrueBroadcast(tuple, current) : current.applyTrueBroadcast(tuple, *y);
+      } break;
+      default:
+        throw std::runtime_error("FusedElementwiseOp: unsupported step type");
+    }
+  }
+
+  z->assign(current);
+
+  return sd::Status::OK;
+}
+
+}  // namespace ops
+}  // namespace sd
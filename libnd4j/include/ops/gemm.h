@@ -46,6 +46,22 @@ class GEMM {
                  int ldb, double beta, void *C, int ldc);
 };
 
+/**
+ * Cache-blocked GEMM used whenever vendor BLAS can't be used for the given data types:
+ * C = alpha * A x B + beta * C, where element (m, k) of A lives at A[m * aMstride + k * aKstride], etc.
+ * A and B are packed into MR/NR-wide panels sized for L1/L2 caches, C is computed by a register-blocked
+ * micro-kernel, and macro-tiles of C are distributed across threads.
+ *
+ * Implementation lives in ops/impl/gemm_blocked.hpp, include it to instantiate.
+ */
+template <typename X, typename Y, typename Z>
+class BlockedGEMM {
+ public:
+  static void op(sd::LongType M, sd::LongType N, sd::LongType K, double alpha, const X *A, sd::LongType aMstride,
+                 sd::LongType aKstride, const Y *B, sd::LongType bKstride, sd::LongType bNstride, double beta, Z *C,
+                 sd::LongType cMstride, sd::LongType cNstride);
+};
+
 template <typename X, typename Y, typename Z>
 class GEMV : public sd::blas::GEMM<X, Y, Z> {
  public:
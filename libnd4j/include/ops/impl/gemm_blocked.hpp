@@ -0,0 +1,251 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Cache-blocked GEMM for data types not covered by vendor BLAS
+//
+
+#ifndef LIBND4J_GEMM_BLOCKED_HPP
+#define LIBND4J_GEMM_BLOCKED_HPP
+
+#include <execution/Threads.h>
+#include <ops/gemm.h>
+#include <system/CpuDispatch.h>
+#include <types/types.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace sd {
+namespace blas {
+
+// half precision types are accumulated in float, everything else in its own type
+template <typename T>
+struct GemmAccumulator {
+  typedef T type;
+};
+
+template <>
+struct GemmAccumulator<float16> {
+  typedef float type;
+};
+
+template <>
+struct GemmAccumulator<bfloat16> {
+  typedef float type;
+};
+
+// MR x NR is the register block of the micro-kernel, NR is chosen so that one row of it spans a full AVX-512 register
+// KC x NR panel of B is meant to stay in L1, MC x KC block of A in L2, KC x NC block of B in L3
+template <typename T>
+struct GemmBlocking {
+  static constexpr int MR = sizeof(T) >= 8 ? 4 : 6;
+  static constexpr int NR = sizeof(T) >= 8 ? 8 : 16;
+  static constexpr sd::LongType KC = sizeof(T) >= 8 ? 192 : 256;
+  static constexpr sd::LongType MC = MR * 24;
+  static constexpr sd::LongType NC = 4096;
+  // number of columns of C processed by a single task within NC block
+  static constexpr sd::LongType NB = NR * 16;
+};
+
+// copies mr x kc sub-block of A into MR-interleaved panel, rows beyond mr are zero-padded
+template <typename X, typename Acc, int MR>
+static SD_INLINE void packPanelA(const X *A, const sd::LongType aMstride, const sd::LongType aKstride,
+                                 const sd::LongType mr, const sd::LongType kc, Acc *pa) {
+  if (mr == MR && aKstride == 1) {
+    for (sd::LongType i = 0; i < MR; i++) {
+      const X *a = A + i * aMstride;
+      for (sd::LongType p = 0; p < kc; p++) pa[p * MR + i] = static_cast<Acc>(a[p]);
+    }
+    return;
+  }
+
+  for (sd::LongType p = 0; p < kc; p++) {
+    const X *a = A + p * aKstride;
+    sd::LongType i = 0;
+    for (; i < mr; i++) pa[p * MR + i] = static_cast<Acc>(a[i * aMstride]);
+    for (; i < MR; i++) pa[p * MR + i] = static_cast<Acc>(0);
+  }
+}
+
+// copies kc x nr sub-block of B into NR-interleaved panel, columns beyond nr are zero-padded
+template <typename Y, typename Acc, int NR>
+static SD_INLINE void packPanelB(const Y *B, const sd::LongType bKstride, const sd::LongType bNstride,
+                                 const sd::LongType nr, const sd::LongType kc, Acc *pb) {
+  for (sd::LongType p = 0; p < kc; p++) {
+    const Y *b = B + p * bKstride;
+    auto dst = pb + p * NR;
+    sd::LongType j = 0;
+    if (bNstride == 1) {
+      for (; j < nr; j++) dst[j] = static_cast<Acc>(b[j]);
+    } else {
+      for (; j < nr; j++) dst[j] = static_cast<Acc>(b[j * bNstride]);
+    }
+    for (; j < NR; j++) dst[j] = static_cast<Acc>(0);
+  }
+}
+
+// acc = pa x pb, where pa is kc x MR panel and pb is kc x NR panel
+template <typename Acc, int MR, int NR>
+static SD_INLINE void microKernel(const sd::LongType kc, const Acc *pa, const Acc *pb, Acc *acc) {
+  for (int i = 0; i < MR * NR; i++) acc[i] = static_cast<Acc>(0);
+
+  for (sd::LongType p = 0; p < kc; p++) {
+    const Acc *a = pa + p * MR;
+    const Acc *b = pb + p * NR;
+    for (int i = 0; i < MR; i++) {
+      const Acc ai = a[i];
+      auto row = acc + i * NR;
+      PRAGMA_OMP_SIMD
+      for (int j = 0; j < NR; j++) row[j] += ai * b[j];
+    }
+  }
+}
+
+// C = alpha * acc + beta * C for the first K block, C += alpha * acc for the rest of them
+template <typename Z, typename Acc, int NR>
+static SD_INLINE void storeTile(const Acc *acc, const sd::LongType mr, const sd::LongType nr, const Acc alpha,
+                                const Acc beta, const bool firstBlock, Z *C, const sd::LongType cMstride,
+                                const sd::LongType cNstride) {
+  for (sd::LongType i = 0; i < mr; i++) {
+    auto c = C + i * cMstride;
+    auto row = acc + i * NR;
+    if (!firstBlock) {
+      for (sd::LongType j = 0; j < nr; j++)
+        c[j * cNstride] = static_cast<Z>(static_cast<Acc>(c[j * cNstride]) + alpha * row[j]);
+    } else if (beta == static_cast<Acc>(0)) {
+      for (sd::LongType j = 0; j < nr; j++) c[j * cNstride] = static_cast<Z>(alpha * row[j]);
+    } else {
+      for (sd::LongType j = 0; j < nr; j++)
+        c[j * cNstride] = static_cast<Z>(alpha * row[j] + beta * static_cast<Acc>(c[j * cNstride]));
+    }
+  }
+}
+
+// all tiles of packed A block against packed B panels [jrStart, jrStop), built for every ISA level via IsaDispatch
+template <typename Z, typename Acc, int MR, int NR>
+struct GemmTilesKernel {
+  static SD_INLINE void run(const Acc *packedA, const sd::LongType numPanelsA, const sd::LongType mc,
+                            const Acc *packedB, const sd::LongType jrStart, const sd::LongType jrStop,
+                            const sd::LongType nc, const sd::LongType kc, const Acc alpha, const Acc beta,
+                            const bool firstBlock, Z *C, const sd::LongType cMstride, const sd::LongType cNstride) {
+    Acc acc[MR * NR];
+
+    for (sd::LongType jr = jrStart; jr < jrStop; jr++) {
+      const sd::LongType j = jr * NR;
+      const sd::LongType nr = std::min<sd::LongType>(NR, nc - j);
+      const Acc *pb = packedB + jr * kc * NR;
+
+      for (sd::LongType ir = 0; ir < numPanelsA; ir++) {
+        const sd::LongType i = ir * MR;
+        microKernel<Acc, MR, NR>(kc, packedA + ir * kc * MR, pb, acc);
+        storeTile<Z, Acc, NR>(acc, std::min<sd::LongType>(MR, mc - i), nr, alpha, beta, firstBlock,
+                              C + i * cMstride + j * cNstride, cMstride, cNstride);
+      }
+    }
+  }
+};
+
+template <typename X, typename Y, typename Z>
+void BlockedGEMM<X, Y, Z>::op(sd::LongType M, sd::LongType N, sd::LongType K, double alpha, const X *A,
+                              sd::LongType aMstride, sd::LongType aKstride, const Y *B, sd::LongType bKstride,
+                              sd::LongType bNstride, double beta, Z *C, sd::LongType cMstride, sd::LongType cNstride) {
+  typedef typename GemmAccumulator<Z>::type Acc;
+  typedef GemmBlocking<Acc> Blocking;
+
+  constexpr int MR = Blocking::MR;
+  constexpr int NR = Blocking::NR;
+  constexpr sd::LongType MC = Blocking::MC;
+  constexpr sd::LongType KC = Blocking::KC;
+  constexpr sd::LongType NC = Blocking::NC;
+  constexpr sd::LongType NB = Blocking::NB;
+
+  if (M <= 0 || N <= 0) return;
+
+  const Acc alphaA = static_cast<Acc>(alpha);
+  const Acc betaA = static_cast<Acc>(beta);
+
+  // nothing to multiply, C = beta * C
+  if (K <= 0 || alpha == 0.0) {
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; i++) {
+        auto c = C + i * cMstride;
+        for (sd::LongType j = 0; j < N; j++)
+          c[j * cNstride] = beta == 0.0 ? static_cast<Z>(0) : static_cast<Z>(betaA * static_cast<Acc>(c[j * cNstride]));
+      }
+    };
+    samediff::Threads::parallel_tad(func, 0, M);
+    return;
+  }
+
+  const sd::LongType numMBlocks = (M + MC - 1) / MC;
+  std::vector<Acc> packedB(KC * (((std::min(NC, N) + NR - 1) / NR) * NR));
+
+  for (sd::LongType jc = 0; jc < N; jc += NC) {
+    const sd::LongType nc = std::min(NC, N - jc);
+    const sd::LongType numPanelsB = (nc + NR - 1) / NR;
+    const sd::LongType numNBlocks = (nc + NB - 1) / NB;
+
+    for (sd::LongType pc = 0; pc < K; pc += KC) {
+      const sd::LongType kc = std::min(KC, K - pc);
+      const bool firstBlock = pc == 0;
+
+      auto packB = PRAGMA_THREADS_FOR {
+        for (auto jr = start; jr < stop; jr++) {
+          const sd::LongType j = jr * NR;
+          packPanelB<Y, Acc, NR>(B + pc * bKstride + (jc + j) * bNstride, bKstride, bNstride,
+                                 std::min<sd::LongType>(NR, nc - j), kc, packedB.data() + jr * kc * NR);
+        }
+      };
+      samediff::Threads::parallel_for(packB, 0, numPanelsB);
+
+      auto tiles = PRAGMA_THREADS_FOR_2D {
+        // every thread keeps its own packed block of A, it's reused for all N blocks assigned to this thread
+        std::vector<Acc> packedA(MC * kc);
+
+        for (auto ib = start_x; ib < stop_x; ib += inc_x) {
+          const sd::LongType ic = ib * MC;
+          const sd::LongType mc = std::min(MC, M - ic);
+          const sd::LongType numPanelsA = (mc + MR - 1) / MR;
+
+          for (sd::LongType ir = 0; ir < numPanelsA; ir++) {
+            const sd::LongType i = ir * MR;
+            packPanelA<X, Acc, MR>(A + (ic + i) * aMstride + pc * aKstride, aMstride, aKstride,
+                                   std::min<sd::LongType>(MR, mc - i), kc, packedA.data() + ir * kc * MR);
+          }
+
+          for (auto jb = start_y; jb < stop_y; jb += inc_y) {
+            const sd::LongType jrStart = jb * NB / NR;
+            const sd::LongType jrStop = std::min(numPanelsB, (jb + 1) * NB / NR);
+
+            IsaDispatch<GemmTilesKernel<Z, Acc, MR, NR>>::run(
+                static_cast<const Acc *>(packedA.data()), numPanelsA, mc, static_cast<const Acc *>(packedB.data()),
+                jrStart, jrStop, nc, kc, alphaA, betaA, firstBlock, C + ic * cMstride + jc * cNstride, cMstride,
+                cNstride);
+          }
+        }
+      };
+      samediff::Threads::parallel_for(tiles, 0, numMBlocks, 1, 0, numNBlocks, 1);
+    }
+  }
+}
+
+}  // namespace blas
+}  // namespace sd
+
+#endif  // LIBND4J_GEMM_BLOCKED_HPP
@@ -26,6 +26,7 @@
 #include <helpers/TAD.h>
 #include <helpers/shape.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/impl/specials_sort.hpp>
 #include <ops/specials.h>
 #include <types/types.h>
 
@@ -467,7 +468,8 @@ template <typename T>
 void SpecialMethods<T>::sortGeneric(void *vx, sd::LongType const *xShapeInfo, bool descending) {
   auto x = reinterpret_cast<T *>(vx);
 
-  quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+  sortByKeyGeneric<T, T>(x, xShapeInfo, nullptr, nullptr, descending,
+                         sd::Environment::getInstance().maxMasterThreads());
 }
 
 template <typename T>
@@ -476,16 +478,24 @@ void SpecialMethods<T>::sortTadGeneric(void *vx, sd::LongType const *xShapeInfo,
                                        bool descending) {
   auto x = reinterpret_cast<T *>(vx);
 
-  // quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
   sd::LongType xLength = shape::length(xShapeInfo);
   sd::LongType xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-  int numTads = xLength / xTadLength;
+  sd::LongType numTads = xLength / xTadLength;
+  const int numThreads = sd::Environment::getInstance().maxMasterThreads();
+
+  // few TADs: every one of them is sorted with all threads
+  if (numTads < numThreads) {
+    for (sd::LongType r = 0; r < numTads; r++)
+      sortByKeyGeneric<T, T>(x + tadOffsets[r], tadShapeInfo, nullptr, nullptr, descending, numThreads);
+
+    return;
+  }
 
   auto func = PRAGMA_THREADS_FOR {
     for (auto r = start; r < stop; r++) {
       T *dx = x + tadOffsets[r];
 
-      quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
+      sortByKeyGeneric<T, T>(dx, tadShapeInfo, nullptr, nullptr, descending, 1);
     }
   };
   samediff::Threads::parallel_tad(func, 0, numTads);
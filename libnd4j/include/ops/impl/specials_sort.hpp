@@ -0,0 +1,291 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Sorting engine behind SpecialMethods::sortGeneric and DoubleMethods::sortBy*:
+// keys are mapped to unsigned integers of the same width, which order exactly as the original values do,
+// and sorted by parallel LSD radix sort (long arrays) or merge sort (short arrays and TADs)
+//
+#ifndef LIBND4J_SPECIALS_SORT_HPP
+#define LIBND4J_SPECIALS_SORT_HPP
+
+#include <execution/Threads.h>
+#include <helpers/shape.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sd {
+
+// arrays shorter than this are sorted by merge sort, radix passes don't pay off there
+static const sd::LongType SORT_RADIX_THRESHOLD = 1 << 14;
+
+// minimal number of elements handled by single thread during radix pass
+static const sd::LongType SORT_RADIX_CHUNK = 1 << 15;
+
+static const int SORT_RADIX_BITS = 8;
+static const int SORT_RADIX_BUCKETS = 1 << SORT_RADIX_BITS;
+
+// runs of this length are sorted by insertion sort before merging
+static const sd::LongType SORT_MERGE_RUN = 32;
+
+/**
+ * Maps value of type T to unsigned integer of the same width, so that unsigned comparison of keys matches
+ * comparison of values: sign bit is flipped for signed integers, and for floating point types all bits of negative
+ * values are flipped, and sign bit of positive ones. Descending order is ascending order of inverted keys
+ */
+template <typename T>
+struct SortKey {
+  typedef typename std::conditional<
+      sizeof(T) == 1, uint8_t,
+      typename std::conditional<sizeof(T) == 2, uint16_t,
+                                typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type U;
+
+  static_assert(sizeof(T) == sizeof(U), "SortKey: unsupported data type width");
+
+  static const bool isFloat = !std::is_integral<T>::value;
+  static const bool isSigned = isFloat || std::is_signed<T>::value;
+  static const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+
+  static SD_INLINE U encode(const T value, const U mask) {
+    U bits;
+    memcpy(&bits, &value, sizeof(U));
+
+    if (isFloat)
+      bits = (bits & signBit) ? static_cast<U>(~bits) : static_cast<U>(bits | signBit);
+    else if (isSigned)
+      bits = static_cast<U>(bits ^ signBit);
+
+    return static_cast<U>(bits ^ mask);
+  }
+
+  static SD_INLINE T decode(U bits, const U mask) {
+    bits = static_cast<U>(bits ^ mask);
+
+    if (isFloat)
+      bits = (bits & signBit) ? static_cast<U>(bits ^ signBit) : static_cast<U>(~bits);
+    else if (isSigned)
+      bits = static_cast<U>(bits ^ signBit);
+
+    T value;
+    memcpy(&value, &bits, sizeof(U));
+    return value;
+  }
+
+  static SD_INLINE U mask(const bool descending) { return descending ? static_cast<U>(~static_cast<U>(0)) : 0; }
+};
+
+/**
+ * Stable LSD radix sort of keys, values (if not nullptr) are moved along with their keys.
+ * Temp buffers must have the same length, sorted data always ends up in keys/values
+ */
+template <typename U, typename Y>
+static void radixSortEncoded(U *keys, U *keysTemp, Y *values, Y *valuesTemp, const sd::LongType n, int numThreads) {
+  const int numPasses = sizeof(U) * 8 / SORT_RADIX_BITS;
+  const sd::LongType numChunks = sd::math::sd_max<sd::LongType>(
+      1, sd::math::sd_min<sd::LongType>(numThreads, (n + SORT_RADIX_CHUNK - 1) / SORT_RADIX_CHUNK));
+
+  // per-chunk histograms of the current pass, turned into scatter positions in place
+  std::vector<sd::LongType> positions(numChunks * SORT_RADIX_BUCKETS);
+
+  // digits of all passes are counted at once: pass is skipped when all keys share its digit
+  std::vector<sd::LongType> totals(numChunks * numPasses * SORT_RADIX_BUCKETS, 0);
+  auto countAll = PRAGMA_THREADS_FOR {
+    for (auto c = start; c < stop; c++) {
+      auto counts = totals.data() + c * numPasses * SORT_RADIX_BUCKETS;
+      for (auto e = c * n / numChunks; e < (c + 1) * n / numChunks; e++)
+        for (int p = 0; p < numPasses; p++)
+          counts[p * SORT_RADIX_BUCKETS + ((keys[e] >> (p * SORT_RADIX_BITS)) & (SORT_RADIX_BUCKETS - 1))]++;
+    }
+  };
+  samediff::Threads::parallel_tad(countAll, 0, numChunks, 1, numChunks);
+
+  U *src = keys, *dst = keysTemp;
+  Y *srcV = values, *dstV = valuesTemp;
+
+  for (int p = 0; p < numPasses; p++) {
+    bool isTrivial = false;
+    for (int d = 0; d < SORT_RADIX_BUCKETS && !isTrivial; d++) {
+      sd::LongType count = 0;
+      for (sd::LongType c = 0; c < numChunks; c++) count += totals[(c * numPasses + p) * SORT_RADIX_BUCKETS + d];
+      isTrivial = count == n;
+    }
+
+    if (isTrivial) continue;
+
+    const int shift = p * SORT_RADIX_BITS;
+
+    auto count = PRAGMA_THREADS_FOR {
+      for (auto c = start; c < stop; c++) {
+        auto counts = positions.data() + c * SORT_RADIX_BUCKETS;
+        std::fill(counts, counts + SORT_RADIX_BUCKETS, 0);
+        for (auto e = c * n / numChunks; e < (c + 1) * n / numChunks; e++)
+          counts[(src[e] >> shift) & (SORT_RADIX_BUCKETS - 1)]++;
+      }
+    };
+    samediff::Threads::parallel_tad(count, 0, numChunks, 1, numChunks);
+
+    // digit-major, chunk-minor order keeps the sort stable
+    sd::LongType sum = 0;
+    for (int d = 0; d < SORT_RADIX_BUCKETS; d++)
+      for (sd::LongType c = 0; c < numChunks; c++) {
+        auto v = positions[c * SORT_RADIX_BUCKETS + d];
+        positions[c * SORT_RADIX_BUCKETS + d] = sum;
+        sum += v;
+      }
+
+    auto scatter = PRAGMA_THREADS_FOR {
+      for (auto c = start; c < stop; c++) {
+        auto offsets = positions.data() + c * SORT_RADIX_BUCKETS;
+        for (auto e = c * n / numChunks; e < (c + 1) * n / numChunks; e++) {
+          auto pos = offsets[(src[e] >> shift) & (SORT_RADIX_BUCKETS - 1)]++;
+          dst[pos] = src[e];
+          if (values != nullptr) dstV[pos] = srcV[e];
+        }
+      }
+    };
+    samediff::Threads::parallel_tad(scatter, 0, numChunks, 1, numChunks);
+
+    std::swap(src, dst);
+    std::swap(srcV, dstV);
+  }
+
+  if (src != keys) {
+    memcpy(keys, src, n * sizeof(U));
+    if (values != nullptr) memcpy(values, srcV, n * sizeof(Y));
+  }
+}
+
+/**
+ * Stable bottom-up merge sort of keys, values (if not nullptr) are moved along with their keys.
+ * Temp buffers must have the same length, sorted data always ends up in keys/values
+ */
+template <typename U, typename Y>
+static void mergeSortEncoded(U *keys, U *keysTemp, Y *values, Y *valuesTemp, const sd::LongType n) {
+  for (sd::LongType r = 0; r < n; r += SORT_MERGE_RUN) {
+    const auto end = sd::math::sd_min<sd::LongType>(r + SORT_MERGE_RUN, n);
+    for (auto e = r + 1; e < end; e++) {
+      const U key = keys[e];
+      auto j = e;
+
+      if (values != nullptr) {
+        const Y value = values[e];
+        for (; j > r && keys[j - 1] > key; j--) {
+          keys[j] = keys[j - 1];
+          values[j] = values[j - 1];
+        }
+        values[j] = value;
+      } else {
+        for (; j > r && keys[j - 1] > key; j--) keys[j] = keys[j - 1];
+      }
+
+      keys[j] = key;
+    }
+  }
+
+  U *src = keys, *dst = keysTemp;
+  Y *srcV = values, *dstV = valuesTemp;
+
+  for (sd::LongType width = SORT_MERGE_RUN; width < n; width *= 2) {
+    for (sd::LongType left = 0; left < n; left += 2 * width) {
+      const auto middle = sd::math::sd_min<sd::LongType>(left + width, n);
+      const auto right = sd::math::sd_min<sd::LongType>(left + 2 * width, n);
+
+      auto i = left, j = middle, o = left;
+      while (i < middle && j < right) {
+        // equal keys are taken from the left run first, so merge stays stable
+        const auto from = src[j] < src[i] ? j++ : i++;
+        dst[o] = src[from];
+        if (values != nullptr) dstV[o] = srcV[from];
+        o++;
+      }
+
+      memcpy(dst + o, src + i, (middle - i) * sizeof(U));
+      memcpy(dst + o + (middle - i), src + j, (right - j) * sizeof(U));
+      if (values != nullptr) {
+        memcpy(dstV + o, srcV + i, (middle - i) * sizeof(Y));
+        memcpy(dstV + o + (middle - i), srcV + j, (right - j) * sizeof(Y));
+      }
+    }
+
+    std::swap(src, dst);
+    std::swap(srcV, dstV);
+  }
+
+  if (src != keys) {
+    memcpy(keys, src, n * sizeof(U));
+    if (values != nullptr) memcpy(values, srcV, n * sizeof(Y));
+  }
+}
+
+/**
+ * This method sorts keys described by xShapeInfo, and moves values described by yShapeInfo along with them.
+ * Values can be nullptr. Arrays of any strides are supported: keys are gathered into contiguous buffer of
+ * encoded keys, sorted there and scattered back. Values are sorted in place if they're contiguous.
+ * Without values, keys with elementwise stride 1 are sorted in buffer order, just like quickSort_parallel did
+ */
+template <typename X, typename Y>
+static void sortByKeyGeneric(X *x, const sd::LongType *xShapeInfo, Y *y, const sd::LongType *yShapeInfo,
+                             const bool descending, int numThreads) {
+  typedef typename SortKey<X>::U U;
+
+  const auto n = shape::length(xShapeInfo);
+  if (n < 2) return;
+
+  const auto mask = SortKey<X>::mask(descending);
+  const bool isKeysPlain =
+      shape::elementWiseStride(xShapeInfo) == 1 && (y == nullptr || shape::order(xShapeInfo) == 'c');
+  const bool isValuesPlain =
+      y == nullptr || (shape::elementWiseStride(yShapeInfo) == 1 && shape::order(yShapeInfo) == 'c');
+
+  std::vector<U> keys(n), keysTemp(n);
+
+  // plain arrays instead of std::vector, since Y can be bool
+  std::unique_ptr<Y[]> valuesCopy(y != nullptr && !isValuesPlain ? new Y[n] : nullptr);
+  std::unique_ptr<Y[]> valuesTemp(y != nullptr ? new Y[n] : nullptr);
+  Y *values = y == nullptr ? nullptr : isValuesPlain ? y : valuesCopy.get();
+
+  auto gather = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      keys[e] = SortKey<X>::encode(isKeysPlain ? x[e] : x[shape::getIndexOffset(e, xShapeInfo)], mask);
+      if (y != nullptr && !isValuesPlain) values[e] = y[shape::getIndexOffset(e, yShapeInfo)];
+    }
+  };
+  samediff::Threads::parallel_for(gather, 0, n, 1, numThreads);
+
+  if (n < SORT_RADIX_THRESHOLD)
+    mergeSortEncoded<U, Y>(keys.data(), keysTemp.data(), values, valuesTemp.get(), n);
+  else
+    radixSortEncoded<U, Y>(keys.data(), keysTemp.data(), values, valuesTemp.get(), n, numThreads);
+
+  auto scatter = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      x[isKeysPlain ? e : shape::getIndexOffset(e, xShapeInfo)] = SortKey<X>::decode(keys[e], mask);
+      if (y != nullptr && !isValuesPlain) y[shape::getIndexOffset(e, yShapeInfo)] = values[e];
+    }
+  };
+  samediff::Threads::parallel_for(scatter, 0, n, 1, numThreads);
+}
+
+}  // namespace sd
+
+#endif  // LIBND4J_SPECIALS_SORT_HPP
@@ -320,6 +320,33 @@ class GaussianDistribution {
 
     const T epsilon = static_cast<T>(1e-5);
 
+    if (zEWS == 1 && (y == z || yEWS == 1)) {
+      // contiguous case: uniform pairs are generated in blocks and transformed at once
+      auto func = PRAGMA_THREADS_FOR {
+        T u0[sd::graph::RandomGenerator::BLOCK_LENGTH];
+        T u1[sd::graph::RandomGenerator::BLOCK_LENGTH];
+
+        for (auto b = start; b < stop; b += sd::graph::RandomGenerator::BLOCK_LENGTH) {
+          auto n = sd::math::sd_min<sd::LongType>(sd::graph::RandomGenerator::BLOCK_LENGTH, stop - b);
+          rng->relativeBlock<T>(b, n, u0, epsilon, static_cast<T>(1.0f));
+          rng->relativeBlock<T>(b + middle, n, u1, epsilon, static_cast<T>(1.0f));
+          sd::graph::RandomGenerator::boxMuller<T>(n, u0, u1);
+
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < n; e++) z[b + e] = u0[e] * stddev + (y == z ? mean : y[b + e]);
+
+          // for odd length last element has no pair
+          auto m = sd::math::sd_min<sd::LongType>(n, zLength - middle - b);
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < m; e++)
+            z[b + middle + e] = u1[e] * stddev + (y == z ? mean : y[b + middle + e]);
+        }
+      };
+
+      samediff::Threads::parallel_for(func, 0, middle, 1, _threads);
+      return;
+    }
+
     auto func = PRAGMA_THREADS_FOR {
       for (auto e = start; e < stop; e++) {
         auto epm = e + middle;
@@ -808,6 +835,32 @@ class LogNormalDistribution {
     const T stddev = extraArguments[1];
     const T epsilon = static_cast<T>(1e-5);
 
+    if (zEWS == 1 && (y == z || yEWS == 1)) {
+      auto func = PRAGMA_THREADS_FOR {
+        T u0[sd::graph::RandomGenerator::BLOCK_LENGTH];
+        T u1[sd::graph::RandomGenerator::BLOCK_LENGTH];
+
+        for (auto b = start; b < stop; b += sd::graph::RandomGenerator::BLOCK_LENGTH) {
+          auto n = sd::math::sd_min<sd::LongType>(sd::graph::RandomGenerator::BLOCK_LENGTH, stop - b);
+          rng->relativeBlock<T>(b, n, u0, epsilon, static_cast<T>(1.0f));
+          rng->relativeBlock<T>(b + middle, n, u1, epsilon, static_cast<T>(1.0f));
+          sd::graph::RandomGenerator::boxMuller<T>(n, u0, u1);
+
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < n; e++)
+            z[b + e] = sd::math::sd_exp<T, T>(u0[e] * stddev + (y == z ? mean : y[b + e]));
+
+          auto m = sd::math::sd_min<sd::LongType>(n, zLength - middle - b);
+          PRAGMA_OMP_SIMD
+          for (sd::LongType e = 0; e < m; e++)
+            z[b + middle + e] = sd::math::sd_exp<T, T>(u1[e] * stddev + (y == z ? mean : y[b + middle + e]));
+        }
+      };
+
+      samediff::Threads::parallel_for(func, 0, middle, 1, _threads);
+      return;
+    }
+
     auto func = PRAGMA_THREADS_FOR {
       PRAGMA_OMP_SIMD
       for (auto e = start; e < stop; e++) {
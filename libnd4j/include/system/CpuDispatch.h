@@ -0,0 +1,106 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Runtime selection of ISA-specific variants of hot CPU kernels
+//
+
+#ifndef LIBND4J_CPUDISPATCH_H
+#define LIBND4J_CPUDISPATCH_H
+
+#include <system/common.h>
+
+// kernels get AVX2 and AVX-512 variants only on x86-64 builds with cpu_features, and only if the binary itself
+// doesn't target AVX-512 already
+#if defined(CPU_FEATURES) && defined(__GNUC__) && defined(__x86_64__) && !defined(__CUDACC__) && \
+    !defined(__NEC__) && !defined(F_AVX512)
+#define SD_ISA_DISPATCH
+#define SD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c,bmi,bmi2")))
+#define SD_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,avx512cd,avx2,fma,f16c,bmi,bmi2")))
+#else
+#define SD_TARGET_AVX2
+#define SD_TARGET_AVX512
+#endif
+
+namespace sd {
+
+// same numbering as binaryLevel()/optimalLevel() in NativeOps
+enum IsaLevel : int {
+  ISA_GENERIC = 1,
+  ISA_AVX2 = 2,
+  ISA_AVX512 = 3,
+};
+
+class SD_LIB_EXPORT CpuDispatch {
+ public:
+  /**
+   * Best ISA level supported by the host, detected once via cpu_features
+   */
+  static int detectedLevel();
+
+  /**
+   * ISA level used for dispatched kernels: detected level, capped by Environment::maxIsaLevel()
+   */
+  static int level();
+
+  /**
+   * Returns true if this binary carries AVX2/AVX-512 variants of dispatched kernels
+   */
+  static bool isEnabled();
+};
+
+/**
+ * Runs Kernel::run(args...) built for the ISA level selected at runtime. Kernel::run has to be SD_INLINE, so its body
+ * (together with inlined ops it calls) is generated separately within every target-specific wrapper below.
+ */
+template <typename Kernel>
+struct IsaDispatch {
+#ifdef SD_ISA_DISPATCH
+  template <typename... Args>
+  SD_TARGET_AVX512 static void avx512(Args... args) {
+    Kernel::run(args...);
+  }
+
+  template <typename... Args>
+  SD_TARGET_AVX2 static void avx2(Args... args) {
+    Kernel::run(args...);
+  }
+#endif
+
+  template <typename... Args>
+  static void run(Args... args) {
+#ifdef SD_ISA_DISPATCH
+    switch (CpuDispatch::level()) {
+      case ISA_AVX512:
+        avx512<Args...>(args...);
+        return;
+      case ISA_AVX2:
+        avx2<Args...>(args...);
+        return;
+      default:
+        break;
+    }
+#endif
+    Kernel::run(args...);
+  }
+};
+
+}  // namespace sd
+
+#endif  // LIBND4J_CPUDISPATCH_H
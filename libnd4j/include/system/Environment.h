@@ -53,6 +53,11 @@ class SD_LIB_EXPORT Environment {
 
   std::atomic<int> _maxThreads;
   std::atomic<int> _maxMasterThreads;
+  std::atomic<int> _interOpThreads{1};
+  std::atomic<bool> _memoryPlanning{false};
+  std::atomic<bool> _graphFusion{false};
+  std::atomic<bool> _opStatistics{true};
+  std::atomic<int> _maxIsaLevel{0};
 
   // these fields hold defaults
   std::atomic<int64_t> _maxTotalPrimaryMemory{-1};
@@ -114,6 +119,50 @@ class SD_LIB_EXPORT Environment {
   int maxMasterThreads();
   void setMaxMasterThreads(int max);
 
+  /**
+   * Number of independent graph nodes GraphExecutioner is allowed to run concurrently (inter-op parallelism).
+   * Each of the concurrently running nodes gets intraOpThreads() threads for its own loops.
+   * Default value is 1, i.e. nodes are executed one by one
+   */
+  int interOpThreads();
+  void setInterOpThreads(int numThreads);
+
+  /**
+   * Number of threads every concurrently executed graph node may use: maxMasterThreads() / interOpThreads()
+   */
+  int intraOpThreads();
+
+  /**
+   * Limits maxMasterThreads() for the calling thread only, 0 removes the limit
+   */
+  void setThreadMaxMasterThreads(int max);
+
+  /**
+   * If enabled, GraphExecutioner builds static MemoryPlan after first execution of the graph, and all following
+   * executions place intermediate arrays into single preallocated arena. Assumes input shapes do not change between runs
+   */
+  bool isMemoryPlanning();
+  void setMemoryPlanning(bool reallyPlan);
+
+  /**
+   * If enabled, Graph replaces chains of elementwise ops with single FusedElementwiseOp while building execution plan.
+   * Intermediate results of fused chains aren't available in VariableSpace anymore
+   */
+  bool isGraphFusion();
+  void setGraphFusion(bool reallyFuse);
+
+  /**
+   * If enabled, every custom op execution and every legacy op call via NativeOps is accounted in OpStatistics
+   */
+  bool isOpStatistics();
+  void setOpStatistics(bool reallyCollect);
+
+  /**
+   * Upper bound for ISA level of runtime-dispatched CPU kernels (see CpuDispatch), 0 means no bound
+   */
+  int maxIsaLevel();
+  void setMaxIsaLevel(int level);
+
   /*
    * Legacy memory limits API, still used in new API as simplified version
    */
@@ -135,6 +135,77 @@ TEST_F(AttentionTests, multi_head_input_dot_product_attention_bp_with_mask) {
 }
  */
 
+TEST_F(AttentionTests, blocked_dot_product_attention_matches_weights_path) {
+  // sequences span several key blocks, and the last one is partial
+  NDArray queries('c', {2, 3, 4, 70}, sd::DataType::DOUBLE);
+  NDArray keys('c', {2, 3, 4, 300}, sd::DataType::DOUBLE);
+  NDArray values('c', {2, 3, 5, 300}, sd::DataType::DOUBLE);
+  NDArray mask('c', {2, 300}, sd::DataType::DOUBLE);
+
+  queries.linspace(-1, 0.001);
+  keys.linspace(1, -0.0007);
+  values.linspace(-2, 0.0011);
+  mask.assign(1.);
+  for (int e = 0; e < 300; e += 3) mask.p(1, e, 0.);
+
+  sd::ops::dot_product_attention op;
+  auto blocked = op.evaluate({&queries, &keys, &values, &mask}, {1, 0});
+  auto materialized = op.evaluate({&queries, &keys, &values, &mask}, {1, 1});
+  ASSERT_EQ(sd::Status::OK, blocked.status());
+  ASSERT_EQ(sd::Status::OK, materialized.status());
+
+  ASSERT_TRUE(materialized.at(0)->equalsTo(blocked.at(0), 1e-10));
+}
+
+TEST_F(AttentionTests, blocked_dot_product_attention_bp_grad_check) {
+  NDArray queries('c', {2, 3, 5}, sd::DataType::DOUBLE);
+  NDArray keys('c', {2, 3, 140}, sd::DataType::DOUBLE);
+  NDArray values('c', {2, 2, 140}, sd::DataType::DOUBLE);
+  NDArray eps('c', {2, 2, 5}, sd::DataType::DOUBLE);
+
+  queries.linspace(-1, 0.07);
+  keys.linspace(1, -0.003);
+  values.linspace(-2, 0.005);
+
+  const OpArgsHolder argsHolderFF({&queries, &keys, &values}, {}, {1, 0});
+  const OpArgsHolder argsHolderBP({&queries, &keys, &values, &eps}, {}, {1});
+
+  sd::ops::dot_product_attention opFF;
+  sd::ops::dot_product_attention_bp opBP;
+
+  ASSERT_TRUE(GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP));
+}
+
+TEST_F(AttentionTests, blocked_dot_product_attention_bp_with_mask) {
+  NDArray queries('c', {2, 2, 3, 6}, sd::DataType::DOUBLE);
+  NDArray keys('c', {2, 2, 3, 150}, sd::DataType::DOUBLE);
+  NDArray values('c', {2, 2, 4, 150}, sd::DataType::DOUBLE);
+  NDArray eps('c', {2, 2, 4, 6}, sd::DataType::DOUBLE);
+  NDArray mask('c', {2, 150}, sd::DataType::DOUBLE);
+
+  queries.linspace(-1, 0.03);
+  keys.linspace(1, -0.002);
+  values.linspace(-2, 0.003);
+  eps.linspace(0.5, -0.01);
+  mask.assign(1.);
+  for (int e = 100; e < 150; e++) mask.p(0, e, 0.);
+
+  sd::ops::dot_product_attention_bp op;
+  auto result = op.evaluate({&queries, &keys, &values, &eps, &mask}, {1});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  // masked keys don't take part in softmax, so they get no gradient
+  auto dLdk = result.at(1);
+  auto dLdv = result.at(2);
+  auto maskedK = (*dLdk)({0, 1, 0, 0, 0, 0, 100, 150});
+  auto maskedV = (*dLdv)({0, 1, 0, 0, 0, 0, 100, 150});
+  auto unmaskedK = (*dLdk)({1, 2, 0, 0, 0, 0, 100, 150});
+
+  ASSERT_NEAR(0., maskedK.reduceNumber(reduce::ASum).e<double>(0), 1e-12);
+  ASSERT_NEAR(0., maskedV.reduceNumber(reduce::ASum).e<double>(0), 1e-12);
+  ASSERT_TRUE(unmaskedK.reduceNumber(reduce::ASum).e<double>(0) > 1e-6);
+}
+
 TEST_F(AttentionTests, basic_multi_head_dot_product_attention) {
   auto keys = NDArrayFactory::create<float>('c', {10, 4, 5});
   auto values = NDArrayFactory::create<float>('c', {10, 4, 5});
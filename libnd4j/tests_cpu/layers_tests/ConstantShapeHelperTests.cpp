@@ -22,6 +22,7 @@
 #include <array/ConstantDataBuffer.h>
 #include <array/ShapeDescriptor.h>
 #include <helpers/ConstantShapeHelper.h>
+#include <helpers/ConstantTadHelper.h>
 #include <helpers/PointersManager.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -74,6 +75,33 @@ TEST_F(ConstantTadHelperTests, test_cachedAmount_1) {
   ASSERT_EQ(ttlMiddle, ttlAfter);
 }
 
+TEST_F(ConstantTadHelperTests, test_concurrent_1) {
+  auto array = NDArrayFactory::create<float>('c', {3, 5, 7, 11});
+  auto ttlBefore = ConstantTadHelper::getInstance().totalCachedEntries();
+  auto missesBefore = ConstantTadHelper::getInstance().cacheCounter(CONSTANT_CACHE_MISSES);
+
+  // every thread asks for the same set of TADs, each of them must be created exactly once
+  std::vector<const sd::LongType *> offsets(8 * 4);
+  auto func = [&](int thread) {
+    for (int i = 0; i < 100; i++)
+      for (int d = 0; d < 4; d++)
+        offsets[thread * 4 + d] =
+            ConstantTadHelper::getInstance().tadForDimensions(array.shapeInfo(), {d}).primaryOffsets();
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) threads.emplace_back(func, t);
+
+  for (auto &t : threads) t.join();
+
+  for (int t = 1; t < 8; t++)
+    for (int d = 0; d < 4; d++) ASSERT_EQ(offsets[d], offsets[t * 4 + d]);
+
+  ASSERT_EQ(ttlBefore + 4, ConstantTadHelper::getInstance().totalCachedEntries());
+  ASSERT_EQ(missesBefore + 4, ConstantTadHelper::getInstance().cacheCounter(CONSTANT_CACHE_MISSES));
+  ASSERT_TRUE(ConstantTadHelper::getInstance().cacheCounter(CONSTANT_CACHE_LOCAL_HITS) > 0);
+}
+
 TEST_F(ConstantShapeHelperTests, basic_test_1) {
   auto ptr = ShapeBuilders::createShapeInfo(sd::DataType::BFLOAT16, 'f', {5, 10, 15});
   ShapeDescriptor descriptor(ptr);
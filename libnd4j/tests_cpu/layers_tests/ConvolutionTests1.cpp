@@ -3945,4 +3945,173 @@ TEST_F(ConvolutionTests1, conv2d_ff_119_2) {
   ASSERT_EQ(sd::Status::OK, status);
 }
 
+#ifndef __CUDABLAS__
+// plain loops over c-ordered NCHW input and [oC, iC, kH, kW] weights, depthwise if weights are [iC, mC, kH, kW]
+static void conv2dReference(const NDArray& x, const NDArray& w, const NDArray& gO, NDArray& z, NDArray& gI, NDArray& gW,
+                            int sH, int sW, int pH, int pW, int dH, int dW, bool depthwise) {
+  const int bS = x.sizeAt(0), iC = x.sizeAt(1), iH = x.sizeAt(2), iW = x.sizeAt(3);
+  const int kH = w.sizeAt(2), kW = w.sizeAt(3), oC = z.sizeAt(1), oH = z.sizeAt(2), oW = z.sizeAt(3);
+  const int mC = depthwise ? w.sizeAt(1) : 1;
+
+  auto px = x.bufferAsT<double>();
+  auto pw = w.bufferAsT<double>();
+  auto pgO = gO.bufferAsT<double>();
+  auto pz = z.bufferAsT<double>();
+  auto pgI = gI.bufferAsT<double>();
+  auto pgW = gW.bufferAsT<double>();
+  z.nullify();
+  gI.nullify();
+  gW.nullify();
+
+  for (int b = 0; b < bS; b++)
+    for (int o = 0; o < oC; o++)
+      for (int oh = 0; oh < oH; oh++)
+        for (int ow = 0; ow < oW; ow++) {
+          const auto zi = ((b * oC + o) * oH + oh) * oW + ow;
+          for (int c = depthwise ? o / mC : 0; c < (depthwise ? o / mC + 1 : iC); c++)
+            for (int kh = 0; kh < kH; kh++)
+              for (int kw = 0; kw < kW; kw++) {
+                const int ih = oh * sH - pH + kh * dH, iw = ow * sW - pW + kw * dW;
+                if (ih < 0 || ih >= iH || iw < 0 || iw >= iW) continue;
+
+                const auto xi = ((b * iC + c) * iH + ih) * iW + iw;
+                const auto wi = depthwise ? ((c * mC + o % mC) * kH + kh) * kW + kw : ((o * iC + c) * kH + kh) * kW + kw;
+                pz[zi] += px[xi] * pw[wi];
+                pgI[xi] += pgO[zi] * pw[wi];
+                pgW[wi] += pgO[zi] * px[xi];
+              }
+        }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests1, conv2d_native_algorithms_1) {
+  const int bS = 2, iC = 5, oC = 7, iH = 11, iW = 9, kH = 3, kW = 3, pH = 1, pW = 1;
+  const int oH = iH, oW = iW;
+
+  NDArray x('c', {bS, iC, iH, iW}, sd::DataType::DOUBLE);
+  NDArray w('c', {oC, iC, kH, kW}, sd::DataType::DOUBLE);
+  NDArray gO('c', {bS, oC, oH, oW}, sd::DataType::DOUBLE);
+  x.linspace(-1., 0.013);
+  w.linspace(0.7, -0.021);
+  gO.linspace(-0.4, 0.003);
+
+  NDArray expZ = gO.ulike(), expGI = x.ulike(), expGW = w.ulike();
+  conv2dReference(x, w, gO, expZ, expGI, expGW, 1, 1, pH, pW, 1, 1, false);
+
+  const std::vector<std::vector<sd::LongType>> wPermutes = {{2, 3, 1, 0}, {0, 1, 2, 3}, {0, 2, 3, 1}};
+  const std::vector<sd::LongType> toNHWC = {0, 2, 3, 1}, toNCHW = {0, 3, 1, 2};
+  const std::vector<sd::ops::Conv2dAlgorithm> algorithms = {sd::ops::CONV2D_DIRECT, sd::ops::CONV2D_IMPLICIT_GEMM,
+                                                            sd::ops::CONV2D_WINOGRAD_2X2, sd::ops::CONV2D_WINOGRAD_4X4};
+
+  for (int isNCHW = 0; isNCHW < 2; isNCHW++)
+    for (int wFormat = 0; wFormat < 3; wFormat++)
+      for (auto algorithm : algorithms) {
+        auto input = isNCHW ? x.dup('c') : x.permute(toNHWC).dup('c');
+        auto gradO = isNCHW ? gO.dup('c') : gO.permute(toNHWC).dup('c');
+        auto weights = w.permute(wPermutes[wFormat]).dup('c');
+        auto output = gradO.ulike(), gradI = input.ulike(), gradW = weights.ulike();
+
+        sd::ops::ConvolutionUtils::conv2dNative(algorithm, &input, &weights, &output, kH, kW, 1, 1, pH, pW, 1, 1,
+                                                isNCHW, wFormat);
+        sd::ops::ConvolutionUtils::conv2dBPNative(algorithm, &input, &weights, &gradO, &gradI, &gradW, kH, kW, 1, 1,
+                                                  pH, pW, 1, 1, isNCHW, wFormat);
+
+        auto z = isNCHW ? output : output.permute(toNCHW);
+        auto gI = isNCHW ? gradI : gradI.permute(toNCHW);
+        ASSERT_TRUE(expZ.equalsTo(z, 1e-10));
+        ASSERT_TRUE(expGI.equalsTo(gI, 1e-10));
+        ASSERT_TRUE(w.permute(wPermutes[wFormat]).isSameShape(gradW));
+        ASSERT_TRUE(expGW.permute(wPermutes[wFormat]).equalsTo(gradW, 1e-10));
+      }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests1, conv2d_native_algorithms_2) {
+  // strides and dilations go through direct and implicit gemm kernels only
+  const int bS = 2, iC = 3, oC = 4, iH = 10, iW = 12, kH = 3, kW = 2, sH = 2, sW = 3, pH = 2, pW = 1, dH = 2, dW = 1;
+  const int oH = (iH + 2 * pH - (kH - 1) * dH - 1) / sH + 1, oW = (iW + 2 * pW - (kW - 1) * dW - 1) / sW + 1;
+
+  NDArray x('c', {bS, iC, iH, iW}, sd::DataType::DOUBLE);
+  NDArray w('c', {oC, iC, kH, kW}, sd::DataType::DOUBLE);
+  NDArray gO('c', {bS, oC, oH, oW}, sd::DataType::DOUBLE);
+  x.linspace(0.5, -0.017);
+  w.linspace(-0.3, 0.029);
+  gO.linspace(0.2, 0.011);
+
+  NDArray expZ = gO.ulike(), expGI = x.ulike(), expGW = w.ulike();
+  conv2dReference(x, w, gO, expZ, expGI, expGW, sH, sW, pH, pW, dH, dW, false);
+
+  for (auto algorithm : {sd::ops::CONV2D_DIRECT, sd::ops::CONV2D_IMPLICIT_GEMM}) {
+    auto output = gO.ulike(), gradI = x.ulike(), gradW = w.ulike();
+
+    sd::ops::ConvolutionUtils::conv2dNative(algorithm, &x, &w, &output, kH, kW, sH, sW, pH, pW, dH, dW, 1, 1);
+    sd::ops::ConvolutionUtils::conv2dBPNative(algorithm, &x, &w, &gO, &gradI, &gradW, kH, kW, sH, sW, pH, pW, dH, dW,
+                                              1, 1);
+
+    ASSERT_TRUE(expZ.equalsTo(output, 1e-10));
+    ASSERT_TRUE(expGI.equalsTo(gradI, 1e-10));
+    ASSERT_TRUE(expGW.equalsTo(gradW, 1e-10));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests1, depthwise_conv2d_native_1) {
+  const int bS = 2, iC = 3, mC = 2, iH = 7, iW = 6, kH = 3, kW = 2, sH = 2, sW = 1, pH = 1, pW = 0, dH = 1, dW = 2;
+  const int oH = (iH + 2 * pH - (kH - 1) * dH - 1) / sH + 1, oW = (iW + 2 * pW - (kW - 1) * dW - 1) / sW + 1;
+
+  NDArray x('c', {bS, iC, iH, iW}, sd::DataType::DOUBLE);
+  NDArray w('c', {iC, mC, kH, kW}, sd::DataType::DOUBLE);
+  NDArray gO('c', {bS, iC * mC, oH, oW}, sd::DataType::DOUBLE);
+  x.linspace(-0.9, 0.021);
+  w.linspace(0.4, -0.037);
+  gO.linspace(-0.1, 0.007);
+
+  NDArray expZ = gO.ulike(), expGI = x.ulike(), expGW = w.ulike();
+  conv2dReference(x, w, gO, expZ, expGI, expGW, sH, sW, pH, pW, dH, dW, true);
+
+  // NHWC input, [kH, kW, iC, mC] weights
+  auto input = x.permute({0, 2, 3, 1}).dup('c');
+  auto gradO = gO.permute({0, 2, 3, 1}).dup('c');
+  auto weights = w.permute({2, 3, 0, 1}).dup('c');
+  auto output = gradO.ulike(), gradI = input.ulike(), gradW = weights.ulike();
+
+  sd::ops::ConvolutionUtils::depthwiseConv2dNative(&input, &weights, &output, kH, kW, sH, sW, pH, pW, dH, dW, 0, 0);
+  sd::ops::ConvolutionUtils::depthwiseConv2dBPNative(&input, &weights, &gradO, &gradI, &gradW, kH, kW, sH, sW, pH, pW,
+                                                     dH, dW, 0, 0);
+
+  ASSERT_TRUE(expZ.equalsTo(output.permute({0, 3, 1, 2}), 1e-10));
+  ASSERT_TRUE(expGI.equalsTo(gradI.permute({0, 3, 1, 2}), 1e-10));
+  ASSERT_TRUE(expGW.equalsTo(gradW.permute({2, 3, 0, 1}), 1e-10));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests1, conv2d_bp_winograd_grad_check) {
+  int bS = 1, iH = 8, iW = 8, iC = 16, oC = 16, kH = 3, kW = 3, sH = 1, sW = 1, pH = 0, pW = 0, dH = 1, dW = 1;
+  int paddingMode = 1;  // 1-SAME, 0-VALID;
+  int dataFormat = 0;   // 1-NHWC, 0-NCHW
+
+  NDArray input('c', {bS, iC, iH, iW}, sd::DataType::DOUBLE);
+  NDArray weights('c', {kH, kW, iC, oC}, sd::DataType::DOUBLE);
+  NDArray bias('c', {oC}, sd::DataType::DOUBLE);
+  NDArray gradO('c', {bS, oC, iH, iW}, sd::DataType::DOUBLE);
+
+  input.linspace(-1., 0.002);
+  weights.linspace(0.3, -0.0007);
+  bias.linspace(-0.1, 0.01);
+  gradO.linspace(-0.5, 0.001);
+
+  const OpArgsHolder argsHolderFF({&input, &weights, &bias}, {},
+                                  {kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, dataFormat});
+  const OpArgsHolder argsHolderBP({&input, &weights, &bias, &gradO}, {},
+                                  {kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, dataFormat});
+
+  sd::ops::conv2d opFF;
+  sd::ops::conv2d_bp opBP;
+
+  const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
+
+  ASSERT_TRUE(isGradCorrect);
+}
+
 #endif  // LIBND4J_CONVOLUTIONTESTS1_H
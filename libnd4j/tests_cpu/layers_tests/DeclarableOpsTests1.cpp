@@ -2977,6 +2977,83 @@ TEST_F(DeclarableOpsTests1, softmax_test12) {
   ASSERT_TRUE(expOutput.equalsTo(z));
 }
 //////////////////////////////////////////////////////////////////////
+// non-last axes, f order and rows longer than the lanes of the engine
+TEST_F(DeclarableOpsTests1, softmax_test13) {
+  for (auto order : {'c', 'f'}) {
+    NDArray input(order, {3, 70, 67}, sd::DataType::FLOAT32);
+    input.linspace(-20.f, 0.01f);
+    input.applyTransform(transform::Sin, input);
+    input *= 10.f;
+
+    for (int dim = -1; dim < 3; dim++) {
+      const int axis = dim < 0 ? dim + 3 : dim;
+      auto max = input.reduceAlongDimension(reduce::Max, {axis}, true);
+      auto exp = input - max;
+      exp.applyTransform(transform::Exp, exp);
+      exp /= exp.reduceAlongDimension(reduce::Sum, {axis}, true);
+
+      auto logExp = exp.transform(transform::Log);
+
+      sd::ops::softmax op;
+      auto results = op.evaluate({&input}, {}, {dim}, {});
+      ASSERT_EQ(sd::Status::OK, results.status());
+      ASSERT_TRUE(exp.equalsTo(results.at(0)));
+
+      sd::ops::log_softmax logOp;
+      auto logResults = logOp.evaluate({&input}, {}, {dim}, {});
+      ASSERT_EQ(sd::Status::OK, logResults.status());
+      ASSERT_TRUE(logExp.equalsTo(logResults.at(0), 1e-4));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, softmax_test14) {
+  NDArray input('c', {4, 33, 70}, sd::DataType::FLOAT32);
+  NDArray gradO('c', {4, 33, 70}, sd::DataType::FLOAT32);
+  input.linspace(-3.f, 0.001f);
+  gradO.linspace(1.f, -0.0005f);
+
+  for (int dim = -1; dim < 3; dim++) {
+    const int axis = dim < 0 ? dim + 3 : dim;
+    sd::ops::softmax op;
+    auto softmaxed = op.evaluate({&input}, {}, {dim}, {});
+    auto y = softmaxed.at(0);
+
+    auto expBp = *y * (gradO - (*y * gradO).reduceAlongDimension(reduce::Sum, {axis}, true));
+    auto expLogBp = gradO - *y * gradO.reduceAlongDimension(reduce::Sum, {axis}, true);
+
+    sd::ops::softmax_bp bpOp;
+    auto bpResults = bpOp.evaluate({&input, &gradO, y}, {}, {dim}, {});
+    ASSERT_EQ(sd::Status::OK, bpResults.status());
+    ASSERT_TRUE(expBp.equalsTo(bpResults.at(0)));
+
+    sd::ops::log_softmax_bp logBpOp;
+    auto logBpResults = logBpOp.evaluate({&input, &gradO, y}, {}, {dim}, {});
+    ASSERT_EQ(sd::Status::OK, logBpResults.status());
+    ASSERT_TRUE(expLogBp.equalsTo(logBpResults.at(0)));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+// views with gaps along the axis and within outer dimensions
+TEST_F(DeclarableOpsTests1, softmax_test15) {
+  NDArray base('c', {6, 10, 9}, sd::DataType::FLOAT32);
+  base.linspace(-5.f, 0.02f);
+
+  auto input = base({1, 5, 1, 0, 10, 2, 0, 8, 1}, true, true);
+  auto dup = input.dup('c');
+
+  for (int dim = 0; dim < 3; dim++) {
+    sd::ops::softmax op;
+    auto results = op.evaluate({&input}, {}, {dim}, {});
+    auto expected = op.evaluate({&dup}, {}, {dim}, {});
+
+    ASSERT_EQ(sd::Status::OK, results.status());
+    ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0)));
+  }
+}
+//////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests1, Reverse_1) {
   float inBuff[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
   float expBuff[] = {24., 23., 22., 21., 20., 19., 18., 17., 16., 15., 14., 13.,
@@ -3372,6 +3372,33 @@ TEST_F(DeclarableOpsTests12, ImageResize_Test12_Input_Strided) {
 
   }  // channels
 }
+
+TEST_F(DeclarableOpsTests12, ImageResize_Test13_UInt8) {
+  // 8-bit images go through fixed point weights, so results may only differ from float ones by a fraction of a level
+  ops::helpers::ImageResizeMethods methods[] = {
+      ops::helpers::ImageResizeMethods::kResizeBilinear,  ops::helpers::ImageResizeMethods::kResizeGaussian,
+      ops::helpers::ImageResizeMethods::kResizeLanczos3,  ops::helpers::ImageResizeMethods::kResizeLanczos5,
+      ops::helpers::ImageResizeMethods::kResizeMitchellcubic};
+
+  auto input = NDArrayFactory::create<float>('c', {3, 13, 17, 3});
+  for (int e = 0; e < input.lengthOf(); e++) input.p(e, (e * 37) % 256);
+  auto inputUInt8 = input.cast(DataType::UINT8);
+
+  for (auto size : {NDArrayFactory::create<int>({9, 23}), NDArrayFactory::create<int>({29, 5})}) {
+    for (auto antialias : {false, true}) {
+      for (auto method : methods) {
+        sd::ops::image_resize op;
+        auto expected = op.evaluate({&input, &size}, {}, {method}, {false, antialias});
+        auto result = op.evaluate({&inputUInt8, &size}, {}, {method}, {false, antialias});
+
+        ASSERT_EQ(sd::Status::OK, expected.status());
+        ASSERT_EQ(sd::Status::OK, result.status());
+        ASSERT_TRUE(expected[0]->isSameShape(result[0]));
+        ASSERT_TRUE(expected[0]->equalsTo(result[0], 0.1));
+      }
+    }
+  }
+}
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests12, TriangularSolve_Test_1) {
   auto a = NDArrayFactory::create<float>(
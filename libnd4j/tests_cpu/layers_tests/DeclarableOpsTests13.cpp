@@ -2308,6 +2308,157 @@ TEST_F(DeclarableOpsTests13, lstmLayer_bp_ScalarCheck) {
   }
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests13, lstmLayer_14) {
+  const int sL = 5;
+  const int bS = 4;
+  const int nIn = 3;
+  const int nOut = 4;
+
+  const int dataFormat = 0;     // [sL,bS,nIn]
+  const int directionMode = 3;  // bidirectional concat
+  const int gateAct = 2;        // sigmoid activation for input (i), forget (f) and output (o) gates
+  const int cellAct = 0;        // tanh activation for cell state
+  const int outAct = 0;         // tanh activation for output
+
+  const double cellClip = 1.5;
+
+  NDArray x('c', {sL, bS, nIn}, sd::DataType::FLOAT32);
+  NDArray Wx('c', {2, nIn, 4 * nOut}, sd::DataType::FLOAT32);
+  NDArray Wr('c', {2, nOut, 4 * nOut}, sd::DataType::FLOAT32);
+  NDArray b('c', {2, 4 * nOut}, sd::DataType::FLOAT32);
+  NDArray seqLen('c', {bS}, {3, 0, 5, 1}, sd::DataType::FLOAT32);
+  NDArray hI('c', {2, bS, nOut}, sd::DataType::FLOAT32);
+  NDArray cI('c', {2, bS, nOut}, sd::DataType::FLOAT32);
+  NDArray Wp('c', {2, 3 * nOut}, sd::DataType::FLOAT32);
+
+  x.linspace(-1.f, 0.05f);
+  Wx.linspace(0.5f, -0.01f);
+  Wr.linspace(-0.3f, 0.005f);
+  b.linspace(0.2f, -0.02f);
+  hI.linspace(-0.4f, 0.03f);
+  cI.linspace(0.6f, -0.04f);
+  Wp.linspace(0.1f, 0.02f);
+
+  std::vector<double> tArgs = {cellClip};
+  std::vector<sd::LongType> iArgs = {dataFormat, directionMode, gateAct, cellAct, outAct};
+  std::vector<bool> bArgs = {true, true, true, true, true, true, true, true};
+
+  sd::ops::lstmLayer op;
+  auto results = op.evaluate({&x, &Wx, &Wr, &b, &seqLen, &hI, &cI, &Wp}, tArgs, iArgs, bArgs);
+  ASSERT_EQ(sd::Status::OK, results.status());
+
+  auto h = results.at(0);
+  auto hL = results.at(1);
+  auto cL = results.at(2);
+
+  // every direction of every batch row is stepped through with lstmLayerCell
+  sd::ops::lstmLayerCell cellOp;
+  for (int d = 0; d < 2; ++d) {
+    NDArray Wxd = Wx({d, d + 1, 0, 0, 0, 0});
+    NDArray Wrd = Wr({d, d + 1, 0, 0, 0, 0});
+    NDArray bd = b({d, d + 1, 0, 0});
+    NDArray Wpd = Wp({d, d + 1, 0, 0});
+
+    for (int e = 0; e < bS; ++e) {
+      const int limit = seqLen.e<int>(e);
+
+      NDArray ht = hI({d, d + 1, e, e + 1, 0, 0}).reshape('c', {1, nOut}).dup();
+      NDArray ct = cI({d, d + 1, e, e + 1, 0, 0}).reshape('c', {1, nOut}).dup();
+
+      for (int s = 0; s < limit; ++s) {
+        const int t = d == 0 ? s : limit - 1 - s;
+        NDArray xt = x({t, t + 1, e, e + 1, 0, 0}).reshape('c', {1, nIn}).dup();
+
+        auto step = cellOp.evaluate({&xt, &Wxd, &Wrd, &bd, &ht, &ct, &Wpd}, {cellClip}, {gateAct, cellAct, outAct},
+                                    {true, true});
+        ASSERT_EQ(sd::Status::OK, step.status());
+
+        ht.assign(step.at(0));
+        ct.assign(step.at(1));
+
+        NDArray hExp = ht.reshape('c', {nOut});
+        ASSERT_TRUE(hExp.equalsTo((*h)({t, t + 1, e, e + 1, d * nOut, (d + 1) * nOut})));
+      }
+
+      // time steps beyond sequence length are zeros, so are last output and cell state of empty sequence
+      for (int t = limit; t < sL; ++t)
+        ASSERT_EQ(0.f, (*h)({t, t + 1, e, e + 1, d * nOut, (d + 1) * nOut}).reduceNumber(reduce::ASum).e<float>(0));
+
+      if (limit == 0) {
+        ht.nullify();
+        ct.nullify();
+      }
+
+      NDArray hLExp = ht.reshape('c', {nOut});
+      NDArray cLExp = ct.reshape('c', {nOut});
+      ASSERT_TRUE(hLExp.equalsTo((*hL)({d, d + 1, e, e + 1, 0, 0})));
+      ASSERT_TRUE(cLExp.equalsTo((*cL)({d, d + 1, e, e + 1, 0, 0})));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests13, lstmLayer_bp_7) {
+  const int sL = 4;
+  const int bS = 3;
+  const int nIn = 2;
+  const int nOut = 3;
+
+  const int dataFormat = 1;     // [bS,sL,nIn]
+  const int directionMode = 3;  // bidirectional concat
+  const int gateAct = 2;        // sigmoid activation for input (i), forget (f) and output (o) gates
+  const int cellAct = 0;        // tanh activation for cell state
+  const int outAct = 0;         // tanh activation for output
+
+  const bool hasBiases = true;   // biases array is provided
+  const bool hasSeqLen = true;   // seqLen array is provided
+  const auto hasInitH = true;    // initial output is provided
+  const auto hasInitC = true;    // initial cell state is provided
+  const auto hasPH = true;       // peephole connections are present
+  const auto retFullSeq = true;  // dLdh per each time step
+  const auto retLastH = true;    // output at last time step
+  const auto retLastC = true;    // cells state at last time step
+
+  const double cellClip = 0;  // do not apply clipping
+
+  NDArray x('c', {bS, sL, nIn}, sd::DataType::DOUBLE);
+  NDArray Wx('c', {2, nIn, 4 * nOut}, sd::DataType::DOUBLE);
+  NDArray Wr('c', {2, nOut, 4 * nOut}, sd::DataType::DOUBLE);
+  NDArray b('c', {2, 4 * nOut}, sd::DataType::DOUBLE);
+  NDArray seqLen('c', {bS}, {2, 0, 4}, sd::DataType::DOUBLE);
+  NDArray hI('c', {2, bS, nOut}, sd::DataType::DOUBLE);
+  NDArray cI('c', {2, bS, nOut}, sd::DataType::DOUBLE);
+  NDArray Wp('c', {2, 3 * nOut}, sd::DataType::DOUBLE);
+  NDArray dLdh('c', {bS, sL, 2 * nOut}, sd::DataType::DOUBLE);
+  NDArray dLdhL('c', {2, bS, nOut}, sd::DataType::DOUBLE);
+  NDArray dLdcL('c', {2, bS, nOut}, sd::DataType::DOUBLE);
+
+  x.linspace(-2, 0.1);
+  hI.linspace(-1.5, 0.1);
+  cI.linspace(0.7, -0.1);
+  Wx.linspace(1, -0.1);
+  Wr.linspace(-1, 0.1);
+  Wp.linspace(0.2, 0.2);
+  b.linspace(1, -0.15);
+
+  std::vector<double> tArgs = {cellClip};
+  std::vector<sd::LongType> iArgs = {dataFormat, directionMode, gateAct, cellAct, outAct};
+  std::vector<bool> bArgs = {hasBiases, hasSeqLen, hasInitH, hasInitC, hasPH, retFullSeq, retLastH, retLastC};
+
+  const OpArgsHolder argsHolderFF({&x, &Wx, &Wr, &b, &seqLen, &hI, &cI, &Wp}, tArgs, iArgs, bArgs);
+  const OpArgsHolder argsHolderBP({&x, &Wx, &Wr, &b, &seqLen, &hI, &cI, &Wp, &dLdh, &dLdhL, &dLdcL}, tArgs, iArgs,
+                                  bArgs);
+
+  sd::ops::lstmLayer opFF;
+  sd::ops::lstmLayer_bp opBP;
+
+  const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP,
+                                                  {true, true, true, true, false, true, true, true});
+
+  ASSERT_TRUE(isGradCorrect);
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests13, batchnorm_test1) {
   NDArray input('c', {2, 4}, sd::DataType::FLOAT32);
@@ -2318,3 +2318,96 @@ TEST_F(DeclarableOpsTests18, TestUpdaterAmsGrad3) {
   ASSERT_TRUE(stateH.isSameShape(results.at(3)));
   ASSERT_TRUE(stateH.equalsTo(results.at(3)));
 }
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests18, TestUpdaterAdamForeach1) {
+  NDArray base('c', {6, 8}, DataType::FLOAT32);
+  base.linspace(-1.f, 0.05f);
+
+  std::vector<NDArray> grads = {NDArray('c', {3, 4}, DataType::FLOAT32), NDArray('c', {7}, DataType::FLOAT32),
+                                base({0, 0, 0, 4})};
+  grads[0].linspace(0.5f, 0.1f);
+  grads[1].linspace(-2.f, 0.3f);
+
+  std::vector<NDArray> initU, initM, updates, stateU, stateM;
+  for (auto& g : grads) {
+    initU.emplace_back(g.ulike());
+    initM.emplace_back(g.ulike());
+    initU.back().linspace(0.01f, 0.01f);
+    initM.back().linspace(-0.1f, 0.02f);
+
+    updates.emplace_back(g.ulike());
+    stateU.emplace_back(g.ulike());
+    stateM.emplace_back(g.ulike());
+  }
+
+  std::vector<NDArray*> inputs, outputs;
+  for (auto list : {&grads, &initU, &initM})
+    for (auto& array : *list) inputs.emplace_back(&array);
+  for (auto list : {&updates, &stateU, &stateM})
+    for (auto& array : *list) outputs.emplace_back(&array);
+
+  sd::ops::adam_updater_foreach op;
+  sd::ops::adam_updater opSingle;
+  ASSERT_EQ(sd::Status::OK, op.execute(inputs, outputs, {0.001, 0.9, 0.999, 1.0e-8}, {3}));
+
+  for (size_t e = 0; e < grads.size(); e++) {
+    auto results = opSingle.evaluate({&grads[e], &initU[e], &initM[e]}, {0.001, 0.9, 0.999, 1.0e-8}, {3});
+    ASSERT_EQ(sd::Status::OK, results.status());
+
+    ASSERT_TRUE(updates[e].equalsTo(results.at(0)));
+    ASSERT_TRUE(stateU[e].equalsTo(results.at(1)));
+    ASSERT_TRUE(stateM[e].equalsTo(results.at(2)));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests18, TestUpdaterNadamForeach1) {
+  // parameters allocated in one flat buffer, op gets views and updates them in place
+  NDArray grad('c', {30}, DataType::DOUBLE);
+  NDArray initV('c', {30}, DataType::DOUBLE);
+  NDArray initM('c', {30}, DataType::DOUBLE);
+  grad.linspace(-1.5, 0.1);
+  initV.linspace(0.001, 0.002);
+  initM.linspace(0.2, -0.01);
+
+  sd::ops::nadam_updater opSingle;
+  auto results = opSingle.evaluate({&grad, &initV, &initM}, {0.01, 0.9, 0.999, 1.0e-8}, {1});
+  ASSERT_EQ(sd::Status::OK, results.status());
+
+  std::vector<NDArray> views;
+  for (auto array : {&grad, &initV, &initM})
+    for (auto interval : {std::make_pair(0, 10), std::make_pair(10, 15), std::make_pair(15, 30)})
+      views.emplace_back((*array)({interval.first, interval.second}));
+
+  std::vector<NDArray*> arrays;
+  for (auto& view : views) arrays.emplace_back(&view);
+
+  sd::ops::nadam_updater_foreach op;
+  ASSERT_EQ(sd::Status::OK, op.execute(arrays, arrays, {0.01, 0.9, 0.999, 1.0e-8}, {1}));
+
+  ASSERT_TRUE(grad.equalsTo(results.at(0)));
+  ASSERT_TRUE(initV.equalsTo(results.at(1)));
+  ASSERT_TRUE(initM.equalsTo(results.at(2)));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests18, TestUpdaterRmsPropForeach1) {
+  NDArray grad0('c', {2, 3}, {1, 2, 3, 4, 5, 6}, DataType::FLOAT32);
+  NDArray grad1('c', {4}, {-0.5, 0.25, 0.75, -1}, DataType::FLOAT32);
+  NDArray init0('c', {2, 3}, {0.1, 0.1, 0.2, 0.2, 0.3, 0.3}, DataType::FLOAT32);
+  NDArray init1('c', {4}, {0.01, 0.02, 0.03, 0.04}, DataType::FLOAT32);
+
+  sd::ops::rms_prop_updater opSingle;
+  auto results0 = opSingle.evaluate({&grad0, &init0}, {0.1, 0.95, 1.0e-8});
+  auto results1 = opSingle.evaluate({&grad1, &init1}, {0.1, 0.95, 1.0e-8});
+
+  sd::ops::rms_prop_updater_foreach op;
+  auto results = op.evaluate({&grad0, &grad1, &init0, &init1}, {0.1, 0.95, 1.0e-8});
+  ASSERT_EQ(sd::Status::OK, results.status());
+  ASSERT_EQ(4, results.size());
+
+  ASSERT_TRUE(results0.at(0)->equalsTo(results.at(0)));
+  ASSERT_TRUE(results1.at(0)->equalsTo(results.at(1)));
+  ASSERT_TRUE(results0.at(1)->equalsTo(results.at(2)));
+  ASSERT_TRUE(results1.at(1)->equalsTo(results.at(3)));
+}
@@ -117,6 +117,29 @@ TEST_F(DeclarableOpsTests19, test_threshold_encode_boundary_2) {
   ASSERT_EQ(900, x.sumNumber().e<int>(0));
 }
 
+TEST_F(DeclarableOpsTests19, test_threshold_encode_boundary_3) {
+  // boundary falls into the middle of the array: exactly the first updates over threshold are encoded, in order
+  const int length = 300000;
+  auto x = NDArrayFactory::create<float>('c', {length});
+  for (int e = 0; e < length; e += 3) x.p(e, e % 2 == 0 ? 2.0f : -2.0f);
+
+  sd::ops::encode_threshold op;
+  auto result = op.evaluate({&x}, {1.0}, {70000});
+
+  auto encoded = result.at(1);
+  ASSERT_EQ(70004, encoded->lengthOf());
+
+  for (int i = 0; i < 70000; i++) {
+    const int e = 3 * i;
+    ASSERT_EQ(e % 2 == 0 ? e + 1 : -e - 1, encoded->e<int>(i + 4));
+  }
+
+  for (int e = 0; e < length; e++) {
+    const float expected = e % 3 != 0 ? 0.0f : (e < 3 * 70000 ? 1.0f : 2.0f) * (e % 2 == 0 ? 1.0f : -1.0f);
+    ASSERT_EQ(expected, x.e<float>(e));
+  }
+}
+
 TEST_F(DeclarableOpsTests19, test_threshold_decode_1) {
   auto x = NDArrayFactory::create<double>('c', {3}, {1.0, 2.0, -3.0});
   auto y = NDArrayFactory::create<int>('c', {7}, {3, 3, 1056964608, 0, 1, 2, -3});
@@ -1359,6 +1359,56 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
   ASSERT_TRUE(expI.equalsTo(i));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+  // wide rows with plenty of ties, read through permuted view
+  const int rows = 3, width = 517, k = 20;
+  auto x = NDArrayFactory::create<float>('c', {width, rows});
+  for (int e = 0; e < x.lengthOf(); e++) x.p(e, static_cast<float>((e * 37) % 101));
+  auto p = x.permute({1, 0});
+
+  sd::ops::top_k op;
+  for (bool sorted : {true, false}) {
+    auto result = op.evaluate({&p}, {}, {k}, {sorted});
+    ASSERT_EQ(sd::Status::OK, result.status());
+
+    auto v = result.at(0);
+    auto i = result.at(1);
+
+    for (int r = 0; r < rows; r++) {
+      // reference: larger values first, lower index first among equal ones
+      std::vector<int> order(width);
+      for (int e = 0; e < width; e++) order[e] = e;
+      std::stable_sort(order.begin(), order.end(),
+                       [&](int a, int b) -> bool { return p.e<float>(r, a) > p.e<float>(r, b); });
+      order.resize(k);
+      if (!sorted) std::sort(order.begin(), order.end());
+
+      for (int e = 0; e < k; e++) {
+        ASSERT_EQ(order[e], i->e<sd::LongType>(r, e));
+        ASSERT_EQ(p.e<float>(r, order[e]), v->e<float>(r, e));
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_7) {
+  // indices output of INT32 type
+  auto x = NDArrayFactory::create<float>('c', {2, 5}, {1.f, 9.f, 3.f, 7.f, 5.f, 8.f, 2.f, 6.f, 4.f, 10.f});
+  auto v = NDArrayFactory::create<float>('c', {2, 3});
+  auto i = NDArrayFactory::create<int>('c', {2, 3});
+  auto expV = NDArrayFactory::create<float>('c', {2, 3}, {9.f, 7.f, 5.f, 10.f, 8.f, 6.f});
+  auto expI = NDArrayFactory::create<int>('c', {2, 3}, {1, 3, 4, 4, 0, 2});
+
+  sd::ops::top_k op;
+  auto status = op.execute({&x}, {&v, &i}, {}, {3}, {true});
+  ASSERT_EQ(sd::Status::OK, status);
+
+  ASSERT_EQ(expV, v);
+  ASSERT_EQ(expI, i);
+}
+
 ///////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_Moments_1) {
   auto x = NDArrayFactory::create<double>('c', {2, 3, 4},
@@ -2516,6 +2516,74 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentProdBP_4) {
   ASSERT_TRUE(exp.equalsTo(result.at(0)));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegment_Large_1) {
+  const int numRows = 3000, rowLength = 17, numClasses = 100;
+  auto x = NDArrayFactory::create<float>('c', {numRows, rowLength});
+  auto idx = NDArrayFactory::create<int>('c', {numRows});
+  x.linspace(-1.f, 0.001f);
+
+  // every other row goes into class 7, the rest is spread unevenly, classes above 90 stay empty
+  for (int e = 0; e < numRows; e++) idx.p(e, e % 2 == 0 ? 7 : (e * 31) % 91);
+
+  auto expSum = NDArrayFactory::create<float>('c', {numClasses, rowLength});
+  auto expMax = NDArrayFactory::create<float>('c', {numClasses, rowLength});
+  auto expMean = NDArrayFactory::create<float>('c', {numClasses, rowLength});
+  std::vector<int> counts(numClasses, 0);
+  expMax.assign(-DataTypeUtils::max<float>());
+
+  for (int r = 0; r < numRows; r++) {
+    auto c = idx.e<int>(r);
+    counts[c]++;
+    for (int e = 0; e < rowLength; e++) {
+      auto v = x.e<float>(r, e);
+      expSum.p(c, e, expSum.e<float>(c, e) + v);
+      expMax.p(c, e, sd::math::sd_max<float>(expMax.e<float>(c, e), v));
+    }
+  }
+
+  for (int c = 0; c < numClasses; c++)
+    for (int e = 0; e < rowLength; e++)
+      if (counts[c] > 0) expMean.p(c, e, expSum.e<float>(c, e) / counts[c]);
+
+  sd::ops::unsorted_segment_sum opSum;
+  sd::ops::unsorted_segment_max opMax;
+  sd::ops::unsorted_segment_mean opMean;
+
+  auto resSum = opSum.evaluate({&x, &idx}, {}, {numClasses});
+  auto resMax = opMax.evaluate({&x, &idx}, {}, {numClasses});
+  auto resMean = opMean.evaluate({&x, &idx}, {}, {numClasses});
+  ASSERT_EQ(resSum.status(), sd::Status::OK);
+  ASSERT_EQ(resMax.status(), sd::Status::OK);
+  ASSERT_EQ(resMean.status(), sd::Status::OK);
+
+  ASSERT_TRUE(expSum.equalsTo(resSum.at(0), 1e-2));
+  ASSERT_TRUE(expMax.equalsTo(resMax.at(0)));
+  ASSERT_TRUE(expMean.equalsTo(resMean.at(0), 1e-3));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentMaxBP_Large_1) {
+  const int numRows = 2000, rowLength = 9, numClasses = 40;
+  auto x = NDArrayFactory::create<double>('c', {numRows, rowLength});
+  auto idx = NDArrayFactory::create<int>('c', {numRows});
+  auto gradO = NDArrayFactory::create<double>('c', {numClasses, rowLength});
+  x.linspace(1.);
+  gradO.linspace(0.5);
+
+  for (int e = 0; e < numRows; e++) idx.p(e, (e * 7) % numClasses);
+
+  // rows are increasing, so the last row of every class holds its maximum
+  auto exp = NDArrayFactory::create<double>('c', {numRows, rowLength});
+  for (int r = numRows - numClasses; r < numRows; r++)
+    for (int e = 0; e < rowLength; e++) exp.p(r, e, gradO.e<double>(idx.e<int>(r), e));
+
+  sd::ops::unsorted_segment_max_bp op;
+  auto result = op.evaluate({&x, &idx, &gradO}, {}, {numClasses});
+  ASSERT_EQ(result.status(), sd::Status::OK);
+  ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestExtractImagePatches_1) {
   auto x = NDArrayFactory::create<double>(
@@ -25,6 +25,7 @@
 #include <array/NDArrayFactory.h>
 #include <graph/FlatUtils.h>
 #include <graph/Stash.h>
+#include <helpers/BitwiseUtils.h>
 
 #include "testlayers.h"
 
@@ -50,6 +51,54 @@ TEST_F(FlatUtilsTests, flat_float_serde_1) {
   delete restored;
 }
 
+TEST_F(FlatUtilsTests, flat_float_zero_copy_1) {
+  auto array = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto flatArray = FlatUtils::toFlatArray(builder, array);
+  builder.Finish(flatArray);
+
+  auto pfArray = GetFlatArray(builder.GetBufferPointer());
+
+  auto copied = FlatUtils::fromFlatArray(pfArray);
+  auto mapped = FlatUtils::fromFlatArray(pfArray, true);
+
+  ASSERT_EQ(array, *copied);
+  ASSERT_EQ(array, *mapped);
+
+  // byte vectors are aligned to 4 bytes, enough for floats
+  ASSERT_NE(reinterpret_cast<const void *>(pfArray->buffer()->data()), copied->buffer());
+  ASSERT_EQ(reinterpret_cast<const void *>(pfArray->buffer()->data()), mapped->buffer());
+
+  delete copied;
+  delete mapped;
+}
+
+TEST_F(FlatUtilsTests, flat_float_zero_copy_2) {
+  auto array = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+
+  // payload in foreign byte order can't be used in place
+  auto bytes = array.asByteVector();
+  for (size_t e = 0; e < bytes.size(); e += sizeof(float))
+    std::reverse(bytes.begin() + e, bytes.begin() + e + sizeof(float));
+
+  auto foreign = BitwiseUtils::isBE() ? sd::graph::ByteOrder_LE : sd::graph::ByteOrder_BE;
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto fBuffer = builder.CreateVector(bytes);
+  auto fShape = builder.CreateVector(array.getShapeInfoAsFlatVector());
+  auto flatArray = CreateFlatArray(builder, fShape, fBuffer, static_cast<sd::graph::DType>(array.dataType()), foreign);
+  builder.Finish(flatArray);
+
+  auto pfArray = GetFlatArray(builder.GetBufferPointer());
+  auto restored = FlatUtils::fromFlatArray(pfArray, true);
+
+  ASSERT_EQ(array, *restored);
+  ASSERT_NE(reinterpret_cast<const void *>(pfArray->buffer()->data()), restored->buffer());
+
+  delete restored;
+}
+
 TEST_F(FlatUtilsTests, flat_int_serde_1) {
   auto array = NDArrayFactory::create<int>('c', {4}, {1, 2, 3, 4});
 
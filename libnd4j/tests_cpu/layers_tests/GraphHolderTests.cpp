@@ -20,6 +20,7 @@
 // Created by raver119 on 11.12.17.
 //
 #include <graph/GraphHolder.h>
+#include <ops/declarable/CustomOperations.h>
 
 #include "testlayers.h"
 
@@ -31,6 +32,18 @@ class GraphHolderTests : public testing::Test {
  public:
 };
 
+// op that fails with exception not derived from std::exception
+class ThrowingOp : public sd::ops::DeclarableCustomOp {
+ public:
+  ThrowingOp() : sd::ops::DeclarableCustomOp(1, 1, "throwing_op", false, 0, 0) {}
+
+ protected:
+  sd::Status validateAndExecute(Context& block) override { return sd::Status::OK; }
+
+ public:
+  ShapeList* calculateOutputShape(ShapeList* inputShape, Context& block) override { throw 42; }
+};
+
 TEST_F(GraphHolderTests, SimpleTests_1) {
   Graph graph;
   sd::LongType graphId = 119;
@@ -81,3 +94,268 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
   delete graph2;
 }
+
+TEST_F(GraphHolderTests, Sessions_1) {
+  auto graph = new Graph;
+  auto weights = NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  auto input = NDArrayFactory::create_<float>('c', {2, 2}, {0.f, 0.f, 0.f, 0.f});
+  graph->getVariableSpace()->putVariable(-1, weights);
+  graph->getVariableSpace()->putVariable(-2, input);
+  graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 1, {-1, -2}, {}));
+
+  sd::LongType graphId = 121;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  auto session1 = GraphHolder::getInstance().checkoutSession(graphId);
+  auto session2 = GraphHolder::getInstance().checkoutSession(graphId);
+  ASSERT_TRUE(session1 != session2);
+
+  auto x1 = NDArrayFactory::create<float>('c', {2, 2}, {10.f, 20.f, 30.f, 40.f});
+  auto x2 = NDArrayFactory::create<float>('c', {2, 2}, {-1.f, -2.f, -3.f, -4.f});
+  auto exp1 = NDArrayFactory::create<float>('c', {2, 2}, {11.f, 22.f, 33.f, 44.f});
+  auto exp2 = NDArrayFactory::create<float>('c', {2, 2}, {0.f, 0.f, 0.f, 0.f});
+
+  session1->bindInput(-2, x1.buffer(), x1.shapeInfo());
+  session2->bindInput(-2, x2.buffer(), x2.shapeInfo());
+
+  ASSERT_EQ(sd::Status::OK, session1->execute());
+  ASSERT_EQ(sd::Status::OK, session2->execute());
+
+  ASSERT_TRUE(exp1.equalsTo(session1->variableSpace()->getVariable(1)->getNDArray()));
+  ASSERT_TRUE(exp2.equalsTo(session2->variableSpace()->getVariable(1)->getNDArray()));
+
+  // stored graph isn't modified by requests
+  ASSERT_FALSE(graph->getVariableSpace()->hasVariable(1));
+  ASSERT_EQ(0.f, input->reduceNumber(reduce::Sum).e<float>(0));
+
+  GraphHolder::getInstance().releaseSession(graphId, session1);
+  GraphHolder::getInstance().releaseSession(graphId, session2);
+
+  // idle session is reused, and results of previous request get overwritten
+  auto session3 = GraphHolder::getInstance().checkoutSession(graphId);
+  ASSERT_TRUE(session3 == session1 || session3 == session2);
+
+  session3->bindInput(-2, x2.buffer(), x2.shapeInfo());
+  ASSERT_EQ(sd::Status::OK, session3->execute());
+  ASSERT_TRUE(exp2.equalsTo(session3->variableSpace()->getVariable(1)->getNDArray()));
+
+  GraphHolder::getInstance().releaseSession(graphId, session3);
+
+  GraphHolder::getInstance().dropGraph(graphId);
+  ASSERT_FALSE(GraphHolder::getInstance().hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, Batcher_1) {
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, 3}));
+  graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+  graph->addOutput(1);
+
+  sd::LongType graphId = 122;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  // full batch is executed right away, deadline is only a safety net here
+  BatcherOptions options;
+  options.maxBatchSize = 4;
+  options.maxLatencyMicros = 1000000;
+  auto batcher = GraphHolder::getInstance().enableBatching(graphId, {-1}, options);
+
+  std::vector<NDArray> inputs;
+  for (int e = 0; e < 4; e++)
+    inputs.emplace_back(NDArrayFactory::create<float>('c', {1, 3}, {-1.f * e, 2.f * e, -3.f * e}));
+
+  std::vector<std::future<BatchResult>> futures;
+  for (int e = 0; e < 4; e++) futures.emplace_back(batcher->submit({&inputs[e]}));
+
+  for (int e = 0; e < 4; e++) {
+    auto result = futures[e].get();
+    ASSERT_EQ(sd::Status::OK, result.status);
+    ASSERT_EQ(1, result.outputs.size());
+    ASSERT_EQ(1, result.outputIds[0].first);
+
+    auto exp = NDArrayFactory::create<float>('c', {1, 3}, {1.f * e, 2.f * e, 3.f * e});
+    ASSERT_TRUE(exp.isSameShape(result.outputs[0]));
+    ASSERT_TRUE(exp.equalsTo(result.outputs[0]));
+  }
+
+  auto stats = batcher->stats();
+  ASSERT_EQ(4, stats.requests);
+  ASSERT_EQ(1, stats.batches);
+  ASSERT_EQ(4, stats.rows);
+  ASSERT_EQ(0, stats.paddedElements);
+  ASSERT_EQ(0, stats.queueDepth);
+
+  GraphHolder::getInstance().dropGraphAny(graphId);
+  ASSERT_TRUE(GraphHolder::getInstance().batcher(graphId) == nullptr);
+
+  // reference taken before unregistering stays valid, but doesn't accept requests anymore
+  ASSERT_ANY_THROW(batcher->submit({&inputs[0]}));
+}
+
+TEST_F(GraphHolderTests, Batcher_2) {
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, 3}));
+  graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+  graph->addOutput(1);
+
+  sd::LongType graphId = 123;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  auto x = NDArrayFactory::create<float>('c', {1, 2}, {-1.f, -2.f});
+  auto y = NDArrayFactory::create<float>('c', {1, 3}, {-3.f, -4.f, -5.f});
+
+  // ragged requests never share a batch without padding
+  BatcherOptions options;
+  options.maxBatchSize = 2;
+  options.maxLatencyMicros = 20000;
+  auto batcher = GraphHolder::getInstance().enableBatching(graphId, {-1}, options);
+
+  auto fx = batcher->submit({&x});
+  auto fy = batcher->submit({&y});
+
+  auto rx = fx.get();
+  auto ry = fy.get();
+  ASSERT_EQ(sd::Status::OK, rx.status);
+  ASSERT_EQ(sd::Status::OK, ry.status);
+  ASSERT_EQ(2, rx.outputs[0].lengthOf());
+  ASSERT_EQ(3, ry.outputs[0].lengthOf());
+  ASSERT_EQ(2, batcher->stats().batches);
+
+  // with padding both go together, and outputs keep padded shape
+  options.padding = BatchPadding::PAD;
+  options.maxLatencyMicros = 1000000;
+  batcher = GraphHolder::getInstance().enableBatching(graphId, {-1}, options);
+
+  fx = batcher->submit({&x});
+  fy = batcher->submit({&y});
+
+  auto expX = NDArrayFactory::create<float>('c', {1, 3}, {1.f, 2.f, 0.f});
+  auto expY = NDArrayFactory::create<float>('c', {1, 3}, {3.f, 4.f, 5.f});
+
+  rx = fx.get();
+  ry = fy.get();
+  ASSERT_TRUE(expX.equalsTo(rx.outputs[0]));
+  ASSERT_TRUE(expY.equalsTo(ry.outputs[0]));
+
+  auto stats = batcher->stats();
+  ASSERT_EQ(1, stats.batches);
+  ASSERT_EQ(1, stats.paddedElements);
+
+  GraphHolder::getInstance().dropGraphAny(graphId);
+}
+
+TEST_F(GraphHolderTests, Sessions_2) {
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 3}));
+  graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+  sd::LongType graphId = 124;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  // same session serves requests with different batch sizes
+  auto session = GraphHolder::getInstance().checkoutSession(graphId);
+  for (int rows : {2, 4, 1, 4}) {
+    auto x = NDArrayFactory::create<float>('c', {rows, 3});
+    x.linspace(-5.f);
+    auto exp = x.transform(transform::Abs);
+
+    session->bindInput(-1, x.buffer(), x.shapeInfo());
+    ASSERT_EQ(sd::Status::OK, session->execute());
+    ASSERT_TRUE(exp.equalsTo(session->variableSpace()->getVariable(1)->getNDArray()));
+    session->unbindInputs();
+  }
+
+  GraphHolder::getInstance().releaseSession(graphId, session);
+  GraphHolder::getInstance().dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, Sessions_3) {
+  sd::ops::matmul op;
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f}));
+  graph->getVariableSpace()->putVariable(-2, NDArrayFactory::create_<float>('c', {2, 2}));
+  graph->addNode(new Node(&op, 1, {-1, -2}));
+
+  sd::LongType graphId = 125;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  auto exp = NDArrayFactory::create<float>('c', {2, 2}, {7.f, 10.f, 15.f, 22.f});
+
+  for (int e = 0; e < 3; e++) {
+    // inner dimensions don't match, so execution throws
+    auto bad = NDArrayFactory::create<float>('c', {3, 2});
+    auto session = GraphHolder::getInstance().checkoutSession(graphId);
+    session->bindInput(-2, bad.buffer(), bad.shapeInfo());
+    ASSERT_ANY_THROW(session->execute());
+    GraphHolder::getInstance().discardSession(graphId, session);
+
+    // slot of discarded session keeps serving requests
+    auto good = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    session = GraphHolder::getInstance().checkoutSession(graphId);
+    session->bindInput(-2, good.buffer(), good.shapeInfo());
+    ASSERT_EQ(sd::Status::OK, session->execute());
+    ASSERT_TRUE(exp.equalsTo(session->variableSpace()->getVariable(1)->getNDArray()));
+    GraphHolder::getInstance().releaseSession(graphId, session);
+  }
+
+  GraphHolder::getInstance().dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, Batcher_3) {
+  sd::ops::matmul op;
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f}));
+  graph->getVariableSpace()->putVariable(-2, NDArrayFactory::create_<float>('c', {2, 2}));
+  graph->addNode(new Node(&op, 1, {-1, -2}));
+  graph->addOutput(1);
+
+  sd::LongType graphId = 126;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  BatcherOptions options;
+  options.maxBatchSize = 1;
+  auto batcher = GraphHolder::getInstance().enableBatching(graphId, {-2}, options);
+
+  auto bad = NDArrayFactory::create<float>('c', {3, 3});
+  auto good = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  auto exp = NDArrayFactory::create<float>('c', {2, 2}, {7.f, 10.f, 15.f, 22.f});
+
+  // failed batch doesn't break session used by the next ones
+  for (int e = 0; e < 3; e++) {
+    auto rb = batcher->submit({&bad}).get();
+    ASSERT_EQ(sd::Status::BAD_GRAPH, rb.status);
+
+    auto rg = batcher->submit({&good}).get();
+    ASSERT_EQ(sd::Status::OK, rg.status);
+    ASSERT_TRUE(exp.equalsTo(rg.outputs[0]));
+  }
+
+  GraphHolder::getInstance().dropGraphAny(graphId);
+}
+
+TEST_F(GraphHolderTests, Batcher_4) {
+  ThrowingOp op;
+  auto graph = new Graph;
+  graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, 3}));
+  graph->addNode(new Node(&op, 1, {-1}));
+  graph->addOutput(1);
+
+  sd::LongType graphId = 127;
+  GraphHolder::getInstance().registerGraph(graphId, graph);
+
+  BatcherOptions options;
+  options.maxBatchSize = 1;
+  auto batcher = GraphHolder::getInstance().enableBatching(graphId, {-1}, options);
+
+  // worker survives exceptions of any type, and every request still gets its result
+  auto x = NDArrayFactory::create<float>('c', {1, 3}, {1.f, 2.f, 3.f});
+  for (int e = 0; e < 3; e++) {
+    auto result = batcher->submit({&x}).get();
+    ASSERT_EQ(sd::Status::BAD_GRAPH, result.status);
+    ASSERT_FALSE(result.error.empty());
+  }
+
+  // workers are joined by then, so stats are final
+  GraphHolder::getInstance().dropGraphAny(graphId);
+  ASSERT_EQ(3, batcher->stats().failed);
+}
@@ -259,3 +259,23 @@ TEST_F(GraphRandomGeneratorTests, FloatingPoint_Test_1) {
   // and positives
   ASSERT_NE(z0.size(), negs);
 }
+
+TEST_F(GraphRandomGeneratorTests, Bulk_Test_1) {
+  sd::graph::RandomGenerator g0(119, 5);
+
+  // odd offset and length, so both block tails are covered
+  const sd::LongType offset = 17;
+  std::array<float, 2500> z0, z1;
+  std::array<float16, 2500> h0;
+
+  g0.relativeBlock<float>(offset, z0.size(), z0.data());
+  g0.relativeBlock<float>(offset, z1.size(), z1.data(), -1.0f, 3.0f);
+  g0.relativeBlock<float16>(offset, h0.size(), h0.data(), -1.0f, 3.0f);
+
+  // bulk values should be exactly the same as per-index ones
+  for (int e = 0; e < z0.size(); e++) {
+    ASSERT_EQ(g0.relativeT<float>(offset + e), z0[e]);
+    ASSERT_EQ(g0.relativeT<float>(offset + e, -1.0f, 3.0f), z1[e]);
+    ASSERT_EQ(g0.relativeT<float16>(offset + e, -1.0f, 3.0f), h0[e]);
+  }
+}
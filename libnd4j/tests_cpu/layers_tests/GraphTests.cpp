@@ -27,6 +27,7 @@
 #include <graph/scheme/graph_generated.h>
 #include <graph/scheme/node_generated.h>
 #include <ops/declarable/DeclarableOp.h>
+#include <ops/declarable/FusedElementwiseOp.h>
 
 #include <ops/declarable/generic/parity_ops.cpp>
 
@@ -1617,3 +1618,183 @@ TEST_F(GraphTests, Test_Minifier_3) {
   // remove file from filesystem
   // ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 }
+
+TEST_F(GraphTests, InterOpParallelism_1) {
+  auto x = NDArrayFactory::create<float>('c', {16, 16});
+  auto y = NDArrayFactory::create<float>('c', {16, 16});
+  x.linspace(-1.0, 0.01);
+  y.linspace(1.0, -0.01);
+
+  sd::ops::tanh opA;
+  sd::ops::sigmoid opB;
+  sd::ops::add opC;
+
+  auto run = [&](int interOpThreads) -> NDArray {
+    Graph graph;
+    graph.getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    graph.getVariableSpace()->putVariable(-1, new NDArray(x.dup()));
+    graph.getVariableSpace()->putVariable(-2, new NDArray(y.dup()));
+
+    // nodes 1..4 share the same layer, and don't depend on each other
+    graph.addNode(new Node(&opA, 1, {-1}));
+    graph.addNode(new Node(&opB, 2, {-2}));
+    graph.addNode(new Node(&opA, 3, {-2}));
+    graph.addNode(new Node(&opB, 4, {-1}));
+    graph.addNode(new Node(&opC, 5, {1, 2}));
+    graph.addNode(new Node(&opC, 6, {3, 4}));
+    graph.addNode(new Node(&opC, 7, {5, 6}));
+
+    auto oldThreads = Environment::getInstance().interOpThreads();
+    Environment::getInstance().setInterOpThreads(interOpThreads);
+    auto status = GraphExecutioner::execute(&graph);
+    Environment::getInstance().setInterOpThreads(oldThreads);
+
+    EXPECT_EQ(sd::Status::OK, status);
+    EXPECT_TRUE(graph.getVariableSpace()->hasVariable(7));
+
+    return graph.getVariableSpace()->getVariable(7)->getNDArray()->dup();
+  };
+
+  auto sequential = run(1);
+  auto concurrent = run(4);
+
+  auto exp = x.transform(transform::Tanh) + y.transform(transform::Sigmoid) + y.transform(transform::Tanh) +
+             x.transform(transform::Sigmoid);
+
+  ASSERT_TRUE(exp.equalsTo(sequential));
+  ASSERT_TRUE(exp.equalsTo(concurrent));
+}
+
+TEST_F(GraphTests, MemoryPlan_1) {
+  auto x = NDArrayFactory::create<float>('c', {16, 16});
+  x.linspace(-1.0, 0.01);
+
+  sd::ops::tanh opA;
+  sd::ops::sigmoid opB;
+  sd::ops::add opC;
+
+  Graph graph;
+  graph.getVariableSpace()->putVariable(-1, new NDArray(x.dup()));
+
+  // chain of nodes: every intermediate array is dead right after the next node consumes it
+  graph.addNode(new Node(&opA, 1, {-1}));
+  graph.addNode(new Node(&opB, 2, {1}));
+  graph.addNode(new Node(&opA, 3, {2}));
+  graph.addNode(new Node(&opB, 4, {3}));
+  graph.addNode(new Node(&opC, 5, {4, -1}));
+
+  auto exp = x.transform(transform::Tanh)
+                 .transform(transform::Sigmoid)
+                 .transform(transform::Tanh)
+                 .transform(transform::Sigmoid) +
+             x;
+
+  auto oldPlanning = Environment::getInstance().isMemoryPlanning();
+  Environment::getInstance().setMemoryPlanning(true);
+
+  auto status = GraphExecutioner::execute(&graph);
+  ASSERT_EQ(sd::Status::OK, status);
+  ASSERT_TRUE(exp.equalsTo(graph.getVariableSpace()->getVariable(5)->getNDArray()));
+
+  auto plan = graph.memoryPlan();
+  ASSERT_TRUE(plan != nullptr);
+  ASSERT_EQ(4, plan->allocations().size());
+  ASSERT_EQ(4 * x.lengthOf() * x.sizeOfT(), plan->naiveBytes());
+  ASSERT_EQ(2 * x.lengthOf() * x.sizeOfT(), plan->plannedBytes());
+
+  // second run goes through the arena
+  graph.getVariableSpace()->getVariable(5)->getNDArray()->assign(0.f);
+  status = GraphExecutioner::execute(&graph);
+  Environment::getInstance().setMemoryPlanning(oldPlanning);
+
+  ASSERT_EQ(sd::Status::OK, status);
+  ASSERT_TRUE(exp.equalsTo(graph.getVariableSpace()->getVariable(5)->getNDArray()));
+}
+
+static void buildFusionGraph(Graph &graph, NDArray &x, NDArray &y, NDArray &b, NDArray &s) {
+  static sd::ops::multiply opA;
+  static sd::ops::biasadd opB;
+  static sd::ops::tanh opC;
+  static sd::ops::subtract opD;
+  static sd::ops::relu opE;
+
+  graph.getVariableSpace()->putVariable(-1, new NDArray(x.dup()));
+  graph.getVariableSpace()->putVariable(-2, new NDArray(y.dup()));
+  graph.getVariableSpace()->putVariable(-3, new NDArray(b.dup()));
+  graph.getVariableSpace()->putVariable(-4, new NDArray(s.dup()));
+
+  // relu(s - tanh(x * y + b)): running value of the chain is Y operand of subtract
+  graph.addNode(new Node(&opA, 1, {-1, -2}));
+  graph.addNode(new Node(&opB, 2, {1, -3}));
+  graph.addNode(new Node(&opC, 3, {2}));
+  graph.addNode(new Node(&opD, 4, {-4, 3}));
+  graph.addNode(new Node(&opE, 5, {4}, {}, {}, 0.0f, {0.0}));
+}
+
+TEST_F(GraphTests, FusedElementwise_1) {
+  auto x = NDArrayFactory::create<float>('c', {64, 48});
+  auto y = NDArrayFactory::create<float>('c', {64, 48});
+  auto b = NDArrayFactory::create<float>('c', {48});
+  auto s = NDArrayFactory::create<float>(0.25f);
+  x.linspace(-1.0, 0.001);
+  y.linspace(0.5, 0.0005);
+  b.linspace(-0.3, 0.01);
+
+  auto oldFusion = Environment::getInstance().isGraphFusion();
+
+  Graph plain;
+  buildFusionGraph(plain, x, y, b, s);
+  Environment::getInstance().setGraphFusion(false);
+  ASSERT_EQ(sd::Status::OK, GraphExecutioner::execute(&plain));
+
+  Graph fused;
+  buildFusionGraph(fused, x, y, b, s);
+  Environment::getInstance().setGraphFusion(true);
+  auto status = GraphExecutioner::execute(&fused);
+  Environment::getInstance().setGraphFusion(oldFusion);
+  ASSERT_EQ(sd::Status::OK, status);
+
+  auto op = dynamic_cast<sd::ops::FusedElementwiseOp *>(fused.getMapped()->at(5)->getCustomOp());
+  ASSERT_TRUE(op != nullptr);
+  ASSERT_EQ(5, op->steps().size());
+  ASSERT_TRUE(op->steps().at(3).reversed);
+  ASSERT_EQ(4, fused.getMapped()->at(5)->input()->size());
+
+  auto exp = plain.getVariableSpace()->getVariable(5)->getNDArray();
+  auto z = fused.getVariableSpace()->getVariable(5)->getNDArray();
+  ASSERT_TRUE(exp->isSameShape(z));
+  ASSERT_TRUE(exp->equalsTo(z));
+}
+
+TEST_F(GraphTests, FusedElementwise_2) {
+  // x has to be broadcast against y, so fused op takes generic path
+  auto x = NDArrayFactory::create<double>('c', {48});
+  auto y = NDArrayFactory::create<double>('c', {16, 48});
+  auto b = NDArrayFactory::create<double>('c', {48});
+  auto s = NDArrayFactory::create<double>(0.25);
+  x.linspace(-1.0, 0.05);
+  y.linspace(0.5, 0.001);
+  b.linspace(-0.3, 0.01);
+
+  auto oldFusion = Environment::getInstance().isGraphFusion();
+
+  Graph plain;
+  buildFusionGraph(plain, x, y, b, s);
+  Environment::getInstance().setGraphFusion(false);
+  ASSERT_EQ(sd::Status::OK, GraphExecutioner::execute(&plain));
+
+  Graph fused;
+  buildFusionGraph(fused, x, y, b, s);
+  Environment::getInstance().setGraphFusion(true);
+  auto status = GraphExecutioner::execute(&fused);
+  Environment::getInstance().setGraphFusion(oldFusion);
+  ASSERT_EQ(sd::Status::OK, status);
+
+  ASSERT_TRUE(dynamic_cast<sd::ops::FusedElementwiseOp *>(fused.getMapped()->at(5)->getCustomOp()) != nullptr);
+
+  auto exp = plain.getVariableSpace()->getVariable(5)->getNDArray();
+  auto z = fused.getVariableSpace()->getVariable(5)->getNDArray();
+  ASSERT_TRUE(exp->isSameShape(z));
+  ASSERT_TRUE(exp->equalsTo(z));
+}
@@ -1859,6 +1859,52 @@ TEST_F(HelpersTests1, mmulHelper_test_7) {
   ASSERT_TRUE(exp.equalsTo(&result));
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_8) {
+  // int32 has no BLAS route, sizes span several register and cache blocks, A is a permuted view
+  const sd::LongType M = 157, K = 301, N = 69;
+  auto a = NDArrayFactory::create<int>('c', {K, M});
+  auto b = NDArrayFactory::create<int>('f', {K, N});
+  auto result = NDArrayFactory::create<int>('c', {M, N});
+  auto expected = NDArrayFactory::create<int>('c', {M, N});
+
+  for (sd::LongType i = 0; i < a.lengthOf(); i++) a.p(i, static_cast<int>(i % 7) - 3);
+  for (sd::LongType i = 0; i < b.lengthOf(); i++) b.p(i, static_cast<int>(i % 5) - 2);
+
+  auto x = a.permute({1, 0});
+
+  for (sd::LongType m = 0; m < M; m++)
+    for (sd::LongType n = 0; n < N; n++) {
+      int sum = 0;
+      for (sd::LongType k = 0; k < K; k++) sum += x.t<int>(m, k) * b.t<int>(k, n);
+      expected.p(m, n, sum);
+    }
+
+  MmulHelper::mmul(&x, &b, &result, 1., 0.);
+
+  ASSERT_EQ(expected, result);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_9) {
+  auto x = NDArrayFactory::create<float16>('c', {4, 3});
+  x.linspace(1);
+  auto y = NDArrayFactory::create<float16>('f', {3, 5});
+  y.linspace(1);
+  auto result = NDArrayFactory::create<float16>('c', {4, 5});
+  result.assign(1.f);
+
+  auto xF = x.cast(sd::DataType::FLOAT32);
+  auto yF = y.cast(sd::DataType::FLOAT32);
+  auto expected = NDArrayFactory::create<float>('c', {4, 5});
+  expected.assign(1.f);
+
+  MmulHelper::mmul(&xF, &yF, &expected, 2., 0.5);
+  MmulHelper::mmul(&x, &y, &result, 2., 0.5);
+
+  ASSERT_TRUE(expected.equalsTo(result.cast(sd::DataType::FLOAT32)));
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, tensordot_test_1) {
   auto a = NDArrayFactory::create<float>('c', {2, 3, 4});
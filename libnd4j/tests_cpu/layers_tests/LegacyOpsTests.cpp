@@ -744,3 +744,36 @@ TEST_F(LegacyOpsTests, test_legacy_transform_float_1) {
                                           x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), nullptr, nullptr,
                                           nullptr);
 }
+
+TEST_F(LegacyOpsTests, test_legacy_reduce_permuted_1) {
+  auto x = NDArrayFactory::create<double>('c', {2, 3, 4, 5, 6});
+  x.linspace(1);
+
+  // permuted views collapse into tads of different ranks and strides
+  auto p = x.permute({3, 0, 4, 1, 2});
+  auto c = p.dup('c');
+
+  std::vector<std::vector<LongType>> dimensions = {{0},    {4},       {1, 3},    {2, 4},    {0, 1, 2},
+                                                   {2, 3}, {1, 2, 4}, {0, 2, 3}, {1, 2, 3, 4}};
+
+  for (auto &dims : dimensions) {
+    ASSERT_EQ(c.reduceAlongDimension(reduce::Sum, dims), p.reduceAlongDimension(reduce::Sum, dims));
+    ASSERT_EQ(c.reduceAlongDimension(reduce::Max, dims), p.reduceAlongDimension(reduce::Max, dims));
+    ASSERT_EQ(c.reduceAlongDimension(reduce::Mean, dims), p.reduceAlongDimension(reduce::Mean, dims));
+    ASSERT_EQ(c.reduceAlongDimension(reduce::CountNonZero, dims), p.reduceAlongDimension(reduce::CountNonZero, dims));
+  }
+}
+
+TEST_F(LegacyOpsTests, test_legacy_reduce_permuted_2) {
+  auto x = NDArrayFactory::create<float>('c', {4, 3, 5, 2});
+  x.linspace(-3, 0.25);
+
+  // reduction into permuted output
+  auto p = x.permute({2, 0, 3, 1});
+  auto z = NDArrayFactory::create<float>('c', {3, 5}).transpose();
+  auto e = p.dup('c').reduceAlongDimension(reduce::Sum, {1, 2});
+
+  p.reduceAlongDimension(reduce::Sum, z, {1, 2});
+
+  ASSERT_EQ(e, z);
+}
@@ -20,6 +20,8 @@
 // Created by raver on 5/13/2018.
 //
 #include <array/NDArray.h>
+#include <graph/FlatUtils.h>
+#include <graph/GraphExecutioner.h>
 #include <legacy/NativeOps.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -54,3 +56,50 @@ TEST_F(MmapTests, Test_Basic_Mmap_1) {
 
   remove("file");
 }
+
+TEST_F(MmapTests, Test_Mapped_Graph_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  auto weights = NDArrayFactory::create<float>('c', {3, 4});
+  weights.linspace(1.f);
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto fArray = FlatUtils::toFlatArray(builder, weights);
+  auto fId = CreateIntPair(builder, -1, 0);
+  auto fVar = CreateFlatVariable(builder, fId, 0, static_cast<sd::graph::DType>(weights.dataType()), 0, fArray, 0,
+                                 VarType_CONSTANT);
+  std::vector<flatbuffers::Offset<FlatVariable>> variables = {fVar};
+  auto fGraph = CreateFlatGraph(builder, 1, builder.CreateVector(variables));
+  builder.Finish(fGraph);
+
+  std::ofstream ofs("mapped_graph.fb", std::ios::binary | std::ios::out);
+  ofs.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+  ofs.close();
+
+  auto graph = GraphExecutioner::importFromMappedFile("mapped_graph.fb");
+  auto array = graph->getVariableSpace()->getVariable(-1)->getNDArray();
+  ASSERT_EQ(weights, *array);
+
+  // arrays living in the mapping are read-only, clones get their own writable copies
+  ASSERT_TRUE(graph->getVariableSpace()->getVariable(-1)->isReadOnly());
+
+  auto cloned = graph->getVariableSpace()->clone();
+  auto clonedArray = cloned->getVariable(-1)->getNDArray();
+  ASSERT_NE(array->buffer(), clonedArray->buffer());
+  ASSERT_FALSE(cloned->getVariable(-1)->isReadOnly());
+
+  clonedArray->assign(0.f);
+  ASSERT_EQ(weights, *array);
+
+  delete graph;
+  ASSERT_EQ(0.f, clonedArray->reduceNumber(reduce::Sum).e<float>(0));
+
+  delete cloned;
+  remove("mapped_graph.fb");
+}
+
+TEST_F(MmapTests, Test_Mapped_Graph_2) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  ASSERT_EQ(sd::Status::BAD_INPUT, registerGraphFromFile(nullptr, 119, "non_existent_graph.fb"));
+}
@@ -21,6 +21,7 @@
 //
 #include <array/NDArray.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/OpStatistics.h>
 #include <helpers/ShapeUtils.h>
 #include <helpers/TAD.h>
 #include <loops/reduce3.h>
@@ -33,6 +34,7 @@
 #include <ops/declarable/LegacyReduceSameOp.h>
 #include <ops/declarable/LegacyScalarOp.h>
 #include <ops/declarable/LegacyTransformOp.h>
+#include <system/CpuDispatch.h>
 
 #include "testlayers.h"
 using namespace sd;
@@ -1479,6 +1481,84 @@ TEST_F(NativeOpsTests, interop_databuffer_tests_1) {
   ::deleteDataBuffer(idb);
 }
 
+TEST_F(NativeOpsTests, OpStatistics_1) {
+#ifdef __CUDABLAS__
+  printf("Unsupported for CUDA platform yet.\n");
+  return;
+#endif
+  auto x = NDArrayFactory::create<float>('c', {5, 5});
+  auto z = NDArrayFactory::create<float>('c', {5, 5});
+  x.linspace(1.);
+
+  auto oldStatistics = Environment::getInstance().isOpStatistics();
+  Environment::getInstance().setOpStatistics(true);
+  ::resetOpStatistics();
+
+  OpaqueDataBuffer xBuf(x.dataBuffer());
+  OpaqueDataBuffer zBuf(z.dataBuffer());
+  for (int e = 0; e < 3; e++)
+    ::execTransformSame(nullptr, transform::Square, &xBuf, x.shapeInfo(), x.specialShapeInfo(), &zBuf, z.shapeInfo(),
+                        z.specialShapeInfo(), nullptr);
+
+  sd::ops::add op;
+  auto result = op.evaluate({&x, &x});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  auto records = OpStatistics::getInstance().snapshot();
+  std::string json(::getOpStatistics());
+  Environment::getInstance().setOpStatistics(oldStatistics);
+
+  auto name = std::string("transform_same:") + std::to_string(transform::Square);
+  ASSERT_EQ(1, records.count(name));
+  ASSERT_EQ(3, records[name].calls);
+  ASSERT_EQ(3 * 2 * x.lengthOf() * sizeof(float), records[name].bytes);
+  ASSERT_LE(records[name].minNanos, records[name].percentile(0.5));
+
+  ASSERT_EQ(1, records.count("add"));
+  ASSERT_EQ(1, records["add"].calls);
+  ASSERT_EQ(3 * x.lengthOf() * sizeof(float), records["add"].bytes);
+
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"add\""));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"" + name + "\""));
+}
+
+TEST_F(NativeOpsTests, OpStatistics_2) {
+  // every value falls into bucket with upper bound above it, and within 1/8 of it
+  for (int64_t v : {0L, 1L, 7L, 8L, 9L, 15L, 16L, 17L, 1000L, 123456L, 987654321L}) {
+    auto b = OpStatistics::bucket(v);
+    auto upper = OpStatistics::bucketUpperBound(b);
+    ASSERT_LT(v, upper);
+    if (b > 0) ASSERT_GE(v, OpStatistics::bucketUpperBound(b - 1));
+    if (v >= OpStatistics::SUB_BUCKETS) ASSERT_LE(upper - v, v / OpStatistics::SUB_BUCKETS + 1);
+  }
+}
+
+TEST_F(NativeOpsTests, IsaDispatch_1) {
+  auto x = NDArrayFactory::create<float>('c', {1027});
+  auto y = NDArrayFactory::create<float>('c', {1027});
+  x.linspace(-3.f, 0.01f);
+  y.linspace(1.f, 0.5f);
+
+  auto sum = x.reduceNumber(reduce::Sum);
+  auto add = x + y;
+  auto exp = x.transform(transform::Exp);
+
+  // generic kernels have to produce the same results as ISA-specific ones
+  ::setMaxDispatchLevel(sd::ISA_GENERIC);
+  if (sd::CpuDispatch::isEnabled()) ASSERT_EQ(sd::ISA_GENERIC, ::dispatchLevel());
+
+  auto sumG = x.reduceNumber(reduce::Sum);
+  auto addG = x + y;
+  auto expG = x.transform(transform::Exp);
+
+  ::setMaxDispatchLevel(0);
+  if (sd::CpuDispatch::isEnabled()) ASSERT_EQ(sd::CpuDispatch::detectedLevel(), ::dispatchLevel());
+
+  ASSERT_NEAR(sum.e<float>(0), sumG.e<float>(0), 1e-3f);
+  ASSERT_EQ(add, addG);
+  ASSERT_EQ(exp, expG);
+}
+
 // Uncomment when needed only - massive calculations
 // TEST_F(NativeOpsTests, BenchmarkTests_1) {
 //
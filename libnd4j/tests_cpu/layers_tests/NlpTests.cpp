@@ -475,3 +475,92 @@ TEST_F(NlpTests, test_cbow_hs_batch_1) {
   ASSERT_EQ(exp1, row_s1_5);
   ASSERT_EQ(exp2, row_s1_6);
 }
+
+TEST_F(NlpTests, test_word2vec_corpus_1) {
+#ifdef __CUDABLAS__
+  return;
+#endif
+
+  // two words with window 1 and no negatives: each one is the only context of the other
+  for (bool isCbow : {false, true}) {
+    auto tokens = NDArrayFactory::create<int>('c', {2}, {0, 1});
+    auto syn0 = NDArrayFactory::create<float>('c', {4, 10});
+    auto syn1Neg = NDArrayFactory::create<float>('c', {4, 10});
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::empty<float>();
+
+    syn0.assign(0.01);
+    syn1Neg.assign(0.02);
+    expTable.assign(0.5);
+
+    sd::ops::word2vec_corpus op;
+    auto result = op.evaluate({&tokens, &syn0, &syn1Neg, &expTable, &negTable}, {0.025}, {1, 0, 1, 1}, {isCbow}, {},
+                              true);
+    ASSERT_EQ(sd::Status::OK, result.status());
+
+    // g = (1 - 0.5) * 0.025, applied to pre-update rows
+    auto exp0 = NDArrayFactory::create<float>('c', {2, 10});
+    auto exp1 = NDArrayFactory::create<float>('c', {2, 10});
+    exp0.assign(0.01025f);
+    exp1.assign(0.020125f);
+
+    ASSERT_TRUE(exp0.equalsTo(syn0({0, 2, 0, 0}, true), 1e-6));
+    ASSERT_TRUE(exp1.equalsTo(syn1Neg({0, 2, 0, 0}, true), 1e-6));
+    ASSERT_NEAR(0.01f, syn0.e<float>(2, 0), 1e-6f);
+    ASSERT_NEAR(0.02f, syn1Neg.e<float>(3, 0), 1e-6f);
+  }
+}
+
+TEST_F(NlpTests, test_word2vec_corpus_2) {
+#ifdef __CUDABLAS__
+  return;
+#endif
+
+  // sentences are built from either first or second half of vocabulary, so halves should form clusters
+  const int vocabSize = 40;
+  const int vectorLength = 16;
+  std::vector<int> corpus;
+  sd::graph::RandomGenerator rng(119, 5);
+  for (int s = 0; s < 2000; s++) {
+    for (int w = 0; w < 10; w++)
+      corpus.emplace_back((s % 2) * (vocabSize / 2) + rng.relativeInt(s * 10 + w) % (vocabSize / 2));
+
+    corpus.emplace_back(-1);
+  }
+
+  auto tokens = NDArrayFactory::create<int>('c', {(sd::LongType)corpus.size()}, corpus);
+  auto syn0 = NDArrayFactory::create<float>('c', {vocabSize, vectorLength});
+  auto syn1Neg = NDArrayFactory::create<float>('c', {vocabSize, vectorLength});
+  auto expTable = NDArrayFactory::create<float>('c', {1000});
+  auto negTable = NDArrayFactory::create<float>('c', {10000});
+
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &syn0, -0.5 / vectorLength, 0.5 / vectorLength);
+  for (int e = 0; e < expTable.lengthOf(); e++) {
+    auto x = sd::math::sd_exp<double, double>((e / (double)expTable.lengthOf() * 2 - 1) * 6.0);
+    expTable.p(e, x / (x + 1));
+  }
+  for (int e = 0; e < negTable.lengthOf(); e++) negTable.p(e, e % vocabSize);
+
+  for (bool isCbow : {false, true}) {
+    sd::ops::word2vec_corpus op;
+    auto result = op.evaluate({&tokens, &syn0, &syn1Neg, &expTable, &negTable}, {0.025, 0.0001}, {5, 5, 119},
+                              {isCbow}, {}, true);
+    ASSERT_EQ(sd::Status::OK, result.status());
+  }
+
+  auto norms = syn0.reduceAlongDimension(reduce::Norm2, {1});
+  auto similarity = [&](int a, int b) -> double {
+    double dot = 0.0;
+    for (int e = 0; e < vectorLength; e++) dot += syn0.e<double>(a, e) * syn0.e<double>(b, e);
+    return dot / (norms.e<double>(a) * norms.e<double>(b));
+  };
+
+  double same = 0.0, cross = 0.0;
+  const int half = vocabSize / 2;
+  for (int a = 0; a < half; a++) {
+    same += similarity(a, (a + 1) % half) + similarity(a + half, (a + 1) % half + half);
+    cross += 2 * similarity(a, a + half);
+  }
+
+  ASSERT_GT(same / vocabSize, cross / vocabSize + 0.5);
+}
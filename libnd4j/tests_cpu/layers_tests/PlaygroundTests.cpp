@@ -23,9 +23,11 @@
 //
 #include <build_info.h>
 #include <graph/Graph.h>
+#include <graph/GraphExecutioner.h>
 #include <graph/Node.h>
 #include <graph/profiling/GraphProfilingHelper.h>
 #include <helpers/BenchmarkHelper.h>
+#include <helpers/BlasHelper.h>
 #include <helpers/ConstantShapeHelper.h>
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/GradCheck.h>
@@ -35,19 +37,24 @@
 #include <helpers/OmpLaunchHelper.h>
 #include <helpers/RandomLauncher.h>
 #include <helpers/threshold.h>
+#include <legacy/NativeOps.h>
 #include <loops/type_conversions.h>
+#include <memory/MemoryCounter.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/addBias.h>
 #include <ops/declarable/helpers/axis.h>
 #include <ops/declarable/helpers/convolutions.h>
 #include <ops/declarable/helpers/im2col.h>
+#include <ops/declarable/helpers/image_resize.h>
 #include <ops/declarable/helpers/legacy_helpers.h>
 #include <ops/declarable/helpers/reductions.h>
 #include <ops/declarable/helpers/scatter.h>
+#include <ops/impl/gemm_blocked.hpp>
 #include <ops/ops.h>
 
 #include <array>
 #include <chrono>
+#include <functional>
 #include <random>
 
 #include "testlayers.h"
@@ -63,7 +70,8 @@ class PlaygroundTests : public testing::Test {
 };
 
 TEST_F(PlaygroundTests, test_avx) {
-  sd_printf("Optimal level: %i; Binary level: %i;\n", ::optimalLevel(), ::binaryLevel());
+  sd_printf("Optimal level: %i; Binary level: %i; Dispatch level: %i;\n", ::optimalLevel(), ::binaryLevel(),
+            ::dispatchLevel());
 }
 
 TEST_F(PlaygroundTests, buildver) { sd_printf("%s\n", buildInfo()); }
@@ -90,6 +98,682 @@ TEST_F(PlaygroundTests, test_biasAdd_1) {
 
   sd_printf("Time: %lld us;\n", values[values.size() / 2]);
 }
+TEST_F(PlaygroundTests, test_gemm_blocked_bench) {
+#ifdef _RELEASE
+  // naive fallback that used to run for types without BLAS vs blocked kernel vs cblas
+  for (sd::LongType n : {128, 256, 512, 1024}) {
+    auto a = NDArrayFactory::create<float>('c', {n, n});
+    auto b = NDArrayFactory::create<float>('c', {n, n});
+    auto c = NDArrayFactory::create<float>('c', {n, n});
+    a.linspace(0.1, 0.001);
+    b.linspace(0.2, 0.001);
+    auto pA = a.bufferAsT<float>();
+    auto pB = b.bufferAsT<float>();
+    auto pC = c.bufferAsT<float>();
+
+    auto naive = [&]() {
+      auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+          const auto m = i / n, j = i % n;
+          float val = 0.f;
+          for (sd::LongType k = 0; k < n; k++) val += pA[m * n + k] * pB[k * n + j];
+          pC[i] = val;
+        }
+      };
+      samediff::Threads::parallel_tad(func, 0, n * n);
+    };
+
+    auto blocked = [&]() {
+      sd::blas::BlockedGEMM<float, float, float>::op(n, n, n, 1.0, pA, n, 1, pB, n, 1, 0.0, pC, n, 1);
+    };
+
+    auto blas = [&]() {
+      BlasHelper::getInstance().sgemm()(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.f, pA, n, pB, n, 0.f,
+                                        pC, n);
+    };
+
+    auto measure = [](const std::function<void()> &func) {
+      std::vector<sd::LongType> values;
+      for (int e = 0; e < 10; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+        func();
+        auto timeEnd = std::chrono::system_clock::now();
+        values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+      }
+      std::sort(values.begin(), values.end());
+      return values[values.size() / 2];
+    };
+
+    const double flops = 2.0 * n * n * n;
+    auto tNaive = measure(naive);
+    auto tBlocked = measure(blocked);
+    sd_printf("gemm %lld: naive %lld us (%.2f GFLOPS); blocked %lld us (%.2f GFLOPS);\n", n, tNaive,
+              flops / tNaive / 1e3, tBlocked, flops / tBlocked / 1e3);
+
+    if (BlasHelper::getInstance().hasGEMM<float>()) {
+      auto tBlas = measure(blas);
+      sd_printf("gemm %lld: cblas %lld us (%.2f GFLOPS);\n", n, tBlas, flops / tBlas / 1e3);
+    }
+
+    // half precision never goes to cblas, so this is what users actually get
+    auto aH = a.cast(sd::DataType::HALF);
+    auto bH = b.cast(sd::DataType::HALF);
+    auto cH = c.cast(sd::DataType::HALF);
+    auto tHalf = measure([&]() { MmulHelper::mmul(&aH, &bH, &cH, 1., 0.); });
+    sd_printf("gemm %lld: float16 mmul %lld us (%.2f GFLOPS);\n", n, tHalf, flops / tHalf / 1e3);
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_fused_elementwise_bench) {
+#ifdef _RELEASE
+  // relu(s - tanh(x * y + b)): 5 passes over memory vs single pass of fused chain
+  auto x = NDArrayFactory::create<float>('c', {4096, 1024});
+  auto y = NDArrayFactory::create<float>('c', {4096, 1024});
+  auto b = NDArrayFactory::create<float>('c', {1024});
+  auto s = NDArrayFactory::create<float>(0.25f);
+  x.linspace(-1.0, 1e-6);
+  y.linspace(0.5, 1e-7);
+  b.linspace(-0.3, 1e-3);
+
+  sd::ops::multiply opA;
+  sd::ops::biasadd opB;
+  sd::ops::tanh opC;
+  sd::ops::subtract opD;
+  sd::ops::relu opE;
+
+  auto oldFusion = Environment::getInstance().isGraphFusion();
+  for (bool fusion : {false, true}) {
+    Environment::getInstance().setGraphFusion(fusion);
+
+    Graph graph;
+    graph.getVariableSpace()->putVariable(-1, new NDArray(x.dup()));
+    graph.getVariableSpace()->putVariable(-2, new NDArray(y.dup()));
+    graph.getVariableSpace()->putVariable(-3, new NDArray(b.dup()));
+    graph.getVariableSpace()->putVariable(-4, new NDArray(s.dup()));
+    graph.addNode(new Node(&opA, 1, {-1, -2}));
+    graph.addNode(new Node(&opB, 2, {1, -3}));
+    graph.addNode(new Node(&opC, 3, {2}));
+    graph.addNode(new Node(&opD, 4, {-4, 3}));
+    graph.addNode(new Node(&opE, 5, {4}, {}, {}, 0.0f, {0.0}));
+
+    // first run allocates outputs
+    GraphExecutioner::execute(&graph);
+
+    std::vector<sd::LongType> values;
+    for (int e = 0; e < 20; e++) {
+      auto timeStart = std::chrono::system_clock::now();
+      GraphExecutioner::execute(&graph);
+      auto timeEnd = std::chrono::system_clock::now();
+      values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(values.begin(), values.end());
+
+    sd_printf("elementwise chain, fusion %s: %lld us\n", fusion ? "on" : "off", values[values.size() / 2]);
+  }
+  Environment::getInstance().setGraphFusion(oldFusion);
+#endif
+}
+
+TEST_F(PlaygroundTests, test_permuted_reduce_bench) {
+#ifdef _RELEASE
+  // reductions over permuted views vs the same reductions over contiguous copies
+  auto x4 = NDArrayFactory::create<float>('c', {32, 64, 56, 56});
+  auto x5 = NDArrayFactory::create<float>('c', {16, 32, 16, 28, 28});
+  x4.linspace(-1.0, 1e-7);
+  x5.linspace(-1.0, 1e-7);
+
+  auto p4 = x4.permute({0, 2, 3, 1});
+  auto p5 = x5.permute({0, 2, 3, 4, 1});
+
+  std::vector<std::pair<NDArray *, std::vector<LongType>>> cases = {
+      {&p4, {1, 2}}, {&p4, {3}}, {&p4, {0, 1, 2}}, {&p5, {1, 2, 3}}, {&p5, {4}}, {&p5, {0, 4}}};
+
+  for (auto &c : cases) {
+    auto contiguous = c.first->dup('c');
+
+    for (auto array : {c.first, &contiguous}) {
+      auto z = array->reduceAlongDimension(reduce::Sum, c.second);
+
+      std::vector<sd::LongType> values;
+      for (int e = 0; e < 20; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+        array->reduceAlongDimension(reduce::Sum, z, c.second);
+        auto timeEnd = std::chrono::system_clock::now();
+        values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+      }
+      std::sort(values.begin(), values.end());
+
+      sd_printf("sum over %s of rank %i %s: %lld us\n", ShapeUtils::shapeAsString(c.second).c_str(),
+                array->rankOf(), array == c.first ? "permuted" : "contiguous", values[values.size() / 2]);
+    }
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_softmax_axis_bench) {
+#ifdef _RELEASE
+  // online softmax engine vs max/subtract/exp/sum/divide sequence, over last and non-last axes
+  std::vector<std::pair<std::vector<LongType>, int>> cases = {
+      {{64, 32000}, 1}, {{32000, 64}, 0}, {{16, 8, 128, 128}, 3}, {{32, 1000, 49}, 1}};
+
+  for (auto &c : cases) {
+    auto x = NDArrayFactory::create<float>('c', c.first);
+    auto z = x.ulike();
+    x.linspace(-1.0, 1e-5);
+    auto dim = c.second;
+
+    sd::ops::softmax op;
+    std::vector<sd::LongType> engine, legacy;
+    for (int e = 0; e < 20; e++) {
+      auto timeStart = std::chrono::system_clock::now();
+      op.execute({&x}, {&z}, {}, {dim}, {});
+      auto timeEnd = std::chrono::system_clock::now();
+      engine.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+      timeStart = std::chrono::system_clock::now();
+      auto max = x.reduceAlongDimension(reduce::Max, {dim}, true);
+      x.applyTrueBroadcast(BroadcastOpsTuple::Subtract(), max, z, false);
+      z.applyTransform(transform::Exp, z);
+      z /= z.reduceAlongDimension(reduce::Sum, {dim}, true);
+      timeEnd = std::chrono::system_clock::now();
+      legacy.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(engine.begin(), engine.end());
+    std::sort(legacy.begin(), legacy.end());
+
+    sd_printf("softmax %s along %i: engine %lld us; 5 passes %lld us\n", ShapeUtils::shapeAsString(c.first).c_str(),
+              dim, engine[engine.size() / 2], legacy[legacy.size() / 2]);
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_top_k_bench) {
+#ifdef _RELEASE
+  sd::ops::top_k op;
+
+  for (sd::LongType width : {1000L, 100000L, 1000000L}) {
+    auto x = NDArrayFactory::create<float>('c', {64, width});
+    RandomGenerator rng(119, 5);
+    RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &x, 0.0, 1.0);
+
+    for (sd::LongType k : {1L, 10L, 100L}) {
+      auto values = NDArrayFactory::create<float>('c', {64, k});
+      auto indices = NDArrayFactory::create<sd::LongType>('c', {64, k});
+
+      std::vector<sd::LongType> times;
+      for (int e = 0; e < 10; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+        op.execute({&x}, {&values, &indices}, {}, {k}, {true});
+        auto timeEnd = std::chrono::system_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+      }
+      std::sort(times.begin(), times.end());
+
+      sd_printf("top_k over [64, %lld], k = %lld: %lld us\n", width, k, times[times.size() / 2]);
+    }
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_random_bench) {
+#ifdef _RELEASE
+  auto x = NDArrayFactory::create<float>('c', {16, 1000000});
+  auto z = x.ulike();
+  RandomGenerator rng(119, 5);
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &x, 0.0, 1.0);
+
+  sd::ops::dropout op;
+  std::vector<sd::LongType> gaussian, logNormal, dropout;
+  for (int e = 0; e < 10; e++) {
+    auto timeStart = std::chrono::system_clock::now();
+    RandomLauncher::fillGaussian(LaunchContext::defaultContext(), rng, &z, 0.0, 1.0);
+    auto timeMid = std::chrono::system_clock::now();
+    RandomLauncher::fillLogNormal(LaunchContext::defaultContext(), rng, &z, 0.0, 1.0);
+    auto timeMid2 = std::chrono::system_clock::now();
+    op.execute({&x}, {&z}, {0.5}, {119}, {});
+    auto timeEnd = std::chrono::system_clock::now();
+
+    gaussian.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeMid - timeStart).count());
+    logNormal.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeMid2 - timeMid).count());
+    dropout.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeMid2).count());
+  }
+  std::sort(gaussian.begin(), gaussian.end());
+  std::sort(logNormal.begin(), logNormal.end());
+  std::sort(dropout.begin(), dropout.end());
+
+  sd_printf("gaussian: %lld us; lognormal: %lld us; dropout: %lld us\n", gaussian[gaussian.size() / 2],
+            logNormal[logNormal.size() / 2], dropout[dropout.size() / 2]);
+#endif
+}
+
+TEST_F(PlaygroundTests, test_word2vec_bench) {
+#ifdef _RELEASE
+  const int vocabSize = 10000;
+  const int vectorLength = 100;
+  const int window = 5;
+  const int nsRounds = 5;
+  const int numTokens = 1000000;
+
+  std::vector<int> corpus(numTokens);
+  RandomGenerator rng(119, 5);
+  for (int e = 0; e < numTokens; e++) corpus[e] = rng.relativeInt(e) % vocabSize;
+
+  auto tokens = NDArrayFactory::create<int>('c', {numTokens}, corpus);
+  auto syn0 = NDArrayFactory::create<float>('c', {vocabSize, vectorLength});
+  auto syn1Neg = NDArrayFactory::create<float>('c', {vocabSize, vectorLength});
+  auto syn1 = NDArrayFactory::empty<float>();
+  auto expTable = NDArrayFactory::create<float>('c', {1000});
+  auto negTable = NDArrayFactory::create<float>('c', {1000000});
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &syn0, -0.005, 0.005);
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &expTable, 0.0, 1.0);
+  negTable.linspace(0.0, (double)vocabSize / negTable.lengthOf());
+
+  const auto numThreads = sd::Environment::getInstance().maxMasterThreads();
+
+  // corpus engine, both modes
+  for (bool isCbow : {false, true}) {
+    sd::ops::word2vec_corpus op;
+    auto timeStart = std::chrono::system_clock::now();
+    op.evaluate({&tokens, &syn0, &syn1Neg, &expTable, &negTable}, {0.025, 0.0001}, {window, nsRounds, 119}, {isCbow},
+                {}, true);
+    auto timeEnd = std::chrono::system_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+    sd_printf("word2vec_corpus %s: %lld us; %.0f words/s per thread\n", isCbow ? "cbow" : "skipgram", us,
+              numTokens * 1e6 / us / numThreads);
+  }
+
+  // existing batched skipgram over the same corpus, one (target, context) pair per window position
+  const int numPairs = 2 * window * 100000;
+  std::vector<int> targets(numPairs), contexts(numPairs);
+  for (int e = 0; e < numPairs; e++) {
+    auto center = window + e / (2 * window);
+    auto offset = e % (2 * window) - window;
+    targets[e] = corpus[center];
+    contexts[e] = corpus[center + (offset >= 0 ? offset + 1 : offset)];
+  }
+
+  auto target = NDArrayFactory::create<int>('c', {numPairs}, targets);
+  auto ngStarter = NDArrayFactory::create<int>('c', {numPairs}, contexts);
+  auto indices = NDArrayFactory::empty<int>();
+  auto codes = NDArrayFactory::empty<int8_t>();
+  auto alpha = NDArrayFactory::create<double>('c', {numPairs});
+  auto randomValue = NDArrayFactory::create<sd::LongType>('c', {numPairs});
+  auto inferenceVector = NDArrayFactory::empty<float>();
+  auto neu1e = NDArrayFactory::create<float>('c', {numPairs, vectorLength});
+  alpha.assign(0.025);
+  randomValue.linspace(1);
+
+  sd::ops::skipgram op;
+  auto timeStart = std::chrono::system_clock::now();
+  op.evaluate({&target, &ngStarter, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha,
+               &randomValue, &inferenceVector, &neu1e},
+              {}, {numThreads, nsRounds}, {false, false}, {}, true);
+  auto timeEnd = std::chrono::system_clock::now();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+  sd_printf("skipgram batch: %lld us; %.0f words/s per thread\n", us, (numPairs / (2 * window)) * 1e6 / us / numThreads);
+#endif
+}
+
+TEST_F(PlaygroundTests, test_image_resize_bench) {
+#ifdef _RELEASE
+  auto input = NDArrayFactory::create<float>('c', {16, 480, 640, 3});
+  RandomGenerator rng(119, 5);
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &input, 0.0, 255.0);
+  auto inputUInt8 = input.cast(DataType::UINT8);
+  auto size = NDArrayFactory::create<int>({224, 224});
+
+  sd::ops::image_resize op;
+  for (auto method : {ops::helpers::kResizeBilinear, ops::helpers::kResizeLanczos3}) {
+    for (auto antialias : {false, true}) {
+      for (auto image : {&input, &inputUInt8}) {
+        std::vector<sd::LongType> values;
+        for (int e = 0; e < 10; e++) {
+          auto timeStart = std::chrono::system_clock::now();
+          op.evaluate({image, &size}, {}, {method}, {false, antialias});
+          auto timeEnd = std::chrono::system_clock::now();
+          values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        }
+        std::sort(values.begin(), values.end());
+
+        sd_printf("method %i, antialias %i, %s: %lld us\n", (int)method, (int)antialias,
+                  image->dataType() == DataType::UINT8 ? "uint8" : "float", values[values.size() / 2]);
+      }
+    }
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_segment_bench) {
+#ifdef _RELEASE
+  const int numRows = 1000000, rowLength = 32, numClasses = 1000;
+  auto input = NDArrayFactory::create<float>('c', {numRows, rowLength});
+  auto indices = NDArrayFactory::create<int>('c', {numRows});
+  RandomGenerator rng(119, 5);
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &input, -1.0, 1.0);
+
+  // skewed classes: squared uniform puts most of rows into the first few classes
+  std::vector<int> classes(numRows);
+  for (int e = 0; e < numRows; e++) {
+    auto u = rng.relativeT<double>(e, 0.0, 1.0);
+    classes[e] = static_cast<int>(u * u * (numClasses - 1));
+    indices.p(e, classes[e]);
+  }
+
+  std::sort(classes.begin(), classes.end());
+  auto sorted = NDArrayFactory::create<int>('c', {numRows}, classes);
+  auto gradO = NDArrayFactory::create<float>('c', {numClasses, rowLength});
+  gradO.assign(1.f);
+
+  sd::ops::segment_sum opSortedSum;
+  sd::ops::unsorted_segment_sum opSum;
+  sd::ops::unsorted_segment_max opMax;
+  sd::ops::unsorted_segment_mean opMean;
+  sd::ops::unsorted_segment_max_bp opMaxBp;
+
+  std::vector<std::pair<std::string, std::function<void()>>> cases = {
+      {"segment_sum", [&]() { opSortedSum.evaluate({&input, &sorted}); }},
+      {"unsorted_segment_sum", [&]() { opSum.evaluate({&input, &indices}, {}, {numClasses}); }},
+      {"unsorted_segment_max", [&]() { opMax.evaluate({&input, &indices}, {}, {numClasses}); }},
+      {"unsorted_segment_mean", [&]() { opMean.evaluate({&input, &indices}, {}, {numClasses}); }},
+      {"unsorted_segment_max_bp", [&]() { opMaxBp.evaluate({&input, &indices, &gradO}, {}, {numClasses}); }}};
+
+  for (auto& c : cases) {
+    std::vector<sd::LongType> values;
+    for (int e = 0; e < 10; e++) {
+      auto timeStart = std::chrono::system_clock::now();
+      c.second();
+      auto timeEnd = std::chrono::system_clock::now();
+      values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(values.begin(), values.end());
+
+    sd_printf("%s: %lld us\n", c.first.c_str(), values[values.size() / 2]);
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_updater_foreach_bench) {
+#ifdef _RELEASE
+  // 100 layers, each with [256, 256] weights and two [256] vectors: bias and layer-norm gain
+  std::vector<std::vector<sd::LongType>> shapes;
+  sd::LongType total = 0;
+  for (int e = 0; e < 100; e++) {
+    for (auto shape : {std::vector<sd::LongType>{256, 256}, std::vector<sd::LongType>{256},
+                       std::vector<sd::LongType>{256}}) {
+      shapes.emplace_back(shape);
+      total += shape::prodLong(shape.data(), shape.size());
+    }
+  }
+
+  // one flat buffer per role, parameters are views into it
+  std::vector<NDArray> flat;
+  for (int e = 0; e < 3; e++) flat.emplace_back(NDArrayFactory::create<float>('c', {total}));
+  RandomGenerator rng(119, 5);
+  RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &flat[0], -0.1, 0.1);
+
+  std::vector<NDArray> views, copies;
+  for (auto& array : flat) {
+    sd::LongType offset = 0;
+    for (auto& shape : shapes) {
+      auto length = shape::prodLong(shape.data(), shape.size());
+      views.emplace_back(array({offset, offset + length}).reshape('c', shape, false));
+      copies.emplace_back(views.back().dup());
+      offset += length;
+    }
+  }
+
+  std::vector<NDArray*> viewArgs, copyArgs;
+  for (auto& view : views) viewArgs.emplace_back(&view);
+  for (auto& copy : copies) copyArgs.emplace_back(&copy);
+
+  const int numParams = shapes.size();
+  sd::ops::adam_updater op;
+  sd::ops::adam_updater_foreach opForeach;
+  std::vector<double> tArgs = {0.001, 0.9, 0.999, 1e-8};
+
+  std::vector<std::pair<std::string, std::function<void()>>> cases = {
+      {"adam_updater per parameter",
+       [&]() {
+         for (int p = 0; p < numParams; p++) {
+           std::vector<NDArray*> args = {copyArgs[p], copyArgs[numParams + p], copyArgs[2 * numParams + p]};
+           op.execute(args, args, tArgs, {});
+         }
+       }},
+      {"adam_updater_foreach", [&]() { opForeach.execute(copyArgs, copyArgs, tArgs, {}); }},
+      {"adam_updater_foreach, flat views", [&]() { opForeach.execute(viewArgs, viewArgs, tArgs, {}); }}};
+
+  for (auto& c : cases) {
+    std::vector<sd::LongType> values;
+    for (int e = 0; e < 20; e++) {
+      auto timeStart = std::chrono::system_clock::now();
+      c.second();
+      auto timeEnd = std::chrono::system_clock::now();
+      values.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(values.begin(), values.end());
+
+    sd_printf("%s: %lld us\n", c.first.c_str(), values[values.size() / 2]);
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_lstm_layer_bench) {
+#ifdef _RELEASE
+  const int sL = 64;
+  const int nIn = 128;
+  const int nOut = 256;
+
+  sd::ops::lstmLayer op;
+  sd::ops::lstmLayer_bp opBp;
+
+  for (int bS : {1, 32}) {
+    auto x = NDArrayFactory::create<float>('c', {sL, bS, nIn});
+    auto Wx = NDArrayFactory::create<float>('c', {nIn, 4 * nOut});
+    auto Wr = NDArrayFactory::create<float>('c', {nOut, 4 * nOut});
+    auto b = NDArrayFactory::create<float>('c', {4 * nOut});
+    auto dLdh = NDArrayFactory::create<float>('c', {sL, bS, nOut});
+
+    RandomGenerator rng(119, 5);
+    for (auto array : {&x, &Wx, &Wr, &b, &dLdh})
+      RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, array, -0.1, 0.1);
+
+    // dataFormat TNS, forward, sigmoid gates, tanh cell and output, biases, full sequence returned
+    std::vector<sd::LongType> iArgs = {0, 0, 2, 0, 0};
+    std::vector<bool> bArgs = {true, false, false, false, false, true, false, false};
+
+    std::vector<sd::LongType> times, timesBp;
+    for (int e = 0; e < 10; e++) {
+      auto timeStart = std::chrono::system_clock::now();
+      auto results = op.evaluate({&x, &Wx, &Wr, &b}, {0.}, iArgs, bArgs);
+      auto timeEnd = std::chrono::system_clock::now();
+      times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+      timeStart = std::chrono::system_clock::now();
+      auto resultsBp = opBp.evaluate({&x, &Wx, &Wr, &b, &dLdh}, {0.}, iArgs, bArgs);
+      timeEnd = std::chrono::system_clock::now();
+      timesBp.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(times.begin(), times.end());
+    std::sort(timesBp.begin(), timesBp.end());
+
+    sd_printf("lstmLayer sL = %i, bS = %i, nIn = %i, nOut = %i: ff %lld us; bp %lld us\n", sL, bS, nIn, nOut,
+              times[times.size() / 2], timesBp[timesBp.size() / 2]);
+  }
+#endif
+}
+
+TEST_F(PlaygroundTests, test_dot_product_attention_bench) {
+#ifdef _RELEASE
+  const int bS = 4;
+  const int nH = 8;
+  const int d = 64;
+
+  sd::ops::dot_product_attention op;
+  sd::ops::dot_product_attention_bp opBp;
+  auto &counter = sd::memory::MemoryCounter::getInstance();
+
+  for (int T : {128, 512, 2048}) {
+    auto queries = NDArrayFactory::create<float>('c', {bS, nH, d, T});
+    auto keys = NDArrayFactory::create<float>('c', {bS, nH, d, T});
+    auto values = NDArrayFactory::create<float>('c', {bS, nH, d, T});
+    auto eps = NDArrayFactory::create<float>('c', {bS, nH, d, T});
+    auto mask = NDArrayFactory::create<float>('c', {bS, T});
+    mask.assign(1.f);
+
+    RandomGenerator rng(119, 5);
+    for (auto array : {&queries, &keys, &values, &eps})
+      RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, array, -1, 1);
+
+    // weights requested: [Tk, Tq] matrix of every head is materialized, just like before blocked kernel
+    for (int withWeights : {0, 1}) {
+      std::vector<sd::LongType> times;
+      sd::LongType peak = 0;
+      for (int e = 0; e < 5; e++) {
+        auto before = counter.allocatedGroup(sd::memory::MemoryType::HOST);
+        counter.resetPeakGroup(sd::memory::MemoryType::HOST);
+
+        auto timeStart = std::chrono::system_clock::now();
+        auto results = op.evaluate({&queries, &keys, &values, &mask}, {1, withWeights});
+        auto timeEnd = std::chrono::system_clock::now();
+
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        peak = counter.peakGroup(sd::memory::MemoryType::HOST) - before;
+      }
+      std::sort(times.begin(), times.end());
+
+      sd_printf("dot_product_attention T = %i, weights = %i: %lld us; peak %lld MB\n", T, withWeights,
+                times[times.size() / 2], peak / (1024 * 1024));
+    }
+
+    std::vector<sd::LongType> timesBp;
+    sd::LongType peakBp = 0;
+    for (int e = 0; e < 5; e++) {
+      auto before = counter.allocatedGroup(sd::memory::MemoryType::HOST);
+      counter.resetPeakGroup(sd::memory::MemoryType::HOST);
+
+      auto timeStart = std::chrono::system_clock::now();
+      auto results = opBp.evaluate({&queries, &keys, &values, &eps, &mask}, {1});
+      auto timeEnd = std::chrono::system_clock::now();
+
+      timesBp.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+      peakBp = counter.peakGroup(sd::memory::MemoryType::HOST) - before;
+    }
+    std::sort(timesBp.begin(), timesBp.end());
+
+    sd_printf("dot_product_attention_bp T = %i: %lld us; peak %lld MB\n", T, timesBp[timesBp.size() / 2],
+              peakBp / (1024 * 1024));
+  }
+#endif
+}
+
+template <typename T>
+static void benchSort(const char *name) {
+  for (sd::LongType length : {10000, 1000000, 100000000}) {
+    auto x = NDArrayFactory::create<T>('c', {length});
+    auto values = NDArrayFactory::create<sd::LongType>('c', {length});
+    RandomGenerator rng(119, 5);
+    RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &x, -1000, 1000);
+    values.linspace(0);
+
+    std::vector<sd::LongType> timesQuick, timesSort, timesByKey;
+    for (int e = 0; e < 3; e++) {
+      // quicksort is what sort() used before radix sort
+      auto quick = x.dup();
+      auto timeStart = std::chrono::system_clock::now();
+      SpecialMethods<T>::quickSort_parallel(quick.buffer(), quick.shapeInfo(), length, omp_get_max_threads(), false);
+      auto timeEnd = std::chrono::system_clock::now();
+      timesQuick.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+      auto sorted = x.dup();
+      timeStart = std::chrono::system_clock::now();
+      sort(nullptr, sorted.buffer(), sorted.shapeInfo(), nullptr, nullptr, false);
+      timeEnd = std::chrono::system_clock::now();
+      timesSort.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+      auto keys = x.dup();
+      auto payload = values.dup();
+      timeStart = std::chrono::system_clock::now();
+      sortByKey(nullptr, keys.buffer(), keys.shapeInfo(), nullptr, nullptr, payload.buffer(), payload.shapeInfo(),
+                nullptr, nullptr, false);
+      timeEnd = std::chrono::system_clock::now();
+      timesByKey.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+    }
+    std::sort(timesQuick.begin(), timesQuick.end());
+    std::sort(timesSort.begin(), timesSort.end());
+    std::sort(timesByKey.begin(), timesByKey.end());
+
+    sd_printf("sort %s [%lld]: quicksort %lld us; sort %lld us; sortByKey %lld us\n", name, length, timesQuick[1],
+              timesSort[1], timesByKey[1]);
+  }
+}
+
+TEST_F(PlaygroundTests, test_sort_bench) {
+#ifdef _RELEASE
+  benchSort<float>("float");
+  benchSort<double>("double");
+  benchSort<float16>("half");
+  benchSort<int>("int");
+  benchSort<sd::LongType>("long");
+  benchSort<uint8_t>("uint8");
+#endif
+}
+
+TEST_F(PlaygroundTests, test_conv2d_algorithms_bench) {
+#ifdef _RELEASE
+  // {bS, iC, oC, iH, iW, kH, kW, sH}
+  const std::vector<std::vector<int>> shapes = {
+      {8, 64, 64, 56, 56, 3, 3, 1}, {8, 3, 32, 112, 112, 3, 3, 1}, {8, 128, 128, 28, 28, 1, 1, 1},
+      {8, 32, 64, 56, 56, 3, 3, 2}, {8, 256, 256, 14, 14, 3, 3, 1}};
+  const char *names[] = {"im2col", "direct", "implicit_gemm", "winograd_2x2", "winograd_4x4"};
+
+  for (auto &shape : shapes) {
+    const int bS = shape[0], iC = shape[1], oC = shape[2], iH = shape[3], iW = shape[4], kH = shape[5], kW = shape[6];
+    const int sH = shape[7], sW = shape[7], pH = kH / 2, pW = kW / 2;
+    const int oH = (iH + 2 * pH - kH) / sH + 1, oW = (iW + 2 * pW - kW) / sW + 1;
+
+    auto input = NDArrayFactory::create<float>('c', {bS, iC, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+    auto output = NDArrayFactory::create<float>('c', {bS, oC, oH, oW});
+    auto columns = NDArrayFactory::create<float>('c', {bS, iC, kH, kW, oH, oW});
+    auto outputNHWC = NDArrayFactory::create<float>('c', {bS, oH, oW, oC});
+    input.linspace(-1, 0.0001);
+    weights.linspace(1, -0.0001);
+
+    auto selected = sd::ops::ConvolutionUtils::conv2dAlgorithm({&input, &weights, &output}, iC, oC, oH, oW, kH, kW,
+                                                               sH, sW, 1, 1);
+
+    for (int algorithm = sd::ops::CONV2D_IM2COL; algorithm <= sd::ops::CONV2D_WINOGRAD_4X4; algorithm++) {
+      const bool isWinograd =
+          algorithm == sd::ops::CONV2D_WINOGRAD_2X2 || algorithm == sd::ops::CONV2D_WINOGRAD_4X4;
+      if (isWinograd && (kH != 3 || kW != 3 || sH != 1)) continue;
+
+      std::vector<sd::LongType> times;
+      for (int e = 0; e < 5; e++) {
+        auto timeStart = std::chrono::system_clock::now();
+
+        if (algorithm == sd::ops::CONV2D_IM2COL) {
+          // columns are materialized, just like conv2d did before native engine
+          sd::ops::helpers::im2col(*LaunchContext::defaultContext(), input, columns, kH, kW, sH, sW, pH, pW, 1, 1,
+                                   NDArrayFactory::create(0.f));
+          MmulHelper::tensorDot(&columns, &weights, &outputNHWC, {1, 2, 3}, {2, 0, 1});
+        } else {
+          sd::ops::ConvolutionUtils::conv2dNative(static_cast<sd::ops::Conv2dAlgorithm>(algorithm), &input, &weights,
+                                                  &output, kH, kW, sH, sW, pH, pW, 1, 1, 1, 0);
+        }
+
+        auto timeEnd = std::chrono::system_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+      }
+      std::sort(times.begin(), times.end());
+
+      sd_printf("conv2d [%i, %i, %i, %i] -> %i, k%ix%i s%i, %s%s: %lld us\n", bS, iC, iH, iW, oC, kH, kW, sH,
+                names[algorithm], algorithm == selected ? " (selected)" : "", times[times.size() / 2]);
+    }
+  }
+#endif
+}
+
 #if defined(TEST_BENCH_CONV)
 
 void bench_conv(int outter_loop, const char *msg, const std::vector<NDArray *> &inList,
@@ -318,6 +318,29 @@ TEST_F(RNGTests, Test_Gaussian_21) {
   ASSERT_NEAR(variance->e<float>(0), 1.0f, 0.2f);
 }
 
+TEST_F(RNGTests, Test_Gaussian_Bulk_1) {
+  // odd length spanning few blocks
+  auto x0 = NDArrayFactory::create<float>('c', {2051});
+
+  RandomLauncher::fillGaussian(LaunchContext::defaultContext(), _rngA, &x0, 1.0f, 2.0f);
+
+  // every pair should match Box-Muller transform of per-index uniform values
+  const float two_pi = 2.0f * 3.14159265358979323846f;
+  const sd::LongType length = x0.lengthOf();
+  const sd::LongType middle = length / 2 + length % 2;
+  for (sd::LongType e = 0; e < middle; e++) {
+    auto r0 = _rngB.relativeT<float>(e, 1e-5f, 1.0f);
+    auto r1 = _rngB.relativeT<float>(e + middle, 1e-5f, 1.0f);
+    auto radius = sd::math::sd_sqrt<float, float>(-2.0f * sd::math::sd_log<float, float>(r0));
+
+    auto z0 = radius * sd::math::sd_cos<float, float>(two_pi * r1) * 2.0f + 1.0f;
+    auto z1 = radius * sd::math::sd_sin<float, float>(two_pi * r1) * 2.0f + 1.0f;
+
+    ASSERT_NEAR(z0, x0.e<float>(e), 1e-5f);
+    if (e + middle < length) ASSERT_NEAR(z1, x0.e<float>(e + middle), 1e-5f);
+  }
+}
+
 #ifdef DEBUG_BUILD
 TEST_F(RNGTests, Test_Gaussian_22) {
   auto x0 = NDArrayFactory::create<float>('c', {1000, 800});
@@ -78,7 +78,7 @@ TEST_F(SortCpuTests, test_tad_sort_by_key_1) {
   auto ev = NDArrayFactory::create<double>('c', {2, 10}, {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5,
                                                           0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5});
 
-  int axis = 1;
+  sd::LongType axis = 1;
   sortTadByKey(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(),
                v.specialBuffer(), v.specialShapeInfo(), &axis, 1, false);
 
@@ -99,10 +99,83 @@ TEST_F(SortCpuTests, test_tad_sort_by_val_1) {
   auto ev = NDArrayFactory::create<double>('c', {2, 10}, {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5,
                                                           0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5});
 
-  int axis = 1;
+  sd::LongType axis = 1;
   sortTadByValue(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(),
                  v.specialBuffer(), v.specialShapeInfo(), &axis, 1, false);
 
   ASSERT_EQ(ek, k);
   ASSERT_EQ(ev, v);
 }
+
+TEST_F(SortCpuTests, test_linear_sort_radix_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  // long enough for radix path, negative values and duplicates included
+  const int length = 100000;
+  auto x = NDArrayFactory::create<float>('c', {length});
+  auto e = NDArrayFactory::create<float>('c', {length});
+  auto eDesc = NDArrayFactory::create<float>('c', {length});
+  for (int i = 0; i < length; i++) {
+    x.p(i, static_cast<float>((i * 7919) % length - length / 2) / 4.f);
+    e.p(i, static_cast<float>(i - length / 2) / 4.f);
+    eDesc.p(length - 1 - i, static_cast<float>(i - length / 2) / 4.f);
+  }
+
+  auto y = x.dup();
+
+  sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), false);
+  ASSERT_EQ(e, x);
+
+  sort(nullptr, y.buffer(), y.shapeInfo(), y.specialBuffer(), y.specialShapeInfo(), true);
+  ASSERT_EQ(eDesc, y);
+}
+
+TEST_F(SortCpuTests, test_linear_sort_by_key_radix_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  const int length = 50000;
+  auto k = NDArrayFactory::create<int>('c', {length});
+  auto v = NDArrayFactory::create<sd::LongType>('c', {length});
+  for (int i = 0; i < length; i++) {
+    k.p(i, (length - 1 - i) / 2 - 1000);
+    v.p(i, i);
+  }
+
+  sortByKey(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(),
+            v.specialBuffer(), v.specialShapeInfo(), false);
+
+  // equal keys keep original order of values
+  for (int i = 0; i < length; i++) {
+    ASSERT_EQ(i / 2 - 1000, k.e<int>(i));
+    ASSERT_EQ(length - 1 - (i ^ 1), v.e<sd::LongType>(i));
+  }
+}
+
+TEST_F(SortCpuTests, test_strided_sort_by_value_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  auto kOrig = NDArrayFactory::create<double>('c', {10, 2});
+  auto vOrig = NDArrayFactory::create<float>('c', {2, 10});
+  kOrig.linspace(0.5, 0.5);
+  vOrig.assign(7.f);
+
+  auto k = kOrig({0, 0, 0, 1}, true);
+  auto v = vOrig({1, 2, 0, 0}, true);
+  v.assign(NDArrayFactory::create<float>('c', {1, 10}, {-1.5, 3.5, 5.5, -9.5, 0.5, 2.5, 4.5, 6.5, 7.5, 8.5}));
+  k.linspace(0.5, 1.);
+
+  auto ek = NDArrayFactory::create<double>('c', {10, 1}, {9.5, 8.5, 7.5, 2.5, 6.5, 1.5, 5.5, 4.5, 0.5, 3.5});
+  auto ev = NDArrayFactory::create<float>('c', {1, 10}, {8.5, 7.5, 6.5, 5.5, 4.5, 3.5, 2.5, 0.5, -1.5, -9.5});
+
+  sortByValue(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(),
+              v.specialBuffer(), v.specialShapeInfo(), true);
+
+  ASSERT_EQ(ev, v);
+  ASSERT_TRUE(ek.equalsTo(k));
+
+  // second column of keys and first row of values stay intact
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(7.f, vOrig.e<float>(0, i));
+    ASSERT_EQ(static_cast<double>(1 + i), kOrig.e<double>(i, 1));
+  }
+}
@@ -223,6 +223,38 @@ TEST_F(ThreadsTests, crash_test_1) {
   }
 }
 
+TEST_F(ThreadsTests, nested_test_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  // outer regions opened concurrently by several threads, with nested regions inside of them
+  std::atomic<int64_t> total(0);
+  auto outer = [&]() {
+    for (int e = 0; e < 50; e++) {
+      auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+          auto inner = PRAGMA_REDUCE_LONG {
+            int64_t sum = 0;
+            for (auto j = start; j < stop; j++) sum++;
+
+            return sum;
+          };
+
+          total += Threads::parallel_long(inner, LAMBDA_AL { return _old + _new; }, 0, 4096, 1, 4);
+        }
+      };
+
+      Threads::parallel_tad(func, 0, 16, 1, 8);
+    }
+  };
+
+  std::vector<std::thread> threads(4);
+  for (auto &t : threads) t = std::thread(outer);
+
+  for (auto &t : threads) t.join();
+
+  ASSERT_EQ(4 * 50 * 16 * 4096, total.load());
+}
+
 /*
 TEST_F(ThreadsTests, basic_test_1) {
     if (!Environment::getInstance().isCPU())
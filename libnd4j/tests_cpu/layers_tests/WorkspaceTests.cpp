@@ -263,6 +263,55 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
   ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, SpillsRecycling_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  char buffer[1024];
+  ExternalWorkspace pojo((sd::Pointer)buffer, 1024, nullptr, 0);
+  Workspace ws(&pojo);
+
+  // external workspace can't grow, so spilled blocks are reused by the following cycles
+  for (int c = 0; c < 5; c++) {
+    for (int e = 0; e < 4; e++) ws.allocateBytes(1000);
+
+    ASSERT_EQ(3000, ws.getSpilledSize());
+    ws.scopeOut();
+  }
+
+  ASSERT_EQ(1024, ws.getCurrentSize());
+  ASSERT_EQ(15, ws.getSpillsCount());
+  ASSERT_EQ(12, ws.getRecycledSpillsCount());
+  ASSERT_EQ(15000, ws.getTotalSpilledSize());
+  ASSERT_EQ(4000, ws.getPeakCycleAllocations());
+}
+
+TEST_F(WorkspaceTests, AutoGrow_1) {
+  if (!Environment::getInstance().isCPU()) return;
+
+  Workspace ws(1024);
+
+  auto base = ws.allocateBytes(1000);
+  for (int e = 0; e < 3; e++) ws.allocateBytes(1000);
+  ws.scopeOut();
+
+  // scopeOut() doesn't move workspace memory, it grows on next scopeIn()
+  ASSERT_EQ(1024, ws.getCurrentSize());
+  ASSERT_EQ(base, ws.allocateBytes(1000));
+  ws.scopeOut();
+
+  for (int c = 0; c < 4; c++) {
+    ws.scopeIn();
+    for (int e = 0; e < 4; e++) ws.allocateBytes(1000);
+
+    ws.scopeOut();
+  }
+
+  // workspace grows to the high-water mark after the first cycle
+  ASSERT_EQ(4000, ws.getCurrentSize());
+  ASSERT_EQ(3, ws.getSpillsCount());
+  ASSERT_EQ(0, ws.getSpilledSize());
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {
@@ -1200,8 +1200,29 @@ public interface NativeOps {
 
     int registerGraph(PointerPointer extraPointers, long graphId, Pointer flatBufferPointer);
 
+    /**
+     * Registers graph stored in FlatBuffers file: file is memory-mapped, and weights are used from the mapping where possible
+     */
+    int registerGraphFromFile(PointerPointer extraPointers, long graphId, String fileName);
+
     OpaqueVariablesSet executeStoredGraph(PointerPointer extraPointers, long graphId, PointerPointer inputBuffers, PointerPointer inputShapes, IntPointer inputIndices, int numInputs);
 
+    /**
+     * Starts batching front-end for stored graph: requests passed to executeBatchedGraph() are coalesced along the first dimension,
+     * up to maxBatchSize rows or until the oldest one waited for maxLatencyMicros.
+     * padding: 0 - only equally shaped requests are batched together, 1 - ragged requests are padded with padValue
+     */
+    int registerGraphBatcher(PointerPointer extraPointers, long graphId, IntPointer inputIndices, int numInputs, int maxBatchSize, long maxLatencyMicros, int numWorkers, int padding, double padValue);
+
+    int unregisterGraphBatcher(PointerPointer extraPointers, long graphId);
+
+    OpaqueVariablesSet executeBatchedGraph(PointerPointer extraPointers, long graphId, PointerPointer inputBuffers, PointerPointer inputShapes, IntPointer inputIndices, int numInputs);
+
+    /**
+     * Fills 8 values: requests, batches, failed requests, rows, padded elements, total queue time (us), current queue depth, max queue depth
+     */
+    void getGraphBatcherStats(PointerPointer extraPointers, long graphId, @Cast("sd::LongType *") LongPointer stats);
+
     long getVariablesSetSize(OpaqueVariablesSet set);
     int getVariablesSetStatus(OpaqueVariablesSet set);
     OpaqueVariable getVariable(OpaqueVariablesSet set, long i);
@@ -1349,6 +1370,21 @@ public interface NativeOps {
 
     long getCachedMemory(int deviceId);
 
+    /**
+     * Returns value of the counter of constant caches
+     * @param cacheType 0 for shapes cache, 1 for TADs cache
+     * @param counter 0 - thread-local hits, 1 - shared hits, 2 - misses, 3 - contended inserts, 4 - cached entries
+     */
+    long getConstantCacheCounter(int cacheType, int counter);
+
+    /**
+     * Returns per-op call counts, latency percentiles and histograms, bytes touched and platform helper hits,
+     * collected since start or last reset, as JSON document
+     */
+    String getOpStatistics();
+
+    void resetOpStatistics();
+
     OpaqueLaunchContext defaultLaunchContext();
 
     Pointer lcScalarPointer(OpaqueLaunchContext lc);
@@ -1370,6 +1406,16 @@ public interface NativeOps {
     boolean isMinimalRequirementsMet();
     boolean isOptimalRequirementsMet();
 
+    /**
+     * Returns ISA level used by runtime-dispatched CPU kernels: 1 - generic, 2 - AVX2, 3 - AVX-512, 0 if dispatch isn't available
+     */
+    int dispatchLevel();
+
+    /**
+     * Caps ISA level of runtime-dispatched CPU kernels, 0 removes the cap
+     */
+    void setMaxDispatchLevel(int level);
+
 
     OpaqueDataBuffer allocateDataBuffer(long elements, int dataType, boolean allocateBoth);
     OpaqueDataBuffer dbAllocateDataBuffer(long elements, int dataType, boolean allocateBoth);